@@ -529,10 +529,14 @@ export async function loadTracks(): Promise<TrackDefinition[]> {
 
   const csvFiles = entries.filter((name) => name.toLowerCase().endsWith(".csv")).sort();
   const tracks: TrackDefinition[] = [];
+  // Issue every read at once; parsing below stays in file order.
+  const reads = await Promise.allSettled(csvFiles.map((file) => fs.readFile(path.join(dir, file), "utf-8")));
 
-  for (const file of csvFiles) {
+  for (const [index, file] of csvFiles.entries()) {
     try {
-      const content = await fs.readFile(path.join(dir, file), "utf-8");
+      const read = reads[index];
+      if (read.status === "rejected") throw read.reason;
+      const content = read.value;
       const parsedCones = parseCsvCones(content);
       const cones = scaleTrack(parsedCones, TRACK_SCALE_FACTOR);
       const slug = file.replace(/\.csv$/i, "");
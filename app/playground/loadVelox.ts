@@ -18,11 +18,11 @@ async function readYamlDirectory(
     .filter((name) => name.toLowerCase().endsWith(".yaml"))
     .filter((name) => (filter ? filter(name) : true))
 
+  const contents = await Promise.all(files.map((name) => fs.readFile(path.join(dir, name), "utf-8")))
   const results: Record<string, string> = {}
-  for (const name of files) {
-    const content = await fs.readFile(path.join(dir, name), "utf-8")
-    results[`${prefix}${name}`] = content
-  }
+  files.forEach((name, index) => {
+    results[`${prefix}${name}`] = contents[index]
+  })
   return results
 }
 
@@ -116,24 +116,28 @@ function ensureModelTiming(configFiles: Record<string, string>): void {
 export async function loadVeloxBundle(): Promise<VeloxConfigBundle> {
   const configDir = path.join(process.cwd(), "config")
   const parameterDir = path.join(process.cwd(), "parameters")
-  const tracks = await loadTracks()
-
-  const configFiles = await readYamlDirectory(configDir)
-  ensureModelTiming(configFiles)
-
   const allowedVehicleIds = new Set<number>([BMW_VEHICLE_ID])
 
-  const parameterFiles = {
-    ...(await readYamlDirectory(path.join(parameterDir, "tire"), "tire/")),
-    ...(await readYamlDirectory(
+  // Every directory is read concurrently; nothing below depends on another read.
+  const [tracks, configFiles, tireFiles, vehicleFiles, stFiles, vehicles] = await Promise.all([
+    loadTracks(),
+    readYamlDirectory(configDir),
+    readYamlDirectory(path.join(parameterDir, "tire"), "tire/"),
+    readYamlDirectory(
       path.join(parameterDir, "vehicle"),
       "vehicle/",
       (name) => allowedVehicleIds.has(vehicleIdFromName(name) ?? -1)
-    )),
-    ...(await readYamlDirectory(path.join(parameterDir, "st"), "st/")),
-  }
+    ),
+    readYamlDirectory(path.join(parameterDir, "st"), "st/"),
+    loadVehicleOptions(path.join(parameterDir, "vehicle"), allowedVehicleIds),
+  ])
+  ensureModelTiming(configFiles)
 
-  const vehicles = await loadVehicleOptions(path.join(parameterDir, "vehicle"), allowedVehicleIds)
+  const parameterFiles = {
+    ...tireFiles,
+    ...vehicleFiles,
+    ...stFiles,
+  }
 
   return {
     configRoot: CONFIG_ROOT,
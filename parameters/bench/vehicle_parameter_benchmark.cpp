@@ -0,0 +1,301 @@
+// Startup benchmark for the parameter subsystem.
+//
+// Times cold (first in process) and warm (repeated) loads of vehicles 1-4 and splits
+// setup_vehicle_parameters into its stages: the fs::exists checks, mapping the files and the
+// streaming field extraction, with the yaml-cpp route alongside for comparison. The cached,
+// .vpbin snapshot and catalog paths are measured too, plus the compiled-in sets when built
+// with VELOX_EMBEDDED_PARAMETERS.
+//
+// Output is JSON in the Google Benchmark layout ({"context": ..., "benchmarks": [...]}),
+// so existing compare scripts can diff two runs.
+//
+//   vehicle_parameter_benchmark [--root parameters] [--iterations 200] [--out results.json]
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <ctime>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "vehicle_catalog.hpp"
+#include "vehicle_parameter_cache.hpp"
+#include "vehicle_parameter_snapshot.hpp"
+#include "vehicle_parameters.hpp"
+#include "yaml_subset.hpp"
+
+#ifndef VELOX_PARAMETERS_NO_YAML
+#include "vehicle_parameters_yaml.hpp"
+#endif
+
+#ifdef VELOX_EMBEDDED_PARAMETERS
+#include "vehicle/parameters_vehicle_embedded.hpp"
+#endif
+
+namespace fs = std::filesystem;
+using namespace velox::models;
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+struct Options {
+    std::string root = "parameters";
+    int iterations = 200;
+    std::string out;
+};
+
+struct Result {
+    std::string name;
+    int iterations{};
+    double first_ns{}; // the first (cold) sample
+    double min_ns{};
+    double median_ns{};
+    double mean_ns{};
+    double p99_ns{};
+};
+
+// Keeps the optimiser from discarding a benchmarked result.
+template <typename T>
+void do_not_optimize(const T& value)
+{
+#if defined(__GNUC__) || defined(__clang__)
+    asm volatile("" : : "r,m"(value) : "memory");
+#else
+    static volatile const void* sink;
+    sink = &value;
+#endif
+}
+
+double elapsed_ns(Clock::time_point start)
+{
+    return std::chrono::duration<double, std::nano>(Clock::now() - start).count();
+}
+
+// Runs body `iterations` times; `before` (untimed) runs ahead of every sample.
+Result measure(const std::string& name, int iterations,
+               const std::function<void()>& body,
+               const std::function<void()>& before = {})
+{
+    std::vector<double> samples;
+    samples.reserve(static_cast<std::size_t>(iterations));
+    for (int i = 0; i < iterations; ++i) {
+        if (before) before();
+        const auto start = Clock::now();
+        body();
+        samples.push_back(elapsed_ns(start));
+    }
+
+    Result r;
+    r.name = name;
+    r.iterations = iterations;
+    r.first_ns = samples.front();
+    double sum = 0.0;
+    for (double s : samples) sum += s;
+    r.mean_ns = sum / static_cast<double>(samples.size());
+    std::sort(samples.begin(), samples.end());
+    r.min_ns = samples.front();
+    r.median_ns = samples[samples.size() / 2];
+    r.p99_ns = samples[std::min(samples.size() - 1, samples.size() * 99 / 100)];
+    return r;
+}
+
+Options parse_options(int argc, char** argv)
+{
+    Options o;
+    for (int i = 1; i < argc; ++i) {
+        const std::string arg = argv[i];
+        auto value = [&]() -> std::string {
+            if (i + 1 >= argc) throw std::invalid_argument("Missing value for " + arg);
+            return argv[++i];
+        };
+        if (arg == "--root") {
+            o.root = value();
+        } else if (arg == "--iterations") {
+            o.iterations = std::max(1, std::atoi(value().c_str()));
+        } else if (arg == "--out") {
+            o.out = value();
+        } else {
+            throw std::invalid_argument("Unknown argument: " + arg);
+        }
+    }
+    return o;
+}
+
+std::string json_escape(const std::string& s)
+{
+    std::string out;
+    for (char c : s) {
+        if (c == '"' || c == '\\') out.push_back('\\');
+        out.push_back(c);
+    }
+    return out;
+}
+
+std::string to_json(const Options& o, const std::vector<Result>& results)
+{
+    std::ostringstream js;
+    const std::time_t now = std::time(nullptr);
+    char date[32];
+    std::strftime(date, sizeof(date), "%Y-%m-%dT%H:%M:%S", std::localtime(&now));
+
+    js << "{\n  \"context\": {\n"
+       << "    \"date\": \"" << date << "\",\n"
+       << "    \"executable\": \"vehicle_parameter_benchmark\",\n"
+       << "    \"num_cpus\": " << std::thread::hardware_concurrency() << ",\n"
+       << "    \"parameter_root\": \"" << json_escape(o.root) << "\",\n"
+#ifdef VELOX_EMBEDDED_PARAMETERS
+       << "    \"embedded_parameters\": true,\n"
+#else
+       << "    \"embedded_parameters\": false,\n"
+#endif
+#ifdef NDEBUG
+       << "    \"library_build_type\": \"release\"\n"
+#else
+       << "    \"library_build_type\": \"debug\"\n"
+#endif
+       << "  },\n  \"benchmarks\": [";
+    for (std::size_t i = 0; i < results.size(); ++i) {
+        const Result& r = results[i];
+        js << (i ? "," : "") << "\n    {"
+           << "\"name\": \"" << json_escape(r.name) << "\", "
+           << "\"run_type\": \"iteration\", "
+           << "\"iterations\": " << r.iterations << ", "
+           << "\"real_time\": " << r.median_ns << ", "
+           << "\"cpu_time\": " << r.median_ns << ", "
+           << "\"time_unit\": \"ns\", "
+           << "\"first_ns\": " << r.first_ns << ", "
+           << "\"min_ns\": " << r.min_ns << ", "
+           << "\"mean_ns\": " << r.mean_ns << ", "
+           << "\"p99_ns\": " << r.p99_ns << "}";
+    }
+    js << "\n  ]\n}\n";
+    return js.str();
+}
+
+} // anonymous namespace
+
+int main(int argc, char** argv)
+{
+    try {
+        const Options opt = parse_options(argc, argv);
+        const int n = opt.iterations;
+        std::vector<Result> results;
+
+        const fs::path root = parameter_root(opt.root);
+        const fs::path snapshot_dir = fs::temp_directory_path() / "velox_parameter_benchmark";
+        fs::create_directories(snapshot_dir);
+
+        for (int id = 1; id <= 4; ++id) {
+            const std::string suffix = "/vehicle" + std::to_string(id);
+            const fs::path vehicle_yaml = vehicle_parameter_file(root, id);
+            const fs::path tire_yaml = tire_parameter_file(root);
+
+            // The first iteration of each stage is its cold sample (first touch in process).
+            results.push_back(measure("setup_vehicle_parameters" + suffix, n, [&] {
+                do_not_optimize(setup_vehicle_parameters(id, opt.root));
+            }));
+
+            results.push_back(measure("stage/fs_exists" + suffix, n, [&] {
+                const bool found = fs::exists(vehicle_yaml) && fs::exists(tire_yaml);
+                do_not_optimize(found);
+            }));
+
+            results.push_back(measure("stage/map_files" + suffix, n, [&] {
+                MappedTextFile vehicle(vehicle_yaml.string());
+                MappedTextFile tire(tire_yaml.string());
+                do_not_optimize(vehicle.text());
+                do_not_optimize(tire.text());
+            }));
+
+            const MappedTextFile vehicle_text(vehicle_yaml.string());
+            const MappedTextFile tire_text(tire_yaml.string());
+            results.push_back(measure("stage/stream_fields" + suffix, n, [&] {
+                VehicleParameters p;
+                apply_vehicle_document(vehicle_text.text(), p);
+                apply_tire_document(tire_text.text(), p);
+                do_not_optimize(p);
+            }));
+
+#ifndef VELOX_PARAMETERS_NO_YAML
+            // The yaml-cpp route, for comparison with the streaming reader.
+            results.push_back(measure("yaml_cpp/load_file" + suffix, n, [&] {
+                YAML::Node vehicle = YAML::LoadFile(vehicle_yaml.string());
+                YAML::Node tire = YAML::LoadFile(tire_yaml.string());
+                do_not_optimize(vehicle);
+                do_not_optimize(tire);
+            }));
+
+            const YAML::Node vehicle_doc = YAML::LoadFile(vehicle_yaml.string());
+            const YAML::Node tire_doc = YAML::LoadFile(tire_yaml.string());
+            results.push_back(measure("yaml_cpp/field_extraction" + suffix, n, [&] {
+                VehicleParameters p;
+                apply_vehicle_yaml(vehicle_doc, p);
+                apply_tire_yaml(tire_doc, p);
+                do_not_optimize(p);
+            }));
+#endif
+
+            results.push_back(measure("cache/miss" + suffix, n,
+                [&] { do_not_optimize(cached_vehicle_parameters(id, opt.root)); },
+                [] { clear_vehicle_parameter_cache(); }));
+
+            cached_vehicle_parameters(id, opt.root);
+            results.push_back(measure("cache/hit" + suffix, n, [&] {
+                do_not_optimize(cached_vehicle_parameters(id, opt.root));
+            }));
+
+            const VehicleParameters params = setup_vehicle_parameters(id, opt.root);
+            const std::string snapshot =
+                (snapshot_dir / ("vehicle" + std::to_string(id) + ".vpbin")).string();
+
+            results.push_back(measure("snapshot/write" + suffix, n, [&] {
+                write_vehicle_parameter_snapshot(snapshot, params, id);
+            }));
+
+            results.push_back(measure("snapshot/load" + suffix, n, [&] {
+                do_not_optimize(load_vehicle_parameter_snapshot(snapshot));
+            }));
+
+            results.push_back(measure("snapshot/mmap" + suffix, n, [&] {
+                MappedVehicleParameters mapped(snapshot);
+                do_not_optimize(mapped.get());
+            }));
+
+#ifdef VELOX_EMBEDDED_PARAMETERS
+            results.push_back(measure("embedded/lookup" + suffix, n, [&] {
+                do_not_optimize(embedded::find_vehicle_parameters(id));
+            }));
+#endif
+        }
+
+        // All vehicles at once: one directory scan, one tire parse, parallel vehicle parses.
+        results.push_back(measure("catalog/load_vehicle_catalog", n, [&] {
+            do_not_optimize(load_vehicle_catalog(opt.root));
+        }));
+
+        std::error_code ec;
+        fs::remove_all(snapshot_dir, ec);
+
+        const std::string json = to_json(opt, results);
+        if (opt.out.empty()) {
+            std::cout << json;
+        } else {
+            std::ofstream out(opt.out);
+            if (!out) throw std::runtime_error("Cannot open " + opt.out);
+            out << json;
+        }
+        return 0;
+    } catch (const std::exception& e) {
+        std::cerr << "vehicle_parameter_benchmark: " << e.what() << '\n';
+        return 1;
+    }
+}
@@ -0,0 +1,342 @@
+#include "config_bundle.hpp"
+#include "vehicle_parameter_cache.hpp"
+#include "yaml_subset.hpp"
+
+#include <cmath>
+#include <stdexcept>
+#include <string_view>
+#include <vector>
+
+namespace fs = std::filesystem;
+
+namespace velox::models {
+
+namespace {
+
+// One config/ document flattened to dotted scalar paths ("normal.engage_speed"). The values
+// stay text until a typed accessor asks for them, so errors can name the line.
+class ConfigDocument {
+public:
+    explicit ConfigDocument(const fs::path& file)
+        : name_(file.filename().string())
+    {
+        const MappedTextFile text(file.string());
+        try {
+            YamlSubsetReader reader(text.text());
+            YamlEvent event;
+            while (reader.next(event)) {
+                if (event.type != YamlEventType::Scalar) continue;
+                std::string path;
+                for (std::size_t d = 0; d < reader.open_maps(); ++d) {
+                    path.append(reader.map_key(d));
+                    path.push_back('.');
+                }
+                path.append(event.key);
+                entries_.push_back({std::move(path), std::string(event.value), event.line});
+            }
+        } catch (const std::runtime_error& e) {
+            throw std::runtime_error(name_ + ": " + e.what());
+        }
+    }
+
+    bool has_section(std::string_view section) const
+    {
+        for (const Entry& e : entries_) {
+            if (e.path.size() > section.size() && e.path.compare(0, section.size(), section) == 0 &&
+                e.path[section.size()] == '.') {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    double number(const std::string& path) const
+    {
+        const Entry& e = require(path);
+        double value = 0.0;
+        if (!parse_yaml_number(e.value, value) || !std::isfinite(value)) {
+            fail(e, "expects a finite number, got '" + e.value + "'");
+        }
+        return value;
+    }
+
+    bool flag(const std::string& path) const
+    {
+        const Entry& e = require(path);
+        bool value = false;
+        if (!parse_yaml_bool(e.value, value)) {
+            fail(e, "expects true or false, got '" + e.value + "'");
+        }
+        return value;
+    }
+
+    [[noreturn]] void invalid(const std::string& what) const
+    {
+        throw std::runtime_error(name_ + ": " + what);
+    }
+
+private:
+    struct Entry {
+        std::string path;
+        std::string value;
+        std::size_t line{};
+    };
+
+    const Entry& require(const std::string& path) const
+    {
+        for (const Entry& e : entries_) {
+            if (e.path == path) return e;
+        }
+        invalid("missing " + path);
+    }
+
+    [[noreturn]] void fail(const Entry& e, const std::string& what) const
+    {
+        invalid("line " + std::to_string(e.line) + ": " + e.path + " " + what);
+    }
+
+    std::string name_;
+    std::vector<Entry> entries_;
+};
+
+void check(const ConfigDocument& doc, bool ok, const char* what)
+{
+    if (!ok) doc.invalid(what);
+}
+
+AeroConfig load_aero(const ConfigDocument& doc)
+{
+    AeroConfig c;
+    c.drag_coefficient      = doc.number("drag_coefficient");
+    c.downforce_coefficient = doc.number("downforce_coefficient");
+    check(doc, c.drag_coefficient >= 0.0 && c.downforce_coefficient >= 0.0,
+          "aero coefficients must be non-negative");
+    return c;
+}
+
+BrakesConfig load_brakes(const ConfigDocument& doc)
+{
+    BrakesConfig c;
+    c.max_force       = doc.number("max_force");
+    c.max_regen_force = doc.number("max_regen_force");
+    c.min_regen_speed = doc.number("min_regen_speed");
+    check(doc, c.max_force > 0.0, "max_force must be positive");
+    check(doc, c.max_regen_force >= 0.0 && c.min_regen_speed >= 0.0,
+          "max_regen_force and min_regen_speed must be non-negative");
+    return c;
+}
+
+FinalAccelControllerConfig load_final_accel_controller(const ConfigDocument& doc)
+{
+    FinalAccelControllerConfig c;
+    c.tau_throttle       = doc.number("tau_throttle");
+    c.tau_brake          = doc.number("tau_brake");
+    c.accel_min          = doc.number("accel_min");
+    c.accel_max          = doc.number("accel_max");
+    c.stop_speed_epsilon = doc.number("stop_speed_epsilon");
+    check(doc, c.tau_throttle > 0.0 && c.tau_brake > 0.0, "time constants must be positive");
+    check(doc, c.accel_min <= 0.0 && c.accel_max >= 0.0 && c.accel_min < c.accel_max,
+          "requires accel_min <= 0 <= accel_max with accel_min < accel_max");
+    check(doc, c.stop_speed_epsilon >= 0.0, "stop_speed_epsilon must be non-negative");
+    return c;
+}
+
+MetricThreshold load_metric(const ConfigDocument& doc, const std::string& prefix)
+{
+    MetricThreshold m;
+    m.threshold = doc.number(prefix + ".threshold");
+    m.rate      = doc.number(prefix + ".rate");
+    if (!(m.threshold > 0.0) || !(m.rate > 0.0)) {
+        doc.invalid(prefix + " requires positive threshold and rate");
+    }
+    return m;
+}
+
+LossOfControlConfig load_loss_of_control(const ConfigDocument& doc, VehicleModel model)
+{
+    std::string section = vehicle_model_key(model);
+    if (!doc.has_section(section)) section = "std";
+
+    LossOfControlConfig c;
+    c.yaw_rate      = load_metric(doc, section + ".yaw_rate");
+    c.slip_angle    = load_metric(doc, section + ".slip_angle");
+    c.lateral_accel = load_metric(doc, section + ".lateral_accel");
+    c.slip_ratio    = load_metric(doc, section + ".slip_ratio");
+    return c;
+}
+
+// Same checks as LowSpeedSafety.validateConfig.
+LowSpeedSafetyProfile load_profile(const ConfigDocument& doc, const std::string& name)
+{
+    LowSpeedSafetyProfile p;
+    p.engage_speed     = doc.number(name + ".engage_speed");
+    p.release_speed    = doc.number(name + ".release_speed");
+    p.yaw_rate_limit   = doc.number(name + ".yaw_rate_limit");
+    p.slip_angle_limit = doc.number(name + ".slip_angle_limit");
+    if (p.engage_speed < 0.0 || p.release_speed <= 0.0 || p.release_speed < p.engage_speed) {
+        doc.invalid("profile " + name + " has invalid engage/release speeds");
+    }
+    if (!(p.yaw_rate_limit > 0.0) || !(p.slip_angle_limit > 0.0)) {
+        doc.invalid("profile " + name + " requires positive limits");
+    }
+    return p;
+}
+
+LowSpeedSafetyConfig load_low_speed_safety(const ConfigDocument& doc)
+{
+    LowSpeedSafetyConfig c;
+    c.normal             = load_profile(doc, "normal");
+    c.drift              = load_profile(doc, "drift");
+    c.stop_speed_epsilon = doc.number("stop_speed_epsilon");
+    c.drift_enabled      = doc.flag("drift_enabled");
+    check(doc, c.stop_speed_epsilon >= 0.0, "stop_speed_epsilon must be non-negative");
+    return c;
+}
+
+ModelTiming load_timing(const ConfigDocument& doc, VehicleModel model)
+{
+    const std::string section = vehicle_model_key(model);
+    if (!doc.has_section(section)) {
+        return {0.01, 0.016}; // ConfigManager.loadModelTiming defaults
+    }
+    ModelTiming t;
+    t.nominal_dt = doc.number(section + ".nominal_dt");
+    t.max_dt     = doc.number(section + ".max_dt");
+    check(doc, t.nominal_dt > 0.0 && t.max_dt >= t.nominal_dt, "requires 0 < nominal_dt <= max_dt");
+    return t;
+}
+
+PowertrainConfig load_powertrain(const ConfigDocument& doc)
+{
+    PowertrainConfig c;
+    c.max_drive_torque     = doc.number("max_drive_torque");
+    c.max_regen_torque     = doc.number("max_regen_torque");
+    c.max_power            = doc.number("max_power");
+    c.drive_efficiency     = doc.number("drive_efficiency");
+    c.regen_efficiency     = doc.number("regen_efficiency");
+    c.min_soc              = doc.number("min_soc");
+    c.max_soc              = doc.number("max_soc");
+    c.initial_soc          = doc.number("initial_soc");
+    c.battery_capacity_kwh = doc.number("battery_capacity_kwh");
+    check(doc, c.max_drive_torque > 0.0 && c.max_power > 0.0, "max_drive_torque and max_power must be positive");
+    check(doc, c.max_regen_torque >= 0.0, "max_regen_torque must be non-negative");
+    check(doc, c.drive_efficiency > 0.0 && c.drive_efficiency <= 1.0 &&
+               c.regen_efficiency > 0.0 && c.regen_efficiency <= 1.0,
+          "efficiencies must lie in (0, 1]");
+    check(doc, 0.0 <= c.min_soc && c.min_soc <= c.initial_soc && c.initial_soc <= c.max_soc && c.max_soc <= 1.0,
+          "requires 0 <= min_soc <= initial_soc <= max_soc <= 1");
+    check(doc, c.battery_capacity_kwh > 0.0, "battery_capacity_kwh must be positive");
+    return c;
+}
+
+RollingConfig load_rolling(const ConfigDocument& doc)
+{
+    RollingConfig c;
+    c.c_rr = doc.number("c_rr");
+    check(doc, c.c_rr >= 0.0, "c_rr must be non-negative");
+    return c;
+}
+
+SteeringConfig load_steering(const ConfigDocument& doc)
+{
+    SteeringConfig c;
+    c.wheel.max_angle           = doc.number("wheel.max_angle");
+    c.wheel.max_rate            = doc.number("wheel.max_rate");
+    c.wheel.nudge_angle         = doc.number("wheel.nudge_angle");
+    c.wheel.centering_stiffness = doc.number("wheel.centering_stiffness");
+    c.wheel.centering_deadband  = doc.number("wheel.centering_deadband");
+    check(doc, c.wheel.max_angle > 0.0 && c.wheel.max_rate > 0.0 && c.wheel.nudge_angle > 0.0,
+          "wheel max_angle, max_rate and nudge_angle must be positive");
+    check(doc, c.wheel.centering_stiffness >= 0.0 && c.wheel.centering_deadband >= 0.0,
+          "wheel centering terms must be non-negative");
+
+    c.final.min_angle               = doc.number("final.min_angle");
+    c.final.max_angle               = doc.number("final.max_angle");
+    c.final.max_rate                = doc.number("final.max_rate");
+    c.final.actuator_time_constant  = doc.number("final.actuator_time_constant");
+    c.final.smoothing_time_constant = doc.number("final.smoothing_time_constant");
+    check(doc, c.final.min_angle < c.final.max_angle, "final steering requires min_angle < max_angle");
+    check(doc, c.final.max_rate > 0.0, "final max_rate must be positive");
+    check(doc, c.final.actuator_time_constant >= 0.0 && c.final.smoothing_time_constant >= 0.0,
+          "final time constants must be non-negative");
+    return c;
+}
+
+ConfigDocument open_document(const fs::path& root, const char* name)
+{
+    const fs::path file = root / name;
+    if (!fs::exists(file)) {
+        throw std::runtime_error("Config file not found: " + file.string());
+    }
+    return ConfigDocument(file);
+}
+
+} // anonymous namespace
+
+const char* vehicle_model_key(VehicleModel model)
+{
+    switch (model) {
+    case VehicleModel::St:  return "st";
+    case VehicleModel::Std: return "std";
+    case VehicleModel::Mb:  return "mb";
+    }
+    return "st";
+}
+
+fs::path config_root(const std::string& dir_params, const std::string& dir_config)
+{
+    if (!dir_config.empty()) {
+        return fs::path(dir_config);
+    }
+#ifdef VELOX_CONFIG_ROOT
+    if (dir_params.empty()) {
+        return fs::path(VELOX_CONFIG_ROOT);
+    }
+#endif
+    // sibling of the parameter root, like ConfigManager's siblingConfigRoot
+    fs::path params = parameter_root(dir_params).lexically_normal();
+    if (!params.has_filename()) params = params.parent_path();
+    return params.parent_path() / "config";
+}
+
+std::shared_ptr<const ConfigBundle> load_config_bundle(int vehicle_id, VehicleModel model,
+                                                       const std::string& dir_params,
+                                                       const std::string& dir_config)
+{
+    return make_config_bundle(vehicle_id, *load_model_configs(model, dir_params, dir_config), dir_params);
+}
+
+std::shared_ptr<const ConfigBundle> load_model_configs(VehicleModel model, const std::string& dir_params,
+                                                       const std::string& dir_config)
+{
+    const fs::path root = config_root(dir_params, dir_config);
+
+    auto bundle = std::make_shared<ConfigBundle>();
+    bundle->model = model;
+
+    bundle->aero                   = load_aero(open_document(root, "aero.yaml"));
+    bundle->brakes                 = load_brakes(open_document(root, "brakes.yaml"));
+    bundle->final_accel_controller = load_final_accel_controller(open_document(root, "final_accel_controller.yaml"));
+    bundle->loss_of_control        = load_loss_of_control(open_document(root, "loss_of_control_detector.yaml"), model);
+    bundle->timing                 = load_timing(open_document(root, "model_timing.yaml"), model);
+    bundle->powertrain             = load_powertrain(open_document(root, "powertrain.yaml"));
+    bundle->rolling                = load_rolling(open_document(root, "rolling.yaml"));
+    bundle->steering               = load_steering(open_document(root, "steering.yaml"));
+
+    const fs::path override_file = root / ("low_speed_safety_" + std::string(vehicle_model_key(model)) + ".yaml");
+    bundle->low_speed_safety = load_low_speed_safety(
+        fs::exists(override_file) ? ConfigDocument(override_file) : open_document(root, "low_speed_safety.yaml"));
+
+    return bundle;
+}
+
+std::shared_ptr<const ConfigBundle> make_config_bundle(int vehicle_id, const ConfigBundle& configs,
+                                                       const std::string& dir_params)
+{
+    auto bundle = std::make_shared<ConfigBundle>(configs);
+    bundle->vehicle    = *cached_vehicle_parameters(vehicle_id, dir_params);
+    bundle->vehicle_id = vehicle_id;
+    return bundle;
+}
+
+} // namespace velox::models
@@ -0,0 +1,189 @@
+#pragma once
+
+#include <cstddef>
+#include <filesystem>
+#include <memory>
+#include <string>
+
+#include "vehicle_parameters.hpp"
+
+namespace velox::models {
+
+/**
+ * Typed counterparts of the documents in config/, field for field. Every key is required;
+ * unknown keys are ignored like in the vehicle loader.
+ */
+
+// config/aero.yaml
+struct AeroConfig {
+    double drag_coefficient{};
+    double downforce_coefficient{};
+};
+
+// config/brakes.yaml
+struct BrakesConfig {
+    double max_force{};       // [N]
+    double max_regen_force{}; // [N]
+    double min_regen_speed{}; // [m/s]
+};
+
+// config/final_accel_controller.yaml
+struct FinalAccelControllerConfig {
+    double tau_throttle{};       // [s]
+    double tau_brake{};          // [s]
+    double accel_min{};          // [m/s^2]
+    double accel_max{};          // [m/s^2]
+    double stop_speed_epsilon{}; // [m/s]
+};
+
+struct MetricThreshold {
+    double threshold{};
+    double rate{};
+};
+
+// one model section of config/loss_of_control_detector.yaml
+struct LossOfControlConfig {
+    MetricThreshold yaw_rate{};
+    MetricThreshold slip_angle{};
+    MetricThreshold lateral_accel{};
+    MetricThreshold slip_ratio{};
+};
+
+struct LowSpeedSafetyProfile {
+    double engage_speed{};     // [m/s]
+    double release_speed{};    // [m/s]
+    double yaw_rate_limit{};   // [rad/s]
+    double slip_angle_limit{}; // [rad]
+};
+
+// config/low_speed_safety.yaml, or its low_speed_safety_<model>.yaml override
+struct LowSpeedSafetyConfig {
+    LowSpeedSafetyProfile normal{};
+    LowSpeedSafetyProfile drift{};
+    double stop_speed_epsilon{}; // [m/s]
+    bool drift_enabled{};
+};
+
+// one model section of config/model_timing.yaml
+struct ModelTiming {
+    double nominal_dt{}; // [s]
+    double max_dt{};     // [s]
+};
+
+// config/powertrain.yaml
+struct PowertrainConfig {
+    double max_drive_torque{};     // [N m]
+    double max_regen_torque{};     // [N m]
+    double max_power{};            // [W]
+    double drive_efficiency{};     // (0, 1]
+    double regen_efficiency{};     // (0, 1]
+    double min_soc{};              // [0, 1]
+    double max_soc{};              // [0, 1]
+    double initial_soc{};          // [min_soc, max_soc]
+    double battery_capacity_kwh{}; // [kWh]
+};
+
+// config/rolling.yaml
+struct RollingConfig {
+    double c_rr{};
+};
+
+struct SteeringWheelConfig {
+    double max_angle{};           // [rad]
+    double max_rate{};            // [rad/s]
+    double nudge_angle{};         // [rad] incremental change per input step
+    double centering_stiffness{}; // [1/s] pull-back rate towards center
+    double centering_deadband{};  // [rad] no centering within this window
+};
+
+struct SteeringFinalConfig {
+    double min_angle{};               // [rad]
+    double max_angle{};               // [rad]
+    double max_rate{};                // [rad/s]
+    double actuator_time_constant{};  // [s]
+    double smoothing_time_constant{}; // [s]
+};
+
+// config/steering.yaml
+struct SteeringConfig {
+    SteeringWheelConfig wheel{};
+    SteeringFinalConfig final{};
+};
+
+enum class VehicleModel {
+    St,  // single track
+    Std, // single track with wheel dynamics
+    Mb,  // multi-body
+};
+
+/** Lower-case key of model as used in config/ ("st", "std", "mb"). */
+const char* vehicle_model_key(VehicleModel model);
+
+inline constexpr std::size_t kConfigCacheLine = 64;
+
+/**
+ * ConfigBundle
+ *
+ * Everything a simulator reads at reset: the vehicle parameters plus every config/ document,
+ * resolved for one model. Built once by load_config_bundle and shared read-only between
+ * simulators; the alignment keeps the block from sharing a cache line with writable data.
+ */
+struct alignas(kConfigCacheLine) ConfigBundle {
+    VehicleParameters vehicle{};
+    AeroConfig aero{};
+    BrakesConfig brakes{};
+    FinalAccelControllerConfig final_accel_controller{};
+    LossOfControlConfig loss_of_control{};
+    LowSpeedSafetyConfig low_speed_safety{};
+    ModelTiming timing{};
+    PowertrainConfig powertrain{};
+    RollingConfig rolling{};
+    SteeringConfig steering{};
+    VehicleModel model{VehicleModel::St};
+    int vehicle_id{};
+};
+
+/**
+ * load_config_bundle
+ *
+ * Loads VehicleParameters (through cached_vehicle_parameters) and all config/ documents,
+ * validates them and returns the immutable bundle. Model-specific documents resolve as in
+ * ConfigManager: low_speed_safety_<model>.yaml falls back to low_speed_safety.yaml, and the
+ * <model> section of model_timing.yaml falls back to nominal 0.01 s / max 0.016 s. The
+ * loss-of-control thresholds are only tuned for STD, so other models fall back to its section.
+ *
+ * @param vehicle_id  CommonRoad vehicle ID (1..4 as in the reference paper)
+ * @param model       model whose sections are selected
+ * @param dir_params  parameter directory, same semantics as setup_vehicle_parameters
+ * @param dir_config  config directory; empty means config_root(dir_params)
+ *
+ * Throws std::runtime_error naming the file for a missing document or key, a malformed or
+ * non-numeric value, or a value outside its valid range.
+ */
+std::shared_ptr<const ConfigBundle> load_config_bundle(int vehicle_id, VehicleModel model,
+                                                       const std::string& dir_params = {},
+                                                       const std::string& dir_config = {});
+
+/**
+ * The vehicle-independent half of load_config_bundle: every config/ document, read and
+ * validated once and resolved for model. vehicle is left default and vehicle_id is 0; pass the
+ * result to make_config_bundle for each vehicle instead of re-reading config/ per vehicle.
+ * Throws like load_config_bundle.
+ */
+std::shared_ptr<const ConfigBundle> load_model_configs(VehicleModel model, const std::string& dir_params = {},
+                                                       const std::string& dir_config = {});
+
+/**
+ * Bundle of vehicle_id on top of configs from load_model_configs: copies the config sections
+ * and adds the vehicle through cached_vehicle_parameters. Reads no config/ file.
+ */
+std::shared_ptr<const ConfigBundle> make_config_bundle(int vehicle_id, const ConfigBundle& configs,
+                                                       const std::string& dir_params = {});
+
+/**
+ * Resolves the config directory: dir_config if given, otherwise the compiled-in
+ * VELOX_CONFIG_ROOT, otherwise the "config" sibling of parameter_root(dir_params).
+ */
+std::filesystem::path config_root(const std::string& dir_params = {}, const std::string& dir_config = {});
+
+} // namespace velox::models
@@ -3,14 +3,26 @@
 #include <string>
 #include "vehicle_parameters.hpp"
 
+#ifdef VELOX_EMBEDDED_PARAMETERS
+#include "parameters_vehicle_embedded.hpp"
+#endif
+
 namespace velox::models {
 
 /**
  * Creates a VehicleParameters object holding all vehicle parameters for
  * vehicle ID 2 (BMW 320i).
+ *
+ * With VELOX_EMBEDDED_PARAMETERS an empty dir_params returns the compiled-in set;
+ * passing dir_params always reads the YAML from that directory.
  */
 inline VehicleParameters parameters_vehicle2(const std::string& dir_params = {})
 {
+#ifdef VELOX_EMBEDDED_PARAMETERS
+    if (dir_params.empty()) {
+        return embedded::kVehicle2;
+    }
+#endif
     return setup_vehicle_parameters(2, dir_params);
 }
 
@@ -0,0 +1,277 @@
+// Generated by scripts/generate_vehicle_parameters.ts from parameters/vehicle/*.yaml
+// and parameters/tire/parameters_tire.yaml. Do not edit by hand; regenerate instead.
+#pragma once
+
+#include "vehicle_parameters.hpp"
+
+namespace velox::models::embedded {
+
+namespace detail {
+
+constexpr void apply_tire(VehicleParameters& p)
+{
+    p.tire.p_cx1 = 1.6411;
+    p.tire.p_dx1 = 1.1739;
+    p.tire.p_dx3 = 0;
+    p.tire.p_ex1 = 0.46403;
+    p.tire.p_kx1 = 22.303;
+    p.tire.p_hx1 = 0.0012297;
+    p.tire.p_vx1 = -8.8098e-06;
+    p.tire.r_bx1 = 13.276;
+    p.tire.r_bx2 = -13.778;
+    p.tire.r_cx1 = 1.2568;
+    p.tire.r_ex1 = 0.65225;
+    p.tire.r_hx1 = 0.0050722;
+    p.tire.p_cy1 = 1.3507;
+    p.tire.p_dy1 = 1.0489;
+    p.tire.p_dy3 = -2.8821;
+    p.tire.p_ey1 = -0.0074722;
+    p.tire.p_ky1 = -21.92;
+    p.tire.p_hy1 = 0.0026747;
+    p.tire.p_hy3 = 0.031415;
+    p.tire.p_vy1 = 0.037318;
+    p.tire.p_vy3 = -0.32931;
+    p.tire.r_by1 = 7.1433;
+    p.tire.r_by2 = 9.1916;
+    p.tire.r_by3 = -0.027856;
+    p.tire.r_cy1 = 1.0719;
+    p.tire.r_ey1 = -0.27572;
+    p.tire.r_hy1 = 5.7448e-06;
+    p.tire.r_vy1 = -0.027825;
+    p.tire.r_vy3 = -0.27568;
+    p.tire.r_vy4 = 12.12;
+    p.tire.r_vy5 = 1.9;
+    p.tire.r_vy6 = -10.704;
+}
+
+} // namespace detail
+
+constexpr VehicleParameters make_vehicle1()
+{
+    VehicleParameters p{};
+    p.l = 4.298;
+    p.w = 1.674;
+    p.m = 1225.8878467253344;
+    p.m_s = 1094.542720290477;
+    p.m_uf = 65.67256321742863;
+    p.m_ur = 65.67256321742863;
+    p.a = 0.88392;
+    p.b = 1.50876;
+    p.I_Phi_s = 244.04723069965206;
+    p.I_y_s = 1342.2597688480864;
+    p.I_z = 1538.8533713561394;
+    p.I_xz_s = 0.0;
+    p.K_sf = 21898.332429625985;
+    p.K_sdf = 1459.3902937206362;
+    p.K_sr = 21898.332429625985;
+    p.K_sdr = 1459.3902937206362;
+    p.T_f = 1.389888;
+    p.T_r = 1.423416;
+    p.K_ras = 175186.65943700788;
+    p.K_tsf = -12880.270509148304;
+    p.K_tsr = 0.0;
+    p.K_rad = 10215.732056044453;
+    p.K_zt = 189785.5477234252;
+    p.h_cg = 0.5577840000000001;
+    p.h_raf = 0.0;
+    p.h_rar = 0.0;
+    p.h_s = 0.59436;
+    p.I_uf = 32.53963075995361;
+    p.I_ur = 32.53963075995361;
+    p.I_y_w = 1.7;
+    p.K_lt = 1.0278264878518764e-05;
+    p.R_w = 0.344;
+    p.T_sb = 0.76;
+    p.T_se = 1;
+    p.D_f = -0.6233595800524934;
+    p.D_r = -0.20997375328083986;
+    p.E_f = 0;
+    p.E_r = 0;
+
+    p.steering.max = 0.91;
+    p.steering.min = -0.91;
+    p.steering.v_max = 0.4;
+    p.steering.v_min = -0.4;
+    p.steering.kappa_dot_max = 0.4;
+    p.steering.kappa_dot_dot_max = 20;
+
+    p.longitudinal.a_max = 11.5;
+    p.longitudinal.j_max = 10.0e+3;
+    p.longitudinal.j_dot_max = 10.0e3;
+    p.longitudinal.v_max = 45.8;
+    p.longitudinal.v_min = -13.9;
+    p.longitudinal.v_switch = 4.755;
+
+    detail::apply_tire(p);
+    return p;
+}
+
+inline constexpr VehicleParameters kVehicle1 = make_vehicle1();
+
+constexpr VehicleParameters make_vehicle2()
+{
+    VehicleParameters p{};
+    p.l = 4.508;
+    p.w = 1.61;
+    p.m = 1093.2952334674046;
+    p.m_s = 965.7108098804363;
+    p.m_uf = 63.7921826056784;
+    p.m_ur = 63.7921826056784;
+    p.a = 1.1561957064;
+    p.b = 1.4227170936;
+    p.I_Phi_s = 207.26524557936952;
+    p.I_y_s = 1565.8178787125541;
+    p.I_z = 1791.5995300122856;
+    p.I_xz_s = 0.0;
+    p.K_sf = 24453.137879749014;
+    p.K_sdf = 1786.2441002440723;
+    p.K_sr = 19635.504745231297;
+    p.K_sdr = 1649.0833034887382;
+    p.T_f = 1.38684;
+    p.T_r = 1.36398;
+    p.K_ras = 175186.65943700788;
+    p.K_tsf = -6914.881688272133;
+    p.K_tsr = -2643.6009520155308;
+    p.K_rad = 10215.732056044453;
+    p.K_zt = 158294.1398119115;
+    p.h_cg = 0.5748689544000001;
+    p.h_raf = 0.0;
+    p.h_rar = 0.0;
+    p.h_s = 0.61373004;
+    p.I_uf = 30.673279563178017;
+    p.I_ur = 29.670408143156248;
+    p.I_y_w = 1.7;
+    p.K_lt = 1.6430724599974725e-05;
+    p.R_w = 0.344;
+    p.T_sb = 0.66;
+    p.T_se = 0;
+    p.D_f = -0.39370078740157477;
+    p.D_r = -0.905511811023622;
+    p.E_f = 0;
+    p.E_r = 0;
+
+    p.steering.max = 1.066;
+    p.steering.min = -1.066;
+    p.steering.v_max = 0.4;
+    p.steering.v_min = -0.4;
+    p.steering.kappa_dot_max = 0.4;
+    p.steering.kappa_dot_dot_max = 20;
+
+    p.longitudinal.a_max = 11.5;
+    p.longitudinal.j_max = 10.0e+3;
+    p.longitudinal.j_dot_max = 10.0e3;
+    p.longitudinal.v_max = 50.8;
+    p.longitudinal.v_min = -13.9;
+    p.longitudinal.v_switch = 7.319;
+
+    detail::apply_tire(p);
+    return p;
+}
+
+inline constexpr VehicleParameters kVehicle2 = make_vehicle2();
+
+constexpr VehicleParameters make_vehicle3()
+{
+    VehicleParameters p{};
+    p.l = 4.569;
+    p.w = 1.844;
+    p.m = 1478.8979637767998;
+    p.m_s = 1316.6086552490374;
+    p.m_uf = 81.14428941630796;
+    p.m_ur = 81.14428941630796;
+    p.a = 1.1507916024;
+    p.b = 1.3211363976000001;
+    p.I_Phi_s = 479.88430581318335;
+    p.I_y_s = 2204.322715845899;
+    p.I_z = 2473.1176915564442;
+    p.I_xz_s = 0.0;
+    p.K_sf = 33577.44305875984;
+    p.K_sdf = 2405.564099800005;
+    p.K_sr = 39125.020607598424;
+    p.K_sdr = 2769.727219182409;
+    p.T_f = 1.574292;
+    p.T_r = 1.5438120000000002;
+    p.K_ras = 175186.65943700788;
+    p.K_tsf = -33948.217142834066;
+    p.K_tsr = -7731.374238208578;
+    p.K_rad = 10215.732056044453;
+    p.K_zt = 212641.56722464017;
+    p.h_cg = 0.7478167416;
+    p.h_raf = 0.0;
+    p.h_rar = 0.0;
+    p.h_s = 0.804490644;
+    p.I_uf = 50.276902138127426;
+    p.I_ur = 48.34891545742069;
+    p.I_y_w = 1.7;
+    p.K_lt = 1.2231329122034703e-05;
+    p.R_w = 0.344;
+    p.T_sb = 0.64;
+    p.T_se = 0.0;
+    p.D_f = -0.32808398950131235;
+    p.D_r = -0.32808398950131235;
+    p.E_f = 0;
+    p.E_r = 0;
+
+    p.steering.max = 1.023;
+    p.steering.min = -1.023;
+    p.steering.v_max = 0.4;
+    p.steering.v_min = -0.4;
+    p.steering.kappa_dot_max = 0.4;
+    p.steering.kappa_dot_dot_max = 20;
+
+    p.longitudinal.a_max = 11.5;
+    p.longitudinal.j_max = 10.0e+3;
+    p.longitudinal.j_dot_max = 10.0e3;
+    p.longitudinal.v_max = 41.7;
+    p.longitudinal.v_min = -11.2;
+    p.longitudinal.v_switch = 7.824;
+
+    detail::apply_tire(p);
+    return p;
+}
+
+inline constexpr VehicleParameters kVehicle3 = make_vehicle3();
+
+constexpr VehicleParameters make_vehicle4()
+{
+    VehicleParameters p{};
+    p.l = 5.1;
+    p.w = 2.55;
+    p.a = 1.8;
+    p.b = 1.8;
+
+    p.steering.max = 0.55;
+    p.steering.min = -0.55;
+    p.steering.v_max = 0.7103;
+    p.steering.v_min = -0.7103;
+
+    p.longitudinal.a_max = 11.5;
+    p.longitudinal.v_max = 22.22;
+    p.longitudinal.v_min = -2.78;
+    p.longitudinal.v_switch = 7.824;
+
+    p.trailer.l = 13.6;
+    p.trailer.w = 2.55;
+    p.trailer.l_hitch = 12.0;
+    p.trailer.l_total = 16.5;
+    p.trailer.l_wb = 8.1;
+
+    detail::apply_tire(p);
+    return p;
+}
+
+inline constexpr VehicleParameters kVehicle4 = make_vehicle4();
+
+/** Compiled-in parameters for vehicle_id, or nullptr if none were embedded. */
+constexpr const VehicleParameters* find_vehicle_parameters(int vehicle_id)
+{
+    switch (vehicle_id) {
+    case 1: return &kVehicle1;
+    case 2: return &kVehicle2;
+    case 3: return &kVehicle3;
+    case 4: return &kVehicle4;
+    default: return nullptr;
+    }
+}
+
+} // namespace velox::models::embedded
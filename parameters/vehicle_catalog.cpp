@@ -0,0 +1,210 @@
+#include "vehicle_catalog.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cctype>
+#include <charconv>
+#include <exception>
+#include <mutex>
+#include <stdexcept>
+#include <string_view>
+#include <thread>
+
+#include "yaml_subset.hpp"
+
+namespace fs = std::filesystem;
+
+namespace velox::models {
+
+VehicleCatalog::VehicleCatalog(fs::path root, std::vector<VehicleCatalogEntry> entries)
+    : root_(std::move(root))
+    , entries_(std::move(entries))
+{
+    std::sort(entries_.begin(), entries_.end(),
+              [](const auto& a, const auto& b) { return a.vehicle_id < b.vehicle_id; });
+}
+
+const VehicleCatalogEntry* VehicleCatalog::find(int vehicle_id) const
+{
+    auto it = std::lower_bound(entries_.begin(), entries_.end(), vehicle_id,
+                               [](const VehicleCatalogEntry& e, int id) { return e.vehicle_id < id; });
+    return (it != entries_.end() && it->vehicle_id == vehicle_id) ? &*it : nullptr;
+}
+
+const VehicleParameters& VehicleCatalog::at(int vehicle_id) const
+{
+    if (const VehicleCatalogEntry* entry = find(vehicle_id)) {
+        return entry->params;
+    }
+    throw std::out_of_range("Vehicle " + std::to_string(vehicle_id) + " is not in the catalog at " +
+                            root_.string());
+}
+
+namespace {
+
+// "parameters_vehicle12.yaml" -> 12, anything else -> -1
+int vehicle_id_from_name(const std::string& name)
+{
+    constexpr std::string_view prefix = "parameters_vehicle";
+    constexpr std::string_view suffix = ".yaml";
+    if (name.size() <= prefix.size() + suffix.size() ||
+        name.compare(0, prefix.size(), prefix) != 0 ||
+        name.compare(name.size() - suffix.size(), suffix.size(), suffix) != 0) {
+        return -1;
+    }
+    // Digits only; a run too long for int (from_chars reports out of range) is skipped too.
+    const char* first = name.data() + prefix.size();
+    const char* last = name.data() + name.size() - suffix.size();
+    int id = -1;
+    const auto [end, ec] = std::from_chars(first, last, id);
+    if (ec != std::errc{} || end != last || *first == '-' || *first == '+') {
+        return -1;
+    }
+    return id;
+}
+
+std::string trim(std::string_view s)
+{
+    const auto first = s.find_first_not_of(" \t\r");
+    if (first == std::string_view::npos) return {};
+    const auto last = s.find_last_not_of(" \t\r");
+    return std::string(s.substr(first, last - first + 1));
+}
+
+std::string lower(std::string s)
+{
+    std::transform(s.begin(), s.end(), s.begin(), [](unsigned char c) { return std::tolower(c); });
+    return s;
+}
+
+// Drops trailing references ("see ..."), parentheticals and dash-separated remarks, matching
+// sanitizeLabel in app/playground/loadVelox.ts.
+std::string sanitize_label(std::string label)
+{
+    const std::string l = lower(label);
+    if (auto pos = l.find(" see "); pos != std::string::npos) label.resize(pos);
+    if (!label.empty() && label.back() == ')') {
+        if (auto pos = label.rfind('('); pos != std::string::npos) label.resize(pos);
+    }
+    for (std::string_view dash : {" - ", " – ", " — "}) {
+        if (auto pos = label.find(dash); pos != std::string::npos) label.resize(pos);
+    }
+    return trim(label);
+}
+
+// Label and description from the leading comment block of a vehicle YAML.
+void read_metadata(std::string_view content, VehicleCatalogEntry& entry)
+{
+    std::vector<std::string> header;   // first comment paragraph
+    std::string source;                // text after "values are taken from"
+    bool paragraph_done = false;
+
+    for (std::size_t pos = 0; pos < content.size();) {
+        const std::size_t eol = std::min(content.find('\n', pos), content.size());
+        const std::string text = trim(content.substr(pos, eol - pos));
+        pos = eol + 1;
+        if (text.empty()) {
+            paragraph_done = paragraph_done || !header.empty();
+            continue;
+        }
+        if (text.front() != '#') break; // YAML content starts, header is over
+
+        const std::string comment = trim(std::string_view(text).substr(text.find_first_not_of('#')));
+        if (!paragraph_done && !comment.empty()) header.push_back(comment);
+
+        constexpr std::string_view marker = "values are taken from ";
+        const std::string lc = lower(comment);
+        if (auto pos = lc.find(marker); source.empty() && pos != std::string::npos) {
+            std::string name = comment.substr(pos + marker.size());
+            if (lower(name).rfind("an ", 0) == 0) name.erase(0, 3);
+            else if (lower(name).rfind("a ", 0) == 0) name.erase(0, 2);
+            name = name.substr(0, name.find_first_of(".#"));
+            source = sanitize_label(name);
+        }
+    }
+
+    std::string description;
+    for (const auto& part : header) {
+        if (!description.empty()) description.push_back(' ');
+        description += part;
+    }
+    // "parameters_vehicle2 - parameter set of ..." -> "parameter set of ..."
+    if (description.rfind("parameters_vehicle", 0) == 0) {
+        if (auto pos = description.find(" - "); pos != std::string::npos) description.erase(0, pos + 3);
+    }
+
+    entry.label = source.empty() ? "Vehicle " + std::to_string(entry.vehicle_id) : source;
+    entry.description = description.empty() ? entry.label : description;
+}
+
+} // anonymous namespace
+
+VehicleCatalog load_vehicle_catalog(const std::string& dir_params)
+{
+    const fs::path root = parameter_root(dir_params);
+    const fs::path vehicle_dir = root / "vehicle";
+    const fs::path tire_yaml = tire_parameter_file(root);
+
+    if (!fs::is_directory(vehicle_dir)) {
+        throw std::runtime_error("Vehicle parameter directory not found: " + vehicle_dir.string());
+    }
+    if (!fs::exists(tire_yaml)) {
+        throw std::runtime_error("Tire parameter file not found: " + tire_yaml.string());
+    }
+
+    // One scan of the vehicle directory.
+    std::vector<VehicleCatalogEntry> entries;
+    for (const auto& dirent : fs::directory_iterator(vehicle_dir)) {
+        if (!dirent.is_regular_file()) continue;
+        const int id = vehicle_id_from_name(dirent.path().filename().string());
+        if (id < 0) continue;
+        VehicleCatalogEntry entry;
+        entry.vehicle_id = id;
+        entry.parameter_file = dirent.path();
+        entries.push_back(std::move(entry));
+    }
+
+    // One tire parse, shared by every vehicle.
+    VehicleParameters tire_only;
+    apply_tire_document(MappedTextFile(tire_yaml.string()).text(), tire_only);
+
+    std::atomic<std::size_t> next{0};
+    std::exception_ptr failure;
+    std::mutex failure_mutex;
+
+    auto worker = [&] {
+        for (std::size_t i = next.fetch_add(1); i < entries.size(); i = next.fetch_add(1)) {
+            VehicleCatalogEntry& entry = entries[i];
+            try {
+                const MappedTextFile content(entry.parameter_file.string());
+                entry.params.tire = tire_only.tire;
+                apply_vehicle_document(content.text(), entry.params);
+                read_metadata(content.text(), entry);
+            } catch (const std::exception& e) {
+                std::lock_guard lock(failure_mutex);
+                if (!failure) {
+                    failure = std::make_exception_ptr(std::runtime_error(
+                        "Failed to load " + entry.parameter_file.string() + ": " + e.what()));
+                }
+            }
+        }
+    };
+
+    const std::size_t threads =
+        std::min<std::size_t>(entries.size(), std::max(1u, std::thread::hardware_concurrency()));
+    std::vector<std::thread> pool;
+    for (std::size_t t = 1; t < threads; ++t) {
+        pool.emplace_back(worker);
+    }
+    worker();
+    for (auto& t : pool) {
+        t.join();
+    }
+    if (failure) {
+        std::rethrow_exception(failure);
+    }
+
+    return VehicleCatalog(root, std::move(entries));
+}
+
+} // namespace velox::models
@@ -0,0 +1,57 @@
+#pragma once
+
+#include <filesystem>
+#include <string>
+#include <vector>
+
+#include "vehicle_parameters.hpp"
+
+namespace velox::models {
+
+/** One vehicle of a parameter directory, with the metadata from its YAML header comment. */
+struct VehicleCatalogEntry {
+    int vehicle_id{};
+    std::string label;        // e.g. "BMW 320i"; "Vehicle N" when the header names no source
+    std::string description;  // header comment after the "parameters_vehicleN - " prefix
+    std::filesystem::path parameter_file;
+    VehicleParameters params{};
+};
+
+/** Vehicles of one parameter root, ordered by vehicle_id. */
+class VehicleCatalog {
+public:
+    VehicleCatalog() = default;
+    VehicleCatalog(std::filesystem::path root, std::vector<VehicleCatalogEntry> entries);
+
+    const std::filesystem::path& root() const { return root_; }
+    const std::vector<VehicleCatalogEntry>& entries() const { return entries_; }
+    std::size_t size() const { return entries_.size(); }
+    bool empty() const { return entries_.empty(); }
+
+    /** Entry for vehicle_id, or nullptr. O(log n). */
+    const VehicleCatalogEntry* find(int vehicle_id) const;
+
+    /** Parameters of vehicle_id. Throws std::out_of_range if the catalog has no such vehicle. */
+    const VehicleParameters& at(int vehicle_id) const;
+
+private:
+    std::filesystem::path root_;
+    std::vector<VehicleCatalogEntry> entries_;
+};
+
+/**
+ * load_vehicle_catalog
+ *
+ * Loads every vehicle/parameters_vehicleN.yaml below a parameter root in one go: the directory
+ * is listed once, the shared tire YAML is parsed once and applied to every vehicle, and the
+ * vehicle files are parsed in parallel. Each entry carries the label/description taken from
+ * the leading comment block of its YAML (the same text the playground shows).
+ *
+ * @param dir_params  Optional parameter directory, same semantics as setup_vehicle_parameters.
+ *
+ * Throws std::runtime_error if the directories or the tire file are missing, or if any vehicle
+ * file cannot be parsed (the message names the file).
+ */
+VehicleCatalog load_vehicle_catalog(const std::string& dir_params = {});
+
+} // namespace velox::models
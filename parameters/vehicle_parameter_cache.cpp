@@ -0,0 +1,141 @@
+#include "vehicle_parameter_cache.hpp"
+
+#include <atomic>
+#include <filesystem>
+#include <map>
+#include <mutex>
+#include <shared_mutex>
+#include <system_error>
+#include <utility>
+
+#ifdef VELOX_EMBEDDED_PARAMETERS
+#include "vehicle/parameters_vehicle_embedded.hpp"
+#endif
+
+namespace fs = std::filesystem;
+
+namespace velox::models {
+
+namespace {
+
+using CacheKey = std::pair<int, std::string>;
+
+struct CacheEntry {
+    std::shared_ptr<const VehicleParameters> params;
+    fs::file_time_type vehicle_mtime{};
+    fs::file_time_type tire_mtime{};
+};
+
+struct ParameterCache {
+    std::shared_mutex mutex;
+    std::map<CacheKey, CacheEntry> entries;
+    std::atomic<std::uint64_t> hits{0};
+    std::atomic<std::uint64_t> misses{0};
+    std::atomic<std::uint64_t> invalidations{0};
+};
+
+ParameterCache& cache()
+{
+    static ParameterCache instance;
+    return instance;
+}
+
+// weakly_canonical so that "parameters", "./parameters" and an absolute path share one entry
+std::string canonical_root(const fs::path& root)
+{
+    std::error_code ec;
+    fs::path resolved = fs::weakly_canonical(root, ec);
+    if (ec) {
+        resolved = fs::absolute(root, ec);
+        if (ec) return root.lexically_normal().string();
+    }
+    return resolved.string();
+}
+
+// Missing files report the minimum time point; setup_vehicle_parameters then raises the error.
+fs::file_time_type write_time(const fs::path& file)
+{
+    std::error_code ec;
+    auto t = fs::last_write_time(file, ec);
+    return ec ? fs::file_time_type::min() : t;
+}
+
+} // anonymous namespace
+
+std::shared_ptr<const VehicleParameters> cached_vehicle_parameters(int vehicle_id,
+                                                                   const std::string& dir_params)
+{
+    ParameterCache& c = cache();
+
+#ifdef VELOX_EMBEDDED_PARAMETERS
+    if (dir_params.empty()) {
+        if (const VehicleParameters* embedded = embedded::find_vehicle_parameters(vehicle_id)) {
+            // Non-owning alias: the compiled-in set has static storage duration.
+            c.hits.fetch_add(1, std::memory_order_relaxed);
+            return std::shared_ptr<const VehicleParameters>(std::shared_ptr<void>{}, embedded);
+        }
+    }
+#endif
+
+    const fs::path root = parameter_root(dir_params);
+    CacheKey key{vehicle_id, canonical_root(root)};
+    const fs::file_time_type vehicle_mtime = write_time(vehicle_parameter_file(root, vehicle_id));
+    const fs::file_time_type tire_mtime    = write_time(tire_parameter_file(root));
+
+    bool stale = false;
+    {
+        std::shared_lock lock(c.mutex);
+        auto it = c.entries.find(key);
+        if (it != c.entries.end()) {
+            const CacheEntry& e = it->second;
+            if (e.vehicle_mtime == vehicle_mtime && e.tire_mtime == tire_mtime) {
+                c.hits.fetch_add(1, std::memory_order_relaxed);
+                return e.params;
+            }
+            stale = true;
+        }
+    }
+
+    // Parse outside the lock; concurrent misses on the same key simply race to publish.
+    c.misses.fetch_add(1, std::memory_order_relaxed);
+    if (stale) {
+        c.invalidations.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    CacheEntry fresh;
+    fresh.params = std::make_shared<const VehicleParameters>(
+        setup_vehicle_parameters(vehicle_id, dir_params));
+    fresh.vehicle_mtime = vehicle_mtime;
+    fresh.tire_mtime    = tire_mtime;
+
+    std::unique_lock lock(c.mutex);
+    CacheEntry& slot = c.entries[std::move(key)];
+    slot = std::move(fresh);
+    return slot.params;
+}
+
+VehicleParameterCacheStats vehicle_parameter_cache_stats()
+{
+    ParameterCache& c = cache();
+    VehicleParameterCacheStats stats;
+    stats.hits          = c.hits.load(std::memory_order_relaxed);
+    stats.misses        = c.misses.load(std::memory_order_relaxed);
+    stats.invalidations = c.invalidations.load(std::memory_order_relaxed);
+    {
+        std::shared_lock lock(c.mutex);
+        stats.entries = c.entries.size();
+    }
+    return stats;
+}
+
+void clear_vehicle_parameter_cache()
+{
+    ParameterCache& c = cache();
+    std::unique_lock lock(c.mutex);
+    c.entries.clear();
+    c.hits.store(0, std::memory_order_relaxed);
+    c.misses.store(0, std::memory_order_relaxed);
+    c.invalidations.store(0, std::memory_order_relaxed);
+}
+
+} // namespace velox::models
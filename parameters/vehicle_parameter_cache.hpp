@@ -0,0 +1,50 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+
+#include "vehicle_parameters.hpp"
+
+namespace velox::models {
+
+/**
+ * Hit/miss counters of the process-wide vehicle parameter cache.
+ *
+ * A miss is any lookup that had to parse YAML; invalidations count the subset of
+ * misses caused by a changed vehicle or tire file modification time.
+ */
+struct VehicleParameterCacheStats {
+    std::uint64_t hits{};
+    std::uint64_t misses{};
+    std::uint64_t invalidations{};
+    std::size_t   entries{};
+};
+
+/**
+ * cached_vehicle_parameters
+ *
+ * Thread-safe, process-wide memoisation of setup_vehicle_parameters. Entries are keyed by
+ * (vehicle_id, canonical parameter root) and shared as immutable objects, so thousands of
+ * simulators asking for the same vehicle share a single parse.
+ *
+ * Each lookup compares the last write time of the vehicle and tire YAML with the values
+ * recorded when the entry was loaded; a mismatch reloads the entry. Callers that already
+ * hold a pointer keep their (now stale) snapshot.
+ *
+ * @param vehicle_id  CommonRoad vehicle ID (1..4 as in the reference paper)
+ * @param dir_params  Optional parameter directory, same semantics as setup_vehicle_parameters.
+ *
+ * Throws std::runtime_error if required files are missing or cannot be parsed.
+ */
+std::shared_ptr<const VehicleParameters> cached_vehicle_parameters(int vehicle_id,
+                                                                   const std::string& dir_params = {});
+
+/** Snapshot of the cache counters. */
+VehicleParameterCacheStats vehicle_parameter_cache_stats();
+
+/** Drops all cached entries and resets the counters. */
+void clear_vehicle_parameter_cache();
+
+} // namespace velox::models
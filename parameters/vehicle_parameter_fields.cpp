@@ -0,0 +1,92 @@
+#include "vehicle_parameter_fields.hpp"
+
+#include <cmath>
+#include <cstring>
+
+namespace velox::models {
+
+// Every field must be reachable through the perfect hash.
+static_assert([] {
+    for (const auto& d : kVehicleParameterFields) {
+        if (find_field(d.section, d.key) != &d) return false;
+    }
+    return find_field(FieldSection::Vehicle, "not_a_field") == nullptr;
+}(), "vehicle parameter field index is not perfect");
+
+std::string_view section_name(FieldSection section)
+{
+    switch (section) {
+    case FieldSection::Vehicle:      return "";
+    case FieldSection::Steering:     return "steering";
+    case FieldSection::Longitudinal: return "longitudinal";
+    case FieldSection::Trailer:      return "trailer";
+    case FieldSection::Tire:         return "tire";
+    }
+    return "";
+}
+
+std::string field_path(const FieldDescriptor& d)
+{
+    const std::string_view section = section_name(d.section);
+    std::string path;
+    if (!section.empty()) {
+        path.append(section).push_back('.');
+    }
+    path.append(d.key);
+    return path;
+}
+
+const FieldDescriptor* find_field_path(std::string_view path)
+{
+    const std::size_t dot = path.find('.');
+    if (dot == std::string_view::npos) {
+        return find_field(FieldSection::Vehicle, path);
+    }
+    const std::string_view section = path.substr(0, dot);
+    for (FieldSection s : {FieldSection::Steering, FieldSection::Longitudinal, FieldSection::Trailer,
+                           FieldSection::Tire}) {
+        if (section_name(s) == section) return find_field(s, path.substr(dot + 1));
+    }
+    return nullptr;
+}
+
+std::uint32_t vehicle_parameter_layout_hash()
+{
+    std::uint32_t h = 2166136261u;
+    auto mix = [&h](unsigned char byte) { h = (h ^ byte) * 16777619u; };
+    for (const auto& d : kVehicleParameterFields) {
+        mix(static_cast<unsigned char>(d.section));
+        for (char c : d.key) mix(static_cast<unsigned char>(c));
+        for (std::size_t i = 0; i < sizeof(std::uint32_t); ++i) {
+            mix(static_cast<unsigned char>((d.offset >> (8 * i)) & 0xffu));
+        }
+    }
+    return h;
+}
+
+std::vector<const FieldDescriptor*> diff_vehicle_parameters(const VehicleParameters& a,
+                                                            const VehicleParameters& b)
+{
+    std::vector<const FieldDescriptor*> out;
+    for (const auto& d : kVehicleParameterFields) {
+        const double va = field_value(a, d);
+        const double vb = field_value(b, d);
+        if (std::memcmp(&va, &vb, sizeof(double)) != 0) {
+            out.push_back(&d);
+        }
+    }
+    return out;
+}
+
+std::vector<const FieldDescriptor*> non_finite_fields(const VehicleParameters& p)
+{
+    std::vector<const FieldDescriptor*> out;
+    for (const auto& d : kVehicleParameterFields) {
+        if (!std::isfinite(field_value(p, d))) {
+            out.push_back(&d);
+        }
+    }
+    return out;
+}
+
+} // namespace velox::models
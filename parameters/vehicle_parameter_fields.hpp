@@ -0,0 +1,298 @@
+#pragma once
+
+#include <array>
+#include <bitset>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "vehicle_parameters.hpp"
+
+namespace velox::models {
+
+/**
+ * Compile-time field reflection for VehicleParameters.
+ *
+ * kVehicleParameterFields is the single list of every (section, YAML key, offset, type) triple;
+ * the YAML loader, the snapshot layout fingerprint and the diff/validation helpers all walk it
+ * instead of keeping their own copies of the field list. Lookups by key go through a perfect
+ * hash built at compile time (hash-and-displace), so dispatching a YAML key is one hash, one
+ * table probe and one string compare.
+ */
+
+/// YAML section a field lives in; Vehicle is the top level of parameters_vehicleN.yaml.
+enum class FieldSection : std::uint8_t {
+    Vehicle,
+    Steering,
+    Longitudinal,
+    Trailer,
+    Tire,
+};
+
+enum class FieldType : std::uint8_t {
+    Double,
+};
+
+struct FieldDescriptor {
+    FieldSection     section;
+    std::string_view key;
+    FieldType        type;
+    std::size_t      offset; // byte offset inside VehicleParameters
+};
+
+namespace detail {
+
+#define VELOX_FIELD(section_enum, member, key) \
+    FieldDescriptor{FieldSection::section_enum, key, FieldType::Double, offsetof(VehicleParameters, member)}
+#define VELOX_NESTED_FIELD(section_enum, outer, Outer, member)                                     \
+    FieldDescriptor{FieldSection::section_enum, #member, FieldType::Double,                         \
+                    offsetof(VehicleParameters, outer) + offsetof(utils::Outer, member)}
+
+} // namespace detail
+
+inline constexpr std::array kVehicleParameterFields = {
+    // vehicle body dimensions
+    VELOX_FIELD(Vehicle, l, "l"),
+    VELOX_FIELD(Vehicle, w, "w"),
+
+    // masses
+    VELOX_FIELD(Vehicle, m, "m"),
+    VELOX_FIELD(Vehicle, m_s, "m_s"),
+    VELOX_FIELD(Vehicle, m_uf, "m_uf"),
+    VELOX_FIELD(Vehicle, m_ur, "m_ur"),
+
+    // axes distances
+    VELOX_FIELD(Vehicle, a, "a"),
+    VELOX_FIELD(Vehicle, b, "b"),
+
+    // inertias
+    VELOX_FIELD(Vehicle, I_Phi_s, "I_Phi_s"),
+    VELOX_FIELD(Vehicle, I_y_s, "I_y_s"),
+    VELOX_FIELD(Vehicle, I_z, "I_z"),
+    VELOX_FIELD(Vehicle, I_xz_s, "I_xz_s"),
+
+    // suspension parameters
+    VELOX_FIELD(Vehicle, K_sf, "K_sf"),
+    VELOX_FIELD(Vehicle, K_sdf, "K_sdf"),
+    VELOX_FIELD(Vehicle, K_sr, "K_sr"),
+    VELOX_FIELD(Vehicle, K_sdr, "K_sdr"),
+
+    // geometric parameters
+    VELOX_FIELD(Vehicle, T_f, "T_f"),
+    VELOX_FIELD(Vehicle, T_r, "T_r"),
+    VELOX_FIELD(Vehicle, K_ras, "K_ras"),
+    VELOX_FIELD(Vehicle, K_tsf, "K_tsf"),
+    VELOX_FIELD(Vehicle, K_tsr, "K_tsr"),
+    VELOX_FIELD(Vehicle, K_rad, "K_rad"),
+    VELOX_FIELD(Vehicle, K_zt, "K_zt"),
+    VELOX_FIELD(Vehicle, h_cg, "h_cg"),
+    VELOX_FIELD(Vehicle, h_raf, "h_raf"),
+    VELOX_FIELD(Vehicle, h_rar, "h_rar"),
+    VELOX_FIELD(Vehicle, h_s, "h_s"),
+    VELOX_FIELD(Vehicle, I_uf, "I_uf"),
+    VELOX_FIELD(Vehicle, I_ur, "I_ur"),
+    VELOX_FIELD(Vehicle, I_y_w, "I_y_w"),
+    VELOX_FIELD(Vehicle, K_lt, "K_lt"),
+    VELOX_FIELD(Vehicle, R_w, "R_w"),
+
+    // torque split
+    VELOX_FIELD(Vehicle, T_sb, "T_sb"),
+    VELOX_FIELD(Vehicle, T_se, "T_se"),
+
+    // suspension camber parameters
+    VELOX_FIELD(Vehicle, D_f, "D_f"),
+    VELOX_FIELD(Vehicle, D_r, "D_r"),
+    VELOX_FIELD(Vehicle, E_f, "E_f"),
+    VELOX_FIELD(Vehicle, E_r, "E_r"),
+
+    // steering
+    VELOX_NESTED_FIELD(Steering, steering, SteeringParameters, min),
+    VELOX_NESTED_FIELD(Steering, steering, SteeringParameters, max),
+    VELOX_NESTED_FIELD(Steering, steering, SteeringParameters, v_min),
+    VELOX_NESTED_FIELD(Steering, steering, SteeringParameters, v_max),
+    VELOX_NESTED_FIELD(Steering, steering, SteeringParameters, kappa_dot_max),
+    VELOX_NESTED_FIELD(Steering, steering, SteeringParameters, kappa_dot_dot_max),
+
+    // longitudinal
+    VELOX_NESTED_FIELD(Longitudinal, longitudinal, LongitudinalParameters, v_min),
+    VELOX_NESTED_FIELD(Longitudinal, longitudinal, LongitudinalParameters, v_max),
+    VELOX_NESTED_FIELD(Longitudinal, longitudinal, LongitudinalParameters, v_switch),
+    VELOX_NESTED_FIELD(Longitudinal, longitudinal, LongitudinalParameters, a_max),
+    VELOX_NESTED_FIELD(Longitudinal, longitudinal, LongitudinalParameters, j_max),
+    VELOX_NESTED_FIELD(Longitudinal, longitudinal, LongitudinalParameters, j_dot_max),
+
+    // trailer
+    VELOX_NESTED_FIELD(Trailer, trailer, TrailerParameters, l),
+    VELOX_NESTED_FIELD(Trailer, trailer, TrailerParameters, w),
+    VELOX_NESTED_FIELD(Trailer, trailer, TrailerParameters, l_hitch),
+    VELOX_NESTED_FIELD(Trailer, trailer, TrailerParameters, l_total),
+    VELOX_NESTED_FIELD(Trailer, trailer, TrailerParameters, l_wb),
+
+    // tire: longitudinal coefficients
+    VELOX_NESTED_FIELD(Tire, tire, TireParameters, p_cx1),
+    VELOX_NESTED_FIELD(Tire, tire, TireParameters, p_dx1),
+    VELOX_NESTED_FIELD(Tire, tire, TireParameters, p_dx3),
+    VELOX_NESTED_FIELD(Tire, tire, TireParameters, p_ex1),
+    VELOX_NESTED_FIELD(Tire, tire, TireParameters, p_kx1),
+    VELOX_NESTED_FIELD(Tire, tire, TireParameters, p_hx1),
+    VELOX_NESTED_FIELD(Tire, tire, TireParameters, p_vx1),
+    VELOX_NESTED_FIELD(Tire, tire, TireParameters, r_bx1),
+    VELOX_NESTED_FIELD(Tire, tire, TireParameters, r_bx2),
+    VELOX_NESTED_FIELD(Tire, tire, TireParameters, r_cx1),
+    VELOX_NESTED_FIELD(Tire, tire, TireParameters, r_ex1),
+    VELOX_NESTED_FIELD(Tire, tire, TireParameters, r_hx1),
+
+    // tire: lateral coefficients
+    VELOX_NESTED_FIELD(Tire, tire, TireParameters, p_cy1),
+    VELOX_NESTED_FIELD(Tire, tire, TireParameters, p_dy1),
+    VELOX_NESTED_FIELD(Tire, tire, TireParameters, p_dy3),
+    VELOX_NESTED_FIELD(Tire, tire, TireParameters, p_ey1),
+    VELOX_NESTED_FIELD(Tire, tire, TireParameters, p_ky1),
+    VELOX_NESTED_FIELD(Tire, tire, TireParameters, p_hy1),
+    VELOX_NESTED_FIELD(Tire, tire, TireParameters, p_hy3),
+    VELOX_NESTED_FIELD(Tire, tire, TireParameters, p_vy1),
+    VELOX_NESTED_FIELD(Tire, tire, TireParameters, p_vy3),
+    VELOX_NESTED_FIELD(Tire, tire, TireParameters, r_by1),
+    VELOX_NESTED_FIELD(Tire, tire, TireParameters, r_by2),
+    VELOX_NESTED_FIELD(Tire, tire, TireParameters, r_by3),
+    VELOX_NESTED_FIELD(Tire, tire, TireParameters, r_cy1),
+    VELOX_NESTED_FIELD(Tire, tire, TireParameters, r_ey1),
+    VELOX_NESTED_FIELD(Tire, tire, TireParameters, r_hy1),
+    VELOX_NESTED_FIELD(Tire, tire, TireParameters, r_vy1),
+    VELOX_NESTED_FIELD(Tire, tire, TireParameters, r_vy3),
+    VELOX_NESTED_FIELD(Tire, tire, TireParameters, r_vy4),
+    VELOX_NESTED_FIELD(Tire, tire, TireParameters, r_vy5),
+    VELOX_NESTED_FIELD(Tire, tire, TireParameters, r_vy6),
+};
+
+#undef VELOX_FIELD
+#undef VELOX_NESTED_FIELD
+
+static_assert(kVehicleParameterFields.size() * sizeof(double) == sizeof(VehicleParameters),
+              "kVehicleParameterFields must list every VehicleParameters member");
+
+namespace detail {
+
+inline constexpr std::size_t kFieldBuckets = 32;
+inline constexpr std::size_t kFieldSlots   = 128;
+
+constexpr std::uint32_t field_hash(FieldSection section, std::string_view key, std::uint32_t seed)
+{
+    std::uint32_t h = 2166136261u ^ (seed * 0x9e3779b9u);
+    h = (h ^ static_cast<std::uint8_t>(section)) * 16777619u;
+    for (char c : key) {
+        h = (h ^ static_cast<unsigned char>(c)) * 16777619u;
+    }
+    return h ^ (h >> 15);
+}
+
+struct FieldIndex {
+    std::array<std::uint32_t, kFieldBuckets> displacement{};
+    std::array<std::int16_t, kFieldSlots>    field{};
+};
+
+// Hash-and-displace: place the largest buckets first, each with the smallest seed that maps all
+// of its keys to free slots.
+constexpr FieldIndex build_field_index()
+{
+    constexpr std::size_t n = kVehicleParameterFields.size();
+    FieldIndex index{};
+    for (auto& f : index.field) f = -1;
+
+    std::array<std::size_t, n> bucket_of{};
+    std::array<std::size_t, kFieldBuckets> bucket_size{};
+    for (std::size_t i = 0; i < n; ++i) {
+        const auto& d = kVehicleParameterFields[i];
+        bucket_of[i] = field_hash(d.section, d.key, 0) % kFieldBuckets;
+        ++bucket_size[bucket_of[i]];
+    }
+
+    std::array<bool, kFieldBuckets> placed{};
+    for (std::size_t round = 0; round < kFieldBuckets; ++round) {
+        std::size_t bucket = kFieldBuckets;
+        for (std::size_t b = 0; b < kFieldBuckets; ++b) {
+            if (!placed[b] && (bucket == kFieldBuckets || bucket_size[b] > bucket_size[bucket])) bucket = b;
+        }
+        placed[bucket] = true;
+        if (bucket_size[bucket] == 0) continue;
+
+        for (std::uint32_t seed = 1;; ++seed) {
+            std::array<std::size_t, n> slots{};
+            std::size_t count = 0;
+            bool ok = true;
+            for (std::size_t i = 0; i < n && ok; ++i) {
+                if (bucket_of[i] != bucket) continue;
+                const auto& d = kVehicleParameterFields[i];
+                const std::size_t slot = field_hash(d.section, d.key, seed) % kFieldSlots;
+                ok = index.field[slot] < 0;
+                for (std::size_t k = 0; k < count && ok; ++k) ok = slots[k] != slot;
+                slots[count++] = slot;
+            }
+            if (!ok) continue;
+            count = 0;
+            for (std::size_t i = 0; i < n; ++i) {
+                if (bucket_of[i] == bucket) index.field[slots[count++]] = static_cast<std::int16_t>(i);
+            }
+            index.displacement[bucket] = seed;
+            break;
+        }
+    }
+    return index;
+}
+
+inline constexpr FieldIndex kFieldIndex = build_field_index();
+
+} // namespace detail
+
+/** Descriptor for (section, key), or nullptr for keys VehicleParameters does not have. */
+constexpr const FieldDescriptor* find_field(FieldSection section, std::string_view key)
+{
+    using namespace detail;
+    const std::uint32_t seed = kFieldIndex.displacement[field_hash(section, key, 0) % kFieldBuckets];
+    const std::int16_t i = kFieldIndex.field[field_hash(section, key, seed) % kFieldSlots];
+    if (i < 0) return nullptr;
+    const FieldDescriptor& d = kVehicleParameterFields[static_cast<std::size_t>(i)];
+    return (d.section == section && d.key == key) ? &d : nullptr;
+}
+
+/// One bit per kVehicleParameterFields entry, e.g. the keys a document set.
+using VehicleFieldSet = std::bitset<kVehicleParameterFields.size()>;
+
+/// Position of d in kVehicleParameterFields.
+inline std::size_t field_index(const FieldDescriptor& d)
+{
+    return static_cast<std::size_t>(&d - kVehicleParameterFields.data());
+}
+
+inline double& field_value(VehicleParameters& p, const FieldDescriptor& d)
+{
+    return *reinterpret_cast<double*>(reinterpret_cast<unsigned char*>(&p) + d.offset);
+}
+
+inline double field_value(const VehicleParameters& p, const FieldDescriptor& d)
+{
+    return *reinterpret_cast<const double*>(reinterpret_cast<const unsigned char*>(&p) + d.offset);
+}
+
+/// YAML section name ("" for the vehicle top level, else "steering", "longitudinal", ...).
+std::string_view section_name(FieldSection section);
+
+/// Dotted path of a field, e.g. "steering.v_max" or "m".
+std::string field_path(const FieldDescriptor& d);
+
+/// Descriptor for a dotted path as produced by field_path, or nullptr.
+const FieldDescriptor* find_field_path(std::string_view path);
+
+/// Fingerprint of the table (keys and offsets); changes whenever the struct layout does.
+std::uint32_t vehicle_parameter_layout_hash();
+
+/// Fields whose values differ between a and b (bitwise, so NaN == NaN).
+std::vector<const FieldDescriptor*> diff_vehicle_parameters(const VehicleParameters& a,
+                                                            const VehicleParameters& b);
+
+/// Fields holding NaN or infinity.
+std::vector<const FieldDescriptor*> non_finite_fields(const VehicleParameters& p);
+
+} // namespace velox::models
@@ -0,0 +1,218 @@
+#include "vehicle_parameter_snapshot.hpp"
+#include "vehicle_parameter_fields.hpp"
+
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#define VELOX_HAVE_MMAP 1
+#endif
+
+namespace fs = std::filesystem;
+
+namespace velox::models {
+
+static_assert(std::is_trivially_copyable_v<VehicleParameters>,
+              "VehicleParameters must stay a flat aggregate to be snapshotted");
+static_assert(sizeof(VehicleParameters) % sizeof(double) == 0,
+              "VehicleParameters is expected to contain only doubles");
+static_assert(sizeof(VehicleParameterSnapshotHeader) == 32 &&
+              sizeof(VehicleParameterSnapshotHeader) % alignof(VehicleParameters) == 0,
+              "snapshot header must keep the payload aligned");
+
+namespace {
+
+constexpr char          kMagic[4]  = {'V', 'P', 'B', 'N'};
+constexpr std::uint32_t kEndianTag = 0x01020304u;
+
+std::uint64_t fnv1a64(const void* data, std::size_t size)
+{
+    const auto* bytes = static_cast<const unsigned char*>(data);
+    std::uint64_t hash = 0xcbf29ce484222325ull;
+    for (std::size_t i = 0; i < size; ++i) {
+        hash ^= bytes[i];
+        hash *= 0x100000001b3ull;
+    }
+    return hash;
+}
+
+} // anonymous namespace
+
+void write_vehicle_parameter_snapshot(const std::string& path,
+                                      const VehicleParameters& params,
+                                      int vehicle_id)
+{
+    VehicleParameterSnapshotHeader header{};
+    std::memcpy(header.magic, kMagic, sizeof(kMagic));
+    header.version      = kVehicleParameterSnapshotVersion;
+    header.payload_size = static_cast<std::uint32_t>(sizeof(VehicleParameters));
+    header.endian_tag   = kEndianTag;
+    header.vehicle_id   = vehicle_id;
+    header.layout_hash  = vehicle_parameter_layout_hash();
+    header.checksum     = fnv1a64(&params, sizeof(VehicleParameters));
+
+    const fs::path target(path);
+    fs::path tmp = target;
+    tmp += ".tmp";
+    {
+        std::ofstream out(tmp, std::ios::binary | std::ios::trunc);
+        if (!out) {
+            throw std::runtime_error("Cannot open snapshot for writing: " + tmp.string());
+        }
+        out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+        out.write(reinterpret_cast<const char*>(&params), sizeof(VehicleParameters));
+        if (!out) {
+            throw std::runtime_error("Failed to write snapshot: " + tmp.string());
+        }
+    }
+    std::error_code ec;
+    fs::rename(tmp, target, ec);
+    if (ec) {
+        fs::remove(tmp, ec);
+        throw std::runtime_error("Failed to publish snapshot: " + target.string());
+    }
+}
+
+const VehicleParameters& view_vehicle_parameter_snapshot(const void* data,
+                                                         std::size_t size,
+                                                         int* vehicle_id)
+{
+    if (!data || size < sizeof(VehicleParameterSnapshotHeader)) {
+        throw std::runtime_error("Vehicle parameter snapshot is truncated");
+    }
+    VehicleParameterSnapshotHeader header;
+    std::memcpy(&header, data, sizeof(header));
+
+    if (std::memcmp(header.magic, kMagic, sizeof(kMagic)) != 0) {
+        throw std::runtime_error("Not a vehicle parameter snapshot (bad magic)");
+    }
+    if (header.version != kVehicleParameterSnapshotVersion) {
+        throw std::runtime_error("Unsupported vehicle parameter snapshot version " +
+                                 std::to_string(header.version));
+    }
+    if (header.endian_tag != kEndianTag) {
+        throw std::runtime_error("Vehicle parameter snapshot was written with a different byte order");
+    }
+    if (header.payload_size != sizeof(VehicleParameters) ||
+        header.layout_hash != vehicle_parameter_layout_hash() ||
+        size < sizeof(header) + sizeof(VehicleParameters)) {
+        throw std::runtime_error("Vehicle parameter snapshot does not match this build's layout");
+    }
+
+    const auto* payload = static_cast<const unsigned char*>(data) + sizeof(header);
+    if (reinterpret_cast<std::uintptr_t>(payload) % alignof(VehicleParameters) != 0) {
+        throw std::runtime_error("Vehicle parameter snapshot payload is misaligned");
+    }
+    if (fnv1a64(payload, sizeof(VehicleParameters)) != header.checksum) {
+        throw std::runtime_error("Vehicle parameter snapshot checksum mismatch");
+    }
+    if (vehicle_id) *vehicle_id = header.vehicle_id;
+    return *reinterpret_cast<const VehicleParameters*>(payload);
+}
+
+VehicleParameters load_vehicle_parameter_snapshot(const std::string& path, int* vehicle_id)
+{
+    MappedVehicleParameters mapped(path);
+    if (vehicle_id) *vehicle_id = mapped.vehicle_id();
+    return mapped.get();
+}
+
+MappedVehicleParameters::MappedVehicleParameters(const std::string& path)
+{
+#if VELOX_HAVE_MMAP
+    const int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) {
+        throw std::runtime_error("Vehicle parameter snapshot not found: " + path);
+    }
+    struct stat st{};
+    if (::fstat(fd, &st) != 0 || st.st_size <= 0) {
+        ::close(fd);
+        throw std::runtime_error("Vehicle parameter snapshot is empty: " + path);
+    }
+    void* base = ::mmap(nullptr, static_cast<std::size_t>(st.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+    ::close(fd);
+    if (base == MAP_FAILED) {
+        throw std::runtime_error("Failed to map vehicle parameter snapshot: " + path);
+    }
+    base_   = base;
+    size_   = static_cast<std::size_t>(st.st_size);
+    mapped_ = true;
+#else
+    std::ifstream in(path, std::ios::binary | std::ios::ate);
+    if (!in) {
+        throw std::runtime_error("Vehicle parameter snapshot not found: " + path);
+    }
+    const std::streamoff end = in.tellg();
+    if (end <= 0) {
+        throw std::runtime_error("Vehicle parameter snapshot is empty: " + path);
+    }
+    size_ = static_cast<std::size_t>(end);
+    base_ = ::operator new(size_);
+    in.seekg(0);
+    in.read(static_cast<char*>(base_), static_cast<std::streamsize>(size_));
+    if (in.gcount() != static_cast<std::streamsize>(size_)) {
+        release();
+        throw std::runtime_error("Failed to read vehicle parameter snapshot: " + path);
+    }
+#endif
+    try {
+        params_ = &view_vehicle_parameter_snapshot(base_, size_, &vehicle_id_);
+    } catch (...) {
+        release();
+        throw;
+    }
+}
+
+MappedVehicleParameters::~MappedVehicleParameters()
+{
+    release();
+}
+
+MappedVehicleParameters::MappedVehicleParameters(MappedVehicleParameters&& other) noexcept
+    : base_(std::exchange(other.base_, nullptr))
+    , size_(std::exchange(other.size_, 0))
+    , mapped_(std::exchange(other.mapped_, false))
+    , params_(std::exchange(other.params_, nullptr))
+    , vehicle_id_(other.vehicle_id_)
+{
+}
+
+MappedVehicleParameters& MappedVehicleParameters::operator=(MappedVehicleParameters&& other) noexcept
+{
+    if (this != &other) {
+        release();
+        base_       = std::exchange(other.base_, nullptr);
+        size_       = std::exchange(other.size_, 0);
+        mapped_     = std::exchange(other.mapped_, false);
+        params_     = std::exchange(other.params_, nullptr);
+        vehicle_id_ = other.vehicle_id_;
+    }
+    return *this;
+}
+
+void MappedVehicleParameters::release() noexcept
+{
+    if (!base_) return;
+#if VELOX_HAVE_MMAP
+    if (mapped_) {
+        ::munmap(base_, size_);
+    }
+#else
+    ::operator delete(base_);
+#endif
+    base_   = nullptr;
+    size_   = 0;
+    params_ = nullptr;
+}
+
+} // namespace velox::models
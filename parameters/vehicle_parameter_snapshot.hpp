@@ -0,0 +1,78 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+#include "vehicle_parameters.hpp"
+
+namespace velox::models {
+
+/**
+ * Binary snapshot (.vpbin) of a single VehicleParameters.
+ *
+ * Layout: a 32-byte header followed by the VehicleParameters object as raw native-endian
+ * doubles. The header records the format version, payload size, an endianness marker and an
+ * FNV-1a 64 checksum of the payload, plus a fingerprint of the field table, so a stale or
+ * foreign file is rejected instead of being misread. The payload starts 8-byte aligned, which
+ * lets a memory-mapped file be used in place.
+ */
+struct VehicleParameterSnapshotHeader {
+    char          magic[4];     // "VPBN"
+    std::uint32_t version;
+    std::uint32_t payload_size; // sizeof(VehicleParameters) of the writer
+    std::uint32_t endian_tag;   // 0x01020304 as written by the producer
+    std::int32_t  vehicle_id;
+    std::uint32_t layout_hash;  // vehicle_parameter_layout_hash() of the writer
+    std::uint64_t checksum;     // FNV-1a 64 over the payload bytes
+};
+
+inline constexpr std::uint32_t kVehicleParameterSnapshotVersion = 2;
+
+/** Writes params to path (atomically via a temporary file). Throws std::runtime_error. */
+void write_vehicle_parameter_snapshot(const std::string& path,
+                                      const VehicleParameters& params,
+                                      int vehicle_id);
+
+/**
+ * Validates a snapshot held in memory and returns a pointer to the payload inside it.
+ * No copy is made; data must stay alive and be 8-byte aligned.
+ *
+ * Throws std::runtime_error on a bad magic, version, size, layout, endianness or checksum.
+ */
+const VehicleParameters& view_vehicle_parameter_snapshot(const void* data,
+                                                         std::size_t size,
+                                                         int* vehicle_id = nullptr);
+
+/** Reads and validates a snapshot file into a VehicleParameters copy. */
+VehicleParameters load_vehicle_parameter_snapshot(const std::string& path,
+                                                  int* vehicle_id = nullptr);
+
+/**
+ * Read-only memory mapping of a .vpbin file. The mapped payload is validated once on open and
+ * then used directly; on platforms without mmap the file is read into an owned buffer instead.
+ */
+class MappedVehicleParameters {
+public:
+    explicit MappedVehicleParameters(const std::string& path);
+    ~MappedVehicleParameters();
+
+    MappedVehicleParameters(const MappedVehicleParameters&) = delete;
+    MappedVehicleParameters& operator=(const MappedVehicleParameters&) = delete;
+    MappedVehicleParameters(MappedVehicleParameters&& other) noexcept;
+    MappedVehicleParameters& operator=(MappedVehicleParameters&& other) noexcept;
+
+    const VehicleParameters& get() const { return *params_; }
+    int vehicle_id() const { return vehicle_id_; }
+
+private:
+    void release() noexcept;
+
+    void* base_{nullptr};
+    std::size_t size_{0};
+    bool mapped_{false};
+    const VehicleParameters* params_{nullptr};
+    int vehicle_id_{0};
+};
+
+} // namespace velox::models
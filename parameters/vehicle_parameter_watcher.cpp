@@ -0,0 +1,474 @@
+#include "vehicle_parameter_watcher.hpp"
+
+#include <cmath>
+#include <condition_variable>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+#include <utility>
+
+#include "vehicle_parameter_fields.hpp"
+#include "yaml_subset.hpp"
+
+#if defined(__linux__)
+#include <fcntl.h>
+#include <poll.h>
+#include <sys/inotify.h>
+#include <unistd.h>
+#elif defined(__APPLE__)
+#include <CoreServices/CoreServices.h>
+#include <dispatch/dispatch.h>
+#endif
+
+namespace fs = std::filesystem;
+
+namespace velox::models {
+
+VehicleParameterSlot::VehicleParameterSlot(int vehicle_id,
+                                           std::shared_ptr<const VehicleParameters> initial)
+    : vehicle_id_(vehicle_id)
+    , current_(std::move(initial))
+{
+}
+
+void VehicleParameterSlot::publish(std::shared_ptr<const VehicleParameters> params)
+{
+    current_.store(std::move(params), std::memory_order_release);
+    generation_.fetch_add(1, std::memory_order_release);
+}
+
+VehicleParameterSubscriber::VehicleParameterSubscriber(std::shared_ptr<const VehicleParameterSlot> slot)
+    : slot_(std::move(slot))
+{
+    if (!slot_) {
+        throw std::invalid_argument("VehicleParameterSubscriber requires a slot");
+    }
+    // Generation first: a publish racing with this constructor is picked up by the next refresh().
+    seen_ = slot_->generation();
+    params_ = slot_->get();
+}
+
+bool VehicleParameterSubscriber::refresh()
+{
+    const std::uint64_t generation = slot_->generation();
+    if (generation == seen_) {
+        return false;
+    }
+    params_ = slot_->get();
+    seen_ = generation;
+    return true;
+}
+
+// ---------------------------------------------------------------------------------------------
+// Change notification backends. Each one only wakes the watcher thread; which files changed is
+// decided by comparing modification times, so a missed or coalesced event is harmless.
+// ---------------------------------------------------------------------------------------------
+
+#if defined(__linux__)
+
+struct VehicleParameterWatcher::Backend {
+    int inotify_fd = -1;
+    int wake_pipe[2] = {-1, -1};
+
+    Backend()
+    {
+        inotify_fd = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+        if (pipe2(wake_pipe, O_NONBLOCK | O_CLOEXEC) != 0) {
+            wake_pipe[0] = wake_pipe[1] = -1;
+        }
+    }
+
+    ~Backend()
+    {
+        for (int fd : {inotify_fd, wake_pipe[0], wake_pipe[1]}) {
+            if (fd >= 0) ::close(fd);
+        }
+    }
+
+    void add(const fs::path& dir)
+    {
+        if (inotify_fd >= 0) {
+            // Editors either rewrite in place (CLOSE_WRITE) or rename a temporary over the file.
+            inotify_add_watch(inotify_fd, dir.c_str(),
+                              IN_CLOSE_WRITE | IN_MOVED_TO | IN_CREATE | IN_ATTRIB);
+        }
+    }
+
+    void wait(std::chrono::milliseconds timeout)
+    {
+        pollfd fds[2] = {{inotify_fd, POLLIN, 0}, {wake_pipe[0], POLLIN, 0}};
+        const int ms = inotify_fd >= 0 ? -1 : static_cast<int>(timeout.count());
+        if (::poll(fds, 2, ms) <= 0) return;
+
+        char buffer[4096];
+        for (int fd : {inotify_fd, wake_pipe[0]}) {
+            if (fd < 0) continue;
+            while (::read(fd, buffer, sizeof(buffer)) > 0) {
+            }
+        }
+    }
+
+    void wake()
+    {
+        if (wake_pipe[1] >= 0) {
+            [[maybe_unused]] auto n = ::write(wake_pipe[1], "x", 1);
+        }
+    }
+};
+
+#else
+
+struct VehicleParameterWatcher::Backend {
+    std::mutex mutex;
+    std::condition_variable cv;
+    bool signalled = false;
+
+    void signal()
+    {
+        {
+            std::lock_guard lock(mutex);
+            signalled = true;
+        }
+        cv.notify_all();
+    }
+
+    void wait(std::chrono::milliseconds timeout)
+    {
+        std::unique_lock lock(mutex);
+        cv.wait_for(lock, timeout, [this] { return signalled; });
+        signalled = false;
+    }
+
+    void wake() { signal(); }
+
+#if defined(__APPLE__)
+    dispatch_queue_t queue = dispatch_queue_create("velox.parameter_watcher", DISPATCH_QUEUE_SERIAL);
+    FSEventStreamRef stream = nullptr;
+    std::vector<fs::path> dirs;
+
+    ~Backend()
+    {
+        stop_stream();
+        dispatch_release(queue);
+    }
+
+    static void on_events(ConstFSEventStreamRef, void* info, size_t, void*,
+                          const FSEventStreamEventFlags*, const FSEventStreamEventId*)
+    {
+        static_cast<Backend*>(info)->signal();
+    }
+
+    void stop_stream()
+    {
+        if (stream) {
+            FSEventStreamStop(stream);
+            FSEventStreamInvalidate(stream);
+            FSEventStreamRelease(stream);
+            stream = nullptr;
+        }
+    }
+
+    // FSEvents streams have a fixed path list, so a new directory recreates the stream.
+    void add(const fs::path& dir)
+    {
+        dirs.push_back(dir);
+        stop_stream();
+
+        CFMutableArrayRef paths = CFArrayCreateMutable(nullptr, 0, &kCFTypeArrayCallBacks);
+        for (const auto& d : dirs) {
+            CFStringRef s = CFStringCreateWithCString(nullptr, d.c_str(), kCFStringEncodingUTF8);
+            CFArrayAppendValue(paths, s);
+            CFRelease(s);
+        }
+        FSEventStreamContext context{0, this, nullptr, nullptr, nullptr};
+        stream = FSEventStreamCreate(nullptr, &Backend::on_events, &context, paths,
+                                     kFSEventStreamEventIdSinceNow, 0.02,
+                                     kFSEventStreamCreateFlagFileEvents | kFSEventStreamCreateFlagNoDefer);
+        CFRelease(paths);
+        if (stream) {
+            FSEventStreamSetDispatchQueue(stream, queue);
+            FSEventStreamStart(stream);
+        }
+    }
+#else
+    void add(const fs::path&) {}
+#endif
+};
+
+#endif
+
+// ---------------------------------------------------------------------------------------------
+
+namespace {
+
+bool stat_file(const fs::path& file, fs::file_time_type& mtime, std::uintmax_t& size)
+{
+    std::error_code ec;
+    mtime = fs::last_write_time(file, ec);
+    if (ec) return false;
+    size = fs::file_size(file, ec);
+    return !ec;
+}
+
+fs::path normalized(const fs::path& file)
+{
+    std::error_code ec;
+    fs::path absolute = fs::absolute(file, ec);
+    return (ec ? file : absolute).lexically_normal();
+}
+
+// Keys every vehicle file must set: the kinematic core all four models need.
+constexpr const char* kRequiredFields[] = {
+    "a", "b", "steering.min", "steering.max", "steering.v_min", "steering.v_max", "longitudinal.a_max",
+};
+
+// Fields that are unphysical at zero or below (masses, inertias, wheel radius, a_max); every other
+// field, e.g. a spring constant, a trailer length or a drag term, may legitimately be set to 0.
+constexpr const char* kPositiveFields[] = {
+    "m", "m_s", "I_z", "I_Phi_s", "I_y_s", "I_y_w", "R_w", "longitudinal.a_max",
+};
+
+/**
+ * Rejects a parsed vehicle document that the models cannot run on. keys holds the fields the
+ * document set (from apply_vehicle_document), so a truncated or half-written file fails on the
+ * missing key instead of publishing its zero default, while an explicit 0 stays a valid edit.
+ * Every field must be finite, the kRequiredFields present, the kPositiveFields that are present
+ * positive, the wheelbase a + b positive, the steering ranges non-empty, and m and I_z set
+ * together (vehicle 4, the kinematic trailer set, has neither). On a reload, a key of the
+ * previous document may not disappear.
+ * Throws std::runtime_error naming the first bad field.
+ */
+void validate_vehicle(const VehicleParameters& p, const VehicleFieldSet& keys, const VehicleFieldSet* previous)
+{
+    if (const auto bad = non_finite_fields(p); !bad.empty()) {
+        throw std::runtime_error("vehicle parameter " + field_path(*bad.front()) + " is not finite");
+    }
+    const auto missing = [](const FieldDescriptor& d) {
+        return std::runtime_error("vehicle parameter " + field_path(d) + " is missing");
+    };
+    for (const char* path : kRequiredFields) {
+        const FieldDescriptor& d = *find_field_path(path);
+        if (!keys.test(field_index(d))) throw missing(d);
+    }
+    const FieldDescriptor& m = *find_field_path("m");
+    const FieldDescriptor& I_z = *find_field_path("I_z");
+    if (keys.test(field_index(m)) != keys.test(field_index(I_z))) {
+        throw missing(keys.test(field_index(m)) ? I_z : m);
+    }
+    for (const char* path : kPositiveFields) {
+        const FieldDescriptor& d = *find_field_path(path);
+        if (keys.test(field_index(d)) && !(field_value(p, d) > 0.0)) {
+            throw std::runtime_error("vehicle parameter " + field_path(d) + " must be positive");
+        }
+    }
+    if (!(p.a + p.b > 0.0)) {
+        throw std::runtime_error("vehicle parameter a + b (wheelbase) must be positive");
+    }
+    if (!(p.steering.min < p.steering.max)) {
+        throw std::runtime_error("vehicle parameter steering.min must be below steering.max");
+    }
+    if (!(p.steering.v_min < p.steering.v_max)) {
+        throw std::runtime_error("vehicle parameter steering.v_min must be below steering.v_max");
+    }
+    if (!previous) return;
+    for (const FieldDescriptor& d : kVehicleParameterFields) {
+        if (previous->test(field_index(d)) && !keys.test(field_index(d))) throw missing(d);
+    }
+}
+
+} // anonymous namespace
+
+VehicleParameterWatcher::VehicleParameterWatcher(const std::string& dir_params,
+                                                 VehicleParameterWatcherOptions options)
+    : root_(normalized(parameter_root(dir_params)))
+    , options_(std::move(options))
+    , backend_(std::make_unique<Backend>())
+{
+    const fs::path tire_yaml = tire_parameter_file(root_);
+    WatchedFile tire;
+    tire.kind = FileKind::Tire;
+    if (!stat_file(tire_yaml, tire.mtime, tire.size)) {
+        throw std::runtime_error("Tire parameter file not found: " + tire_yaml.string());
+    }
+    VehicleParameters parsed;
+    apply_tire_document(MappedTextFile(tire_yaml.string()).text(), parsed);
+    tire_ = parsed.tire;
+
+    files_.emplace(tire_yaml, std::move(tire));
+    add_directory(tire_yaml.parent_path());
+    add_directory(root_ / "vehicle");
+
+    thread_ = std::thread([this] { run(); });
+}
+
+VehicleParameterWatcher::~VehicleParameterWatcher()
+{
+    stopping_.store(true);
+    backend_->wake();
+    if (thread_.joinable()) {
+        thread_.join();
+    }
+}
+
+std::shared_ptr<const VehicleParameterSlot> VehicleParameterWatcher::watch(int vehicle_id)
+{
+    std::lock_guard lock(mutex_);
+    if (auto it = slots_.find(vehicle_id); it != slots_.end()) {
+        return it->second;
+    }
+
+    const fs::path vehicle_yaml = vehicle_parameter_file(root_, vehicle_id);
+    WatchedFile file;
+    file.kind = FileKind::Vehicle;
+    file.vehicle_id = vehicle_id;
+    // Stat before parsing so that a write during the parse is seen by the next scan.
+    if (!stat_file(vehicle_yaml, file.mtime, file.size)) {
+        throw std::runtime_error("Vehicle parameter file not found: " + vehicle_yaml.string());
+    }
+
+    auto params = std::make_shared<VehicleParameters>();
+    params->tire = tire_;
+    apply_vehicle_document(MappedTextFile(vehicle_yaml.string()).text(), *params, &file.keys);
+    try {
+        validate_vehicle(*params, file.keys, nullptr);
+    } catch (const std::exception& e) {
+        throw std::runtime_error(vehicle_yaml.string() + ": " + e.what());
+    }
+
+    auto slot = std::make_shared<VehicleParameterSlot>(vehicle_id, std::move(params));
+    slots_.emplace(vehicle_id, slot);
+    files_[vehicle_yaml] = std::move(file);
+    return slot;
+}
+
+void VehicleParameterWatcher::watch_file(const fs::path& file, FileCallback callback)
+{
+    const fs::path path = normalized(file);
+    WatchedFile entry;
+    entry.kind = FileKind::Custom;
+    entry.callback = std::move(callback);
+    stat_file(path, entry.mtime, entry.size); // a missing file is reported once it appears
+
+    std::lock_guard lock(mutex_);
+    files_[path] = std::move(entry);
+    add_directory(path.parent_path());
+}
+
+void VehicleParameterWatcher::add_directory(const fs::path& dir)
+{
+    for (const auto& known : directories_) {
+        if (known == dir) return;
+    }
+    directories_.push_back(dir);
+    backend_->add(dir);
+}
+
+void VehicleParameterWatcher::run()
+{
+    while (!stopping_.load()) {
+        backend_->wait(options_.poll_interval);
+        if (stopping_.load()) break;
+        std::this_thread::sleep_for(options_.debounce);
+        scan();
+    }
+}
+
+void VehicleParameterWatcher::scan()
+{
+    bool tire_changed = false;
+    std::vector<int> vehicles;
+    std::vector<std::pair<fs::path, FileCallback>> callbacks;
+
+    {
+        std::lock_guard lock(mutex_);
+        for (auto& [path, file] : files_) {
+            fs::file_time_type mtime;
+            std::uintmax_t size = 0;
+            if (!stat_file(path, mtime, size)) continue; // mid-rename or deleted: keep the old value
+            if (mtime == file.mtime && size == file.size) continue;
+            file.mtime = mtime;
+            file.size = size;
+
+            switch (file.kind) {
+            case FileKind::Tire:    tire_changed = true; break;
+            case FileKind::Vehicle: vehicles.push_back(file.vehicle_id); break;
+            case FileKind::Custom:  callbacks.emplace_back(path, file.callback); break;
+            }
+        }
+    }
+
+    // Tire first, so vehicles changed in the same burst are rebuilt on the new tire block.
+    if (tire_changed) reload_tire();
+    for (int id : vehicles) reload_vehicle(id);
+
+    for (auto& [path, callback] : callbacks) {
+        try {
+            if (callback) callback(path);
+        } catch (const std::exception& e) {
+            report(path, e.what());
+        }
+    }
+}
+
+void VehicleParameterWatcher::reload_vehicle(int vehicle_id)
+{
+    const fs::path vehicle_yaml = vehicle_parameter_file(root_, vehicle_id);
+    try {
+        const MappedTextFile doc(vehicle_yaml.string());
+
+        std::shared_ptr<VehicleParameterSlot> slot;
+        VehicleFieldSet previous;
+        auto params = std::make_shared<VehicleParameters>();
+        {
+            std::lock_guard lock(mutex_);
+            slot = slots_.at(vehicle_id);
+            previous = files_.at(vehicle_yaml).keys;
+            params->tire = tire_;
+        }
+        VehicleFieldSet keys;
+        apply_vehicle_document(doc.text(), *params, &keys);
+        validate_vehicle(*params, keys, &previous); // on failure the previous snapshot stays published
+        {
+            std::lock_guard lock(mutex_);
+            files_.at(vehicle_yaml).keys = keys;
+        }
+        slot->publish(std::move(params));
+        reloads_.fetch_add(1, std::memory_order_relaxed);
+    } catch (const std::exception& e) {
+        report(vehicle_yaml, e.what());
+    }
+}
+
+void VehicleParameterWatcher::reload_tire()
+{
+    const fs::path tire_yaml = tire_parameter_file(root_);
+    try {
+        VehicleParameters parsed;
+        apply_tire_document(MappedTextFile(tire_yaml.string()).text(), parsed);
+
+        std::vector<std::shared_ptr<VehicleParameterSlot>> slots;
+        {
+            std::lock_guard lock(mutex_);
+            tire_ = parsed.tire;
+            for (const auto& [id, slot] : slots_) slots.push_back(slot);
+        }
+        // Only the tire block changes; the vehicle fields are copied from the live value.
+        for (const auto& slot : slots) {
+            auto params = std::make_shared<VehicleParameters>(*slot->get());
+            params->tire = parsed.tire;
+            slot->publish(std::move(params));
+        }
+        reloads_.fetch_add(1, std::memory_order_relaxed);
+    } catch (const std::exception& e) {
+        report(tire_yaml, e.what());
+    }
+}
+
+void VehicleParameterWatcher::report(const fs::path& file, const std::string& message) const
+{
+    if (options_.on_error) {
+        options_.on_error(file, message);
+    }
+}
+
+} // namespace velox::models
@@ -0,0 +1,147 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <filesystem>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "vehicle_parameter_fields.hpp"
+#include "vehicle_parameters.hpp"
+
+namespace velox::models {
+
+/**
+ * Published VehicleParameters of one vehicle. The watcher thread replaces the pointer and then
+ * bumps the generation; readers compare generations and only touch the pointer after a change.
+ */
+class VehicleParameterSlot {
+public:
+    VehicleParameterSlot(int vehicle_id, std::shared_ptr<const VehicleParameters> initial);
+
+    int vehicle_id() const noexcept { return vehicle_id_; }
+
+    /// Incremented after every publish. A single atomic load, safe to poll every step.
+    std::uint64_t generation() const noexcept { return generation_.load(std::memory_order_acquire); }
+
+    std::shared_ptr<const VehicleParameters> get() const { return current_.load(std::memory_order_acquire); }
+
+    void publish(std::shared_ptr<const VehicleParameters> params);
+
+private:
+    int vehicle_id_;
+    std::atomic<std::shared_ptr<const VehicleParameters>> current_;
+    std::atomic<std::uint64_t> generation_{0};
+};
+
+/**
+ * Per-simulation-thread view of a slot. Call refresh() at a step boundary: while nothing
+ * changed it costs a single acquire load and takes no lock, and params() stays valid
+ * (the subscriber holds its own reference) until the next refresh().
+ */
+class VehicleParameterSubscriber {
+public:
+    explicit VehicleParameterSubscriber(std::shared_ptr<const VehicleParameterSlot> slot);
+
+    /** Picks up a newer publish if there is one. Returns true when params() changed. */
+    bool refresh();
+
+    const VehicleParameters& params() const noexcept { return *params_; }
+    const std::shared_ptr<const VehicleParameters>& shared() const noexcept { return params_; }
+    std::uint64_t generation() const noexcept { return seen_; }
+
+private:
+    std::shared_ptr<const VehicleParameterSlot> slot_;
+    std::shared_ptr<const VehicleParameters> params_;
+    std::uint64_t seen_{0};
+};
+
+struct VehicleParameterWatcherOptions {
+    /// Quiet period after a change before files are re-read (editors write in bursts).
+    std::chrono::milliseconds debounce{50};
+    /// Rescan period when the platform has no change notification API.
+    std::chrono::milliseconds poll_interval{250};
+    /// Called on the watcher thread when a changed file fails to parse or validate (a required
+    /// key or a key of the previous document missing, a mass, inertia, wheelbase or wheel radius
+    /// that is not positive, empty steering ranges); the old value stays live. Any other field
+    /// may be edited to 0.
+    std::function<void(const std::filesystem::path&, const std::string&)> on_error;
+};
+
+/**
+ * VehicleParameterWatcher
+ *
+ * Watches a parameter root (VELOX_PARAM_ROOT by default) with inotify on Linux, FSEvents on
+ * macOS and mtime polling elsewhere. Only the file that changed is re-parsed:
+ *   - vehicle/parameters_vehicleN.yaml re-reads vehicle N and reuses the parsed tire block;
+ *   - tire/parameters_tire.yaml re-reads the tire file and republishes every watched vehicle.
+ * Arbitrary extra files (the config/ YAML files) can be watched with a callback.
+ */
+class VehicleParameterWatcher {
+public:
+    using FileCallback = std::function<void(const std::filesystem::path&)>;
+
+    explicit VehicleParameterWatcher(const std::string& dir_params = {},
+                                     VehicleParameterWatcherOptions options = {});
+    ~VehicleParameterWatcher();
+
+    VehicleParameterWatcher(const VehicleParameterWatcher&) = delete;
+    VehicleParameterWatcher& operator=(const VehicleParameterWatcher&) = delete;
+
+    /**
+     * Loads vehicle_id and keeps it up to date. Watching the same id twice returns the same
+     * slot. Throws std::runtime_error if the initial load fails.
+     */
+    std::shared_ptr<const VehicleParameterSlot> watch(int vehicle_id);
+
+    /** Invokes callback (on the watcher thread) whenever file is rewritten. */
+    void watch_file(const std::filesystem::path& file, FileCallback callback);
+
+    const std::filesystem::path& root() const noexcept { return root_; }
+
+    /** Number of successful re-parses since construction (tire and vehicle files). */
+    std::uint64_t reload_count() const noexcept { return reloads_.load(std::memory_order_relaxed); }
+
+private:
+    enum class FileKind { Tire, Vehicle, Custom };
+
+    struct WatchedFile {
+        FileKind kind{};
+        int vehicle_id{};
+        FileCallback callback;
+        std::filesystem::file_time_type mtime{};
+        std::uintmax_t size{};
+        VehicleFieldSet keys; ///< vehicle files: the keys of the last accepted document
+    };
+
+    struct Backend;
+
+    void run();
+    void scan();
+    void reload_vehicle(int vehicle_id);
+    void reload_tire();
+    void add_directory(const std::filesystem::path& dir);
+    void report(const std::filesystem::path& file, const std::string& message) const;
+
+    std::filesystem::path root_;
+    VehicleParameterWatcherOptions options_;
+
+    std::mutex mutex_; // guards everything below except the slots' published values
+    std::map<std::filesystem::path, WatchedFile> files_;
+    std::map<int, std::shared_ptr<VehicleParameterSlot>> slots_;
+    utils::TireParameters tire_{};
+    std::vector<std::filesystem::path> directories_;
+
+    std::atomic<std::uint64_t> reloads_{0};
+    std::atomic<bool> stopping_{false};
+    std::unique_ptr<Backend> backend_;
+    std::thread thread_;
+};
+
+} // namespace velox::models
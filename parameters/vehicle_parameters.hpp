@@ -1,5 +1,6 @@
 #pragma once
 
+#include <filesystem>
 #include <string>
 
 #include "models/longitudinal_parameters.hpp"
@@ -94,13 +95,20 @@ struct VehicleParameters {
  * setup_vehicle_parameters
  *
  * Creates a VehicleParameters object holding all vehicle parameters for a given vehicle type ID.
- * Parameters are read from YAML files in a parameter directory.
+ * Parameters are read from YAML files in a parameter directory with the allocation-free
+ * YAML-subset reader (apply_vehicle_document / apply_tire_document).
  *
  * @param vehicle_id  CommonRoad vehicle ID (1..4 as in the reference paper)
  * @param dir_params  Optional path to the parameter directory containing subfolders
  *                    "vehicle/" and "tire/". If empty, a compiled-in default is used
  *                    (typically "parameters").
  *
+ * Build flags:
+ *   VELOX_EMBEDDED_PARAMETERS  an empty dir_params returns the constexpr sets from
+ *                              vehicle/parameters_vehicle_embedded.hpp without touching disk.
+ *   VELOX_PARAMETERS_NO_YAML   drops the yaml-cpp adapters (vehicle_parameters_yaml.hpp); the
+ *                              files themselves are always streamed through yaml_subset.hpp.
+ *
  * @return VehicleParameters object populated from YAML.
  *
  * Throws std::runtime_error if required files are missing or cannot be parsed.
@@ -108,4 +116,16 @@ struct VehicleParameters {
 VehicleParameters setup_vehicle_parameters(int vehicle_id,
                                            const std::string& dir_params = {});
 
+/**
+ * Resolves the parameter root used by setup_vehicle_parameters: dir_params if given,
+ * otherwise the compiled-in VELOX_PARAM_ROOT.
+ */
+std::filesystem::path parameter_root(const std::string& dir_params = {});
+
+/** Path of the vehicle YAML for vehicle_id below a parameter root. */
+std::filesystem::path vehicle_parameter_file(const std::filesystem::path& root, int vehicle_id);
+
+/** Path of the shared tire YAML below a parameter root. */
+std::filesystem::path tire_parameter_file(const std::filesystem::path& root);
+
 } // namespace velox::models
@@ -0,0 +1,25 @@
+#pragma once
+
+#ifndef VELOX_PARAMETERS_NO_YAML
+
+#include <yaml-cpp/yaml.h>
+
+#include "vehicle_parameters.hpp"
+
+namespace velox::models {
+
+/**
+ * Field extraction step of setup_vehicle_parameters, for callers that parse the YAML
+ * themselves (shared tire documents, benchmarks). Keys are dispatched through
+ * kVehicleParameterFields; unknown keys are ignored and fields not mentioned keep their value.
+ *
+ * Throws YAML::Exception if a known key does not hold a number.
+ */
+void apply_vehicle_yaml(const YAML::Node& vehicle, VehicleParameters& p);
+
+/** Same for the tire document, either flat or below a top-level "tire" node. */
+void apply_tire_yaml(const YAML::Node& tire, VehicleParameters& p);
+
+} // namespace velox::models
+
+#endif // VELOX_PARAMETERS_NO_YAML
@@ -0,0 +1,321 @@
+#include "yaml_subset.hpp"
+#include "vehicle_parameter_fields.hpp"
+
+#include <charconv>
+#include <fstream>
+#include <iterator>
+#include <limits>
+#include <stdexcept>
+#include <system_error>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#define VELOX_HAVE_MMAP 1
+#endif
+
+namespace velox::models {
+
+namespace {
+
+constexpr std::size_t kUnset = static_cast<std::size_t>(-1);
+
+bool is_blank(char c)
+{
+    return c == ' ' || c == '\t';
+}
+
+std::string_view trim(std::string_view s)
+{
+    while (!s.empty() && is_blank(s.front())) s.remove_prefix(1);
+    while (!s.empty() && is_blank(s.back())) s.remove_suffix(1);
+    return s;
+}
+
+// Case-insensitive comparison against a lower-case literal.
+bool equals_lower(std::string_view s, std::string_view lower)
+{
+    if (s.size() != lower.size()) return false;
+    for (std::size_t i = 0; i < s.size(); ++i) {
+        char c = s[i];
+        if (c >= 'A' && c <= 'Z') c = static_cast<char>(c - 'A' + 'a');
+        if (c != lower[i]) return false;
+    }
+    return true;
+}
+
+} // anonymous namespace
+
+void YamlSubsetReader::fail(std::size_t line, const char* message) const
+{
+    throw std::runtime_error("YAML line " + std::to_string(line) + ": " + message);
+}
+
+bool YamlSubsetReader::read_line(Line& line)
+{
+    while (pos_ < text_.size()) {
+        const std::size_t end = text_.find('\n', pos_);
+        const std::size_t stop = end == std::string_view::npos ? text_.size() : end;
+        std::string_view raw = text_.substr(pos_, stop - pos_);
+        pos_ = stop == text_.size() ? stop : stop + 1;
+        ++line_no_;
+
+        if (!raw.empty() && raw.back() == '\r') raw.remove_suffix(1);
+
+        std::size_t indent = 0;
+        while (indent < raw.size() && raw[indent] == ' ') ++indent;
+        std::string_view content = raw.substr(indent);
+        if (!content.empty() && content.front() == '\t') {
+            fail(line_no_, "tabs are not allowed in indentation");
+        }
+        content = trim(content);
+        if (content.empty() || content.front() == '#') continue;
+
+        const char lead = content.front();
+        if (lead == '-' && (content.size() == 1 || is_blank(content[1]) || content.substr(0, 3) == "---")) {
+            fail(line_no_, "sequences and document markers are not supported");
+        }
+        if (lead == '{' || lead == '[') fail(line_no_, "flow collections are not supported");
+
+        // the key ends at the first ':' followed by a blank or the end of the line
+        std::size_t colon = content.find(':');
+        while (colon != std::string_view::npos && colon + 1 < content.size() && !is_blank(content[colon + 1])) {
+            colon = content.find(':', colon + 1);
+        }
+        if (colon == std::string_view::npos) fail(line_no_, "expected 'key: value'");
+
+        line.indent = indent;
+        line.number = line_no_;
+        line.key = trim(content.substr(0, colon));
+        if (line.key.empty()) fail(line_no_, "empty key");
+
+        std::string_view value = trim(content.substr(colon + 1));
+        line.opens_map = false;
+        if (value.empty() || value.front() == '#') {
+            line.value = {};
+            line.opens_map = true;
+            return true;
+        }
+
+        const char first = value.front();
+        if (first == '"' || first == '\'') {
+            const std::size_t close = value.find(first, 1);
+            if (close == std::string_view::npos) fail(line_no_, "unterminated quoted scalar");
+            const std::string_view rest = trim(value.substr(close + 1));
+            if (!rest.empty() && rest.front() != '#') fail(line_no_, "text after quoted scalar");
+            line.value = value.substr(1, close - 1);
+            return true;
+        }
+        if (first == '|' || first == '>') fail(line_no_, "block scalars are not supported");
+        if (first == '&' || first == '*') fail(line_no_, "anchors and aliases are not supported");
+        if (first == '{' || first == '[') fail(line_no_, "flow collections are not supported");
+
+        // a '#' preceded by a blank starts a trailing comment
+        for (std::size_t i = 1; i < value.size(); ++i) {
+            if (value[i] == '#' && is_blank(value[i - 1])) {
+                value = trim(value.substr(0, i));
+                break;
+            }
+        }
+        line.value = value;
+        return true;
+    }
+    return false;
+}
+
+bool YamlSubsetReader::next(YamlEvent& event)
+{
+    if (!started_) {
+        child_indent_[0] = kUnset;
+        started_ = true;
+    }
+
+    if (!has_pending_) {
+        if (!read_line(pending_)) {
+            if (open_ == 0) return false;
+            --open_;
+            event = {YamlEventType::MapEnd, keys_[open_], {}, open_, line_no_};
+            return true;
+        }
+        has_pending_ = true;
+    }
+
+    // a line at or left of the key that opened the innermost map closes that map first
+    if (open_ > 0 && pending_.indent <= indent_[open_ - 1]) {
+        --open_;
+        event = {YamlEventType::MapEnd, keys_[open_], {}, open_, pending_.number};
+        return true;
+    }
+
+    std::size_t& expected = child_indent_[open_];
+    if (expected == kUnset) {
+        expected = pending_.indent;
+    } else if (pending_.indent != expected) {
+        fail(pending_.number, "inconsistent indentation");
+    }
+    has_pending_ = false;
+
+    if (pending_.opens_map) {
+        if (open_ == kMaxDepth) fail(pending_.number, "maps are nested too deeply");
+        indent_[open_] = pending_.indent;
+        keys_[open_] = pending_.key;
+        ++open_;
+        child_indent_[open_] = kUnset;
+        event = {YamlEventType::MapBegin, pending_.key, {}, open_ - 1, pending_.number};
+        return true;
+    }
+
+    event = {YamlEventType::Scalar, pending_.key, pending_.value, open_, pending_.number};
+    return true;
+}
+
+bool parse_yaml_number(std::string_view text, double& value)
+{
+    bool negative = false;
+    if (!text.empty() && (text.front() == '+' || text.front() == '-')) {
+        negative = text.front() == '-';
+        text.remove_prefix(1);
+    }
+    if (text.empty()) return false;
+
+    if (text.front() == '.' && text.size() > 1 && !(text[1] >= '0' && text[1] <= '9')) {
+        if (equals_lower(text, ".inf")) {
+            value = negative ? -std::numeric_limits<double>::infinity() : std::numeric_limits<double>::infinity();
+            return true;
+        }
+        if (equals_lower(text, ".nan")) {
+            value = std::numeric_limits<double>::quiet_NaN();
+            return true;
+        }
+        return false;
+    }
+    // from_chars would also take "inf" / "nan", which YAML reads as strings
+    if (!((text.front() >= '0' && text.front() <= '9') || text.front() == '.')) return false;
+
+    double parsed = 0.0;
+    const auto [ptr, ec] = std::from_chars(text.data(), text.data() + text.size(), parsed);
+    if (ec != std::errc{} || ptr != text.data() + text.size()) return false;
+    value = negative ? -parsed : parsed;
+    return true;
+}
+
+bool parse_yaml_bool(std::string_view text, bool& value)
+{
+    if (equals_lower(text, "true") || equals_lower(text, "yes") || equals_lower(text, "on")) {
+        value = true;
+        return true;
+    }
+    if (equals_lower(text, "false") || equals_lower(text, "no") || equals_lower(text, "off")) {
+        value = false;
+        return true;
+    }
+    return false;
+}
+
+namespace {
+
+void assign_field(VehicleParameters& p, FieldSection section, const YamlEvent& event,
+                  VehicleFieldSet* present = nullptr)
+{
+    const FieldDescriptor* field = find_field(section, event.key);
+    if (!field) return;
+    if (!parse_yaml_number(event.value, field_value(p, *field))) {
+        throw std::runtime_error("YAML line " + std::to_string(event.line) + ": " + field_path(*field) +
+                                 " expects a number, got '" + std::string(event.value) + "'");
+    }
+    if (present) present->set(field_index(*field));
+}
+
+} // anonymous namespace
+
+void apply_vehicle_document(std::string_view document, VehicleParameters& p, VehicleFieldSet* present)
+{
+    YamlSubsetReader reader(document);
+    YamlEvent event;
+    while (reader.next(event)) {
+        if (event.type != YamlEventType::Scalar) continue;
+
+        if (event.depth == 0) {
+            assign_field(p, FieldSection::Vehicle, event, present);
+        } else if (event.depth == 1) {
+            const std::string_view section = reader.map_key(0);
+            if (section == "steering") {
+                assign_field(p, FieldSection::Steering, event, present);
+            } else if (section == "longitudinal") {
+                assign_field(p, FieldSection::Longitudinal, event, present);
+            } else if (section == "trailer") {
+                assign_field(p, FieldSection::Trailer, event, present);
+            }
+        }
+    }
+}
+
+void apply_tire_document(std::string_view document, VehicleParameters& p)
+{
+    // Same precedence as apply_tire_yaml: a "tire" map wins over flat top-level keys.
+    VehicleParameters flat = p;
+    bool nested = false;
+
+    YamlSubsetReader reader(document);
+    YamlEvent event;
+    while (reader.next(event)) {
+        if (event.type == YamlEventType::MapBegin && event.depth == 0 && event.key == "tire") {
+            nested = true;
+        } else if (event.type == YamlEventType::Scalar) {
+            if (event.depth == 0) {
+                assign_field(flat, FieldSection::Tire, event);
+            } else if (event.depth == 1 && reader.map_key(0) == "tire") {
+                assign_field(p, FieldSection::Tire, event);
+            }
+        }
+    }
+
+    if (!nested) {
+        p.tire = flat.tire;
+    }
+}
+
+MappedTextFile::MappedTextFile(const std::string& path)
+{
+#if VELOX_HAVE_MMAP
+    const int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) {
+        throw std::runtime_error("Cannot open file: " + path);
+    }
+    struct stat st{};
+    if (::fstat(fd, &st) != 0) {
+        ::close(fd);
+        throw std::runtime_error("Cannot stat file: " + path);
+    }
+    if (st.st_size > 0) {
+        void* base = ::mmap(nullptr, static_cast<std::size_t>(st.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+        if (base != MAP_FAILED) {
+            data_   = static_cast<const char*>(base);
+            size_   = static_cast<std::size_t>(st.st_size);
+            mapped_ = true;
+        }
+    }
+    ::close(fd);
+    if (mapped_ || st.st_size == 0) return;
+#endif
+    std::ifstream in(path, std::ios::binary);
+    if (!in) {
+        throw std::runtime_error("Cannot open file: " + path);
+    }
+    owned_.assign(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+    data_ = owned_.data();
+    size_ = owned_.size();
+}
+
+MappedTextFile::~MappedTextFile()
+{
+#if VELOX_HAVE_MMAP
+    if (mapped_) {
+        ::munmap(const_cast<char*>(data_), size_);
+    }
+#endif
+}
+
+} // namespace velox::models
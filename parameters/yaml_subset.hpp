@@ -0,0 +1,113 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <string>
+#include <string_view>
+
+#include "vehicle_parameter_fields.hpp"
+#include "vehicle_parameters.hpp"
+
+namespace velox::models {
+
+/**
+ * Streaming reader for the YAML subset used by config/ and parameters/: nested block maps
+ * whose leaves are plain scalars, with full-line and trailing "#" comments. Sequences, flow
+ * collections, anchors and multi-line scalars are rejected.
+ *
+ * The reader is a pull parser over a caller-owned buffer: events point into the buffer, the
+ * open-map stack has a fixed depth, and nothing is allocated. Malformed input throws
+ * std::runtime_error naming the line.
+ */
+enum class YamlEventType {
+    MapBegin, // "key:" with a nested block; key() is the map name
+    MapEnd,   // closes the innermost open map
+    Scalar,   // "key: value"
+};
+
+struct YamlEvent {
+    YamlEventType type{};
+    std::string_view key;   // map name or scalar key
+    std::string_view value; // scalar text without comment, surrounding blanks or quotes
+    std::size_t depth{};    // 0 for top-level keys
+    std::size_t line{};     // 1-based
+};
+
+class YamlSubsetReader {
+public:
+    static constexpr std::size_t kMaxDepth = 16;
+
+    explicit YamlSubsetReader(std::string_view text) : text_(text) {}
+
+    /** Fills event with the next event; returns false once the document is exhausted. */
+    bool next(YamlEvent& event);
+
+    /** Name of the open map at depth (0 = outermost); valid for depth < open_maps(). */
+    std::string_view map_key(std::size_t depth) const { return keys_[depth]; }
+    std::size_t open_maps() const noexcept { return open_; }
+
+private:
+    struct Line {
+        std::size_t indent{};
+        std::string_view key;
+        std::string_view value;
+        std::size_t number{};
+        bool opens_map{};
+    };
+
+    bool read_line(Line& line);
+    [[noreturn]] void fail(std::size_t line, const char* message) const;
+
+    std::string_view text_;
+    std::size_t pos_{0};
+    std::size_t line_no_{0};
+    Line pending_{};
+    bool has_pending_{false};
+    // indent of the key that opened each map, and of its children once seen (npos until then)
+    std::array<std::size_t, kMaxDepth + 1> child_indent_{};
+    std::array<std::size_t, kMaxDepth> indent_{};
+    std::array<std::string_view, kMaxDepth> keys_{};
+    std::size_t open_{0};
+    bool started_{false};
+};
+
+/** Parses a YAML number (decimal or exponent form, optional '+', .inf/.nan); false otherwise. */
+bool parse_yaml_number(std::string_view text, double& value);
+
+/** Parses true/false, yes/no and on/off (any case); false if text is none of them. */
+bool parse_yaml_bool(std::string_view text, bool& value);
+
+/**
+ * Fills the vehicle fields of p from a parameters_vehicleN.yaml document: top-level scalars
+ * and the steering / longitudinal / trailer maps, dispatched through the field table.
+ * Unknown keys are ignored; a known key with a non-numeric value throws std::runtime_error.
+ * When present is given, the bit of every field the document sets is raised in it, so callers
+ * can tell a missing key from an explicit 0.
+ */
+void apply_vehicle_document(std::string_view document, VehicleParameters& p, VehicleFieldSet* present = nullptr);
+
+/** Fills p.tire from a parameters_tire.yaml document (a "tire" map, or flat keys without one). */
+void apply_tire_document(std::string_view document, VehicleParameters& p);
+
+/**
+ * Read-only view of a whole text file: memory-mapped where mmap exists, otherwise read into
+ * an owned buffer. Throws std::runtime_error if the file cannot be opened.
+ */
+class MappedTextFile {
+public:
+    explicit MappedTextFile(const std::string& path);
+    ~MappedTextFile();
+
+    MappedTextFile(const MappedTextFile&) = delete;
+    MappedTextFile& operator=(const MappedTextFile&) = delete;
+
+    std::string_view text() const noexcept { return {data_, size_}; }
+
+private:
+    const char* data_{nullptr};
+    std::size_t size_{0};
+    bool mapped_{false};
+    std::string owned_;
+};
+
+} // namespace velox::models
@@ -0,0 +1,154 @@
+import { promises as fs } from "fs"
+import path from "path"
+
+// Emits parameters/vehicle/parameters_vehicle_embedded.hpp: constexpr VehicleParameters for
+// every parameters/vehicle/parameters_vehicleN.yaml combined with the shared tire YAML.
+// YAML keys map 1:1 onto VehicleParameters members (see kVehicleParameterFields in
+// vehicle_parameter_fields.hpp).
+
+const parameterDir = path.join(process.cwd(), "parameters")
+const outputFile = path.join(
+  parameterDir,
+  "vehicle",
+  "parameters_vehicle_embedded.hpp"
+)
+
+type YamlMap = { [key: string]: string | YamlMap }
+
+const NESTED_SECTIONS = new Set(["steering", "longitudinal", "trailer"])
+const NUMERIC_LITERAL = /^[-+]?(\d+\.?\d*|\.\d+)([eE][-+]?\d+)?$/
+
+function parseYamlMap(document: string): YamlMap {
+  const result: YamlMap = {}
+  const stack: Array<{ indent: number; target: YamlMap }> = [
+    { indent: -1, target: result },
+  ]
+  for (const raw of document.split(/\r?\n/)) {
+    const line = raw.replace(/\s+#.*$/, "")
+    if (line.trim().length === 0 || line.trim().startsWith("#")) continue
+    const match = line.match(/^(\s*)([^:]+):\s*(.*)$/)
+    if (!match) continue
+    const [, spaces, key, value] = match
+    const indent = spaces.length
+    while (stack.length > 1 && indent <= stack[stack.length - 1].indent) {
+      stack.pop()
+    }
+    const parent = stack[stack.length - 1].target
+    if (value.trim() === "") {
+      const child: YamlMap = {}
+      parent[key.trim()] = child
+      stack.push({ indent, target: child })
+    } else {
+      parent[key.trim()] = value.trim()
+    }
+  }
+  return result
+}
+
+function cppLiteral(value: string, context: string): string {
+  if (NUMERIC_LITERAL.test(value)) {
+    return value.replace(/^\+/, "")
+  }
+  const numeric = Number(value)
+  if (!Number.isFinite(numeric)) {
+    throw new Error(`${context}: expected a numeric scalar, got '${value}'`)
+  }
+  return String(numeric)
+}
+
+function emitAssignments(map: YamlMap, prefix: string, file: string): string[] {
+  const lines: string[] = []
+  for (const [key, value] of Object.entries(map)) {
+    if (typeof value === "string") {
+      lines.push(`    p.${prefix}${key} = ${cppLiteral(value, `${file}:${key}`)};`)
+    }
+  }
+  return lines
+}
+
+function emitVehicle(id: number, vehicle: YamlMap, file: string): string {
+  const lines = emitAssignments(vehicle, "", file)
+  for (const section of NESTED_SECTIONS) {
+    const nested = vehicle[section]
+    if (nested && typeof nested === "object") {
+      lines.push("", ...emitAssignments(nested, `${section}.`, file))
+    }
+  }
+  return [
+    `constexpr VehicleParameters make_vehicle${id}()`,
+    "{",
+    "    VehicleParameters p{};",
+    ...lines,
+    "",
+    "    detail::apply_tire(p);",
+    "    return p;",
+    "}",
+    "",
+    `inline constexpr VehicleParameters kVehicle${id} = make_vehicle${id}();`,
+  ].join("\n")
+}
+
+async function main() {
+  const tireDoc = parseYamlMap(
+    await fs.readFile(
+      path.join(parameterDir, "tire", "parameters_tire.yaml"),
+      "utf-8"
+    )
+  )
+  const tire =
+    typeof tireDoc.tire === "object" ? (tireDoc.tire as YamlMap) : tireDoc
+
+  const vehicleDir = path.join(parameterDir, "vehicle")
+  const files = (await fs.readdir(vehicleDir))
+    .map((name) => ({ name, match: name.match(/^parameters_vehicle(\d+)\.yaml$/) }))
+    .filter((entry) => entry.match)
+    .map((entry) => ({ name: entry.name, id: Number(entry.match![1]) }))
+    .sort((a, b) => a.id - b.id)
+
+  const vehicles: string[] = []
+  for (const { name, id } of files) {
+    const doc = parseYamlMap(await fs.readFile(path.join(vehicleDir, name), "utf-8"))
+    vehicles.push(emitVehicle(id, doc, name))
+  }
+
+  const output = [
+    "// Generated by scripts/generate_vehicle_parameters.ts from parameters/vehicle/*.yaml",
+    "// and parameters/tire/parameters_tire.yaml. Do not edit by hand; regenerate instead.",
+    "#pragma once",
+    "",
+    '#include "vehicle_parameters.hpp"',
+    "",
+    "namespace velox::models::embedded {",
+    "",
+    "namespace detail {",
+    "",
+    "constexpr void apply_tire(VehicleParameters& p)",
+    "{",
+    ...emitAssignments(tire, "tire.", "parameters_tire.yaml"),
+    "}",
+    "",
+    "} // namespace detail",
+    "",
+    vehicles.join("\n\n"),
+    "",
+    "/** Compiled-in parameters for vehicle_id, or nullptr if none were embedded. */",
+    "constexpr const VehicleParameters* find_vehicle_parameters(int vehicle_id)",
+    "{",
+    "    switch (vehicle_id) {",
+    ...files.map(({ id }) => `    case ${id}: return &kVehicle${id};`),
+    "    default: return nullptr;",
+    "    }",
+    "}",
+    "",
+    "} // namespace velox::models::embedded",
+    "",
+  ].join("\n")
+
+  await fs.writeFile(outputFile, output)
+  console.log(`Wrote ${path.relative(process.cwd(), outputFile)} (${files.length} vehicles)`)
+}
+
+main().catch((err) => {
+  console.error(err)
+  process.exit(1)
+})
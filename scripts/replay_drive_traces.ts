@@ -0,0 +1,211 @@
+/**
+ * Regression harness: replays velox/tools/fixtures/driveTraces.json through the JS backend and
+ * the native engine and fails when any reported field differs by more than the scenario's
+ * tolerance.
+ *
+ *   ts-node scripts/replay_drive_traces.ts --module public/wasm/velox.js [--fixture <path>] [--verbose]
+ *
+ * The module is the Emscripten build of native_backend.hpp; for Node add `node` to its
+ * -sENVIRONMENT list. Only fields the native backend reports are compared; fixture tolerances
+ * for others (safety stage, detector severity) are listed as skipped.
+ */
+import fs from 'fs/promises';
+import path from 'path';
+import { pathToFileURL } from 'url';
+import { ConfigManager, Fetcher } from '../velox/io/ConfigManager';
+import { HybridSimulationBackend, type SimulationBackend } from '../velox/simulation/backend';
+import { NativeSimulationBackend, type VeloxNativeModule } from '../velox/simulation/nativeBackend';
+import { ModelType } from '../velox/simulation/types';
+import type { SimulationTelemetry } from '../velox/telemetry/index';
+
+const CONFIG_ROOT = 'http://local.velox.config/';
+const PARAM_ROOT = 'http://local.velox.parameters/';
+
+/** Telemetry fields NativeSimulationBackend.snapshot() fills in. */
+const kNativeFields = [
+  'pose.x',
+  'pose.y',
+  'pose.yaw',
+  'velocity.speed',
+  'velocity.longitudinal',
+  'acceleration.longitudinal',
+  'steering.actual_angle',
+  'steering.actual_rate',
+  'totals.distance_traveled_m',
+  'totals.energy_consumed_joules',
+  'totals.simulation_time_s',
+];
+
+interface TraceSegment {
+  steps: number;
+  steerRate?: number;
+  accel?: number;
+}
+
+interface Scenario {
+  name: string;
+  model: string;
+  vehicleId: number;
+  initialState: number[];
+  dt: number;
+  driftEnabled: boolean;
+  trace: TraceSegment[];
+  tolerances: { default: number; fields?: Record<string, number> };
+}
+
+interface Options {
+  fixture: string;
+  module?: string;
+  verbose: boolean;
+}
+
+interface Mismatch {
+  step: number;
+  field: string;
+  js: number;
+  native: number;
+  tolerance: number;
+}
+
+const fetcher: Fetcher = async (input) => {
+  const url = input.toString();
+  let filePath: string;
+  if (url.startsWith(CONFIG_ROOT)) {
+    filePath = path.join(process.cwd(), url.replace(CONFIG_ROOT, 'config/'));
+  } else if (url.startsWith(PARAM_ROOT)) {
+    filePath = path.join(process.cwd(), url.replace(PARAM_ROOT, 'parameters/'));
+  } else if (url.startsWith('file://')) {
+    filePath = new URL(url).pathname;
+  } else {
+    filePath = path.isAbsolute(url) ? url : path.join(process.cwd(), url);
+  }
+  const stat = await fs.stat(filePath).catch(() => null);
+  if (!stat) {
+    return new Response('missing', { status: 404 });
+  }
+  if (stat.isDirectory()) {
+    return new Response('', { status: 200 });
+  }
+  const content = await fs.readFile(filePath, 'utf-8');
+  return new Response(content, { status: 200, headers: { 'content-type': 'text/plain' } });
+};
+
+function parseOptions(argv: string[]): Options {
+  const options: Options = { fixture: 'velox/tools/fixtures/driveTraces.json', verbose: false };
+  for (let i = 0; i < argv.length; i += 1) {
+    const arg = argv[i];
+    const value = () => {
+      if (i + 1 >= argv.length) throw new Error(`Missing value for ${arg}`);
+      return argv[++i];
+    };
+    if (arg === '--fixture') options.fixture = value();
+    else if (arg === '--module') options.module = value();
+    else if (arg === '--verbose') options.verbose = true;
+    else throw new Error(`Unknown argument: ${arg}`);
+  }
+  return options;
+}
+
+async function loadModule(modulePath: string): Promise<VeloxNativeModule> {
+  const imported = await import(pathToFileURL(path.resolve(modulePath)).href);
+  const factory = imported.createVeloxModule ?? imported.default;
+  if (typeof factory !== 'function') {
+    throw new Error(`${modulePath} does not export a module factory`);
+  }
+  return factory();
+}
+
+function fieldValue(telemetry: SimulationTelemetry, field: string): number | undefined {
+  let node: unknown = telemetry;
+  for (const key of field.split('.')) {
+    if (node === null || typeof node !== 'object') return undefined;
+    node = (node as Record<string, unknown>)[key];
+  }
+  if (typeof node === 'number') return node;
+  if (typeof node === 'boolean') return node ? 1 : 0;
+  return undefined;
+}
+
+async function replay(scenario: Scenario, module: VeloxNativeModule, config: ConfigManager, verbose: boolean) {
+  if (scenario.model !== ModelType.ST) {
+    throw new Error(`${scenario.name}: the native engine only covers the ST model, got ${scenario.model}`);
+  }
+  const js: SimulationBackend = new HybridSimulationBackend({
+    model: ModelType.ST,
+    vehicleId: scenario.vehicleId,
+    configManager: config,
+    driftEnabled: scenario.driftEnabled,
+  });
+  const native = new NativeSimulationBackend({ module, vehicleId: scenario.vehicleId });
+  await js.ready;
+  await js.reset(scenario.initialState, scenario.dt);
+  native.reset(scenario.initialState, scenario.dt);
+
+  const tolerances = scenario.tolerances;
+  const skipped = Object.keys(tolerances.fields ?? {}).filter((field) => !kNativeFields.includes(field));
+  const mismatches: Mismatch[] = [];
+  const worst = new Map<string, number>();
+  let step = 0;
+  try {
+    for (const segment of scenario.trace) {
+      const control = [segment.steerRate ?? 0, segment.accel ?? 0];
+      for (let k = 0; k < segment.steps; k += 1) {
+        await js.step(control, scenario.dt);
+        native.step(control, scenario.dt);
+        step += 1;
+        const a = js.snapshot().telemetry;
+        const b = native.snapshot().telemetry;
+        if (!a || !b) throw new Error(`${scenario.name}: backend reported no telemetry`);
+        for (const field of kNativeFields) {
+          const jsValue = fieldValue(a, field);
+          const nativeValue = fieldValue(b, field);
+          if (jsValue === undefined || nativeValue === undefined) continue;
+          const tolerance = tolerances.fields?.[field] ?? tolerances.default;
+          const error = Math.abs(jsValue - nativeValue);
+          worst.set(field, Math.max(worst.get(field) ?? 0, Number.isNaN(error) ? Infinity : error));
+          if (!(error <= tolerance)) {
+            mismatches.push({ step, field, js: jsValue, native: nativeValue, tolerance });
+          }
+        }
+      }
+    }
+  } finally {
+    native.dispose();
+  }
+
+  const status = mismatches.length === 0 ? 'ok' : 'FAIL';
+  console.log(`${status} ${scenario.name}: ${step} steps, ${kNativeFields.length} fields`);
+  if (verbose) {
+    for (const [field, error] of worst) console.log(`    ${field}: max |js - native| = ${error.toExponential(3)}`);
+  }
+  if (skipped.length > 0) console.log(`    not reported by the native engine: ${skipped.join(', ')}`);
+  for (const m of mismatches.slice(0, 10)) {
+    console.log(`    step ${m.step} ${m.field}: js ${m.js} native ${m.native} (tolerance ${m.tolerance})`);
+  }
+  if (mismatches.length > 10) console.log(`    ... ${mismatches.length - 10} more`);
+  return mismatches.length === 0;
+}
+
+async function main() {
+  const options = parseOptions(process.argv.slice(2));
+  if (!options.module) {
+    throw new Error('--module <velox.js> is required: the native engine is compared against the JS backend');
+  }
+  const fixture = JSON.parse(await fs.readFile(options.fixture, 'utf-8')) as { scenarios: Scenario[] };
+  const module = await loadModule(options.module);
+  const config = new ConfigManager(CONFIG_ROOT, PARAM_ROOT, fetcher);
+
+  let failed = 0;
+  for (const scenario of fixture.scenarios) {
+    if (!(await replay(scenario, module, config, options.verbose))) failed += 1;
+  }
+  if (failed > 0) {
+    console.error(`${failed} of ${fixture.scenarios.length} scenarios exceeded their tolerances`);
+    process.exit(1);
+  }
+}
+
+main().catch((err) => {
+  console.error(err);
+  process.exit(1);
+});
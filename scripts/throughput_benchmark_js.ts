@@ -0,0 +1,266 @@
+/**
+ * JS baseline for velox/bench/throughput_benchmark.cpp: drives the JS single-track backend
+ * (HybridSimulationBackend without a native module, i.e. JsSimulationBackend) with
+ * BaselineController around every track in tracks/, with the same episode rules as the native
+ * benchmark (start pose, one lap or --max-time, leaving the track counted but not terminal; a lap
+ * finished after leaving the track is an off_track_lap and does not count towards laps/sec).
+ *
+ *   ts-node scripts/throughput_benchmark_js.ts [--dt 0.01] [--min-time 1] [--max-time 120]
+ *       [--native native.json] [--baseline previous.json] [--max-regression 0.1] [--out report.json]
+ *
+ * Output is the Google Benchmark layout of the native report with "js/st/<track>" entries.
+ * --native merges a throughput_benchmark report and adds speedup_vs_js to its single-thread
+ * st/<track> entries. --baseline compares steps_per_second of every entry present in both
+ * reports and exits 1 when any falls by more than --max-regression (a fraction), so CI can gate
+ * on the hot paths.
+ */
+import fs from 'fs/promises';
+import path from 'path';
+import { performance } from 'perf_hooks';
+import { loadTracks } from '../app/playground/loadTracks';
+import type { TrackDefinition } from '../app/playground/types';
+import { BaselineController, stateFromTelemetry } from '../controllers/baseline';
+import { buildPath } from '../controllers/baseline/path';
+import { ConfigManager, type Fetcher } from '../velox/io/ConfigManager';
+import { HybridSimulationBackend } from '../velox/simulation/backend';
+import { ModelType } from '../velox/simulation/types';
+
+const CONFIG_ROOT = 'http://local.velox.config/';
+const PARAM_ROOT = 'http://local.velox.parameters/';
+const VEHICLE_ID = 2;
+
+interface Options {
+  dt: number;
+  minTime: number;
+  maxTime: number;
+  native?: string;
+  baseline?: string;
+  maxRegression: number;
+  out?: string;
+}
+
+interface BenchmarkEntry {
+  name: string;
+  steps_per_second: number;
+  [key: string]: unknown;
+}
+
+interface Report {
+  context: Record<string, unknown>;
+  benchmarks: BenchmarkEntry[];
+}
+
+const fetcher: Fetcher = async (input) => {
+  const url = input.toString();
+  let filePath: string;
+  if (url.startsWith(CONFIG_ROOT)) {
+    filePath = path.join(process.cwd(), url.replace(CONFIG_ROOT, 'config/'));
+  } else if (url.startsWith(PARAM_ROOT)) {
+    filePath = path.join(process.cwd(), url.replace(PARAM_ROOT, 'parameters/'));
+  } else {
+    filePath = path.isAbsolute(url) ? url : path.join(process.cwd(), url);
+  }
+  const stat = await fs.stat(filePath).catch(() => null);
+  if (!stat) return new Response('missing', { status: 404 });
+  if (stat.isDirectory()) return new Response('', { status: 200 });
+  const content = await fs.readFile(filePath, 'utf-8');
+  return new Response(content, { status: 200, headers: { 'content-type': 'text/plain' } });
+};
+
+function parseOptions(argv: string[]): Options {
+  const options: Options = { dt: 0.01, minTime: 1, maxTime: 120, maxRegression: 0.1 };
+  for (let i = 0; i < argv.length; i += 1) {
+    const arg = argv[i];
+    const value = () => {
+      if (i + 1 >= argv.length) throw new Error(`Missing value for ${arg}`);
+      return argv[++i];
+    };
+    if (arg === '--dt') options.dt = Number(value());
+    else if (arg === '--min-time') options.minTime = Number(value());
+    else if (arg === '--max-time') options.maxTime = Number(value());
+    else if (arg === '--native') options.native = value();
+    else if (arg === '--baseline') options.baseline = value();
+    else if (arg === '--max-regression') options.maxRegression = Number(value());
+    else if (arg === '--out') options.out = value();
+    else throw new Error(`Unknown argument: ${arg}`);
+  }
+  if (!(options.dt > 0) || !(options.maxTime > 0)) throw new Error('--dt and --max-time must be positive');
+  return options;
+}
+
+// Same test as TrackIndex::on_track: inside the quad between two consecutive gates (even-odd
+// rule), wrapping from the last gate to the first on loops.
+function onTrack(track: TrackDefinition, x: number, y: number): boolean {
+  const gates = [...track.metadata.checkpoints].sort((a, b) => a.order - b.order).map((c) => c.gate);
+  if (gates.length < 2) return false;
+  const quads = track.metadata.isLoop ? gates.length : gates.length - 1;
+  for (let q = 0; q < quads; q += 1) {
+    const g = gates[q];
+    const h = gates[(q + 1) % gates.length];
+    const poly = [g.a, g.b, h.b, h.a];
+    let inside = false;
+    for (let i = 0, j = 3; i < 4; j = i, i += 1) {
+      const pi = poly[i];
+      const pj = poly[j];
+      if (pi.y > y !== pj.y > y && x < ((pj.x - pi.x) * (y - pi.y)) / (pj.y - pi.y) + pi.x) {
+        inside = !inside;
+      }
+    }
+    if (inside) return true;
+  }
+  return false;
+}
+
+function percentile(sorted: number[], q: number): number {
+  if (sorted.length === 0) return 0;
+  return sorted[Math.min(sorted.length - 1, Math.floor(sorted.length * q))];
+}
+
+async function benchmarkTrack(track: TrackDefinition, config: ConfigManager, options: Options): Promise<BenchmarkEntry> {
+  const params = await config.loadModelParameters(VEHICLE_ID, ModelType.ST);
+  const backend = new HybridSimulationBackend({
+    model: ModelType.ST,
+    vehicleId: VEHICLE_ID,
+    configManager: config,
+    driftEnabled: false,
+  });
+  await backend.ready;
+  const controller = new BaselineController();
+  const refPath = buildPath(track);
+  const goal = refPath.isLoop ? refPath.length : refPath.length - 2 * refPath.spacing;
+  const pose = track.metadata.startPose;
+  const initial = [pose?.position.x ?? 0, pose?.position.y ?? 0, pose?.yaw ?? 0, 0, 0];
+  const maxSteps = Math.floor(options.maxTime / options.dt);
+
+  const latency: number[] = [];
+  let steps = 0;
+  let episodes = 0;
+  let laps = 0;
+  let offTrackLaps = 0;
+  let offTrack = 0;
+  const runEpisode = async (timed: boolean) => {
+    await backend.reset(initial, options.dt);
+    controller.reset(track, params);
+    let progress = 0;
+    let prevS = -1;
+    let left = false;
+    for (let k = 0; k < maxSteps; k += 1) {
+      const start = timed ? performance.now() : 0;
+      const telemetry = backend.snapshot().telemetry;
+      if (!telemetry) throw new Error(`${track.id}: backend reported no telemetry`);
+      const output = controller.update(stateFromTelemetry(telemetry), options.dt);
+      await backend.step([output.steeringRate, output.acceleration], options.dt);
+      if (timed) {
+        latency.push((performance.now() - start) * 1e6);
+        steps += 1;
+      }
+      const s = output.pathS;
+      if (prevS >= 0) {
+        let ds = s - prevS;
+        if (refPath.isLoop) {
+          if (ds < -0.5 * refPath.length) ds += refPath.length;
+          if (ds > 0.5 * refPath.length) ds -= refPath.length;
+        }
+        progress += ds;
+      }
+      prevS = s;
+      const state = backend.snapshot().state;
+      left = left || !onTrack(track, state[0], state[1]);
+      if (progress >= goal) {
+        if (timed && left) offTrackLaps += 1;
+        else if (timed) laps += 1;
+        break;
+      }
+    }
+    if (timed) {
+      episodes += 1;
+      if (left) offTrack += 1;
+    }
+  };
+
+  await runEpisode(false); // warm-up, as the native benchmark does
+  const begin = performance.now();
+  do {
+    await runEpisode(true);
+  } while ((performance.now() - begin) / 1000 < options.minTime);
+  const wall = (performance.now() - begin) / 1000;
+  latency.sort((a, b) => a - b);
+  const nsPerStep = (wall * 1e9) / Math.max(steps, 1);
+
+  return {
+    name: `js/st/${track.id}`,
+    run_type: 'iteration',
+    iterations: steps,
+    real_time: nsPerStep,
+    cpu_time: nsPerStep,
+    time_unit: 'ns',
+    threads: 1,
+    steps_per_second: steps / wall,
+    laps_per_second: laps / wall,
+    episodes,
+    laps,
+    off_track_laps: offTrackLaps,
+    off_track: offTrack,
+    p50_ns: percentile(latency, 0.5),
+    p99_ns: percentile(latency, 0.99),
+  };
+}
+
+async function main() {
+  const options = parseOptions(process.argv.slice(2));
+  const config = new ConfigManager(CONFIG_ROOT, PARAM_ROOT, fetcher);
+  const tracks = (await loadTracks()).filter((track) => !track.isEmpty);
+
+  const report: Report = {
+    context: {
+      date: new Date().toISOString(),
+      executable: 'throughput_benchmark_js',
+      node: process.version,
+      vehicle_id: VEHICLE_ID,
+      st_dt: options.dt,
+    },
+    benchmarks: [],
+  };
+  for (const track of tracks) {
+    const entry = await benchmarkTrack(track, config, options);
+    console.error(`${entry.name}: ${Math.round(entry.steps_per_second)} steps/s`);
+    report.benchmarks.push(entry);
+  }
+
+  if (options.native) {
+    const native = JSON.parse(await fs.readFile(options.native, 'utf-8')) as Report;
+    report.context.native = native.context;
+    for (const entry of native.benchmarks) {
+      const js = report.benchmarks.find((b) => b.name === `js/${entry.name}`);
+      if (js && js.steps_per_second > 0) entry.speedup_vs_js = entry.steps_per_second / js.steps_per_second;
+    }
+    report.benchmarks.push(...native.benchmarks);
+  }
+
+  const json = `${JSON.stringify(report, null, 2)}\n`;
+  if (options.out) await fs.writeFile(options.out, json);
+  else process.stdout.write(json);
+
+  if (options.baseline) {
+    const baseline = JSON.parse(await fs.readFile(options.baseline, 'utf-8')) as Report;
+    const regressions: string[] = [];
+    for (const entry of report.benchmarks) {
+      const before = baseline.benchmarks.find((b) => b.name === entry.name);
+      if (!before || !(before.steps_per_second > 0)) continue;
+      const change = entry.steps_per_second / before.steps_per_second - 1;
+      if (change < -options.maxRegression) {
+        regressions.push(`${entry.name}: ${(change * 100).toFixed(1)}% steps/s`);
+      }
+    }
+    if (regressions.length > 0) {
+      console.error(`${regressions.length} entries regressed by more than ${options.maxRegression * 100}%:`);
+      for (const line of regressions) console.error(`    ${line}`);
+      process.exit(1);
+    }
+  }
+}
+
+main().catch((err) => {
+  console.error(err);
+  process.exit(1);
+});
@@ -0,0 +1,567 @@
+// End-to-end throughput benchmark for the native engines.
+//
+// Drives the ST and STD simulators with the baseline controller (BaselineBatch, one vehicle)
+// around every tracks/*.csv from the track's start pose until a lap is complete or max-time runs
+// out, and repeats episodes for at least min-time seconds. Leaving the track does not end an
+// episode (the playground does not either); such episodes are counted as off_track, and a lap
+// they finish counts as an off_track_lap, not a lap. Reported per model and track:
+//
+//   - steps/sec and laps/sec (clean laps only) on one thread, with per-step latency
+//     (controller + dynamics) p50/p99 over a uniform reservoir sample of every timed step, and
+//     heap allocations per step (counted by the replaced global operator new);
+//   - steps/sec and laps/sec with 1, 2, 4, ... up to --threads independent workers, each with
+//     its own simulator and controller.
+//
+// Output is JSON in the Google Benchmark layout ({"context": ..., "benchmarks": [...]}) like
+// vehicle_parameter_benchmark, so runs can be diffed and gated on. The JS backend baseline for
+// the same tracks comes from scripts/throughput_benchmark_js.ts, which also merges the two
+// reports and fails on regressions.
+//
+//   throughput_benchmark [--tracks tracks] [--root parameters] [--vehicle 2] [--models st,std]
+//                        [--st-dt 0.01] [--std-dt 0.001] [--max-time 120] [--min-time 1]
+//                        [--threads N] [--out results.json]
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <ctime>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <new>
+#include <random>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "control/baseline_batch.hpp"
+#include "simulation/dynamic_simulator.hpp"
+#include "simulation/st_simulator.hpp"
+#include "track/reference_path.hpp"
+#include "track/track_index.hpp"
+#include "vehicle_parameter_cache.hpp"
+
+namespace fs = std::filesystem;
+using namespace velox;
+
+namespace {
+
+std::atomic<std::uint64_t> g_allocations{0};
+
+} // anonymous namespace
+
+// Counting replacements of the global allocation functions; the aligned forms back
+// simd::AlignedBuffer.
+void* operator new(std::size_t size)
+{
+    g_allocations.fetch_add(1, std::memory_order_relaxed);
+    if (void* p = std::malloc(size ? size : 1)) return p;
+    throw std::bad_alloc();
+}
+
+void* operator new[](std::size_t size)
+{
+    return ::operator new(size);
+}
+
+void* operator new(std::size_t size, std::align_val_t alignment)
+{
+    g_allocations.fetch_add(1, std::memory_order_relaxed);
+    const std::size_t a = static_cast<std::size_t>(alignment);
+    const std::size_t rounded = (size + a - 1) / a * a;
+    if (void* p = std::aligned_alloc(a, rounded ? rounded : a)) return p;
+    throw std::bad_alloc();
+}
+
+void* operator new[](std::size_t size, std::align_val_t alignment)
+{
+    return ::operator new(size, alignment);
+}
+
+void operator delete(void* p) noexcept { std::free(p); }
+void operator delete[](void* p) noexcept { std::free(p); }
+void operator delete(void* p, std::size_t) noexcept { std::free(p); }
+void operator delete[](void* p, std::size_t) noexcept { std::free(p); }
+void operator delete(void* p, std::align_val_t) noexcept { std::free(p); }
+void operator delete[](void* p, std::align_val_t) noexcept { std::free(p); }
+void operator delete(void* p, std::size_t, std::align_val_t) noexcept { std::free(p); }
+void operator delete[](void* p, std::size_t, std::align_val_t) noexcept { std::free(p); }
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+struct Options {
+    std::string tracks = "tracks";
+    std::string root = "parameters";
+    int vehicle = 2;
+    std::vector<std::string> models{"st", "std"};
+    double st_dt = 0.01;
+    double std_dt = 0.001;
+    double max_time_s = 120.0;
+    double min_time_s = 1.0;
+    std::size_t threads = 0;
+    std::string out;
+};
+
+/// Single-track engine as the benchmark drives it.
+class StEngine {
+public:
+    StEngine(const models::VehicleParameters& params, double dt) : sim_(params, dt) {}
+
+    void reset(const track::StartPose& pose)
+    {
+        const double initial[5] = {pose.x, pose.y, pose.yaw, 0.0, 0.0};
+        sim_.reset(initial, 5);
+    }
+    void step(double steer_rate, double accel) { sim_.step(steer_rate, accel); }
+
+    double x() const { return sim_.state()[0]; }
+    double y() const { return sim_.state()[1]; }
+    double psi() const { return sim_.state()[2]; }
+    double v() const { return sim_.state()[3]; }
+    double delta() const { return sim_.state()[4]; }
+
+private:
+    simulation::StSimulator sim_;
+};
+
+/**
+ * Single-track drift engine; note the [x, y, delta, v, psi, ...] layout.
+ *
+ * The baseline controller commands up to longitudinal.a_max, which the drive axle cannot
+ * transmit (vehicle 2 drives the rear wheels only, T_se = 0): the rear wheel spins up without
+ * bound and the car leaves the track. Throttle is therefore capped at the driven axle's
+ * traction limit, mu F_z / m with mu = tire.p_dx1 and the rear load including the transfer
+ * at that acceleration; braking is passed through.
+ */
+class StdEngine {
+public:
+    StdEngine(const models::VehicleParameters& params, double dt)
+        : sim_(params, dt)
+        , throttle_cap_(traction_limit(params))
+    {
+    }
+
+    void reset(const track::StartPose& pose)
+    {
+        const double initial[7] = {pose.x, pose.y, 0.0, 0.0, pose.yaw, 0.0, 0.0};
+        sim_.reset(initial, 7);
+    }
+    void step(double steer_rate, double accel) { sim_.step(steer_rate, std::min(accel, throttle_cap_)); }
+
+    double x() const { return sim_.state()[0]; }
+    double y() const { return sim_.state()[1]; }
+    double psi() const { return sim_.state()[4]; }
+    double v() const { return sim_.state()[3]; }
+    double delta() const { return sim_.state()[2]; }
+
+private:
+    // Largest a with m a <= mu (front_share F_zf + rear_share F_zr), F_z as in the STD model.
+    static double traction_limit(const models::VehicleParameters& p)
+    {
+        constexpr double g = 9.81;
+        const double mu = p.tire.p_dx1;
+        const double L = p.a + p.b;
+        const double front = p.T_se; // engine torque split, as in vehicle_dynamics_std
+        const double rear = 1.0 - p.T_se;
+        // m a <= mu m (front (g b - a h) + rear (g a + a h)) / L
+        const double denom = L - mu * p.h_s * (rear - front);
+        const double limit = denom > 0.0 ? mu * g * (front * p.b + rear * p.a) / denom : p.longitudinal.a_max;
+        return std::min(limit, p.longitudinal.a_max);
+    }
+
+    simulation::StdSimulator sim_;
+    double throttle_cap_;
+};
+
+struct EpisodeTotals {
+    std::uint64_t steps{};
+    std::uint64_t episodes{};
+    std::uint64_t laps{};           // laps completed without leaving the track
+    std::uint64_t off_track_laps{}; // laps completed after leaving the track
+    std::uint64_t off_track{};      // episodes that left the track at least once
+};
+
+/**
+ * Fixed-size uniform sample of a stream (Vitter's algorithm R): after n values each one is
+ * held with probability capacity / n, so the percentiles cover the whole run, not its start.
+ * Storage is reserved up front; add() does not allocate.
+ */
+class LatencyReservoir {
+public:
+    explicit LatencyReservoir(std::size_t capacity) : capacity_(std::max<std::size_t>(capacity, 1))
+    {
+        samples_.reserve(capacity_);
+    }
+
+    void add(double ns)
+    {
+        ++seen_;
+        if (samples_.size() < capacity_) {
+            samples_.push_back(ns);
+            return;
+        }
+        const std::uint64_t slot = std::uniform_int_distribution<std::uint64_t>(0, seen_ - 1)(rng_);
+        if (slot < capacity_) samples_[slot] = ns;
+    }
+
+    /// Sorts the sample in place; q in [0, 1].
+    double quantile(double q)
+    {
+        if (samples_.empty()) return 0.0;
+        std::sort(samples_.begin(), samples_.end());
+        const auto i = static_cast<std::size_t>(q * static_cast<double>(samples_.size()));
+        return samples_[std::min(samples_.size() - 1, i)];
+    }
+
+private:
+    std::size_t capacity_;
+    std::vector<double> samples_;
+    std::uint64_t seen_{0};
+    std::mt19937_64 rng_{0x5eed};
+};
+
+/**
+ * Engine, controller and the padded one-vehicle state columns BaselineBatch reads. Everything
+ * is built in the constructor, so run_episode() itself should not allocate.
+ */
+template <typename Engine>
+class Driver {
+public:
+    Driver(const models::VehicleParameters& params, double dt, std::shared_ptr<const track::ReferencePath> path,
+           const track::TrackIndex& track)
+        : engine_(params, dt)
+        , controller_(path, params, 1)
+        , track_(&track)
+        , path_(std::move(path))
+        , dt_(dt)
+        , x_(1), y_(1), psi_(1), v_(1), delta_(1), steer_(1), accel_(1)
+    {
+    }
+
+    /// Runs one episode; on_step(ns) receives the latency of every step when timed is true.
+    template <typename OnStep>
+    void run_episode(double max_time_s, EpisodeTotals& totals, bool timed, OnStep&& on_step)
+    {
+        engine_.reset(track_->start_pose());
+        controller_.reset_all();
+        const double length = path_->length();
+        const double goal = path_->closed() ? length : length - 2.0 * track::ReferencePathOptions{}.spacing;
+        const auto max_steps = static_cast<std::uint64_t>(max_time_s / dt_);
+        double progress = 0.0;
+        double prev_s = -1.0;
+        bool left_track = false;
+
+        for (std::uint64_t k = 0; k < max_steps; ++k) {
+            const Clock::time_point start = timed ? Clock::now() : Clock::time_point{};
+            x_[0] = engine_.x();
+            y_[0] = engine_.y();
+            psi_[0] = engine_.psi();
+            v_[0] = engine_.v();
+            delta_[0] = engine_.delta();
+            controller_.update(x_.data(), y_.data(), psi_.data(), v_.data(), delta_.data(), dt_,
+                               steer_.data(), accel_.data());
+            engine_.step(steer_[0], accel_[0]);
+            if (timed) on_step(std::chrono::duration<double, std::nano>(Clock::now() - start).count());
+            ++totals.steps;
+
+            // Arc-length progress of the controller's projection, unwrapped on closed paths.
+            const double s = controller_.path_s()[0];
+            if (prev_s >= 0.0) {
+                double ds = s - prev_s;
+                if (path_->closed()) {
+                    if (ds < -0.5 * length) ds += length;
+                    if (ds > 0.5 * length) ds -= length;
+                }
+                progress += ds;
+            }
+            prev_s = s;
+            left_track = left_track || !track_->on_track(engine_.x(), engine_.y());
+            if (progress >= goal) {
+                ++(left_track ? totals.off_track_laps : totals.laps);
+                break;
+            }
+        }
+        ++totals.episodes;
+        totals.off_track += left_track ? 1 : 0;
+    }
+
+private:
+    Engine engine_;
+    control::BaselineBatch controller_;
+    const track::TrackIndex* track_;
+    std::shared_ptr<const track::ReferencePath> path_;
+    double dt_;
+    simd::AlignedBuffer x_, y_, psi_, v_, delta_, steer_, accel_;
+};
+
+struct Result {
+    std::string name;
+    EpisodeTotals totals{};
+    double wall_s{};
+    std::uint64_t allocations{};
+    bool timed{false};
+    double p50_ns{};
+    double p99_ns{};
+    std::size_t threads{1};
+};
+
+double elapsed_s(Clock::time_point start)
+{
+    return std::chrono::duration<double>(Clock::now() - start).count();
+}
+
+template <typename Engine>
+Result run_single(const std::string& name, const Options& o, const models::VehicleParameters& params, double dt,
+                  const std::shared_ptr<const track::ReferencePath>& path, const track::TrackIndex& track)
+{
+    Driver<Engine> driver(params, dt, path, track);
+    LatencyReservoir latency(std::size_t{1} << 16);
+
+    Result r;
+    r.name = name;
+    r.timed = true;
+    // One untimed episode warms caches and any lazily built state.
+    EpisodeTotals warmup;
+    driver.run_episode(o.max_time_s, warmup, false, [](double) {});
+
+    const std::uint64_t allocations_before = g_allocations.load(std::memory_order_relaxed);
+    const Clock::time_point start = Clock::now();
+    do {
+        driver.run_episode(o.max_time_s, r.totals, true, [&](double ns) { latency.add(ns); });
+    } while (elapsed_s(start) < o.min_time_s);
+    r.wall_s = elapsed_s(start);
+    r.allocations = g_allocations.load(std::memory_order_relaxed) - allocations_before;
+
+    r.p50_ns = latency.quantile(0.5);
+    r.p99_ns = latency.quantile(0.99);
+    return r;
+}
+
+template <typename Engine>
+Result run_scaled(const std::string& name, const Options& o, const models::VehicleParameters& params, double dt,
+                  const std::shared_ptr<const track::ReferencePath>& path, const track::TrackIndex& track,
+                  std::size_t threads)
+{
+    std::vector<EpisodeTotals> totals(threads);
+    std::vector<std::thread> workers;
+    std::atomic<bool> go{false};
+    std::atomic<std::size_t> ready{0};
+    Clock::time_point start;
+
+    for (std::size_t t = 0; t < threads; ++t) {
+        workers.emplace_back([&, t] {
+            Driver<Engine> driver(params, dt, path, track);
+            ready.fetch_add(1);
+            while (!go.load(std::memory_order_acquire)) std::this_thread::yield();
+            do {
+                driver.run_episode(o.max_time_s, totals[t], false, [](double) {});
+            } while (elapsed_s(start) < o.min_time_s);
+        });
+    }
+    while (ready.load() < threads) std::this_thread::yield();
+    const std::uint64_t allocations_before = g_allocations.load(std::memory_order_relaxed);
+    start = Clock::now();
+    go.store(true, std::memory_order_release);
+    for (std::thread& w : workers) {
+        w.join();
+    }
+    const double wall = elapsed_s(start);
+
+    Result r;
+    r.name = name + "/threads:" + std::to_string(threads);
+    r.threads = threads;
+    r.wall_s = wall;
+    r.allocations = g_allocations.load(std::memory_order_relaxed) - allocations_before;
+    for (const EpisodeTotals& t : totals) {
+        r.totals.steps += t.steps;
+        r.totals.episodes += t.episodes;
+        r.totals.laps += t.laps;
+        r.totals.off_track_laps += t.off_track_laps;
+        r.totals.off_track += t.off_track;
+    }
+    return r;
+}
+
+template <typename Engine>
+void run_model(const std::string& model, const Options& o, const models::VehicleParameters& params, double dt,
+               const std::shared_ptr<const track::ReferencePath>& path, const track::TrackIndex& track,
+               const std::string& slug, std::vector<Result>& results)
+{
+    const std::string name = model + "/" + slug;
+    results.push_back(run_single<Engine>(name, o, params, dt, path, track));
+    for (std::size_t t = 1; t <= o.threads; t = (t == o.threads) ? t + 1 : std::min(t * 2, o.threads)) {
+        results.push_back(run_scaled<Engine>(name, o, params, dt, path, track, t));
+    }
+}
+
+std::vector<std::string> split(const std::string& list)
+{
+    std::vector<std::string> items;
+    std::stringstream in(list);
+    for (std::string item; std::getline(in, item, ',');) {
+        if (!item.empty()) items.push_back(item);
+    }
+    return items;
+}
+
+Options parse_options(int argc, char** argv)
+{
+    Options o;
+    for (int i = 1; i < argc; ++i) {
+        const std::string arg = argv[i];
+        auto value = [&]() -> std::string {
+            if (i + 1 >= argc) throw std::invalid_argument("Missing value for " + arg);
+            return argv[++i];
+        };
+        if (arg == "--tracks") {
+            o.tracks = value();
+        } else if (arg == "--root") {
+            o.root = value();
+        } else if (arg == "--vehicle") {
+            o.vehicle = std::atoi(value().c_str());
+        } else if (arg == "--models") {
+            o.models = split(value());
+        } else if (arg == "--st-dt") {
+            o.st_dt = std::atof(value().c_str());
+        } else if (arg == "--std-dt") {
+            o.std_dt = std::atof(value().c_str());
+        } else if (arg == "--max-time") {
+            o.max_time_s = std::atof(value().c_str());
+        } else if (arg == "--min-time") {
+            o.min_time_s = std::atof(value().c_str());
+        } else if (arg == "--threads") {
+            o.threads = static_cast<std::size_t>(std::max(1, std::atoi(value().c_str())));
+        } else if (arg == "--out") {
+            o.out = value();
+        } else {
+            throw std::invalid_argument("Unknown argument: " + arg);
+        }
+    }
+    if (o.threads == 0) {
+        o.threads = std::max<std::size_t>(1, std::thread::hardware_concurrency());
+    }
+    if (!(o.st_dt > 0.0) || !(o.std_dt > 0.0) || !(o.max_time_s > 0.0)) {
+        throw std::invalid_argument("--st-dt, --std-dt and --max-time must be positive");
+    }
+    for (const std::string& m : o.models) {
+        if (m != "st" && m != "std") throw std::invalid_argument("Unknown model: " + m);
+    }
+    return o;
+}
+
+std::string json_escape(const std::string& s)
+{
+    std::string out;
+    for (char c : s) {
+        if (c == '"' || c == '\\') out.push_back('\\');
+        out.push_back(c);
+    }
+    return out;
+}
+
+std::string to_json(const Options& o, const std::vector<Result>& results)
+{
+    std::ostringstream js;
+    const std::time_t now = std::time(nullptr);
+    char date[32];
+    std::strftime(date, sizeof(date), "%Y-%m-%dT%H:%M:%S", std::localtime(&now));
+
+    js << "{\n  \"context\": {\n"
+       << "    \"date\": \"" << date << "\",\n"
+       << "    \"executable\": \"throughput_benchmark\",\n"
+       << "    \"num_cpus\": " << std::thread::hardware_concurrency() << ",\n"
+       << "    \"vehicle_id\": " << o.vehicle << ",\n"
+       << "    \"st_dt\": " << o.st_dt << ",\n"
+       << "    \"std_dt\": " << o.std_dt << ",\n"
+       << "    \"max_threads\": " << o.threads << ",\n"
+#ifdef NDEBUG
+       << "    \"library_build_type\": \"release\"\n"
+#else
+       << "    \"library_build_type\": \"debug\"\n"
+#endif
+       << "  },\n  \"benchmarks\": [";
+    for (std::size_t i = 0; i < results.size(); ++i) {
+        const Result& r = results[i];
+        const double steps = static_cast<double>(std::max<std::uint64_t>(r.totals.steps, 1));
+        // Per-step wall time over all workers: the inverse of aggregate throughput.
+        const double ns_per_step = r.wall_s * 1e9 / steps;
+        js << (i ? "," : "") << "\n    {"
+           << "\"name\": \"" << json_escape(r.name) << "\", "
+           << "\"run_type\": \"iteration\", "
+           << "\"iterations\": " << r.totals.steps << ", "
+           << "\"real_time\": " << ns_per_step << ", "
+           << "\"cpu_time\": " << ns_per_step * static_cast<double>(r.threads) << ", "
+           << "\"time_unit\": \"ns\", "
+           << "\"threads\": " << r.threads << ", "
+           << "\"steps_per_second\": " << static_cast<double>(r.totals.steps) / r.wall_s << ", "
+           << "\"laps_per_second\": " << static_cast<double>(r.totals.laps) / r.wall_s << ", "
+           << "\"allocations_per_step\": " << static_cast<double>(r.allocations) / steps << ", "
+           << "\"episodes\": " << r.totals.episodes << ", "
+           << "\"laps\": " << r.totals.laps << ", "
+           << "\"off_track_laps\": " << r.totals.off_track_laps << ", "
+           << "\"off_track\": " << r.totals.off_track;
+        if (r.timed) {
+            js << ", \"p50_ns\": " << r.p50_ns << ", \"p99_ns\": " << r.p99_ns;
+        }
+        js << "}";
+    }
+    js << "\n  ]\n}\n";
+    return js.str();
+}
+
+} // anonymous namespace
+
+int main(int argc, char** argv)
+{
+    try {
+        const Options opt = parse_options(argc, argv);
+        const std::shared_ptr<const models::VehicleParameters> params =
+            models::cached_vehicle_parameters(opt.vehicle, opt.root);
+
+        std::vector<fs::path> csv;
+        for (const auto& entry : fs::directory_iterator(opt.tracks)) {
+            if (entry.is_regular_file() && entry.path().extension() == ".csv") csv.push_back(entry.path());
+        }
+        std::sort(csv.begin(), csv.end());
+        if (csv.empty()) {
+            throw std::runtime_error("No .csv tracks in " + opt.tracks);
+        }
+
+        std::vector<Result> results;
+        for (const fs::path& file : csv) {
+            const std::string slug = file.stem().string();
+            try {
+                const track::TrackIndex track =
+                    track::TrackIndex::from_csv(file.string(), {track::kPlaygroundTrackScale, 0.0, {}});
+                const auto path = track::cached_reference_path(track, *params);
+                for (const std::string& model : opt.models) {
+                    if (model == "st") {
+                        run_model<StEngine>(model, opt, *params, opt.st_dt, path, track, slug, results);
+                    } else {
+                        run_model<StdEngine>(model, opt, *params, opt.std_dt, path, track, slug, results);
+                    }
+                }
+            } catch (const std::exception& e) {
+                std::cerr << "throughput_benchmark: skipping " << slug << ": " << e.what() << '\n';
+            }
+        }
+
+        const std::string json = to_json(opt, results);
+        if (opt.out.empty()) {
+            std::cout << json;
+        } else {
+            std::ofstream(opt.out) << json;
+        }
+        return 0;
+    } catch (const std::exception& e) {
+        std::cerr << "throughput_benchmark: " << e.what() << '\n';
+        return 1;
+    }
+}
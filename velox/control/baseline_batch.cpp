@@ -0,0 +1,260 @@
+#include "baseline_batch.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+#include "simulation/st_batch.hpp"
+#include "telemetry/instrumentation.hpp"
+
+namespace velox::control {
+
+using namespace velox::simd;
+
+namespace {
+
+constexpr double kPi = 3.14159265358979323846;
+constexpr double kEpsilon = 1e-6; // kEpsilon in math.ts
+
+// clamp() in math.ts: non-finite values map to the lower bound
+double clamp_js(double x, double lo, double hi)
+{
+    if (!std::isfinite(x)) return lo;
+    return std::min(std::max(x, lo), hi);
+}
+
+VecD clamp_js(VecD x, VecD lo, VecD hi)
+{
+    return select(is_finite(x), min(max(x, lo), hi), lo);
+}
+
+// 1 - exp(-dt / tau) of lowPassTime(); 1 disables the filter
+double low_pass_alpha(double dt, double tau)
+{
+    if (!(tau > 0.0) || !(dt > 0.0)) return 1.0;
+    return std::clamp(1.0 - std::exp(-dt / std::max(tau, kEpsilon)), 0.0, 1.0);
+}
+
+} // anonymous namespace
+
+BaselineBatch::BaselineBatch(std::shared_ptr<const track::ReferencePath> path, const models::VehicleParameters& params,
+                             std::size_t count, const BaselineBatchConfig& config)
+    : path_(std::move(path))
+    , config_(config)
+    , count_(count)
+    , cursor_(count)
+    , s_(count), lateral_(count), lookahead_(count), target_x_(count), target_y_(count), raw_speed_(count)
+    , target_speed_(count), pid_i_(count), pid_prev_err_(count), pid_prev_d_(count), pid_prev_cmd_(count)
+    , heading_error_(count), steering_command_(count)
+{
+    if (!path_ || path_->size() < 2) {
+        throw std::invalid_argument("BaselineBatch requires a reference path with at least two samples");
+    }
+    const PurePursuitConfig& pp = config_.pursuit;
+    if (!(pp.min_lookahead > 0.0) || pp.max_lookahead < pp.min_lookahead) {
+        throw std::invalid_argument("BaselineBatch lookahead bounds must satisfy 0 < min <= max");
+    }
+
+    wheelbase_ = std::max(params.a + params.b, 1e-3);
+    steer_min_ = params.steering.min;
+    steer_max_ = params.steering.max;
+    rate_min_  = params.steering.v_min;
+    rate_max_  = params.steering.v_max;
+    accel_max_ = std::max(params.longitudinal.a_max, 1e-3);
+    accel_min_ = -accel_max_;
+
+    const SpeedPidConfig& pid = config_.pid;
+    jerk_max_       = std::isnan(pid.jerk_max) ? params.longitudinal.j_max : pid.jerk_max;
+    integrator_min_ = std::isnan(pid.integrator_min) ? accel_min_ : pid.integrator_min;
+    integrator_max_ = std::isnan(pid.integrator_max) ? accel_max_ : pid.integrator_max;
+    tau_d_          = pid.derivative_filter_hz > 0.0 ? 1.0 / (2.0 * kPi * pid.derivative_filter_hz) : 0.0;
+
+    build_preview_curvature();
+}
+
+void BaselineBatch::build_preview_curvature()
+{
+    // Max |curvature| over the samples from i up to the first one at least preview_distance
+    // ahead (wrapping on closed paths). The sample past the window bounds the interpolated
+    // value at the window end, so max(window[a], window[a + 1]) covers any start on segment a.
+    const track::ReferencePath& path = *path_;
+    const std::vector<double>& s = path.s();
+    const std::vector<double>& k = path.curvature();
+    const std::size_t n = path.size();
+    const std::size_t period = path.closed() ? n - 1 : n;
+    const double preview = std::max(config_.speed.preview_distance, 0.0);
+
+    preview_curvature_.assign(n, 0.0);
+    for (std::size_t i = 0; i < n; ++i) {
+        double best = std::abs(k[i]);
+        double lap = 0.0;
+        std::size_t j = i;
+        for (std::size_t steps = 0; steps < period; ++steps) {
+            if (s[j] + lap - s[i] >= preview) break;
+            if (++j == n) {
+                if (!path.closed()) break;
+                j = 1; // sample n - 1 repeats sample 0
+                lap += path.length();
+            }
+            best = std::max(best, std::abs(k[j]));
+        }
+        preview_curvature_[i] = best;
+    }
+}
+
+double BaselineBatch::preview_curvature(std::size_t segment) const
+{
+    return std::max(preview_curvature_[segment], preview_curvature_[segment + 1]);
+}
+
+void BaselineBatch::reset(std::size_t i, double initial_command)
+{
+    if (i >= count_) {
+        throw std::out_of_range("BaselineBatch::reset index out of range");
+    }
+    cursor_[i] = {};
+    // TargetSpeedPlanner::reset(0) and SpeedPid::reset(initial_command)
+    target_speed_[i] = 0.0;
+    pid_i_[i] = 0.0;
+    pid_prev_err_[i] = 0.0;
+    pid_prev_d_[i] = 0.0;
+    pid_prev_cmd_[i] = initial_command;
+}
+
+void BaselineBatch::reset_all(double initial_command)
+{
+    for (std::size_t i = 0; i < count_; ++i) {
+        reset(i, initial_command);
+    }
+}
+
+void BaselineBatch::update(simulation::StBatch& batch, double dt)
+{
+    if (batch.size() != count_) {
+        throw std::invalid_argument("BaselineBatch and StBatch sizes differ");
+    }
+    update(batch.x(), batch.y(), batch.psi(), batch.v(), batch.delta(), dt,
+           batch.control_steer_rate(), batch.control_accel());
+}
+
+void BaselineBatch::update(const double* x, const double* y, const double* psi, const double* v,
+                           const double* delta, double dt, double* steer_rate, double* accel)
+{
+    if (!(dt > 0.0)) {
+        throw std::invalid_argument("BaselineBatch control period must be positive");
+    }
+    VELOX_TIME_SCOPE(telemetry::Stage::Controller);
+    const track::ReferencePath& path = *path_;
+    const track::SpeedLimits& limits = path.limits();
+    const PurePursuitConfig& pp = config_.pursuit;
+    const bool use_profile = config_.speed.source == TargetSpeedSource::Profile;
+
+    // Pass 1: projection, lookahead target and raw speed limit per vehicle.
+    for (std::size_t i = 0; i < count_; ++i) {
+        const track::PathProjection p = path.project(x[i], y[i], cursor_[i]);
+        const double lookahead = clamp_js(pp.base_lookahead + pp.lookahead_gain * std::max(v[i], 0.0),
+                                          pp.min_lookahead, pp.max_lookahead);
+        const track::PathSample target = path.sample(p.s + lookahead);
+        s_[i] = p.s;
+        lateral_[i] = p.lateral;
+        lookahead_[i] = lookahead;
+        target_x_[i] = target.x;
+        target_y_[i] = target.y;
+        if (use_profile) {
+            raw_speed_[i] = path.sample(p.s).speed;
+        } else {
+            const double kappa = preview_curvature(p.segment);
+            raw_speed_[i] = std::sqrt(limits.lat_accel / (kappa + limits.curvature_epsilon));
+        }
+    }
+
+    // Pass 2: steering law, speed filter and PID, kWidth vehicles at a time.
+    const VecD zero = broadcast(0.0);
+    const VecD h = broadcast(dt);
+    const VecD inv_dt = broadcast(1.0 / std::max(dt, 1e-3));
+    const VecD wheelbase = broadcast(wheelbase_);
+    const VecD steer_min = broadcast(steer_min_);
+    const VecD steer_max = broadcast(steer_max_);
+    const VecD rate_min = broadcast(rate_min_);
+    const VecD rate_max = broadcast(rate_max_);
+    const double rate_abs = std::max(std::abs(rate_max_), std::abs(rate_min_));
+    const VecD rate_step = broadcast(rate_abs * std::max(dt, kEpsilon));
+    const VecD min_speed = broadcast(limits.min_speed);
+    const VecD max_speed = broadcast(limits.max_speed);
+    const double speed_alpha_s = low_pass_alpha(dt, config_.speed.smoothing_time_constant);
+    const VecD speed_alpha = broadcast(speed_alpha_s);
+    const VecD kp = broadcast(config_.pid.kp);
+    const VecD ki_dt = broadcast(config_.pid.ki * dt);
+    const VecD kd = broadcast(config_.pid.kd);
+    const double d_alpha_s = tau_d_ > 0.0 ? low_pass_alpha(dt, tau_d_) : 1.0;
+    const VecD d_alpha = broadcast(d_alpha_s);
+    const VecD i_min = broadcast(integrator_min_);
+    const VecD i_max = broadcast(integrator_max_);
+    const VecD a_min = broadcast(accel_min_);
+    const VecD a_max = broadcast(accel_max_);
+    const bool jerk_limited = jerk_max_ > 0.0;
+    const VecD jerk_step = broadcast(jerk_max_ * dt);
+
+    const std::size_t padded = s_.size();
+    for (std::size_t i = 0; i < padded; i += kWidth) {
+        const VecD px = load(x + i);
+        const VecD py = load(y + i);
+        const VecD yaw = load(psi + i);
+        const VecD speed = load(v + i);
+        const VecD angle = load(delta + i);
+        const VecD lookahead = load(lookahead_.data() + i);
+
+        // PurePursuitController::update; heading error from the target direction in the body
+        // frame, which is already wrapped to (-pi, pi]
+        VecD sin_yaw, cos_yaw;
+        sincos(yaw, sin_yaw, cos_yaw);
+        const VecD dx = load(target_x_.data() + i) - px;
+        const VecD dy = load(target_y_.data() + i) - py;
+        const VecD cross = cos_yaw * dy - sin_yaw * dx;
+        const VecD along = cos_yaw * dx + sin_yaw * dy;
+        const VecD heading_error = atan2(cross, along);
+        const VecD dist = sqrt(dx * dx + dy * dy);
+        const VecD sin_error = select(dist > zero, cross / select(dist > zero, dist, broadcast(1.0)), zero);
+        const VecD curvature = broadcast(2.0) * sin_error / max(lookahead, broadcast(1e-3));
+
+        const VecD command = clamp_js(atan(wheelbase * curvature), steer_min, steer_max);
+        const VecD rate = clamp_js((command - angle) * inv_dt, rate_min, rate_max);
+        const VecD next = angle + clamp_js(rate * h, -rate_step, rate_step);
+        const VecD final_rate = clamp_js((next - angle) * inv_dt, rate_min, rate_max);
+
+        // TargetSpeedPlanner::update
+        const VecD limit = clamp_js(load(raw_speed_.data() + i), min_speed, max_speed);
+        VecD target = limit;
+        if (speed_alpha_s < 1.0) {
+            const VecD last = load(target_speed_.data() + i);
+            target = fma(limit - last, speed_alpha, last);
+        }
+
+        // SpeedPid::update
+        const VecD error = target - speed;
+        const VecD integral = clamp_js(fma(ki_dt, error, load(pid_i_.data() + i)), i_min, i_max);
+        const VecD raw_d = (error - load(pid_prev_err_.data() + i)) / h;
+        VecD d_filtered = raw_d;
+        if (d_alpha_s < 1.0) {
+            const VecD prev_d = load(pid_prev_d_.data() + i);
+            d_filtered = fma(raw_d - prev_d, d_alpha, prev_d);
+        }
+        VecD cmd = clamp_js(kp * error + integral + kd * d_filtered, a_min, a_max);
+        if (jerk_limited) {
+            const VecD prev_cmd = load(pid_prev_cmd_.data() + i);
+            cmd = prev_cmd + clamp_js(cmd - prev_cmd, -jerk_step, jerk_step);
+        }
+
+        store(steer_rate + i, final_rate);
+        store(accel + i, cmd);
+        store(heading_error_.data() + i, heading_error);
+        store(steering_command_.data() + i, command);
+        store(target_speed_.data() + i, target);
+        store(pid_i_.data() + i, integral);
+        store(pid_prev_err_.data() + i, error);
+        store(pid_prev_d_.data() + i, d_filtered);
+        store(pid_prev_cmd_.data() + i, cmd);
+    }
+}
+
+} // namespace velox::control
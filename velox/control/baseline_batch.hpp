@@ -0,0 +1,137 @@
+#pragma once
+
+#include <cstddef>
+#include <limits>
+#include <memory>
+#include <vector>
+
+#include "simulation/simd.hpp"
+#include "track/reference_path.hpp"
+#include "vehicle_parameters.hpp"
+
+namespace velox::simulation {
+class StBatch;
+}
+
+namespace velox::control {
+
+/** PurePursuitConfig in controllers/baseline/purePursuit.ts, BaselineController defaults. */
+struct PurePursuitConfig {
+    double base_lookahead = 2.0;  // [m]
+    double lookahead_gain = 0.25; // [s], lookahead grows with speed
+    double min_lookahead = 0.6;   // [m]
+    double max_lookahead = 18.0;  // [m]
+};
+
+enum class TargetSpeedSource {
+    Preview,  // TargetSpeedPlanner: curvature limit of the sharpest point within preview_distance
+    Profile,  // ReferencePath::speed(), the braking-aware forward/backward profile
+};
+
+/** TargetSpeedConfig in speedProfile.ts; mu, risk and speed bounds come from the path limits. */
+struct TargetSpeedConfig {
+    TargetSpeedSource source = TargetSpeedSource::Preview;
+    double preview_distance = 12.0;       // [m]
+    double smoothing_time_constant = 0.4; // [s], 0 disables the low-pass
+};
+
+/**
+ * PidConfig in speedPid.ts. The command limits are +-longitudinal.a_max; NaN integrator bounds
+ * take the command limits and a NaN jerk_max takes longitudinal.j_max, as BaselineController
+ * does.
+ */
+struct SpeedPidConfig {
+    double kp = 1.2;
+    double ki = 0.35;
+    double kd = 0.05;
+    double derivative_filter_hz = 5.0; // 0 disables the derivative filter
+    double integrator_min = std::numeric_limits<double>::quiet_NaN();
+    double integrator_max = std::numeric_limits<double>::quiet_NaN();
+    double jerk_max = std::numeric_limits<double>::quiet_NaN(); // [m/s^3], 0 disables the limit
+};
+
+struct BaselineBatchConfig {
+    PurePursuitConfig pursuit{};
+    TargetSpeedConfig speed{};
+    SpeedPidConfig pid{};
+};
+
+/**
+ * BaselineBatch
+ *
+ * The baseline controller (pure pursuit + target-speed planner + speed PID, as in
+ * controllers/baseline/) for N vehicles against one shared ReferencePath. update() runs in two
+ * passes over the batch columns:
+ *
+ *   1. per vehicle, projection with a warm-started Cursor (O(1) per step), the lookahead target
+ *      point and the preview curvature; these are table lookups and stay scalar;
+ *   2. the pure-pursuit steering law, rate limits, target-speed filter and PID written once
+ *      against velox::simd, kWidth vehicles at a time.
+ *
+ * The preview curvature is read from a per-sample window maximum built once with the batch, so
+ * it bounds the planner's sampled maximum from above by at most one path spacing. Transcendentals
+ * are the simd.hpp kernels; commands agree with the scalar controller to a few ulp.
+ *
+ * Columns follow StBatch: arrays hold simd::AlignedBuffer::padded(size()) doubles and padding
+ * lanes are ignored.
+ */
+class BaselineBatch {
+public:
+    /// Vehicle parameters are copied into scalar limits; path is shared.
+    BaselineBatch(std::shared_ptr<const track::ReferencePath> path, const models::VehicleParameters& params,
+                  std::size_t count, const BaselineBatchConfig& config = {});
+
+    std::size_t size() const { return count_; }
+    const track::ReferencePath& path() const { return *path_; }
+
+    /// Clears controller i (PID memory, target-speed filter, projection cursor).
+    void reset(std::size_t i, double initial_command = 0.0);
+    void reset_all(double initial_command = 0.0);
+
+    /**
+     * Computes [steering rate, acceleration] for every vehicle from state columns laid out like
+     * StBatch (x, y, psi, v, delta) with control period dt. Throws std::invalid_argument for a
+     * non-positive dt.
+     */
+    void update(const double* x, const double* y, const double* psi, const double* v, const double* delta,
+                double dt, double* steer_rate, double* accel);
+
+    /// Reads the state columns of batch and writes its control columns; sizes must match.
+    void update(simulation::StBatch& batch, double dt);
+
+    // Diagnostics of the last update(), index = vehicle.
+    const double* path_s() const         { return s_.data(); }
+    const double* lateral_error() const  { return lateral_.data(); }
+    const double* lookahead() const      { return lookahead_.data(); }
+    const double* heading_error() const  { return heading_error_.data(); }
+    const double* steering_command() const { return steering_command_.data(); }
+    const double* target_speed() const   { return target_speed_.data(); }
+    const double* speed_error() const    { return pid_prev_err_.data(); }
+
+private:
+    void build_preview_curvature();
+    double preview_curvature(std::size_t segment) const;
+
+    std::shared_ptr<const track::ReferencePath> path_;
+    BaselineBatchConfig config_;
+    std::size_t count_;
+
+    // scalar vehicle limits
+    double wheelbase_;
+    double steer_min_, steer_max_, rate_min_, rate_max_;
+    double accel_min_, accel_max_, jerk_max_;
+    double integrator_min_, integrator_max_;
+    double tau_d_;
+
+    std::vector<double> preview_curvature_; // per path sample
+    std::vector<track::ReferencePath::Cursor> cursor_;
+
+    // pass-1 outputs
+    simd::AlignedBuffer s_, lateral_, lookahead_, target_x_, target_y_, raw_speed_;
+    // controller memory
+    simd::AlignedBuffer target_speed_, pid_i_, pid_prev_err_, pid_prev_d_, pid_prev_cmd_;
+    // diagnostics
+    simd::AlignedBuffer heading_error_, steering_command_;
+};
+
+} // namespace velox::control
@@ -41,7 +41,15 @@ function parseScalar(value: string): number | boolean | string {
   return value;
 }
 
-function parseYamlLike(document: string): Record<string, unknown> {
+/** Turns a YAML document into nested records of scalars; see ConfigManager's yamlParser. */
+export type YamlDocumentParser = (document: string) => Record<string, unknown>;
+
+/**
+ * Line-based YAML-subset parser used when no native module is loaded. The native reader
+ * (yaml_subset.hpp, reached through nativeYamlParser) is the reference: it also strips quotes and
+ * rejects sequences, flow collections and tabs, which this one passes through or skips.
+ */
+export function parseYamlLike(document: string): Record<string, unknown> {
   const result: Record<string, unknown> = {};
   const lines = document
     .split(/\r?\n/)
@@ -114,9 +122,20 @@ export class ConfigManager {
   readonly configRoot: string;
   readonly parameterRoot: string;
   private readonly fetcher: Fetcher;
+  private readonly yamlParser?: YamlDocumentParser | Promise<YamlDocumentParser | undefined>;
   private rootsChecked = false;
 
-  constructor(configRoot?: string, parameterRoot: string = 'parameters', fetcher?: Fetcher) {
+  /**
+   * yamlParser replaces parseYamlLike for YAML documents; pass nativeYamlParser(module) so that
+   * TS and the native engine read a bundle through the same parser. A parser that resolves to
+   * undefined (module without velox_yaml_flatten) falls back to parseYamlLike.
+   */
+  constructor(
+    configRoot?: string,
+    parameterRoot: string = 'parameters',
+    fetcher?: Fetcher,
+    yamlParser?: YamlDocumentParser | Promise<YamlDocumentParser | undefined>,
+  ) {
     this.fetcher = fetcher ?? (typeof fetch !== 'undefined' ? fetch.bind(globalThis) : undefined as unknown as Fetcher);
     if (!this.fetcher) {
       throw new Error('A fetch-compatible API is required to load configuration assets.');
@@ -126,6 +145,7 @@ export class ConfigManager {
     const derivedConfig = withTrailingSlash(configRoot ?? siblingConfigRoot(paramRoot));
     this.parameterRoot = paramRoot;
     this.configRoot = derivedConfig;
+    this.yamlParser = yamlParser;
   }
 
   async verifyRoots(): Promise<void> {
@@ -138,7 +158,7 @@ export class ConfigManager {
   async loadSingleTrackParameters(path = 'st/vehicle.yaml'): Promise<SingleTrackParameters> {
     await this.verifyRoots();
     const document = await this.fetchDocument(this.resolveParameterPath(path), 'single-track parameters');
-    const parsed = this.parseDocument(document);
+    const parsed = await this.parseDocument(document);
     return normalizeSingleTrack(parsed);
   }
 
@@ -155,9 +175,9 @@ export class ConfigManager {
     const overridePath = this.resolveConfigPath(overrideName);
     const fallback = this.resolveConfigPath('low_speed_safety.yaml');
     try {
-      return this.parseDocument(await this.fetchDocument(overridePath, `low speed safety config (${suffix})`));
+      return await this.parseDocument(await this.fetchDocument(overridePath, `low speed safety config (${suffix})`));
     } catch (error) {
-      return this.parseDocument(await this.fetchDocument(fallback, 'low speed safety config (default)'));
+      return await this.parseDocument(await this.fetchDocument(fallback, 'low speed safety config (default)'));
     }
   }
 
@@ -169,7 +189,7 @@ export class ConfigManager {
     const path = this.resolveConfigPath('model_timing.yaml');
     try {
       const document = await this.fetchDocument(path, 'model timing');
-      const parsed = this.parseDocument(document);
+      const parsed = await this.parseDocument(document);
       const modelSection = parsed[modelKey(model)];
       if (modelSection && typeof modelSection === 'object') {
         const section = modelSection as Record<string, unknown>;
@@ -224,10 +244,11 @@ export class ConfigManager {
     return body;
   }
 
-  private parseDocument(document: unknown): Record<string, unknown> {
+  private async parseDocument(document: unknown): Promise<Record<string, unknown>> {
     if (typeof document === 'string') {
+      const parse = (await this.yamlParser) ?? parseYamlLike;
       try {
-        return parseYamlLike(document);
+        return parse(document);
       } catch (error) {
         throw new Error(`Failed to parse YAML: ${error}`);
       }
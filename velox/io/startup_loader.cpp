@@ -0,0 +1,276 @@
+#include "startup_loader.hpp"
+
+#include <algorithm>
+#include <charconv>
+#include <filesystem>
+#include <stdexcept>
+#include <string_view>
+
+#include "vehicle_parameter_cache.hpp"
+
+namespace fs = std::filesystem;
+
+namespace velox::io {
+
+namespace {
+
+// "parameters_vehicle12.yaml" -> 12, anything else -> -1 (same rule as load_vehicle_catalog)
+int vehicle_id_from_name(const std::string& name)
+{
+    constexpr std::string_view prefix = "parameters_vehicle";
+    constexpr std::string_view suffix = ".yaml";
+    if (name.size() <= prefix.size() + suffix.size() ||
+        name.compare(0, prefix.size(), prefix) != 0 ||
+        name.compare(name.size() - suffix.size(), suffix.size(), suffix) != 0) {
+        return -1;
+    }
+    // Digits only; a run too long for int (from_chars reports out of range) is skipped too.
+    const char* first = name.data() + prefix.size();
+    const char* last = name.data() + name.size() - suffix.size();
+    int id = -1;
+    const auto [end, ec] = std::from_chars(first, last, id);
+    if (ec != std::errc{} || end != last || *first == '-' || *first == '+') {
+        return -1;
+    }
+    return id;
+}
+
+std::vector<int> list_vehicles(const std::string& dir_params)
+{
+    const fs::path vehicle_dir = models::parameter_root(dir_params) / "vehicle";
+    if (!fs::is_directory(vehicle_dir)) {
+        throw std::runtime_error("Vehicle parameter directory not found: " + vehicle_dir.string());
+    }
+    std::vector<int> ids;
+    for (const auto& dirent : fs::directory_iterator(vehicle_dir)) {
+        if (!dirent.is_regular_file()) continue;
+        const int id = vehicle_id_from_name(dirent.path().filename().string());
+        if (id >= 0) ids.push_back(id);
+    }
+    std::sort(ids.begin(), ids.end());
+    return ids;
+}
+
+std::vector<std::string> list_tracks(const std::string& dir_tracks)
+{
+    if (!fs::is_directory(dir_tracks)) {
+        throw std::runtime_error("Track directory not found: " + dir_tracks);
+    }
+    std::vector<std::string> slugs;
+    for (const auto& dirent : fs::directory_iterator(dir_tracks)) {
+        if (dirent.is_regular_file() && dirent.path().extension() == ".csv") {
+            slugs.push_back(dirent.path().stem().string());
+        }
+    }
+    std::sort(slugs.begin(), slugs.end());
+    return slugs;
+}
+
+// Moves the selected item (if present) to the front so it is queued first.
+template <typename T>
+void prioritise(std::vector<T>& items, const std::optional<T>& selected)
+{
+    if (!selected) return;
+    auto it = std::find(items.begin(), items.end(), *selected);
+    if (it != items.end()) std::rotate(items.begin(), it, it + 1);
+}
+
+} // anonymous namespace
+
+StartupLoader::StartupLoader(StartupLoadRequest request)
+    : request_(std::move(request))
+{
+    std::vector<int> ids = request_.vehicle_ids.empty() ? list_vehicles(request_.dir_params) : request_.vehicle_ids;
+    std::vector<std::string> slugs = request_.tracks.empty() ? list_tracks(request_.dir_tracks) : request_.tracks;
+    prioritise(ids, request_.selected_vehicle);
+    prioritise(slugs, request_.selected_track);
+
+    // Selected vehicle, the per-model configs, its bundles and the selected track first; then
+    // every other vehicle before its bundles, so no bundle task is dequeued ahead of the
+    // vehicle or configs it waits for.
+    std::size_t first_vehicles = 0;
+    if (!ids.empty() && request_.selected_vehicle && ids.front() == *request_.selected_vehicle) {
+        enqueue_vehicle(ids.front());
+        enqueue_model_configs();
+        enqueue_bundles(ids.front());
+        first_vehicles = 1;
+    } else if (!ids.empty()) {
+        enqueue_model_configs();
+    }
+    std::size_t first_tracks = 0;
+    if (!slugs.empty() && request_.selected_track && slugs.front() == *request_.selected_track) {
+        enqueue_track(slugs.front());
+        first_tracks = 1;
+    }
+    for (std::size_t i = first_vehicles; i < ids.size(); ++i) {
+        enqueue_vehicle(ids[i]);
+    }
+    for (std::size_t i = first_tracks; i < slugs.size(); ++i) {
+        enqueue_track(slugs[i]);
+    }
+    for (std::size_t i = first_vehicles; i < ids.size(); ++i) {
+        enqueue_bundles(ids[i]);
+    }
+
+    std::size_t threads = request_.threads;
+    if (threads == 0) {
+        threads = std::max<std::size_t>(1, std::thread::hardware_concurrency());
+    }
+    threads = std::min(threads, std::max<std::size_t>(1, queue_.size()));
+    threads_.reserve(threads);
+    for (std::size_t t = 0; t < threads; ++t) {
+        threads_.emplace_back([this] { worker_loop(); });
+    }
+}
+
+StartupLoader::~StartupLoader()
+{
+    {
+        std::lock_guard lock(mutex_);
+        stopping_ = true;
+    }
+    work_cv_.notify_all();
+    for (std::thread& t : threads_) {
+        t.join();
+    }
+}
+
+void StartupLoader::enqueue_vehicle(int vehicle_id)
+{
+    if (vehicles_.count(vehicle_id)) return;
+    auto promise = std::make_shared<std::promise<std::shared_ptr<const models::VehicleParameters>>>();
+    vehicles_.emplace(vehicle_id, promise->get_future().share());
+    enqueue([promise, vehicle_id, dir = request_.dir_params] {
+        try {
+            promise->set_value(models::cached_vehicle_parameters(vehicle_id, dir));
+        } catch (...) {
+            promise->set_exception(std::current_exception());
+        }
+    });
+}
+
+void StartupLoader::enqueue_model_configs()
+{
+    for (const models::VehicleModel model : request_.models) {
+        if (configs_.count(model)) continue;
+        auto promise = std::make_shared<std::promise<std::shared_ptr<const models::ConfigBundle>>>();
+        configs_.emplace(model, promise->get_future().share());
+        enqueue([promise, model, dir_params = request_.dir_params, dir_config = request_.dir_config] {
+            try {
+                promise->set_value(models::load_model_configs(model, dir_params, dir_config));
+            } catch (...) {
+                promise->set_exception(std::current_exception());
+            }
+        });
+    }
+}
+
+void StartupLoader::enqueue_bundles(int vehicle_id)
+{
+    const VehicleFuture vehicle = vehicles_.at(vehicle_id);
+    for (const models::VehicleModel model : request_.models) {
+        const auto key = std::make_pair(vehicle_id, model);
+        if (bundles_.count(key)) continue;
+        auto promise = std::make_shared<std::promise<std::shared_ptr<const models::ConfigBundle>>>();
+        bundles_.emplace(key, promise->get_future().share());
+        enqueue([promise, vehicle, configs = configs_.at(model), vehicle_id, dir_params = request_.dir_params] {
+            try {
+                vehicle.get(); // rethrows the vehicle's load error; otherwise the cache now holds it
+                promise->set_value(models::make_config_bundle(vehicle_id, *configs.get(), dir_params));
+            } catch (...) {
+                promise->set_exception(std::current_exception());
+            }
+        });
+    }
+}
+
+void StartupLoader::enqueue_track(const std::string& slug)
+{
+    if (tracks_.count(slug)) return;
+    auto promise = std::make_shared<std::promise<std::shared_ptr<const track::TrackIndex>>>();
+    tracks_.emplace(slug, promise->get_future().share());
+    const std::string path = (fs::path(request_.dir_tracks) / (slug + ".csv")).string();
+    enqueue([promise, path, options = request_.track_options] {
+        try {
+            promise->set_value(std::make_shared<const track::TrackIndex>(track::TrackIndex::from_csv(path, options)));
+        } catch (...) {
+            promise->set_exception(std::current_exception());
+        }
+    });
+}
+
+void StartupLoader::enqueue(std::function<void()> task)
+{
+    std::lock_guard lock(mutex_);
+    queue_.push_back(std::move(task));
+    ++unfinished_;
+}
+
+void StartupLoader::worker_loop()
+{
+    for (;;) {
+        std::function<void()> task;
+        {
+            std::unique_lock lock(mutex_);
+            work_cv_.wait(lock, [this] { return stopping_ || !queue_.empty(); });
+            if (queue_.empty()) return; // stopping, and every queued load has been taken
+            task = std::move(queue_.front());
+            queue_.pop_front();
+        }
+        task(); // never throws: failures go into the task's promise
+        {
+            std::lock_guard lock(mutex_);
+            if (--unfinished_ == 0) idle_cv_.notify_all();
+        }
+    }
+}
+
+void StartupLoader::wait()
+{
+    std::unique_lock lock(mutex_);
+    idle_cv_.wait(lock, [this] { return unfinished_ == 0; });
+}
+
+StartupLoader::VehicleFuture StartupLoader::vehicle(int vehicle_id) const
+{
+    auto it = vehicles_.find(vehicle_id);
+    if (it == vehicles_.end()) {
+        throw std::out_of_range("StartupLoader: vehicle " + std::to_string(vehicle_id) + " was not requested");
+    }
+    return it->second;
+}
+
+StartupLoader::BundleFuture StartupLoader::bundle(int vehicle_id, models::VehicleModel model) const
+{
+    auto it = bundles_.find({vehicle_id, model});
+    if (it == bundles_.end()) {
+        throw std::out_of_range("StartupLoader: no " + std::string(models::vehicle_model_key(model)) +
+                                " bundle for vehicle " + std::to_string(vehicle_id) + " was requested");
+    }
+    return it->second;
+}
+
+StartupLoader::TrackFuture StartupLoader::track(const std::string& slug) const
+{
+    auto it = tracks_.find(slug);
+    if (it == tracks_.end()) {
+        throw std::out_of_range("StartupLoader: track '" + slug + "' was not requested");
+    }
+    return it->second;
+}
+
+std::vector<int> StartupLoader::vehicle_ids() const
+{
+    std::vector<int> ids;
+    for (const auto& [id, future] : vehicles_) ids.push_back(id);
+    return ids;
+}
+
+std::vector<std::string> StartupLoader::track_names() const
+{
+    std::vector<std::string> names;
+    for (const auto& [slug, future] : tracks_) names.push_back(slug);
+    return names;
+}
+
+} // namespace velox::io
@@ -0,0 +1,109 @@
+#pragma once
+
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <future>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "config_bundle.hpp"
+#include "track/track_index.hpp"
+
+namespace velox::io {
+
+struct StartupLoadRequest {
+    std::string dir_params;              // same semantics as setup_vehicle_parameters
+    std::string dir_config;              // empty: config_root(dir_params)
+    std::string dir_tracks = "tracks";
+    std::vector<int> vehicle_ids;        // empty: every vehicle/parameters_vehicleN.yaml
+    std::vector<std::string> tracks;     // slugs (CSV stems); empty: every *.csv in dir_tracks
+    std::vector<models::VehicleModel> models{models::VehicleModel::St}; // bundles per vehicle
+    track::TrackBuildOptions track_options{track::kPlaygroundTrackScale, 0.0, {}};
+
+    /// Loaded ahead of everything else so the first step does not wait for the rest.
+    std::optional<int> selected_vehicle;
+    std::optional<std::string> selected_track;
+
+    std::size_t threads = 0; // 0 uses std::thread::hardware_concurrency()
+};
+
+/**
+ * StartupLoader
+ *
+ * Native counterpart of loadVeloxBundle (app/playground/loadVelox.ts): every vehicle parameter
+ * set, ConfigBundle and track the request names is queued on a small thread pool as soon as the
+ * loader is constructed, and each is handed out as a shared_future. Each task reads and parses
+ * its own file(s), so one file's YAML or CSV parse overlaps the reads of the others, and a
+ * caller waits only for what it asks for: the selected vehicle, its bundles and the selected
+ * track are queued first, so a simulation can step while the remaining tracks still load.
+ *
+ * Vehicles go through cached_vehicle_parameters, so later lookups anywhere in the process hit
+ * the parameter cache. The config/ documents are read once per model (load_model_configs) and
+ * shared: each bundle waits for its vehicle's and its model's futures and only combines the
+ * two (make_config_bundle), so nothing is parsed twice.
+ * Load errors are delivered through the corresponding future (get() rethrows them) and never
+ * stop the other tasks.
+ *
+ * The destructor finishes every queued task before joining, so outstanding futures are always
+ * satisfied.
+ */
+class StartupLoader {
+public:
+    using VehicleFuture = std::shared_future<std::shared_ptr<const models::VehicleParameters>>;
+    using BundleFuture  = std::shared_future<std::shared_ptr<const models::ConfigBundle>>;
+    using TrackFuture   = std::shared_future<std::shared_ptr<const track::TrackIndex>>;
+
+    /// Lists the directories and queues every load. Throws std::runtime_error for a missing
+    /// vehicle or track directory when the request leaves the corresponding list empty.
+    explicit StartupLoader(StartupLoadRequest request);
+    ~StartupLoader();
+
+    StartupLoader(const StartupLoader&) = delete;
+    StartupLoader& operator=(const StartupLoader&) = delete;
+
+    /// Futures of requested items; throw std::out_of_range for anything the request did not name.
+    VehicleFuture vehicle(int vehicle_id) const;
+    BundleFuture bundle(int vehicle_id, models::VehicleModel model) const;
+    TrackFuture track(const std::string& slug) const;
+
+    /// Requested vehicle ids and track slugs, sorted.
+    std::vector<int> vehicle_ids() const;
+    std::vector<std::string> track_names() const;
+
+    /// Blocks until every queued load has finished (successfully or not).
+    void wait();
+
+    std::size_t thread_count() const { return threads_.size(); }
+
+private:
+    void enqueue_vehicle(int vehicle_id);
+    void enqueue_model_configs();
+    void enqueue_bundles(int vehicle_id);
+    void enqueue_track(const std::string& slug);
+    void enqueue(std::function<void()> task);
+    void worker_loop();
+
+    StartupLoadRequest request_;
+    std::map<int, VehicleFuture> vehicles_;
+    std::map<std::pair<int, models::VehicleModel>, BundleFuture> bundles_;
+    std::map<models::VehicleModel, BundleFuture> configs_; // vehicle-independent part per model
+    std::map<std::string, TrackFuture> tracks_;
+
+    std::mutex mutex_;
+    std::condition_variable work_cv_;
+    std::condition_variable idle_cv_;
+    std::deque<std::function<void()>> queue_; // FIFO: a task never waits on one queued after it
+    std::size_t unfinished_{0};               // guarded by mutex_
+    bool stopping_{false};                    // guarded by mutex_
+    std::vector<std::thread> threads_;
+};
+
+} // namespace velox::io
@@ -0,0 +1,52 @@
+#include "single_track_parameters.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+#include <string>
+
+#include "vehicle_dynamics_st.hpp"
+
+namespace velox::models {
+
+SingleTrackParameters single_track_parameters_from_values(const double* values, std::size_t count)
+{
+    if (!values || count != kSingleTrackParameterCount) {
+        throw std::invalid_argument("expected " + std::to_string(kSingleTrackParameterCount) +
+                                    " single-track parameter values, got " + std::to_string(count));
+    }
+    SingleTrackParameters p;
+    p.l_f = values[0];
+    p.l_r = values[1];
+    p.m = values[2];
+    p.I_z = values[3];
+    p.lat_accel_max = values[4];
+    p.mu = values[5];
+    p.steering.min = values[6];
+    p.steering.max = values[7];
+    p.steering.rate_min = values[8];
+    p.steering.rate_max = values[9];
+    p.accel.min = values[10];
+    p.accel.max = values[11];
+    p.accel.jerk_max = values[12];
+    return p;
+}
+
+VehicleParameters vehicle_parameters_from_single_track(const SingleTrackParameters& p)
+{
+    VehicleParameters v;
+    v.a = p.l_f;
+    v.b = p.l_r;
+    v.m = p.m;
+    v.I_z = p.I_z;
+    v.steering.min = p.steering.min;
+    v.steering.max = p.steering.max;
+    v.steering.v_min = p.steering.rate_min;
+    v.steering.v_max = p.steering.rate_max;
+    v.longitudinal.a_max = std::max({p.accel.max, -p.accel.min, 0.0});
+    v.longitudinal.j_max = std::isfinite(p.accel.jerk_max) && p.accel.jerk_max > 0.0 ? p.accel.jerk_max : 0.0;
+    v.tire.p_dy1 = st_friction_coefficient(p);
+    return v;
+}
+
+} // namespace velox::models
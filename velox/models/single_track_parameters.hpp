@@ -0,0 +1,57 @@
+#pragma once
+
+#include <cstddef>
+#include <limits>
+
+#include "vehicle_parameters.hpp"
+
+namespace velox::models {
+
+/**
+ * SingleTrackParameters
+ *
+ * The JS backend's kinematic bicycle parameter set (SingleTrackParameters in
+ * velox/models/types.ts), i.e. what ConfigManager.loadModelParameters returns from
+ * parameters/st/vehicle.yaml. Unlike a CommonRoad VehicleParameters it carries its own friction
+ * inputs (mu, lat_accel_max) and an asymmetric acceleration range.
+ */
+struct SingleTrackParameters {
+    double l_f{};           // CoG to front axle [m]
+    double l_r{};           // CoG to rear axle [m]
+    double m{};             // [kg]
+    double I_z{};           // [kg m^2]
+    double lat_accel_max{}; // [m/s^2]
+    double mu{std::numeric_limits<double>::quiet_NaN()}; // optional; NaN or <= 0 falls back
+
+    struct {
+        double min{};      // [rad]
+        double max{};      // [rad]
+        double rate_min{}; // [rad/s]
+        double rate_max{}; // [rad/s]
+    } steering;
+
+    struct {
+        double min{};      // [m/s^2]
+        double max{};      // [m/s^2]
+        double jerk_max{}; // [m/s^3]; <= 0 or non-finite disables jerk limiting
+    } accel;
+};
+
+/**
+ * Flattened order used by the C ABI (velox_st_create_single_track): l_f, l_r, m, I_z,
+ * lat_accel_max, mu, steering.{min, max, rate_min, rate_max}, accel.{min, max, jerk_max}.
+ */
+inline constexpr std::size_t kSingleTrackParameterCount = 13;
+
+/// Throws std::invalid_argument unless count == kSingleTrackParameterCount.
+SingleTrackParameters single_track_parameters_from_values(const double* values, std::size_t count);
+
+/**
+ * The VehicleParameters view of a single-track set, for code that reads params(): a = l_f,
+ * b = l_r, steering limits as-is, longitudinal.a_max = the larger of accel.max and -accel.min,
+ * and tire.p_dy1 = st_friction_coefficient(p). The ST kernels take their clamps from
+ * derive_vehicle_constants(const SingleTrackParameters&), not from this view.
+ */
+VehicleParameters vehicle_parameters_from_single_track(const SingleTrackParameters& p);
+
+} // namespace velox::models
@@ -0,0 +1,180 @@
+#include "tire_model.hpp"
+
+#include <cmath>
+
+#include "simulation/simd.hpp"
+
+namespace velox::models {
+
+namespace {
+
+// C * atan(B x - E (B x - atan(B x))): the Magic Formula argument shared by every force.
+double magic_angle(double B, double C, double E, double x)
+{
+    const double Bx = B * x;
+    return C * std::atan(Bx - E * (Bx - std::atan(Bx)));
+}
+
+double sign(double x)
+{
+    return (x > 0.0) - (x < 0.0);
+}
+
+} // anonymous namespace
+
+double tire_force_longitudinal(double kappa, double gamma, double F_z, const utils::TireParameters& p)
+{
+    // coordinate system transformation
+    kappa = -kappa;
+
+    const double S_hx    = p.p_hx1;
+    const double S_vx    = F_z * p.p_vx1;
+    const double kappa_x = kappa + S_hx;
+    const double mu_x    = p.p_dx1 * (1.0 - p.p_dx3 * gamma * gamma);
+
+    const double C_x = p.p_cx1;
+    const double D_x = mu_x * F_z;
+    const double E_x = p.p_ex1;
+    const double B_x = p.p_kx1 / (C_x * mu_x); // K_x / (C_x D_x) with K_x = F_z p_kx1
+
+    return D_x * std::sin(magic_angle(B_x, C_x, E_x, kappa_x)) + S_vx;
+}
+
+double tire_force_lateral(double alpha, double gamma, double F_z, const utils::TireParameters& p,
+                          double& mu_y)
+{
+    const double S_hy    = sign(gamma) * (p.p_hy1 + p.p_hy3 * std::abs(gamma));
+    const double S_vy    = sign(gamma) * F_z * (p.p_vy1 + p.p_vy3 * std::abs(gamma));
+    const double alpha_y = alpha + S_hy;
+    mu_y = p.p_dy1 * (1.0 - p.p_dy3 * gamma * gamma);
+
+    const double C_y = p.p_cy1;
+    const double D_y = mu_y * F_z;
+    const double E_y = p.p_ey1;
+    const double B_y = p.p_ky1 / (C_y * mu_y); // K_y / (C_y D_y) with K_y = F_z p_ky1
+
+    return D_y * std::sin(magic_angle(B_y, C_y, E_y, alpha_y)) + S_vy;
+}
+
+double tire_force_longitudinal_combined(double kappa, double alpha, double F0_x,
+                                        const utils::TireParameters& p)
+{
+    const double S_hxalpha = p.r_hx1;
+    const double alpha_s   = alpha + S_hxalpha;
+
+    const double B_xalpha = p.r_bx1 * std::cos(std::atan(p.r_bx2 * kappa));
+    const double C_xalpha = p.r_cx1;
+    const double E_xalpha = p.r_ex1;
+    const double D_xalpha = F0_x / std::cos(magic_angle(B_xalpha, C_xalpha, E_xalpha, S_hxalpha));
+
+    return D_xalpha * std::cos(magic_angle(B_xalpha, C_xalpha, E_xalpha, alpha_s));
+}
+
+double tire_force_lateral_combined(double kappa, double alpha, double gamma, double mu_y,
+                                   double F_z, double F0_y, const utils::TireParameters& p)
+{
+    const double S_hykappa = p.r_hy1;
+    const double kappa_s   = kappa + S_hykappa;
+
+    const double B_ykappa = p.r_by1 * std::cos(std::atan(p.r_by2 * (alpha - p.r_by3)));
+    const double C_ykappa = p.r_cy1;
+    const double E_ykappa = p.r_ey1;
+    const double D_ykappa = F0_y / std::cos(magic_angle(B_ykappa, C_ykappa, E_ykappa, S_hykappa));
+
+    const double D_vykappa = mu_y * F_z * (p.r_vy1 + p.r_vy3 * gamma) * std::cos(std::atan(p.r_vy4 * alpha));
+    const double S_vykappa = D_vykappa * std::sin(p.r_vy5 * std::atan(p.r_vy6 * kappa));
+
+    return D_ykappa * std::cos(magic_angle(B_ykappa, C_ykappa, E_ykappa, kappa_s)) + S_vykappa;
+}
+
+namespace {
+
+using simd::VecD;
+
+VecD magic_angle(VecD B, VecD C, VecD E, VecD x)
+{
+    const VecD Bx = B * x;
+    return C * simd::atan(Bx - E * (Bx - simd::atan(Bx)));
+}
+
+VecD vsin(VecD x)
+{
+    VecD s, c;
+    simd::sincos(x, s, c);
+    return s;
+}
+
+VecD vcos(VecD x)
+{
+    VecD s, c;
+    simd::sincos(x, s, c);
+    return c;
+}
+
+VecD vsign(VecD x)
+{
+    const VecD zero = simd::broadcast(0.0);
+    return simd::select(x > zero, simd::broadcast(1.0),
+                        simd::select(x < zero, simd::broadcast(-1.0), zero));
+}
+
+} // anonymous namespace
+
+void tire_forces_4(const WheelSlip4& slip, const utils::TireParameters& p, WheelForces4& out)
+{
+    using simd::broadcast;
+
+    const VecD one = broadcast(1.0);
+
+    for (std::size_t i = 0; i < 4; i += simd::kWidth) {
+        const VecD kappa = simd::load(&slip.kappa[i]);
+        const VecD alpha = simd::load(&slip.alpha[i]);
+        const VecD gamma = simd::load(&slip.gamma[i]);
+        const VecD F_z   = simd::load(&slip.F_z[i]);
+        const VecD gamma2 = gamma * gamma;
+
+        // pure longitudinal (kappa sign flipped as in the scalar path)
+        const VecD mu_x = broadcast(p.p_dx1) * (one - broadcast(p.p_dx3) * gamma2);
+        const VecD C_x  = broadcast(p.p_cx1);
+        const VecD B_x  = broadcast(p.p_kx1) / (C_x * mu_x);
+        const VecD kappa_x = broadcast(p.p_hx1) - kappa;
+        const VecD F0_x = mu_x * F_z * vsin(magic_angle(B_x, C_x, broadcast(p.p_ex1), kappa_x)) +
+                          F_z * broadcast(p.p_vx1);
+
+        // pure lateral
+        const VecD sgn    = vsign(gamma);
+        const VecD gabs   = simd::abs(gamma);
+        const VecD mu_y   = broadcast(p.p_dy1) * (one - broadcast(p.p_dy3) * gamma2);
+        const VecD C_y    = broadcast(p.p_cy1);
+        const VecD B_y    = broadcast(p.p_ky1) / (C_y * mu_y);
+        const VecD alpha_y = alpha + sgn * (broadcast(p.p_hy1) + broadcast(p.p_hy3) * gabs);
+        const VecD F0_y = mu_y * F_z * vsin(magic_angle(B_y, C_y, broadcast(p.p_ey1), alpha_y)) +
+                          sgn * F_z * (broadcast(p.p_vy1) + broadcast(p.p_vy3) * gabs);
+
+        // combined longitudinal
+        const VecD S_hxalpha = broadcast(p.r_hx1);
+        const VecD B_xalpha  = broadcast(p.r_bx1) * vcos(simd::atan(broadcast(p.r_bx2) * kappa));
+        const VecD C_xalpha  = broadcast(p.r_cx1);
+        const VecD E_xalpha  = broadcast(p.r_ex1);
+        const VecD D_xalpha  = F0_x / vcos(magic_angle(B_xalpha, C_xalpha, E_xalpha, S_hxalpha));
+        const VecD F_x = D_xalpha * vcos(magic_angle(B_xalpha, C_xalpha, E_xalpha, alpha + S_hxalpha));
+
+        // combined lateral
+        const VecD S_hykappa = broadcast(p.r_hy1);
+        const VecD B_ykappa  = broadcast(p.r_by1) *
+                               vcos(simd::atan(broadcast(p.r_by2) * (alpha - broadcast(p.r_by3))));
+        const VecD C_ykappa  = broadcast(p.r_cy1);
+        const VecD E_ykappa  = broadcast(p.r_ey1);
+        const VecD D_ykappa  = F0_y / vcos(magic_angle(B_ykappa, C_ykappa, E_ykappa, S_hykappa));
+        const VecD D_vykappa = mu_y * F_z * (broadcast(p.r_vy1) + broadcast(p.r_vy3) * gamma) *
+                               vcos(simd::atan(broadcast(p.r_vy4) * alpha));
+        const VecD S_vykappa = D_vykappa * vsin(broadcast(p.r_vy5) * simd::atan(broadcast(p.r_vy6) * kappa));
+        const VecD F_y = D_ykappa * vcos(magic_angle(B_ykappa, C_ykappa, E_ykappa, kappa + S_hykappa)) +
+                         S_vykappa;
+
+        simd::store(&out.F_x[i], F_x);
+        simd::store(&out.F_y[i], F_y);
+    }
+}
+
+} // namespace velox::models
@@ -0,0 +1,54 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+
+#include "vehicle_parameters.hpp"
+
+namespace velox::models {
+
+/**
+ * Pacejka Magic Formula tire model of the CommonRoad vehicle models (tireModel.py): pure-slip
+ * longitudinal/lateral forces followed by the combined-slip weighting. Turn slip is neglected
+ * and all scaling factors are 1, as in the reference.
+ *
+ * B = K / (C * D) is evaluated with the normal load cancelled (p_k / (C * mu)), which is the
+ * same value for F_z != 0 and stays finite for an unloaded wheel.
+ */
+
+/// Pure longitudinal force for slip ratio kappa, camber gamma and normal load F_z.
+double tire_force_longitudinal(double kappa, double gamma, double F_z, const utils::TireParameters& p);
+
+/// Pure lateral force; mu_y receives the lateral friction coefficient used by the combined step.
+double tire_force_lateral(double alpha, double gamma, double F_z, const utils::TireParameters& p,
+                          double& mu_y);
+
+/// Combined-slip longitudinal force from the pure-slip force F0_x.
+double tire_force_longitudinal_combined(double kappa, double alpha, double F0_x,
+                                        const utils::TireParameters& p);
+
+/// Combined-slip lateral force from the pure-slip force F0_y and mu_y.
+double tire_force_lateral_combined(double kappa, double alpha, double gamma, double mu_y,
+                                   double F_z, double F0_y, const utils::TireParameters& p);
+
+/// Slip inputs of up to four wheels, lane order LF, RF, LR, RR (STD uses front, rear).
+struct WheelSlip4 {
+    alignas(32) std::array<double, 4> kappa{};
+    alignas(32) std::array<double, 4> alpha{};
+    alignas(32) std::array<double, 4> gamma{};
+    alignas(32) std::array<double, 4> F_z{};
+};
+
+struct WheelForces4 {
+    alignas(32) std::array<double, 4> F_x{};
+    alignas(32) std::array<double, 4> F_y{};
+};
+
+/**
+ * Combined-slip forces of four wheels at once: the four pure and combined evaluations run as
+ * SIMD lanes (one AVX2 pass, two NEON/WASM passes, four scalar passes otherwise). Lane for
+ * lane equal to the scalar functions above up to the ~1e-16 error of the SIMD atan/sincos.
+ */
+void tire_forces_4(const WheelSlip4& slip, const utils::TireParameters& p, WheelForces4& out);
+
+} // namespace velox::models
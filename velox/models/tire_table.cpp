@@ -0,0 +1,367 @@
+#include "tire_table.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstring>
+#include <limits>
+#include <map>
+#include <mutex>
+#include <shared_mutex>
+#include <stdexcept>
+#include <string>
+
+namespace velox::models {
+
+namespace {
+
+// Interpolation stencil along one axis: up to four node indices and their weights.
+struct Stencil {
+    std::size_t index[4];
+    double weight[4];
+    int taps;
+};
+
+Stencil make_stencil(double u, std::size_t nodes, TireTableInterpolation interpolation)
+{
+    const std::size_t i = std::min(static_cast<std::size_t>(u), nodes - 2);
+    const double t = u - static_cast<double>(i);
+
+    Stencil s{};
+    if (interpolation == TireTableInterpolation::Bilinear) {
+        s.taps = 2;
+        s.index[0] = i;
+        s.index[1] = i + 1;
+        s.weight[0] = 1.0 - t;
+        s.weight[1] = t;
+        return s;
+    }
+
+    // Catmull-Rom; the outer taps are clamped to the grid at the edges
+    s.taps = 4;
+    s.index[0] = i == 0 ? 0 : i - 1;
+    s.index[1] = i;
+    s.index[2] = i + 1;
+    s.index[3] = std::min(i + 2, nodes - 1);
+    const double t2 = t * t;
+    const double t3 = t2 * t;
+    s.weight[0] = 0.5 * (-t3 + 2.0 * t2 - t);
+    s.weight[1] = 0.5 * (3.0 * t3 - 5.0 * t2 + 2.0);
+    s.weight[2] = 0.5 * (-3.0 * t3 + 4.0 * t2 + t);
+    s.weight[3] = 0.5 * (t3 - t2);
+    return s;
+}
+
+} // anonymous namespace
+
+// The slip axes are uniform in w = x / (|x| + knee), a division instead of a transcendental
+// per lookup, which puts the nodes where the force curves bend (|x| < ~0.2).
+double TireForceTable::SlipAxis::node(double i) const
+{
+    const double w = -w_limit + i / scale;
+    return knee * w / (1.0 - std::abs(w));
+}
+
+double TireForceTable::SlipAxis::coordinate(double x) const
+{
+    const double w = x / (std::abs(x) + knee);
+    return std::clamp((w + w_limit) * scale, 0.0, static_cast<double>(nodes - 1));
+}
+
+TireForceTable::TireForceTable(const utils::TireParameters& tire, const TireTableOptions& options)
+    : tire_(tire)
+    , options_(options)
+{
+    const TireTableOptions& o = options_;
+    if (o.kappa_nodes < 4 || o.alpha_nodes < 4 || o.camber_nodes < 2) {
+        throw std::invalid_argument("TireForceTable needs >= 4 slip nodes and >= 2 camber nodes per axis");
+    }
+    if (!(o.kappa_limit > 0.0) || !(o.alpha_limit > 0.0) || !(o.camber_limit > 0.0) ||
+        !(o.kappa_knee > 0.0) || !(o.alpha_knee > 0.0)) {
+        throw std::invalid_argument("TireForceTable ranges and knees must be positive");
+    }
+
+    auto make_axis = [](std::size_t nodes, double limit, double knee) {
+        SlipAxis axis;
+        axis.nodes = nodes;
+        axis.knee = knee;
+        axis.w_limit = limit / (limit + knee);
+        axis.scale = static_cast<double>(nodes - 1) / (2.0 * axis.w_limit);
+        return axis;
+    };
+    kappa_axis_   = make_axis(o.kappa_nodes, o.kappa_limit, o.kappa_knee);
+    alpha_axis_   = make_axis(o.alpha_nodes, o.alpha_limit, o.alpha_knee);
+    camber_scale_ = static_cast<double>(o.camber_nodes - 1) / o.camber_limit;
+    slice_stride_ = o.kappa_nodes * o.alpha_nodes * 2;
+
+    build();
+    measure();
+}
+
+void TireForceTable::build()
+{
+    const std::size_t n_k = options_.kappa_nodes;
+    const std::size_t n_a = options_.alpha_nodes;
+    const std::size_t n_c = options_.camber_nodes;
+    const std::size_t slices = 2 * n_c + 1;
+    nodes_.assign(slices * slice_stride_, 0.0f);
+
+    // Slices in ascending camber: n_c negative nodes ending at 0-, gamma == 0, then n_c positive
+    // nodes starting at 0+. The one-sided limits at zero are taken with the smallest
+    // subnormal, which selects sign(gamma) without changing |gamma| or gamma^2.
+    const double tiny = std::numeric_limits<double>::denorm_min();
+    const double h_c = 1.0 / camber_scale_;
+    auto slice_camber = [&](std::size_t s) {
+        if (s < n_c) {
+            const std::size_t j = n_c - 1 - s;
+            return j == 0 ? -tiny : -static_cast<double>(j) * h_c;
+        }
+        if (s == n_c) return 0.0;
+        const std::size_t j = s - n_c - 1;
+        return j == 0 ? tiny : static_cast<double>(j) * h_c;
+    };
+
+    WheelSlip4 slip;
+    slip.F_z = {1.0, 1.0, 1.0, 1.0};
+    WheelForces4 f;
+    std::size_t lane = 0;
+    std::size_t pending[4] = {};
+
+    auto flush = [&](std::size_t lanes) {
+        for (std::size_t l = lanes; l < 4; ++l) {
+            slip.kappa[l] = slip.alpha[l] = slip.gamma[l] = 0.0;
+        }
+        tire_forces_4(slip, tire_, f);
+        for (std::size_t l = 0; l < lanes; ++l) {
+            nodes_[pending[l]]     = static_cast<float>(f.F_x[l]);
+            nodes_[pending[l] + 1] = static_cast<float>(f.F_y[l]);
+        }
+    };
+
+    for (std::size_t s = 0; s < slices; ++s) {
+        const double gamma = slice_camber(s);
+        for (std::size_t ia = 0; ia < n_a; ++ia) {
+            const double alpha = alpha_axis_.node(static_cast<double>(ia));
+            for (std::size_t ik = 0; ik < n_k; ++ik) {
+                slip.kappa[lane] = kappa_axis_.node(static_cast<double>(ik));
+                slip.alpha[lane] = alpha;
+                slip.gamma[lane] = gamma;
+                pending[lane] = s * slice_stride_ + (ia * n_k + ik) * 2;
+                if (++lane == 4) {
+                    flush(4);
+                    lane = 0;
+                }
+            }
+        }
+    }
+    if (lane > 0) {
+        flush(lane);
+    }
+}
+
+void TireForceTable::measure()
+{
+    const std::size_t n_k = options_.kappa_nodes;
+    const std::size_t n_a = options_.alpha_nodes;
+    const std::size_t n_c = options_.camber_nodes;
+    const double h_c = 1.0 / camber_scale_;
+
+    // gamma == 0 plus the midpoint of every camber interval on both sides
+    std::vector<double> cambers{0.0};
+    for (std::size_t j = 0; j + 1 < n_c; ++j) {
+        const double mid = (static_cast<double>(j) + 0.5) * h_c;
+        cambers.push_back(mid);
+        cambers.push_back(-mid);
+    }
+
+    TireTableErrorReport r;
+    double sum_x = 0.0;
+    double sum_y = 0.0;
+    double worst = -1.0;
+
+    WheelSlip4 slip;
+    slip.F_z = {1.0, 1.0, 1.0, 1.0};
+    WheelForces4 f;
+    std::size_t lane = 0;
+
+    auto flush = [&](std::size_t lanes) {
+        for (std::size_t l = lanes; l < 4; ++l) {
+            slip.kappa[l] = slip.alpha[l] = slip.gamma[l] = 0.0;
+        }
+        tire_forces_4(slip, tire_, f);
+        for (std::size_t l = 0; l < lanes; ++l) {
+            double t_x = 0.0;
+            double t_y = 0.0;
+            lookup(slip.kappa[l], slip.alpha[l], slip.gamma[l], t_x, t_y);
+            const double e_x = std::abs(t_x - f.F_x[l]);
+            const double e_y = std::abs(t_y - f.F_y[l]);
+            r.max_error_x = std::max(r.max_error_x, e_x);
+            r.max_error_y = std::max(r.max_error_y, e_y);
+            sum_x += e_x * e_x;
+            sum_y += e_y * e_y;
+            if (std::max(e_x, e_y) > worst) {
+                worst = std::max(e_x, e_y);
+                r.worst_kappa = slip.kappa[l];
+                r.worst_alpha = slip.alpha[l];
+                r.worst_gamma = slip.gamma[l];
+            }
+            ++r.samples;
+        }
+    };
+
+    // cell centres in the warped coordinates
+    for (double gamma : cambers) {
+        for (std::size_t ia = 0; ia + 1 < n_a; ++ia) {
+            const double alpha = alpha_axis_.node(static_cast<double>(ia) + 0.5);
+            for (std::size_t ik = 0; ik + 1 < n_k; ++ik) {
+                slip.kappa[lane] = kappa_axis_.node(static_cast<double>(ik) + 0.5);
+                slip.alpha[lane] = alpha;
+                slip.gamma[lane] = gamma;
+                if (++lane == 4) {
+                    flush(4);
+                    lane = 0;
+                }
+            }
+        }
+    }
+    if (lane > 0) {
+        flush(lane);
+    }
+
+    const double n = static_cast<double>(std::max<std::size_t>(r.samples, 1));
+    r.rms_error_x = std::sqrt(sum_x / n);
+    r.rms_error_y = std::sqrt(sum_y / n);
+    report_ = r;
+}
+
+void TireForceTable::lookup(double kappa, double alpha, double gamma, double& f_x, double& f_y) const
+{
+    const std::size_t n_k = options_.kappa_nodes;
+    const std::size_t n_c = options_.camber_nodes;
+    const Stencil sk = make_stencil(kappa_axis_.coordinate(kappa), n_k, options_.interpolation);
+    const Stencil sa = make_stencil(alpha_axis_.coordinate(alpha), options_.alpha_nodes,
+                                    options_.interpolation);
+
+    auto sample = [&](std::size_t s, double& x, double& y) {
+        const float* base = nodes_.data() + s * slice_stride_;
+        x = 0.0;
+        y = 0.0;
+        for (int a = 0; a < sa.taps; ++a) {
+            const float* row = base + sa.index[a] * n_k * 2;
+            double rx = 0.0;
+            double ry = 0.0;
+            for (int k = 0; k < sk.taps; ++k) {
+                const float* node = row + sk.index[k] * 2;
+                rx += sk.weight[k] * node[0];
+                ry += sk.weight[k] * node[1];
+            }
+            x += sa.weight[a] * rx;
+            y += sa.weight[a] * ry;
+        }
+    };
+
+    if (gamma == 0.0 || !std::isfinite(gamma)) {
+        sample(n_c, f_x, f_y);
+        return;
+    }
+
+    // linear in camber within the slab of sign(gamma)
+    const double g = std::min(std::abs(gamma) * camber_scale_, static_cast<double>(n_c - 1));
+    const std::size_t j = std::min(static_cast<std::size_t>(g), n_c - 2);
+    const double t = g - static_cast<double>(j);
+    const std::size_t s0 = gamma > 0.0 ? n_c + 1 + j : n_c - 1 - j;
+    const std::size_t s1 = gamma > 0.0 ? s0 + 1 : s0 - 1;
+
+    double x0, y0, x1, y1;
+    sample(s0, x0, y0);
+    sample(s1, x1, y1);
+    f_x = x0 + t * (x1 - x0);
+    f_y = y0 + t * (y1 - y0);
+}
+
+void TireForceTable::forces(const WheelSlip4& slip, WheelForces4& out) const
+{
+    for (std::size_t i = 0; i < 4; ++i) {
+        double f_x, f_y;
+        lookup(slip.kappa[i], slip.alpha[i], slip.gamma[i], f_x, f_y);
+        out.F_x[i] = slip.F_z[i] * f_x;
+        out.F_y[i] = slip.F_z[i] * f_y;
+    }
+}
+
+namespace {
+
+struct TableCache {
+    std::shared_mutex mutex;
+    std::map<std::string, std::shared_ptr<const TireForceTable>> entries;
+    std::atomic<std::uint64_t> hits{0};
+    std::atomic<std::uint64_t> misses{0};
+};
+
+TableCache& table_cache()
+{
+    static TableCache instance;
+    return instance;
+}
+
+// TireParameters is a plain block of doubles, so its bytes identify the tire set.
+std::string table_key(const utils::TireParameters& tire, const TireTableOptions& o)
+{
+    const double grid[] = {static_cast<double>(o.kappa_nodes), o.kappa_limit, o.kappa_knee,
+                           static_cast<double>(o.alpha_nodes), o.alpha_limit, o.alpha_knee,
+                           static_cast<double>(o.camber_nodes), o.camber_limit,
+                           static_cast<double>(o.interpolation)};
+    std::string key(sizeof(tire) + sizeof(grid), '\0');
+    std::memcpy(key.data(), &tire, sizeof(tire));
+    std::memcpy(key.data() + sizeof(tire), grid, sizeof(grid));
+    return key;
+}
+
+} // anonymous namespace
+
+std::shared_ptr<const TireForceTable> cached_tire_table(const utils::TireParameters& tire,
+                                                        const TireTableOptions& options)
+{
+    TableCache& c = table_cache();
+    std::string key = table_key(tire, options);
+    {
+        std::shared_lock lock(c.mutex);
+        auto it = c.entries.find(key);
+        if (it != c.entries.end()) {
+            c.hits.fetch_add(1, std::memory_order_relaxed);
+            return it->second;
+        }
+    }
+
+    // Build outside the lock; the first table published for a key wins.
+    c.misses.fetch_add(1, std::memory_order_relaxed);
+    auto table = std::make_shared<const TireForceTable>(tire, options);
+
+    std::unique_lock lock(c.mutex);
+    auto [it, inserted] = c.entries.emplace(std::move(key), std::move(table));
+    return it->second;
+}
+
+TireTableCacheStats tire_table_cache_stats()
+{
+    TableCache& c = table_cache();
+    TireTableCacheStats stats;
+    stats.hits   = c.hits.load(std::memory_order_relaxed);
+    stats.misses = c.misses.load(std::memory_order_relaxed);
+    {
+        std::shared_lock lock(c.mutex);
+        stats.entries = c.entries.size();
+    }
+    return stats;
+}
+
+void clear_tire_table_cache()
+{
+    TableCache& c = table_cache();
+    std::unique_lock lock(c.mutex);
+    c.entries.clear();
+    c.hits.store(0, std::memory_order_relaxed);
+    c.misses.store(0, std::memory_order_relaxed);
+}
+
+} // namespace velox::models
@@ -0,0 +1,127 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "tire_model.hpp"
+
+namespace velox::models {
+
+enum class TireTableInterpolation {
+    Bilinear, // 4 taps per slice
+    Bicubic,  // 16-tap Catmull-Rom per slice
+};
+
+/**
+ * Grid of a TireForceTable. Slip ratio and slip angle cover [-limit, limit] with nodes that are
+ * densest at zero slip: spacing grows as (|x| + knee)^2, i.e. 4x at |x| = knee. Camber uses
+ * camber_nodes per sign over [0, camber_limit]. Inputs outside the ranges are clamped to the
+ * edge, where the Magic Formula is already saturated.
+ */
+struct TireTableOptions {
+    std::size_t kappa_nodes  = 129;
+    double      kappa_limit  = 50.0;
+    double      kappa_knee   = 0.2;
+    std::size_t alpha_nodes  = 129;
+    double      alpha_limit  = 1.5707963267948966; // pi / 2
+    double      alpha_knee   = 0.2;
+    std::size_t camber_nodes = 13;
+    double      camber_limit = 0.6;
+    TireTableInterpolation interpolation = TireTableInterpolation::Bilinear;
+
+    bool operator==(const TireTableOptions&) const = default;
+};
+
+/**
+ * Table error against the transcendental model, measured per unit normal load (N/N) at the
+ * centre of every slip cell and between all camber nodes, i.e. where interpolation is worst.
+ */
+struct TireTableErrorReport {
+    double max_error_x = 0.0;
+    double max_error_y = 0.0;
+    double rms_error_x = 0.0;
+    double rms_error_y = 0.0;
+    // location of the largest error of either component
+    double worst_kappa = 0.0;
+    double worst_alpha = 0.0;
+    double worst_gamma = 0.0;
+    std::size_t samples = 0;
+};
+
+/**
+ * TireForceTable
+ *
+ * Tabulated combined-slip Pacejka forces for one TireParameters set, a drop-in for
+ * tire_forces_4 when throughput matters more than the last digits.
+ *
+ * Every force of the CommonRoad formulation is proportional to F_z (D = mu F_z, S_v ~ F_z, and
+ * B does not depend on the load), so the table stores forces per unit load over (slip ratio,
+ * slip angle, camber) and multiplies by F_z exactly instead of interpolating along the load.
+ * The S_hy / S_vy offsets jump with sign(gamma), so negative camber, gamma == 0 and positive
+ * camber are separate slabs and interpolation never crosses the jump.
+ *
+ * Immutable after construction; safe to share between threads.
+ */
+class TireForceTable {
+public:
+    /// Throws std::invalid_argument for fewer than 4 slip nodes, 2 camber nodes or a non-positive range/knee.
+    explicit TireForceTable(const utils::TireParameters& tire, const TireTableOptions& options = {});
+
+    /** Same contract as tire_forces_4. */
+    void forces(const WheelSlip4& slip, WheelForces4& out) const;
+
+    const utils::TireParameters& tire() const noexcept { return tire_; }
+    const TireTableOptions& options() const noexcept { return options_; }
+    const TireTableErrorReport& error_report() const noexcept { return report_; }
+    std::size_t memory_bytes() const noexcept { return nodes_.size() * sizeof(float); }
+
+private:
+    // One warped slip axis: node i sits at w = -w_limit + i / scale, x = knee w / (1 - |w|).
+    struct SlipAxis {
+        std::size_t nodes{};
+        double knee{};
+        double w_limit{};
+        double scale{};
+
+        double node(double i) const;      // slip value at (fractional) node index i
+        double coordinate(double x) const; // fractional node index of slip x, clamped to the grid
+    };
+
+    void build();
+    void measure();
+    // forces per unit load
+    void lookup(double kappa, double alpha, double gamma, double& f_x, double& f_y) const;
+
+    utils::TireParameters tire_;
+    TireTableOptions options_;
+    TireTableErrorReport report_{};
+    SlipAxis kappa_axis_{};
+    SlipAxis alpha_axis_{};
+    double camber_scale_{}; // camber nodes per radian
+    std::size_t slice_stride_{}; // floats per camber slice
+    std::vector<float> nodes_;   // [slice][alpha][kappa][F_x, F_y]
+};
+
+struct TireTableCacheStats {
+    std::uint64_t hits{};
+    std::uint64_t misses{};
+    std::size_t   entries{};
+};
+
+/**
+ * cached_tire_table
+ *
+ * Process-wide counterpart of cached_vehicle_parameters: tables are keyed by the tire
+ * coefficients and options, so every vehicle (and every simulator) using the same tire set
+ * shares one table. Entries live until clear_tire_table_cache().
+ */
+std::shared_ptr<const TireForceTable> cached_tire_table(const utils::TireParameters& tire,
+                                                        const TireTableOptions& options = {});
+
+TireTableCacheStats tire_table_cache_stats();
+
+void clear_tire_table_cache();
+
+} // namespace velox::models
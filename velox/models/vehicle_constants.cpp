@@ -0,0 +1,176 @@
+#include "vehicle_constants.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <map>
+#include <mutex>
+#include <shared_mutex>
+#include <stdexcept>
+#include <string>
+
+#include "vehicle_dynamics_st.hpp"
+
+namespace velox::models {
+
+namespace {
+
+void require_finite(double value, const char* name)
+{
+    if (!std::isfinite(value)) {
+        throw std::invalid_argument(std::string("VehicleParameters: ") + name + " is not finite");
+    }
+}
+
+struct ConstantsEntry {
+    std::weak_ptr<const VehicleParameters> params;
+    std::shared_ptr<const DerivedVehicleConstants> constants;
+};
+
+struct ConstantsCache {
+    std::shared_mutex mutex;
+    std::map<const VehicleParameters*, ConstantsEntry> entries;
+    // Expired entries are swept once the map reaches this size, then the limit is set to twice
+    // the survivors, so a miss costs O(log n) amortised instead of a scan of every entry.
+    std::size_t sweep_at{16};
+};
+
+ConstantsCache& constants_cache()
+{
+    static ConstantsCache instance;
+    return instance;
+}
+
+// Same owner and still alive: a set freed and replaced at the same address fails the first test.
+bool same_set(const ConstantsEntry& e, const std::shared_ptr<const VehicleParameters>& params)
+{
+    return !e.params.owner_before(params) && !params.owner_before(e.params) && !e.params.expired();
+}
+
+} // anonymous namespace
+
+DerivedVehicleConstants derive_vehicle_constants(const VehicleParameters& p)
+{
+    require_finite(p.a, "a");
+    require_finite(p.b, "b");
+    require_finite(p.m, "m");
+    require_finite(p.h_cg, "h_cg");
+    require_finite(p.steering.min, "steering.min");
+    require_finite(p.steering.max, "steering.max");
+    require_finite(p.steering.v_min, "steering.v_min");
+    require_finite(p.steering.v_max, "steering.v_max");
+    require_finite(p.longitudinal.a_max, "longitudinal.a_max");
+    require_finite(p.longitudinal.j_max, "longitudinal.j_max");
+    if (p.steering.min > p.steering.max) {
+        throw std::invalid_argument("VehicleParameters: steering.min > steering.max");
+    }
+    if (p.steering.v_min > p.steering.v_max) {
+        throw std::invalid_argument("VehicleParameters: steering.v_min > steering.v_max");
+    }
+    if (p.longitudinal.a_max < 0.0) {
+        throw std::invalid_argument("VehicleParameters: longitudinal.a_max is negative");
+    }
+
+    DerivedVehicleConstants c;
+    c.wheelbase = std::max(p.a + p.b, 1e-6);
+    c.rear_ratio = p.b / c.wheelbase;
+    c.friction = st_friction_coefficient(p);
+    c.accel_budget = std::max(c.friction * kGravity, 0.0);
+    c.accel_budget_sq = c.accel_budget * c.accel_budget;
+    c.budget_wheelbase = c.accel_budget * c.wheelbase;
+    c.steer_rate_min = p.steering.v_min;
+    c.steer_rate_max = p.steering.v_max;
+    c.j_max = p.longitudinal.j_max;
+
+    c.steer_min = p.steering.min;
+    c.steer_max = p.steering.max;
+    c.a_min = -p.longitudinal.a_max;
+    c.a_max = p.longitudinal.a_max;
+    c.static_load_front = p.m * kGravity * p.b / c.wheelbase;
+    c.static_load_rear = p.m * kGravity * p.a / c.wheelbase;
+    c.load_transfer = p.m * p.h_cg / c.wheelbase;
+    return c;
+}
+
+DerivedVehicleConstants derive_vehicle_constants(const SingleTrackParameters& p)
+{
+    const auto require = [](double value, const char* name) {
+        if (!std::isfinite(value)) {
+            throw std::invalid_argument(std::string("SingleTrackParameters: ") + name + " is not finite");
+        }
+    };
+    require(p.l_f, "l_f");
+    require(p.l_r, "l_r");
+    require(p.m, "m");
+    require(p.lat_accel_max, "lat_accel_max");
+    require(p.steering.min, "steering.min");
+    require(p.steering.max, "steering.max");
+    require(p.steering.rate_min, "steering.rate_min");
+    require(p.steering.rate_max, "steering.rate_max");
+    require(p.accel.min, "accel.min");
+    require(p.accel.max, "accel.max");
+    if (p.steering.min > p.steering.max) {
+        throw std::invalid_argument("SingleTrackParameters: steering.min > steering.max");
+    }
+    if (p.steering.rate_min > p.steering.rate_max) {
+        throw std::invalid_argument("SingleTrackParameters: steering.rate_min > steering.rate_max");
+    }
+    if (p.accel.min > p.accel.max) {
+        throw std::invalid_argument("SingleTrackParameters: accel.min > accel.max");
+    }
+    if (!(std::isfinite(p.mu) && p.mu > 0.0) && !(p.lat_accel_max > 0.0)) {
+        throw std::invalid_argument("SingleTrackParameters: neither mu nor lat_accel_max is positive");
+    }
+
+    DerivedVehicleConstants c;
+    c.wheelbase = std::max(p.l_f + p.l_r, 1e-6);
+    c.rear_ratio = p.l_r / c.wheelbase;
+    c.friction = st_friction_coefficient(p);
+    c.accel_budget = std::max(c.friction * kGravity, 0.0);
+    c.accel_budget_sq = c.accel_budget * c.accel_budget;
+    c.budget_wheelbase = c.accel_budget * c.wheelbase;
+    c.steer_rate_min = p.steering.rate_min;
+    c.steer_rate_max = p.steering.rate_max;
+    c.j_max = std::isfinite(p.accel.jerk_max) && p.accel.jerk_max > 0.0 ? p.accel.jerk_max : 0.0;
+
+    c.steer_min = p.steering.min;
+    c.steer_max = p.steering.max;
+    c.a_min = p.accel.min;
+    c.a_max = p.accel.max;
+    c.static_load_front = p.m * kGravity * p.l_r / c.wheelbase;
+    c.static_load_rear = p.m * kGravity * p.l_f / c.wheelbase;
+    c.load_transfer = 0.0;
+    return c;
+}
+
+std::shared_ptr<const DerivedVehicleConstants> cached_vehicle_constants(
+    const std::shared_ptr<const VehicleParameters>& params)
+{
+    if (!params) {
+        throw std::invalid_argument("cached_vehicle_constants requires parameters");
+    }
+    if (params.use_count() == 0) {
+        return std::make_shared<const DerivedVehicleConstants>(derive_vehicle_constants(*params));
+    }
+
+    ConstantsCache& c = constants_cache();
+    {
+        std::shared_lock lock(c.mutex);
+        auto it = c.entries.find(params.get());
+        if (it != c.entries.end() && same_set(it->second, params)) {
+            return it->second.constants;
+        }
+    }
+
+    // Derive outside the lock; concurrent misses on the same set simply race to publish.
+    auto constants = std::make_shared<const DerivedVehicleConstants>(derive_vehicle_constants(*params));
+
+    std::unique_lock lock(c.mutex);
+    if (c.entries.size() >= c.sweep_at) {
+        std::erase_if(c.entries, [](const auto& entry) { return entry.second.params.expired(); });
+        c.sweep_at = std::max<std::size_t>(16, 2 * c.entries.size());
+    }
+    c.entries[params.get()] = ConstantsEntry{params, constants};
+    return constants;
+}
+
+} // namespace velox::models
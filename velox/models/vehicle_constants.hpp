@@ -0,0 +1,86 @@
+#pragma once
+
+#include <memory>
+
+#include "single_track_parameters.hpp"
+#include "vehicle_parameters.hpp"
+
+namespace velox::models {
+
+/**
+ * DerivedVehicleConstants
+ *
+ * Quantities the ST kernels used to re-derive from VehicleParameters on every call, computed
+ * once per parameter set. Each value is produced by exactly the expression the per-step code
+ * used (L = max(a + b, 1e-6), b / L, max(mu g, 0), ...), so reading it instead changes no bit
+ * of any result. The twelve values the ST right-hand side and StSimulator's limits read per
+ * substep come first (the first cache line and the start of the second), followed by the
+ * friction coefficient and the axle loads. It doubles as the ST model's hot parameter view
+ * (StdHotParameters is the STD one).
+ */
+struct alignas(64) DerivedVehicleConstants {
+    // --- read every substep (first cache line)
+    double wheelbase{1e-6};     // L = max(a + b, 1e-6) [m]
+    double rear_ratio{};        // b / L
+    double accel_budget{};      // max(mu g, 0) [m/s^2], mu = st_friction_coefficient
+    double accel_budget_sq{};   // accel_budget^2
+    double budget_wheelbase{};  // accel_budget * L, numerator of the steering envelope
+    double steer_rate_min{};    // steering.v_min [rad/s]
+    double steer_rate_max{};    // steering.v_max [rad/s]
+    double j_max{};             // longitudinal.j_max [m/s^3], <= 0 disables jerk limiting
+
+    // --- clamp bounds, also read every substep
+    double steer_min{};         // steering.min [rad]
+    double steer_max{};         // steering.max [rad]
+    double a_min{};             // -longitudinal.a_max, or accel.min of a single-track set [m/s^2]
+    double a_max{};             // longitudinal.a_max, or accel.max of a single-track set [m/s^2]
+
+    // --- not read by the step loop
+    double friction{};          // mu
+    double static_load_front{}; // m g b / L [N]
+    double static_load_rear{};  // m g a / L [N]
+    double load_transfer{};     // m h_cg / L [N per m/s^2], front-to-rear under acceleration
+};
+
+static_assert(sizeof(DerivedVehicleConstants) == 128, "DerivedVehicleConstants spans two cache lines");
+
+/**
+ * derive_vehicle_constants
+ *
+ * Validates the fields the ST kernels depend on and derives their constants.
+ *
+ * Throws std::invalid_argument when a, b, m, h_cg or a steering/longitudinal limit is not
+ * finite, when steering.min > steering.max or steering.v_min > steering.v_max, or when
+ * longitudinal.a_max is negative.
+ */
+DerivedVehicleConstants derive_vehicle_constants(const VehicleParameters& p);
+
+/**
+ * cached_vehicle_constants
+ *
+ * derive_vehicle_constants(*params), derived on the first lookup of a shared set and kept while
+ * the set is alive, so everything seated on the objects cached_vehicle_parameters hands out
+ * (EpisodeWorkspace per episode, the C ABI engines) derives once per loaded set instead of once
+ * per simulator. Entries are keyed by address and checked against a weak reference, so a freed
+ * or reloaded set is never served another set's constants; a non-owning params (an aliasing
+ * pointer with no control block, e.g. an embedded set) is derived on every call.
+ *
+ * Thread-safe. Throws std::invalid_argument for a null params or like derive_vehicle_constants.
+ */
+std::shared_ptr<const DerivedVehicleConstants> cached_vehicle_constants(
+    const std::shared_ptr<const VehicleParameters>& params);
+
+/**
+ * derive_vehicle_constants for a single-track set: L = max(l_f + l_r, 1e-6), the friction of
+ * st_friction_coefficient(const SingleTrackParameters&) and the acceleration range
+ * [accel.min, accel.max], so the ST kernels reproduce vehicleDynamicsST and
+ * VehicleSimulator.clampKinematicControl on the same set. Axle loads use h_cg = 0.
+ *
+ * Throws std::invalid_argument when l_f, l_r, m, lat_accel_max or a steering/acceleration limit
+ * is not finite, when a min exceeds its max, or when neither mu nor lat_accel_max is positive
+ * (VehicleSimulator.applySafety then drops the steering envelope that clampKinematicControl
+ * keeps at 0.8 g, which the shared constants cannot represent).
+ */
+DerivedVehicleConstants derive_vehicle_constants(const SingleTrackParameters& p);
+
+} // namespace velox::models
@@ -0,0 +1,34 @@
+#include "vehicle_constraints.hpp"
+
+namespace velox::models {
+
+double steering_constraints(double steering_angle, double steering_velocity,
+                            const utils::SteeringParameters& p)
+{
+    // steering limit reached?
+    if ((steering_angle <= p.min && steering_velocity <= 0.0) ||
+        (steering_angle >= p.max && steering_velocity >= 0.0)) {
+        return 0.0;
+    }
+    if (steering_velocity <= p.v_min) return p.v_min;
+    if (steering_velocity >= p.v_max) return p.v_max;
+    return steering_velocity;
+}
+
+double acceleration_constraints(double velocity, double acceleration,
+                                const utils::LongitudinalParameters& p)
+{
+    // positive acceleration limit
+    const double pos_limit = velocity > p.v_switch ? p.a_max * p.v_switch / velocity : p.a_max;
+
+    // acceleration limit reached?
+    if ((velocity <= p.v_min && acceleration <= 0.0) ||
+        (velocity >= p.v_max && acceleration >= 0.0)) {
+        return 0.0;
+    }
+    if (acceleration <= -p.a_max) return -p.a_max;
+    if (acceleration >= pos_limit) return pos_limit;
+    return acceleration;
+}
+
+} // namespace velox::models
@@ -0,0 +1,22 @@
+#pragma once
+
+#include "vehicle_parameters.hpp"
+
+namespace velox::models {
+
+/**
+ * Input constraints of the CommonRoad reference models (steering_constraints and
+ * acceleration_constraints in vehicleDynamics_*.py), used by the MB and STD right-hand sides.
+ * Unlike the ST clamps these depend on the state: the steering rate is zeroed at the angle
+ * stops and the positive acceleration limit falls off as a_max * v_switch / v above v_switch.
+ */
+
+/** Steering rate after the angle stops and [steering.v_min, steering.v_max]. */
+double steering_constraints(double steering_angle, double steering_velocity,
+                            const utils::SteeringParameters& p);
+
+/** Longitudinal acceleration after the speed limits and the power-limited envelope. */
+double acceleration_constraints(double velocity, double acceleration,
+                                const utils::LongitudinalParameters& p);
+
+} // namespace velox::models
@@ -0,0 +1,293 @@
+#include "vehicle_dynamics_mb.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+#include "tire_model.hpp"
+#include "vehicle_constraints.hpp"
+
+namespace velox::models {
+
+namespace {
+
+// below this longitudinal speed the planar dynamics switch to the kinematic model [m/s]
+constexpr double kKinematicSpeed = 0.1;
+// keeps the slip ratio finite when a wheel's ground speed is clamped to zero [m/s]
+constexpr double kMinWheelSpeed = 1e-6;
+// time constant pulling the wheel speeds to free rolling in the kinematic regime [s], as the
+// kinematic branch of the single-track drift model does
+constexpr double kWheelRelaxation = 0.02;
+
+} // anonymous namespace
+
+MbState init_mb(const double* initial, std::size_t count, const VehicleParameters& p)
+{
+    double s[7] = {};
+    std::copy_n(initial, std::min<std::size_t>(count, 7), s);
+    const double delta0 = s[2], vel0 = s[3], psi0 = s[4], dot_psi0 = s[5], beta0 = s[6];
+
+    // auxiliary initial states
+    const double lwb = p.a + p.b;
+    const double F0_z_f = p.m_s * kGravity * p.b / lwb + p.m_uf * kGravity;
+    const double F0_z_r = p.m_s * kGravity * p.a / lwb + p.m_ur * kGravity;
+
+    MbState x{};
+    // sprung mass states
+    x[0] = s[0];
+    x[1] = s[1];
+    x[2] = delta0;
+    x[3] = std::cos(beta0) * vel0;
+    x[4] = psi0;
+    x[5] = dot_psi0;
+    x[10] = std::sin(beta0) * vel0;
+
+    // unsprung mass states (front)
+    x[15] = std::sin(beta0) * vel0 + p.a * dot_psi0;
+    x[16] = F0_z_f / (2.0 * p.K_zt);
+
+    // unsprung mass states (rear)
+    x[20] = std::sin(beta0) * vel0 - p.b * dot_psi0;
+    x[21] = F0_z_r / (2.0 * p.K_zt);
+
+    // wheel states
+    const double omega0 = x[3] / p.R_w;
+    x[23] = x[24] = x[25] = x[26] = omega0;
+    return x;
+}
+
+void mb_clamp_state(MbState& x)
+{
+    for (std::size_t i = 23; i < 27; ++i) {
+        x[i] = std::max(0.0, x[i]);
+    }
+}
+
+void vehicle_dynamics_mb(const MbState& x,
+                         const StControl& u_init,
+                         const VehicleParameters& p,
+                         MbState& f,
+                         const TireForceTable* tires)
+{
+    const double g = kGravity;
+
+    const double u_steer = steering_constraints(x[2], u_init[0], p.steering);
+    const double u_accel = acceleration_constraints(x[3], u_init[1], p.longitudinal);
+
+    const double sin_delta = std::sin(x[2]);
+    const double cos_delta = std::cos(x[2]);
+    const double sin_phi   = std::sin(x[6]);
+    const double cos_phi   = std::cos(x[6]);
+    const bool kinematic   = std::abs(x[3]) < kKinematicSpeed;
+
+    // vertical tire forces
+    const double F_z_LF = (x[16] + p.R_w * (std::cos(x[13]) - 1.0) - 0.5 * p.T_f * std::sin(x[13])) * p.K_zt;
+    const double F_z_RF = (x[16] + p.R_w * (std::cos(x[13]) - 1.0) + 0.5 * p.T_f * std::sin(x[13])) * p.K_zt;
+    const double F_z_LR = (x[21] + p.R_w * (std::cos(x[18]) - 1.0) - 0.5 * p.T_r * std::sin(x[18])) * p.K_zt;
+    const double F_z_RR = (x[21] + p.R_w * (std::cos(x[18]) - 1.0) + 0.5 * p.T_r * std::sin(x[18])) * p.K_zt;
+
+    // individual tire speeds (negative wheel ground speed forbidden)
+    const double u_w_lf = std::max(0.0, (x[3] + 0.5 * p.T_f * x[5]) * cos_delta + (x[10] + p.a * x[5]) * sin_delta);
+    const double u_w_rf = std::max(0.0, (x[3] - 0.5 * p.T_f * x[5]) * cos_delta + (x[10] + p.a * x[5]) * sin_delta);
+    const double u_w_lr = std::max(0.0, x[3] + 0.5 * p.T_r * x[5]);
+    const double u_w_rr = std::max(0.0, x[3] - 0.5 * p.T_r * x[5]);
+
+    WheelSlip4 slip;
+
+    // longitudinal slip
+    if (!kinematic) {
+        slip.kappa = {1.0 - p.R_w * x[23] / std::max(u_w_lf, kMinWheelSpeed),
+                      1.0 - p.R_w * x[24] / std::max(u_w_rf, kMinWheelSpeed),
+                      1.0 - p.R_w * x[25] / std::max(u_w_lr, kMinWheelSpeed),
+                      1.0 - p.R_w * x[26] / std::max(u_w_rr, kMinWheelSpeed)};
+    }
+
+    // lateral slip angles
+    if (!kinematic) {
+        const double lat_f = x[10] + p.a * x[5] - x[14] * (p.R_w - x[16]);
+        const double lat_r = x[10] - p.b * x[5] - x[19] * (p.R_w - x[21]);
+        slip.alpha = {std::atan(lat_f / (x[3] + 0.5 * p.T_f * x[5])) - x[2],
+                      std::atan(lat_f / (x[3] - 0.5 * p.T_f * x[5])) - x[2],
+                      std::atan(lat_r / (x[3] + 0.5 * p.T_r * x[5])),
+                      std::atan(lat_r / (x[3] - 0.5 * p.T_r * x[5]))};
+    }
+
+    // auxiliary suspension movement
+    const double z_SLF = (p.h_s - p.R_w + x[16] - x[11]) / cos_phi - p.h_s + p.R_w + p.a * x[8] + 0.5 * (x[6] - x[13]) * p.T_f;
+    const double z_SRF = (p.h_s - p.R_w + x[16] - x[11]) / cos_phi - p.h_s + p.R_w + p.a * x[8] - 0.5 * (x[6] - x[13]) * p.T_f;
+    const double z_SLR = (p.h_s - p.R_w + x[21] - x[11]) / cos_phi - p.h_s + p.R_w - p.b * x[8] + 0.5 * (x[6] - x[18]) * p.T_r;
+    const double z_SRR = (p.h_s - p.R_w + x[21] - x[11]) / cos_phi - p.h_s + p.R_w - p.b * x[8] - 0.5 * (x[6] - x[18]) * p.T_r;
+
+    const double dz_SLF = x[17] - x[12] + p.a * x[9] + 0.5 * (x[7] - x[14]) * p.T_f;
+    const double dz_SRF = x[17] - x[12] + p.a * x[9] - 0.5 * (x[7] - x[14]) * p.T_f;
+    const double dz_SLR = x[22] - x[12] - p.b * x[9] + 0.5 * (x[7] - x[19]) * p.T_r;
+    const double dz_SRR = x[22] - x[12] - p.b * x[9] - 0.5 * (x[7] - x[19]) * p.T_r;
+
+    // camber angles
+    slip.gamma = {x[6] + p.D_f * z_SLF + p.E_f * z_SLF * z_SLF,
+                  x[6] - p.D_f * z_SRF - p.E_f * z_SRF * z_SRF,
+                  x[6] + p.D_r * z_SLR + p.E_r * z_SLR * z_SLR,
+                  x[6] - p.D_r * z_SRR - p.E_r * z_SRR * z_SRR};
+    slip.F_z = {F_z_LF, F_z_RF, F_z_LR, F_z_RR};
+
+    // Pacejka pure and combined slip, all four wheels in one pass
+    WheelForces4 forces;
+    if (tires) {
+        tires->forces(slip, forces);
+    } else {
+        tire_forces_4(slip, p.tire, forces);
+    }
+    const double F_x_LF = forces.F_x[0], F_x_RF = forces.F_x[1], F_x_LR = forces.F_x[2], F_x_RR = forces.F_x[3];
+    const double F_y_LF = forces.F_y[0], F_y_RF = forces.F_y[1], F_y_LR = forces.F_y[2], F_y_RR = forces.F_y[3];
+
+    // auxiliary movements for compliant joint equations
+    const double delta_z_f = p.h_s - p.R_w + x[16] - x[11];
+    const double delta_z_r = p.h_s - p.R_w + x[21] - x[11];
+
+    const double delta_phi_f = x[6] - x[13];
+    const double delta_phi_r = x[6] - x[18];
+
+    const double dot_delta_phi_f = x[7] - x[14];
+    const double dot_delta_phi_r = x[7] - x[19];
+
+    const double dot_delta_z_f = x[17] - x[12];
+    const double dot_delta_z_r = x[22] - x[12];
+
+    const double dot_delta_y_f = x[10] + p.a * x[5] - x[15];
+    const double dot_delta_y_r = x[10] - p.b * x[5] - x[20];
+
+    const double delta_f = delta_z_f * sin_phi - x[27] * cos_phi - (p.h_raf - p.R_w) * std::sin(delta_phi_f);
+    const double delta_r = delta_z_r * sin_phi - x[28] * cos_phi - (p.h_rar - p.R_w) * std::sin(delta_phi_r);
+
+    const double dot_delta_f = (delta_z_f * cos_phi + x[27] * sin_phi) * x[7] + dot_delta_z_f * sin_phi -
+                               dot_delta_y_f * cos_phi - (p.h_raf - p.R_w) * std::cos(delta_phi_f) * dot_delta_phi_f;
+    const double dot_delta_r = (delta_z_r * cos_phi + x[28] * sin_phi) * x[7] + dot_delta_z_r * sin_phi -
+                               dot_delta_y_r * cos_phi - (p.h_rar - p.R_w) * std::cos(delta_phi_r) * dot_delta_phi_r;
+
+    // compliant joint forces
+    const double F_RAF = delta_f * p.K_ras + dot_delta_f * p.K_rad;
+    const double F_RAR = delta_r * p.K_ras + dot_delta_r * p.K_rad;
+
+    // auxiliary suspension forces (bump stop and squat/lift forces neglected)
+    const double lwb = p.a + p.b;
+    const double F_SLF = p.m_s * g * p.b / (2.0 * lwb) - z_SLF * p.K_sf - dz_SLF * p.K_sdf + (x[6] - x[13]) * p.K_tsf / p.T_f;
+    const double F_SRF = p.m_s * g * p.b / (2.0 * lwb) - z_SRF * p.K_sf - dz_SRF * p.K_sdf - (x[6] - x[13]) * p.K_tsf / p.T_f;
+    const double F_SLR = p.m_s * g * p.a / (2.0 * lwb) - z_SLR * p.K_sr - dz_SLR * p.K_sdr + (x[6] - x[18]) * p.K_tsr / p.T_r;
+    const double F_SRR = p.m_s * g * p.a / (2.0 * lwb) - z_SRR * p.K_sr - dz_SRR * p.K_sdr - (x[6] - x[18]) * p.K_tsr / p.T_r;
+
+    // auxiliary variables sprung mass
+    const double sumX = F_x_LR + F_x_RR + (F_x_LF + F_x_RF) * cos_delta - (F_y_LF + F_y_RF) * sin_delta;
+
+    const double sumN = (F_y_LF + F_y_RF) * p.a * cos_delta + (F_x_LF + F_x_RF) * p.a * sin_delta +
+                        (F_y_RF - F_y_LF) * 0.5 * p.T_f * sin_delta + (F_x_LF - F_x_RF) * 0.5 * p.T_f * cos_delta +
+                        (F_x_LR - F_x_RR) * 0.5 * p.T_r - (F_y_LR + F_y_RR) * p.b;
+
+    const double sumY_s = (F_RAF + F_RAR) * cos_phi + (F_SLF + F_SLR + F_SRF + F_SRR) * sin_phi;
+
+    const double sumL = 0.5 * F_SLF * p.T_f + 0.5 * F_SLR * p.T_r - 0.5 * F_SRF * p.T_f - 0.5 * F_SRR * p.T_r -
+                        F_RAF / cos_phi * (p.h_s - x[11] - p.R_w + x[16] - (p.h_raf - p.R_w) * std::cos(x[13])) -
+                        F_RAR / cos_phi * (p.h_s - x[11] - p.R_w + x[21] - (p.h_rar - p.R_w) * std::cos(x[18]));
+
+    const double sumZ_s = (F_SLF + F_SLR + F_SRF + F_SRR) * cos_phi - (F_RAF + F_RAR) * sin_phi;
+
+    const double sumM_s = p.a * (F_SLF + F_SRF) - p.b * (F_SLR + F_SRR) +
+                          ((F_x_LF + F_x_RF) * cos_delta - (F_y_LF + F_y_RF) * sin_delta + F_x_LR + F_x_RR) *
+                              (p.h_s - x[11]);
+
+    // auxiliary variables unsprung mass
+    const double sumL_uf = 0.5 * F_SRF * p.T_f - 0.5 * F_SLF * p.T_f - F_RAF * (p.h_raf - p.R_w) +
+                           F_z_LF * (p.R_w * std::sin(x[13]) + 0.5 * p.T_f * std::cos(x[13]) - p.K_lt * F_y_LF) -
+                           F_z_RF * (-p.R_w * std::sin(x[13]) + 0.5 * p.T_f * std::cos(x[13]) + p.K_lt * F_y_RF) -
+                           ((F_y_LF + F_y_RF) * cos_delta + (F_x_LF + F_x_RF) * sin_delta) * (p.R_w - x[16]);
+
+    const double sumL_ur = 0.5 * F_SRR * p.T_r - 0.5 * F_SLR * p.T_r - F_RAR * (p.h_rar - p.R_w) +
+                           F_z_LR * (p.R_w * std::sin(x[18]) + 0.5 * p.T_r * std::cos(x[18]) - p.K_lt * F_y_LR) -
+                           F_z_RR * (-p.R_w * std::sin(x[18]) + 0.5 * p.T_r * std::cos(x[18]) + p.K_lt * F_y_RR) -
+                           (F_y_LR + F_y_RR) * (p.R_w - x[21]);
+
+    const double sumZ_uf = F_z_LF + F_z_RF + F_RAF * sin_phi - (F_SLF + F_SRF) * cos_phi;
+    const double sumZ_ur = F_z_LR + F_z_RR + F_RAR * sin_phi - (F_SLR + F_SRR) * cos_phi;
+
+    const double sumY_uf = (F_y_LF + F_y_RF) * cos_delta + (F_x_LF + F_x_RF) * sin_delta -
+                           F_RAF * cos_phi - (F_SLF + F_SRF) * sin_phi;
+    const double sumY_ur = (F_y_LR + F_y_RR) - F_RAR * cos_phi - (F_SLR + F_SRR) * sin_phi;
+
+    // dynamics common with the single-track model
+    if (kinematic) {
+        // vehicle_dynamics_ks_cog plus the kinematic yaw acceleration
+        const double tan_delta = std::tan(x[2]);
+        const double beta = std::atan(tan_delta * p.b / lwb);
+        f[0] = x[3] * std::cos(beta + x[4]);
+        f[1] = x[3] * std::sin(beta + x[4]);
+        f[2] = u_steer;
+        f[3] = u_accel;
+        f[4] = x[3] * std::cos(beta) * tan_delta / lwb;
+
+        const double tan_ratio = tan_delta * tan_delta * p.b / lwb;
+        const double d_beta = (p.b * u_steer) / (lwb * cos_delta * cos_delta * (1.0 + tan_ratio * tan_ratio));
+        f[5] = 1.0 / lwb * (u_accel * cos_phi * tan_delta - x[3] * sin_phi * d_beta * tan_delta +
+                            x[3] * cos_phi * u_steer / (cos_delta * cos_delta));
+    } else {
+        f[0] = std::cos(x[4]) * x[3] - std::sin(x[4]) * x[10];
+        f[1] = std::sin(x[4]) * x[3] + std::cos(x[4]) * x[10];
+        f[2] = u_steer;
+        f[3] = 1.0 / p.m * sumX + x[5] * x[10];
+        f[4] = x[5];
+        f[5] = 1.0 / (p.I_z - p.I_xz_s * p.I_xz_s / p.I_Phi_s) * (sumN + p.I_xz_s / p.I_Phi_s * sumL);
+    }
+
+    // remaining sprung mass dynamics
+    f[6]  = x[7];
+    f[7]  = 1.0 / (p.I_Phi_s - p.I_xz_s * p.I_xz_s / p.I_z) * (p.I_xz_s / p.I_z * sumN + sumL);
+    f[8]  = x[9];
+    f[9]  = 1.0 / p.I_y_s * sumM_s;
+    f[10] = 1.0 / p.m_s * sumY_s - x[5] * x[3];
+    f[11] = x[12];
+    f[12] = g - 1.0 / p.m_s * sumZ_s;
+
+    // unsprung mass dynamics (front)
+    f[13] = x[14];
+    f[14] = 1.0 / p.I_uf * sumL_uf;
+    f[15] = 1.0 / p.m_uf * sumY_uf - x[5] * x[3];
+    f[16] = x[17];
+    f[17] = g - 1.0 / p.m_uf * sumZ_uf;
+
+    // unsprung mass dynamics (rear)
+    f[18] = x[19];
+    f[19] = 1.0 / p.I_ur * sumL_ur;
+    f[20] = 1.0 / p.m_ur * sumY_ur - x[5] * x[3];
+    f[21] = x[22];
+    f[22] = g - 1.0 / p.m_ur * sumZ_ur;
+
+    // acceleration input as brake and engine torque
+    const double T_B = u_accel > 0.0 ? 0.0 : p.m * p.R_w * u_accel;
+    const double T_E = u_accel > 0.0 ? p.m * p.R_w * u_accel : 0.0;
+
+    // wheel dynamics with the T_sb / T_se torque split
+    const double front = 0.5 * p.T_sb * T_B + 0.5 * p.T_se * T_E;
+    const double rear  = 0.5 * (1.0 - p.T_sb) * T_B + 0.5 * (1.0 - p.T_se) * T_E;
+    f[23] = 1.0 / p.I_y_w * (-p.R_w * F_x_LF + front);
+    f[24] = 1.0 / p.I_y_w * (-p.R_w * F_x_RF + front);
+    f[25] = 1.0 / p.I_y_w * (-p.R_w * F_x_LR + rear);
+    f[26] = 1.0 / p.I_y_w * (-p.R_w * F_x_RR + rear);
+
+    // Without tire forces the kinematic regime would spin the driven wheels up freely and hand
+    // the dynamic regime a huge slip at kKinematicSpeed; roll them with the ground instead.
+    if (kinematic) {
+        f[23] = (u_w_lf / p.R_w - x[23]) / kWheelRelaxation;
+        f[24] = (u_w_rf / p.R_w - x[24]) / kWheelRelaxation;
+        f[25] = (u_w_lr / p.R_w - x[25]) / kWheelRelaxation;
+        f[26] = (u_w_rr / p.R_w - x[26]) / kWheelRelaxation;
+    }
+
+    // negative wheel spin forbidden: a locked wheel is an equilibrium, not a clamp the
+    // integrator keeps running into (spin-up from it stays allowed)
+    for (std::size_t i = 23; i < 27; ++i) {
+        if (x[i] <= 0.0 && f[i] < 0.0) f[i] = 0.0;
+    }
+
+    // compliant joint equations
+    f[27] = dot_delta_y_f;
+    f[28] = dot_delta_y_r;
+}
+
+} // namespace velox::models
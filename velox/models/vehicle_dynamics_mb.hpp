@@ -0,0 +1,57 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+
+#include "tire_table.hpp"
+#include "vehicle_dynamics_st.hpp"
+
+namespace velox::models {
+
+/**
+ * Multi-body state layout (CommonRoad MB, 29 states):
+ *   0  x            1  y            2  delta        3  v_x          4  psi
+ *   5  psi_dot      6  phi (roll)   7  phi_dot      8  theta (pitch) 9  theta_dot
+ *  10  v_y         11  z           12  v_z
+ *  13  phi_uf      14  phi_dot_uf  15  v_y_uf      16  z_uf        17  v_z_uf
+ *  18  phi_ur      19  phi_dot_ur  20  v_y_ur      21  z_ur        22  v_z_ur
+ *  23  omega_LF    24  omega_RF    25  omega_LR    26  omega_RR
+ *  27  delta_y_f   28  delta_y_r
+ */
+inline constexpr std::size_t kMbStateSize = 29;
+
+using MbState = std::array<double, kMbStateSize>;
+
+/**
+ * Builds the MB state from [x, y, delta, v, psi, psi_dot, beta] (init_mb): sprung and
+ * unsprung masses at static equilibrium, wheels rolling without slip.
+ */
+MbState init_mb(const double* initial, std::size_t count, const VehicleParameters& p);
+
+/** Negative wheel spin is forbidden: clamps the four wheel speeds to >= 0 after a step. */
+void mb_clamp_state(MbState& x);
+
+/**
+ * vehicle_dynamics_mb
+ *
+ * Multi-body right-hand side of the CommonRoad vehicle models. Consumes the full
+ * VehicleParameters set: suspension K_sf/K_sdf/K_sr/K_sdr, anti-roll K_tsf/K_tsr, compliant pin
+ * joint K_ras/K_rad, tire K_zt/K_lt, inertias I_Phi_s/I_y_s/I_z/I_xz_s/I_uf/I_ur/I_y_w, camber
+ * D_f/D_r/E_f/E_r, torque split T_sb/T_se and the Pacejka tire, whose four wheels are evaluated
+ * in one tire_forces_4 call. Below |v_x| = 0.1 m/s the planar part switches to the kinematic
+ * single-track model, as in the reference.
+ *
+ * @param x       state, see kMbStateSize
+ * @param u_init  control [steering rate, acceleration] before constraints
+ * @param p       vehicle parameters
+ * @param f       output derivative, written in place (no allocation)
+ * @param tires   optional tabulated tire forces for p.tire (throughput mode); nullptr evaluates
+ *                the Magic Formula directly
+ */
+void vehicle_dynamics_mb(const MbState& x,
+                         const StControl& u_init,
+                         const VehicleParameters& p,
+                         MbState& f,
+                         const TireForceTable* tires = nullptr);
+
+} // namespace velox::models
@@ -0,0 +1,88 @@
+#include "vehicle_dynamics_st.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+namespace velox::models {
+
+namespace {
+
+// Same semantics as clamp() in dynamics.ts: non-finite values collapse to 0.
+double clamp_finite(double value, double lo, double hi)
+{
+    if (!std::isfinite(value)) return 0.0;
+    return std::min(std::max(value, lo), hi);
+}
+
+} // anonymous namespace
+
+double st_friction_coefficient(const VehicleParameters& p)
+{
+    return (std::isfinite(p.tire.p_dy1) && p.tire.p_dy1 > 0.0) ? p.tire.p_dy1 : 0.8;
+}
+
+double st_friction_coefficient(const SingleTrackParameters& p)
+{
+    if (std::isfinite(p.mu) && p.mu > 0.0) return p.mu;
+    return p.lat_accel_max > 0.0 ? p.lat_accel_max / kGravity : 0.8;
+}
+
+double st_steering_rate_constraint(double rate, const VehicleParameters& p)
+{
+    return clamp_finite(rate, p.steering.v_min, p.steering.v_max);
+}
+
+double st_steering_angle_constraint(double angle, const VehicleParameters& p)
+{
+    return clamp_finite(angle, p.steering.min, p.steering.max);
+}
+
+double st_acceleration_constraint(double accel, const VehicleParameters& p)
+{
+    return clamp_finite(accel, -p.longitudinal.a_max, p.longitudinal.a_max);
+}
+
+void vehicle_dynamics_st(const StState& x,
+                         const StControl& u_init,
+                         const VehicleParameters& p,
+                         StState& f)
+{
+    vehicle_dynamics_st(x, u_init, derive_vehicle_constants(p), f);
+}
+
+void vehicle_dynamics_st(const StState& x,
+                         const StControl& u_init,
+                         const DerivedVehicleConstants& c,
+                         StState& f)
+{
+    const double L = c.wheelbase;
+    const double steer_rate    = clamp_finite(u_init[0], c.steer_rate_min, c.steer_rate_max);
+    const double accel_command = clamp_finite(u_init[1], c.a_min, c.a_max);
+    const double delta_raw     = clamp_finite(x[4], c.steer_min, c.steer_max);
+    const double v   = x[3];
+    const double psi = x[2];
+
+    const double accel_budget = c.accel_budget;
+
+    const double v_abs = std::abs(v);
+    double delta = delta_raw;
+    if (accel_budget > 0.0 && v_abs > 1e-6) {
+        const double max_delta_for_lat = std::atan(c.budget_wheelbase / (v_abs * v_abs));
+        delta = clamp_finite(delta_raw, -max_delta_for_lat, max_delta_for_lat);
+    }
+
+    const double beta          = std::atan(c.rear_ratio * std::tan(delta));
+    const double curvature     = std::sin(beta) / L;
+    const double lateral_accel = v * v * curvature;
+    const double accel_limit   = std::sqrt(std::max(0.0, c.accel_budget_sq -
+                                                         lateral_accel * lateral_accel));
+    const double accel = clamp_finite(accel_command, -accel_limit, accel_limit);
+
+    f[0] = v * std::cos(psi + beta);
+    f[1] = v * std::sin(psi + beta);
+    f[2] = v * curvature;
+    f[3] = accel;
+    f[4] = steer_rate;
+}
+
+} // namespace velox::models
@@ -0,0 +1,75 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+
+#include "vehicle_constants.hpp"
+#include "vehicle_parameters.hpp"
+
+namespace velox::models {
+
+/// Single-track state layout: [x, y, psi, v, delta].
+inline constexpr std::size_t kStStateSize = 5;
+/// Single-track control layout: [steering rate, longitudinal acceleration].
+inline constexpr std::size_t kStControlSize = 2;
+
+using StState   = std::array<double, kStStateSize>;
+using StControl = std::array<double, kStControlSize>;
+
+inline constexpr double kGravity = 9.81;
+
+/**
+ * Friction coefficient used for the combined acceleration budget of the ST model on a
+ * CommonRoad parameter set: the peak lateral tire coefficient p_dy1 when positive, otherwise
+ * 0.8. Those sets carry no mu or lat_accel_max, so this is not the JS chain; see the
+ * single-track overload for that.
+ */
+double st_friction_coefficient(const VehicleParameters& p);
+
+/**
+ * The JS fallback chain of vehicleDynamicsST and clampKinematicControl: mu when finite and
+ * positive, otherwise lat_accel_max / g when positive, otherwise 0.8.
+ */
+double st_friction_coefficient(const SingleTrackParameters& p);
+
+/** Clamp a steering rate to [steering.v_min, steering.v_max]. Non-finite input maps to 0. */
+double st_steering_rate_constraint(double rate, const VehicleParameters& p);
+
+/** Clamp a steering angle to [steering.min, steering.max]. Non-finite input maps to 0. */
+double st_steering_angle_constraint(double angle, const VehicleParameters& p);
+
+/** Clamp a longitudinal acceleration to [-longitudinal.a_max, longitudinal.a_max]. */
+double st_acceleration_constraint(double accel, const VehicleParameters& p);
+
+/**
+ * vehicle_dynamics_st
+ *
+ * Friction-limited kinematic single-track right-hand side with the structure of
+ * vehicleDynamicsST in velox/models/dynamics.ts (l_f = a, l_r = b), on a CommonRoad parameter
+ * set: friction from st_friction_coefficient(const VehicleParameters&) and the acceleration
+ * clamped to +-longitudinal.a_max. Numerically identical to the JS model only through the
+ * constants overload fed by derive_vehicle_constants(const SingleTrackParameters&).
+ *
+ * @param x       state [x, y, psi, v, delta]
+ * @param u_init  control [steering rate, acceleration] before constraints
+ * @param p       vehicle parameters
+ * @param f       output derivative, written in place (no allocation)
+ *
+ * Derives the vehicle constants on every call (and so throws like derive_vehicle_constants);
+ * stepping code should hold them and call the overload below.
+ */
+void vehicle_dynamics_st(const StState& x,
+                         const StControl& u_init,
+                         const VehicleParameters& p,
+                         StState& f);
+
+/**
+ * vehicle_dynamics_st on constants from derive_vehicle_constants: bit-identical to the above
+ * for a VehicleParameters set, and to vehicleDynamicsST for a SingleTrackParameters set.
+ */
+void vehicle_dynamics_st(const StState& x,
+                         const StControl& u_init,
+                         const DerivedVehicleConstants& c,
+                         StState& f);
+
+} // namespace velox::models
@@ -0,0 +1,182 @@
+#include "vehicle_dynamics_std.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+#include "tire_model.hpp"
+#include "vehicle_constraints.hpp"
+
+namespace velox::models {
+
+namespace {
+
+// blending between the dynamic and kinematic model
+constexpr double kBlendSpeed = 0.2;  // v_s [m/s]
+constexpr double kBlendWidth = 0.05; // v_b [m/s]
+constexpr double kMinSpeed   = kBlendSpeed / 2.0;
+// time constant pulling the wheel speeds to free rolling in the kinematic regime [s]
+constexpr double kWheelRelaxation = 0.02;
+
+} // anonymous namespace
+
+StdState init_std(const double* initial, std::size_t count, const VehicleParameters& p)
+{
+    StdState x{};
+    const std::size_t n = std::min<std::size_t>(count, 7);
+    for (std::size_t i = 0; i < n; ++i) {
+        x[i] = initial[i];
+    }
+    const double R_w = p.R_w > 0.0 ? p.R_w : 1.0;
+    x[7] = x[3] * std::cos(x[6]) * std::cos(x[2]) / R_w;
+    x[8] = x[3] * std::cos(x[6]) / R_w;
+    return x;
+}
+
+void std_clamp_state(StdState& x)
+{
+    x[7] = std::max(0.0, x[7]);
+    x[8] = std::max(0.0, x[8]);
+}
+
+StdHotParameters std_hot_parameters(const VehicleParameters& p)
+{
+    StdHotParameters h;
+    h.lf = p.a;
+    h.lr = p.b;
+    h.lwb = p.a + p.b;
+    h.m = p.m;
+    h.inv_m = 1.0 / p.m;
+    h.h_s = p.h_s;
+    h.inv_I_z = 1.0 / p.I_z;
+    h.R_w = p.R_w;
+    h.inv_I_y_w = 1.0 / p.I_y_w;
+    h.m_R_w = p.m * p.R_w;
+    h.T_sb = p.T_sb;
+    h.T_se = p.T_se;
+    h.rear_brake_split = 1.0 - p.T_sb;
+    h.rear_engine_split = 1.0 - p.T_se;
+    h.inv_lwb = 1.0 / h.lwb;
+    h.steering = p.steering;
+    h.longitudinal = p.longitudinal;
+    h.tire = p.tire;
+    return h;
+}
+
+void vehicle_dynamics_std(const StdState& x,
+                          const StControl& u_init,
+                          const VehicleParameters& p,
+                          StdState& f,
+                          const TireForceTable* tires)
+{
+    vehicle_dynamics_std(x, u_init, std_hot_parameters(p), f, tires);
+}
+
+void vehicle_dynamics_std(const StdState& x,
+                          const StControl& u_init,
+                          const StdHotParameters& p,
+                          StdState& f,
+                          const TireForceTable* tires)
+{
+    const double lf  = p.lf;
+    const double lr  = p.lr;
+    const double lwb = p.lwb;
+    const double m   = p.m;
+
+    const double delta = x[2];
+    const double v     = x[3];
+    const double psi   = x[4];
+    const double r     = x[5];
+    const double beta  = x[6];
+    const double omega_f = std::max(0.0, x[7]);
+    const double omega_r = std::max(0.0, x[8]);
+
+    const double u_steer = steering_constraints(delta, u_init[0], p.steering);
+    const double u_accel = acceleration_constraints(v, u_init[1], p.longitudinal);
+
+    const double sin_beta  = std::sin(beta);
+    const double cos_beta  = std::cos(beta);
+    const double sin_delta = std::sin(delta);
+    const double cos_delta = std::cos(delta);
+
+    // lateral tire slip angles
+    const bool dynamic = v > kMinSpeed;
+    const double alpha_f = dynamic ? std::atan((v * sin_beta + r * lf) / (v * cos_beta)) - delta : 0.0;
+    const double alpha_r = dynamic ? std::atan((v * sin_beta - r * lr) / (v * cos_beta)) : 0.0;
+
+    // vertical tire forces
+    const double F_zf = m * (-u_accel * p.h_s + kGravity * lr) / lwb;
+    const double F_zr = m * (u_accel * p.h_s + kGravity * lf) / lwb;
+
+    // front and rear tire speeds
+    const double u_wf = std::max(0.0, v * cos_beta * cos_delta + (v * sin_beta + lf * r) * sin_delta);
+    const double u_wr = std::max(0.0, v * cos_beta);
+
+    // longitudinal tire slip
+    const double s_f = 1.0 - p.R_w * omega_f / std::max(u_wf, kMinSpeed);
+    const double s_r = 1.0 - p.R_w * omega_r / std::max(u_wr, kMinSpeed);
+
+    // Pacejka forces, front and rear in lanes 0/1 (2/3 duplicate them to stay well defined)
+    WheelSlip4 slip;
+    slip.kappa = {s_f, s_r, s_f, s_r};
+    slip.alpha = {alpha_f, alpha_r, alpha_f, alpha_r};
+    slip.gamma = {0.0, 0.0, 0.0, 0.0};
+    slip.F_z   = {F_zf, F_zr, F_zf, F_zr};
+    WheelForces4 forces;
+    if (tires) {
+        tires->forces(slip, forces);
+    } else {
+        tire_forces_4(slip, p.tire, forces);
+    }
+    const double F_xf = forces.F_x[0];
+    const double F_xr = forces.F_x[1];
+    const double F_yf = forces.F_y[0];
+    const double F_yr = forces.F_y[1];
+
+    // acceleration input as brake and engine torque
+    const double T_B = u_accel > 0.0 ? 0.0 : p.m_R_w * u_accel;
+    const double T_E = u_accel > 0.0 ? p.m_R_w * u_accel : 0.0;
+
+    // dynamic model
+    const double d_v = p.inv_m * (-F_yf * std::sin(delta - beta) + F_yr * sin_beta +
+                                  F_xr * cos_beta + F_xf * std::cos(delta - beta));
+    const double dd_psi = p.inv_I_z * (F_yf * cos_delta * lf - F_yr * lr + F_xf * sin_delta * lf);
+    const double d_beta = dynamic
+        ? -r + 1.0 / (m * v) * (F_yf * std::cos(delta - beta) + F_yr * cos_beta -
+                                F_xr * sin_beta + F_xf * std::sin(delta - beta))
+        : 0.0;
+
+    // wheel dynamics (negative wheel spin forbidden; a locked wheel is an equilibrium)
+    const auto wheel = [](double omega, double d_omega) { return omega <= 0.0 && d_omega < 0.0 ? 0.0 : d_omega; };
+    const double d_omega_f =
+        wheel(x[7], p.inv_I_y_w * (-p.R_w * F_xf + p.T_sb * T_B + p.T_se * T_E));
+    const double d_omega_r =
+        wheel(x[8], p.inv_I_y_w * (-p.R_w * F_xr + p.rear_brake_split * T_B + p.rear_engine_split * T_E));
+
+    // kinematic model (vehicle_dynamics_ks_cog) for low speeds
+    const double tan_delta = std::tan(delta);
+    const double beta_ks   = std::atan(tan_delta * lr / lwb);
+    const double d_psi_ks  = v * std::cos(beta_ks) * tan_delta / lwb;
+    const double tan_ratio = tan_delta * tan_delta * lr / lwb;
+    const double d_beta_ks = (lr * u_steer) / (lwb * cos_delta * cos_delta * (1.0 + tan_ratio * tan_ratio));
+    const double dd_psi_ks = p.inv_lwb * (u_accel * cos_beta * tan_delta -
+                                          v * sin_beta * d_beta_ks * tan_delta +
+                                          v * cos_beta * u_steer / (cos_delta * cos_delta));
+    const double d_omega_f_ks = (u_wf / p.R_w - omega_f) / kWheelRelaxation;
+    const double d_omega_r_ks = (u_wr / p.R_w - omega_r) / kWheelRelaxation;
+
+    // mix both models
+    const double w_std = 0.5 * (std::tanh((v - kBlendSpeed) / kBlendWidth) + 1.0);
+    const double w_ks  = 1.0 - w_std;
+
+    f[0] = v * std::cos(beta + psi);
+    f[1] = v * std::sin(beta + psi);
+    f[2] = u_steer;
+    f[3] = w_std * d_v + w_ks * u_accel;
+    f[4] = w_std * r + w_ks * d_psi_ks;
+    f[5] = w_std * dd_psi + w_ks * dd_psi_ks;
+    f[6] = w_std * d_beta + w_ks * d_beta_ks;
+    f[7] = w_std * d_omega_f + w_ks * d_omega_f_ks;
+    f[8] = w_std * d_omega_r + w_ks * d_omega_r_ks;
+}
+
+} // namespace velox::models
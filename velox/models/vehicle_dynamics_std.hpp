@@ -0,0 +1,95 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+
+#include "tire_table.hpp"
+#include "vehicle_dynamics_st.hpp"
+
+namespace velox::models {
+
+/**
+ * Single-track drift state layout (CommonRoad STD):
+ *   [x, y, delta, v, psi, psi_dot, beta, omega_f, omega_r]
+ * Note that delta and psi swap places relative to the kinematic ST layout.
+ */
+inline constexpr std::size_t kStdStateSize = 9;
+
+using StdState = std::array<double, kStdStateSize>;
+
+/**
+ * Builds the STD state from [x, y, delta, v, psi, psi_dot, beta]; missing entries are zero and
+ * the wheel speeds start rolling without slip.
+ */
+StdState init_std(const double* initial, std::size_t count, const VehicleParameters& p);
+
+/** Negative wheel spin is forbidden: clamps omega_f / omega_r to >= 0 after a step. */
+void std_clamp_state(StdState& x);
+
+/**
+ * StdHotParameters
+ *
+ * The fields vehicle_dynamics_std reads, copied out of VehicleParameters once (std_hot_parameters)
+ * so one right-hand-side evaluation touches eight contiguous cache lines instead of picking
+ * values out of the full struct, where trailer, camber and MB-only fields sit in between. The
+ * reciprocals and products are the subexpressions the right-hand side evaluates first, so the
+ * result is bit-identical to reading VehicleParameters. VehicleParameters stays the authoring
+ * and serialization form; this view is never written back.
+ */
+struct alignas(64) StdHotParameters {
+    // --- chassis (first cache line)
+    double lf{};       // a [m]
+    double lr{};       // b [m]
+    double lwb{};      // a + b [m]
+    double m{};        // [kg]
+    double inv_m{};    // 1 / m
+    double h_s{};      // [m]
+    double inv_I_z{};  // 1 / I_z
+    double R_w{};      // [m]
+
+    // --- wheels
+    double inv_I_y_w{};         // 1 / I_y_w
+    double m_R_w{};             // m * R_w, acceleration to wheel torque
+    double T_sb{};              // front brake split
+    double T_se{};              // front engine split
+    double rear_brake_split{};  // 1 - T_sb
+    double rear_engine_split{}; // 1 - T_se
+    double inv_lwb{};           // 1 / (a + b)
+
+    // --- input constraints and tire
+    utils::SteeringParameters steering{};
+    utils::LongitudinalParameters longitudinal{};
+    utils::TireParameters tire{};
+};
+
+/** Builds the STD hot view of p; done once per simulator, not per step. */
+StdHotParameters std_hot_parameters(const VehicleParameters& p);
+
+/**
+ * vehicle_dynamics_std
+ *
+ * Single-track drift right-hand side of the CommonRoad vehicle models: Pacejka combined-slip
+ * forces on a front and a rear tire, wheel spin dynamics with the T_sb / T_se torque split, and
+ * a tanh blend into the kinematic model below 0.2 m/s.
+ *
+ * @param x       state, see kStdStateSize
+ * @param u_init  control [steering rate, acceleration] before constraints
+ * @param p       vehicle parameters (a, b, m, I_z, h_s, R_w, I_y_w, T_sb, T_se, tire)
+ * @param f       output derivative, written in place (no allocation)
+ * @param tires   optional tabulated tire forces for p.tire (throughput mode); nullptr evaluates
+ *                the Magic Formula directly
+ */
+void vehicle_dynamics_std(const StdState& x,
+                          const StControl& u_init,
+                          const VehicleParameters& p,
+                          StdState& f,
+                          const TireForceTable* tires = nullptr);
+
+/** vehicle_dynamics_std on a view from std_hot_parameters; bit-identical to the above. */
+void vehicle_dynamics_std(const StdState& x,
+                          const StControl& u_init,
+                          const StdHotParameters& p,
+                          StdState& f,
+                          const TireForceTable* tires = nullptr);
+
+} // namespace velox::models
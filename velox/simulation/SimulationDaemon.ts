@@ -14,6 +14,7 @@ import { ConfigManager, type Fetcher } from '../io/ConfigManager';
 import { ControlMode, ModelType } from './types';
 import type { ModelTimingInfo } from './types';
 import { BackendSnapshot, HybridSimulationBackend, SimulationBackend } from './backend';
+import { nativeYamlParser, type VeloxNativeModule } from './nativeBackend';
 import { ModelParameters, isSingleTrackParameters } from '../models/types';
 import { stAccelerationConstraint, stSteeringRateConstraint } from '../models/constraints';
 export { ControlMode, ModelType } from './types';
@@ -178,10 +179,23 @@ export interface InitParams {
   drift_enabled?: boolean;
   control_mode?: ControlMode;
   backend?: SimulationBackend;
+  /**
+   * Compiled native core; when present the ST model steps in C++ instead of JS, and the default
+   * ConfigManager parses YAML with the native reader (nativeYamlParser).
+   */
+  native_module?: VeloxNativeModule | Promise<VeloxNativeModule | undefined>;
   config_manager?: ConfigManager;
   config_fetcher?: Fetcher;
   limits?: UserInputLimits;
   timing?: ModelTimingInfo;
+  /**
+   * Lets a backend with its own scheduler (the native engine's velox_st_advance) pick the
+   * substeps by local error instead of stepping planSteps. Off by default: the scheduler is
+   * capped at the same max_dt, so it never takes fewer substeps than the plan and each attempt
+   * costs two engine steps; it buys accuracy near the limits, not speed. The backend's low-speed
+   * latch then moves once per frame rather than once per substep.
+   */
+  adaptive_substeps?: boolean;
   initial_state?: number[];
 }
 
@@ -215,7 +229,7 @@ const kDefaultTimings: Record<ModelType, ModelTimingInfo> = {
 };
 
 class ModelTiming {
-  constructor(private info: ModelTimingInfo) {}
+  constructor(readonly info: ModelTimingInfo) {}
 
   planSteps(requested_dt: number): StepSchedule {
     if (!Number.isFinite(requested_dt)) {
@@ -303,12 +317,23 @@ export class SimulationDaemon {
     this.driftEnabled = init.drift_enabled ?? false;
     this.controlMode = init.control_mode ?? ControlMode.Keyboard;
     this.configManager =
-      init.config_manager ?? new ConfigManager(init.config_root, init.parameter_root, init.config_fetcher);
+      init.config_manager ??
+      new ConfigManager(
+        init.config_root,
+        init.parameter_root,
+        init.config_fetcher,
+        init.native_module
+          ? Promise.resolve(init.native_module)
+              .then((module) => (module ? nativeYamlParser(module) : undefined))
+              .catch(() => undefined)
+          : undefined,
+      );
     this.backend = init.backend ?? new HybridSimulationBackend({
       model: this.model,
       vehicleId: this.vehicleId,
       configManager: this.configManager,
       driftEnabled: this.driftEnabled,
+      nativeModule: this.init.native_module,
     });
     this.limits = init.limits ?? new UserInputLimits();
     const timingInfo = init.timing ?? kDefaultTimings[this.model];
@@ -356,32 +381,22 @@ export class SimulationDaemon {
     const schedule = this.timing.planSteps(sanitized.dt);
     this.lastDt = schedule.clamped_dt;
 
-    let accelCommand = 0;
-    let steerRate = 0;
-    for (const dt of schedule.substeps) {
-      if (sanitized.control_mode === ControlMode.Direct) {
-        accelCommand = this.directAccelerationFromTorque(sanitized.axle_torques ?? []);
-        steerRate = sanitized.steering_rate ?? 0;
-      } else {
-        const nudge = sanitized.steering_nudge ?? 0;
-        steerRate = nudge;
-        if (this.params && isSingleTrackParameters(this.params)) {
-          const accelMax = Math.max(this.params.accel.max ?? this.limits.max_accel, 0);
-          const accelMin = Math.min(this.params.accel.min ?? this.limits.min_accel, 0);
-          const throttleScale = Math.abs(accelMax);
-          const brakeScale = Math.abs(accelMin);
-          accelCommand = (sanitized.longitudinal.throttle ?? 0) * throttleScale -
-            (sanitized.longitudinal.brake ?? 0) * brakeScale;
-        } else {
-          accelCommand = sanitized.longitudinal.throttle - sanitized.longitudinal.brake;
-        }
+    const [steerRate, accelCommand] = this.controlCommand(sanitized);
+    const control = this.clampControl([steerRate, accelCommand]);
+    // With adaptive_substeps, a backend with its own scheduler sizes the substeps by local
+    // error; otherwise, and for backends without one, the fixed plan runs.
+    const substeps =
+      this.init.adaptive_substeps && this.backend.advance
+        ? await this.backend.advance(control, sanitized.dt, this.timing.info)
+        : 0;
+    if (substeps === 0) {
+      for (const dt of schedule.substeps) {
+        await this.backend.step(control, dt);
+        const speed = this.backend.speed();
+        this.cumulativeDistance += Math.abs(speed) * dt;
+        this.cumulativeEnergy += accelCommand * speed * dt;
+        this.simulationTime += dt;
       }
-      const control = [steerRate, accelCommand];
-      await this.backend.step(this.clampControl(control), dt);
-      const speed = this.backend.speed();
-      this.cumulativeDistance += Math.abs(speed) * dt;
-      this.cumulativeEnergy += accelCommand * speed * dt;
-      this.simulationTime += dt;
     }
 
     this.lastTelemetry = this.buildTelemetry(this.backend.snapshot());
@@ -391,6 +406,10 @@ export class SimulationDaemon {
     return this.lastTelemetry;
   }
 
+  /**
+   * Applies a sequence of inputs to this one vehicle. Stepping many independent vehicles at
+   * once belongs to NativeStBatch (nativeBackend.ts), which advances them in SIMD lanes.
+   */
   async stepBatch(inputs: UserInput[]): Promise<SimulationTelemetry[]> {
     const outputs: SimulationTelemetry[] = [];
     for (const entry of inputs) {
@@ -436,6 +455,25 @@ export class SimulationDaemon {
     return telemetry;
   }
 
+  /** [steering rate, longitudinal acceleration] for the sanitized input; held for the whole frame. */
+  private controlCommand(sanitized: UserInput): [number, number] {
+    if (sanitized.control_mode === ControlMode.Direct) {
+      return [sanitized.steering_rate ?? 0, this.directAccelerationFromTorque(sanitized.axle_torques ?? [])];
+    }
+    const steerRate = sanitized.steering_nudge ?? 0;
+    if (this.params && isSingleTrackParameters(this.params)) {
+      const accelMax = Math.max(this.params.accel.max ?? this.limits.max_accel, 0);
+      const accelMin = Math.min(this.params.accel.min ?? this.limits.min_accel, 0);
+      const throttleScale = Math.abs(accelMax);
+      const brakeScale = Math.abs(accelMin);
+      return [
+        steerRate,
+        (sanitized.longitudinal.throttle ?? 0) * throttleScale - (sanitized.longitudinal.brake ?? 0) * brakeScale,
+      ];
+    }
+    return [steerRate, sanitized.longitudinal.throttle - sanitized.longitudinal.brake];
+  }
+
   private clampControl(control: number[]): number[] {
     if (!this.params || !isSingleTrackParameters(this.params) || this.model !== ModelType.ST) {
       return control;
@@ -474,6 +512,7 @@ export class SimulationDaemon {
         vehicleId: this.vehicleId,
         configManager: this.configManager,
         driftEnabled: this.driftEnabled,
+        nativeModule: this.init.native_module,
       });
     }
     const timingInfo = this.init.timing ?? await this.configManager.loadModelTiming(this.model).catch(() => kDefaultTimings[this.model]);
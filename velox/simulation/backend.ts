@@ -1,7 +1,8 @@
-import { ConfigManager } from '../io/ConfigManager';
-import { ModelType } from './types';
+import { ConfigManager, parseYamlLike } from '../io/ConfigManager';
+import { ModelTimingInfo, ModelType } from './types';
 import type { SimulationTelemetry } from '../telemetry/index';
 import { JsSimulationBackend } from './jsBackend';
+import { NativeSimulationBackend, type VeloxNativeModule } from './nativeBackend';
 
 export interface BackendSnapshot {
   state: number[];
@@ -14,6 +15,11 @@ export interface SimulationBackend {
   ready?: Promise<void>;
   reset(state: number[], dt: number): void | Promise<void>;
   step(control: number[], dt: number): void | Promise<void>;
+  /**
+   * Advances a whole frame with the control held, choosing the substeps itself. Returns the
+   * number of substeps taken, or 0 when the backend cannot and the caller must step a plan.
+   */
+  advance?(control: number[], frameDt: number, timing: ModelTimingInfo): number | Promise<number>;
   snapshot(): BackendSnapshot;
   speed(): number;
 }
@@ -33,7 +39,11 @@ interface LowSpeedSafetyConfig {
 }
 
 /**
- * Simple backend wrapper that always uses the JS kinematic bicycle model.
+ * Backend wrapper that steps the native single-track engine when a compiled module is supplied
+ * and otherwise falls back to the JS kinematic bicycle model. Both delegates are built from the
+ * same single-track parameters and low-speed safety config (ConfigManager), so switching between
+ * them does not change the simulated vehicle; when the configs cannot be loaded the native engine
+ * is skipped and the JS backend runs on defaults.
  */
 export class HybridSimulationBackend implements SimulationBackend {
   private delegate!: SimulationBackend;
@@ -45,6 +55,7 @@ export class HybridSimulationBackend implements SimulationBackend {
       vehicleId?: number;
       configManager: ConfigManager;
       driftEnabled: boolean;
+      nativeModule?: VeloxNativeModule | Promise<VeloxNativeModule | undefined>;
     }
   ) {
     this.ready = this.initialize();
@@ -60,6 +71,11 @@ export class HybridSimulationBackend implements SimulationBackend {
     return this.delegate.step(control, dt);
   }
 
+  async advance(control: number[], frameDt: number, timing: ModelTimingInfo): Promise<number> {
+    await this.ready;
+    return this.delegate.advance ? this.delegate.advance(control, frameDt, timing) : 0;
+  }
+
   snapshot(): BackendSnapshot {
     return this.delegate.snapshot();
   }
@@ -70,15 +86,24 @@ export class HybridSimulationBackend implements SimulationBackend {
 
   private async initialize(): Promise<void> {
     const model = this.options.model ?? ModelType.ST;
-    const vehicleId = this.options.vehicleId ?? 0;
-    const fallbackDefaults = await this.loadConfigs(this.options.configManager, vehicleId, model).catch((error) => {
+    // SimulationDaemon's default vehicle; there is no vehicle 0.
+    const vehicleId = this.options.vehicleId ?? 2;
+    const configs = await this.loadConfigs(this.options.configManager, vehicleId, model).catch((error) => {
       console.warn(`HybridSimulationBackend failed to load configs; using defaults: ${error}`);
-      return {
-        vehicle: {},
-        lowSpeed: defaultLowSpeedSafety(),
-      };
+      return undefined;
     });
 
+    const native = configs ? await this.createNativeDelegate(model, configs) : undefined;
+    if (native) {
+      this.delegate = native;
+      return;
+    }
+
+    const fallbackDefaults = configs ?? {
+      vehicle: {},
+      lowSpeed: defaultLowSpeedSafety(),
+    };
+
     this.delegate = new JsSimulationBackend({
       model,
       params: fallbackDefaults.vehicle as any,
@@ -87,6 +112,30 @@ export class HybridSimulationBackend implements SimulationBackend {
     });
   }
 
+  private async createNativeDelegate(
+    model: ModelType,
+    configs: { vehicle: Record<string, unknown>; lowSpeed: LowSpeedSafetyConfig }
+  ): Promise<SimulationBackend | undefined> {
+    if (!this.options.nativeModule || model !== ModelType.ST) {
+      return undefined;
+    }
+    try {
+      const module = await this.options.nativeModule;
+      return module
+        ? new NativeSimulationBackend({
+            module,
+            vehicleId: this.options.vehicleId ?? 2,
+            singleTrack: configs.vehicle as any,
+            lowSpeed: configs.lowSpeed,
+            driftEnabled: this.options.driftEnabled,
+          })
+        : undefined;
+    } catch (error) {
+      console.warn(`HybridSimulationBackend native engine unavailable; using JS backend: ${error}`);
+      return undefined;
+    }
+  }
+
   private async loadConfigs(configManager: ConfigManager, vehicleId: number, model: ModelType) {
     const [vehicle, lowSpeedDoc] = await Promise.all([
       configManager.loadModelParameters(vehicleId, model),
@@ -112,32 +161,6 @@ function parseConfigDocument(document: unknown): Record<string, unknown> {
   return {};
 }
 
-function parseYamlLike(document: string): Record<string, unknown> {
-  const result: Record<string, unknown> = {};
-  const lines = document.split(/\r?\n/).filter((line) => line.trim().length > 0 && !line.trim().startsWith('#'));
-  const stack: Array<{ indent: number; target: Record<string, unknown> }> = [{ indent: -1, target: result }];
-
-  for (const raw of lines) {
-    const match = raw.match(/^(\s*)([^:]+):\s*(.*)$/);
-    if (!match) continue;
-    const [, spaces, key, value] = match;
-    const indent = spaces.length;
-    while (stack.length > 1 && indent <= stack[stack.length - 1].indent) {
-      stack.pop();
-    }
-    const parent = stack[stack.length - 1].target;
-    if (value === '') {
-      const child: Record<string, unknown> = {};
-      parent[key.trim()] = child;
-      stack.push({ indent, target: child });
-    } else {
-      const numeric = Number(value);
-      parent[key.trim()] = Number.isFinite(numeric) ? numeric : value.trim();
-    }
-  }
-  return result;
-}
-
 function ensureObject(value: unknown): Record<string, unknown> {
   if (value && typeof value === 'object') {
     return value as Record<string, unknown>;
@@ -177,6 +200,7 @@ function normalizeLowSpeedSafety(raw: Record<string, any>): LowSpeedSafetyConfig
 
 function coerceBoolean(value: any, fallback: boolean): boolean {
   if (typeof value === 'boolean') return value;
+  if (value === 0 || value === 1) return value === 1; // nativeYamlParser reports booleans as 0/1
   if (value === 'true') return true;
   if (value === 'false') return false;
   return fallback;
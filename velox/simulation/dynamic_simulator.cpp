@@ -0,0 +1,115 @@
+#include "dynamic_simulator.hpp"
+
+#include <algorithm>
+#include <stdexcept>
+#include <string>
+#include <utility>
+
+#include "telemetry/instrumentation.hpp"
+
+namespace velox::simulation {
+
+template <typename Model>
+DynamicSimulator<Model>::DynamicSimulator(const models::VehicleParameters& params, double dt,
+                                          Integrator integrator)
+    : params_(&params)
+    , hot_(Model::hot(params))
+    , integrator_(integrator)
+{
+    set_dt(dt);
+    const double zero[1] = {0.0};
+    reset(zero, 0);
+}
+
+template <typename Model>
+DynamicSimulator<Model>::DynamicSimulator(std::shared_ptr<const models::ConfigBundle> bundle,
+                                          Integrator integrator)
+    : config_(std::move(bundle))
+    , params_(config_ ? &config_->vehicle : nullptr)
+    , integrator_(integrator)
+{
+    if (!config_) {
+        throw std::invalid_argument("DynamicSimulator requires a config bundle");
+    }
+    if (config_->model != Model::kModel) {
+        throw std::invalid_argument(std::string("DynamicSimulator for ") + models::vehicle_model_key(Model::kModel) +
+                                    " given a config bundle loaded for " +
+                                    models::vehicle_model_key(config_->model));
+    }
+    hot_ = Model::hot(*params_);
+    set_dt(config_->timing.nominal_dt);
+    AdaptiveOptions options = adaptive_;
+    options.max_dt = config_->timing.max_dt;
+    options.min_dt = std::min(options.min_dt, options.max_dt);
+    set_adaptive_options(options);
+    const double zero[1] = {0.0};
+    reset(zero, 0);
+}
+
+template <typename Model>
+void DynamicSimulator<Model>::reset(const double* initial, std::size_t count)
+{
+    state_ = Model::init(initial, count, *params_);
+    last_control_ = {0.0, 0.0};
+    adaptive_dt_ = 0.0;
+    report_ = {};
+}
+
+template <typename Model>
+void DynamicSimulator<Model>::set_dt(double dt)
+{
+    if (!(dt > 0.0)) {
+        throw std::invalid_argument("DynamicSimulator timestep must be positive");
+    }
+    dt_ = dt;
+}
+
+template <typename Model>
+void DynamicSimulator<Model>::set_adaptive_options(const AdaptiveOptions& options)
+{
+    if (!(options.max_dt > 0.0) || !(options.min_dt > 0.0) || options.min_dt > options.max_dt) {
+        throw std::invalid_argument("AdaptiveOptions require 0 < min_dt <= max_dt");
+    }
+    adaptive_ = options;
+    adaptive_dt_ = 0.0;
+}
+
+template <typename Model>
+void DynamicSimulator<Model>::set_tire_mode(TireMode mode, const models::TireTableOptions& options)
+{
+    if (mode == TireMode::Exact) {
+        tire_table_.reset();
+    } else {
+        tire_table_ = models::cached_tire_table(params_->tire, options);
+    }
+}
+
+template <typename Model>
+const typename DynamicSimulator<Model>::State& DynamicSimulator<Model>::step(double steer_rate, double accel)
+{
+    VELOX_TIME_SCOPE(telemetry::Stage::Dynamics);
+    VELOX_COUNT(telemetry::Counter::Steps, 1);
+    const models::StControl control{std::isfinite(steer_rate) ? steer_rate : 0.0,
+                                    std::isfinite(accel) ? accel : 0.0};
+    const typename Model::Hot& p = hot_;
+    const models::TireForceTable* tires = tire_table_.get();
+    auto rhs = [&control, &p, tires](const State& x, State& f) { Model::rhs(x, control, p, tires, f); };
+
+    if (integrator_ == Integrator::Rk4) {
+        rk4_step(state_, dt_, rhs);
+        Model::project(state_);
+        VELOX_RECORD_SUBSTEPS(1);
+    } else {
+        report_ = integrate_dopri45(state_, dt_, adaptive_dt_, rhs, adaptive_,
+                                    [](State& x) { Model::project(x); });
+        VELOX_RECORD_SUBSTEPS(report_.accepted);
+        VELOX_COUNT(telemetry::Counter::RejectedSubsteps, report_.rejected);
+    }
+    last_control_ = control;
+    return state_;
+}
+
+template class DynamicSimulator<StdModel>;
+template class DynamicSimulator<MbModel>;
+
+} // namespace velox::simulation
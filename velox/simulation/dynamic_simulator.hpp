@@ -0,0 +1,155 @@
+#pragma once
+
+#include <cmath>
+#include <cstddef>
+#include <memory>
+
+#include "config_bundle.hpp"
+#include "integrators.hpp"
+#include "models/vehicle_dynamics_mb.hpp"
+#include "models/vehicle_dynamics_std.hpp"
+
+namespace velox::simulation {
+
+enum class Integrator {
+    Rk4,             // one classical RK4 step per step() call
+    DormandPrince45, // error-controlled sub-steps, never longer than AdaptiveOptions::max_dt
+};
+
+enum class TireMode {
+    Exact,     // Magic Formula for every wheel and stage
+    Tabulated, // throughput mode: shared TireForceTable from cached_tire_table
+};
+
+/**
+ * Model adapters: state type, hot parameter view, initialiser, right-hand side and post-step
+ * projection. Hot is what rhs reads; the simulator builds it from VehicleParameters once.
+ */
+struct StdModel {
+    using State = models::StdState;
+    using Hot = models::StdHotParameters;
+    static constexpr std::size_t kStateSize = models::kStdStateSize;
+    static constexpr models::VehicleModel kModel = models::VehicleModel::Std;
+
+    static Hot hot(const models::VehicleParameters& p) { return models::std_hot_parameters(p); }
+
+    static State init(const double* initial, std::size_t count, const models::VehicleParameters& p)
+    {
+        return models::init_std(initial, count, p);
+    }
+    static void rhs(const State& x, const models::StControl& u, const Hot& p,
+                    const models::TireForceTable* tires, State& f)
+    {
+        models::vehicle_dynamics_std(x, u, p, f, tires);
+    }
+    static void project(State& x) { models::std_clamp_state(x); }
+    static double speed(const State& x) { return std::abs(x[3]); }
+};
+
+struct MbModel {
+    using State = models::MbState;
+    /// The MB right-hand side reads nearly every field, so its view is the whole struct.
+    using Hot = models::VehicleParameters;
+    static constexpr std::size_t kStateSize = models::kMbStateSize;
+    static constexpr models::VehicleModel kModel = models::VehicleModel::Mb;
+
+    static Hot hot(const models::VehicleParameters& p) { return p; }
+
+    static State init(const double* initial, std::size_t count, const models::VehicleParameters& p)
+    {
+        return models::init_mb(initial, count, p);
+    }
+    static void rhs(const State& x, const models::StControl& u, const Hot& p,
+                    const models::TireForceTable* tires, State& f)
+    {
+        models::vehicle_dynamics_mb(x, u, p, f, tires);
+    }
+    static void project(State& x) { models::mb_clamp_state(x); }
+    static double speed(const State& x) { return std::hypot(x[3], x[10]); }
+};
+
+/**
+ * Native simulator for the dynamic CommonRoad models (STD, MB). Holds the raw control over a
+ * step (the models apply their own constraints) and integrates with RK4 or Dormand-Prince 5(4).
+ * step() performs no heap allocation.
+ *
+ * The wheel-spin dynamics are stiff at low speed and in hard transients; fixed-step RK4 needs
+ * dt of about 1e-3 there, while DormandPrince45 shortens its sub-steps on its own.
+ */
+template <typename Model>
+class DynamicSimulator {
+public:
+    using State = typename Model::State;
+
+    /// Parameters are borrowed; they must outlive the simulator.
+    DynamicSimulator(const models::VehicleParameters& params, double dt,
+                     Integrator integrator = Integrator::Rk4);
+
+    /**
+     * Shares a preloaded bundle: vehicle parameters from bundle->vehicle, dt from
+     * timing.nominal_dt and the adaptive sub-step bound from timing.max_dt. The simulator keeps
+     * the bundle alive. Throws std::invalid_argument for a null bundle or one loaded for a
+     * different model than Model::kModel.
+     */
+    explicit DynamicSimulator(std::shared_ptr<const models::ConfigBundle> bundle,
+                              Integrator integrator = Integrator::Rk4);
+
+    /// Initial state in the common [x, y, delta, v, psi, psi_dot, beta] form.
+    void reset(const double* initial, std::size_t count);
+
+    /// Throws std::invalid_argument for a non-positive dt.
+    void set_dt(double dt);
+    double dt() const { return dt_; }
+
+    void set_integrator(Integrator integrator) { integrator_ = integrator; }
+    Integrator integrator() const { return integrator_; }
+
+    void set_adaptive_options(const AdaptiveOptions& options);
+    const AdaptiveOptions& adaptive_options() const { return adaptive_; }
+
+    /**
+     * Selects exact or tabulated tire forces. Tabulated builds (or reuses) the table for
+     * params().tire on the first call; its error is reported by tire_table()->error_report().
+     */
+    void set_tire_mode(TireMode mode, const models::TireTableOptions& options = {});
+    TireMode tire_mode() const { return tire_table_ ? TireMode::Tabulated : TireMode::Exact; }
+    const models::TireForceTable* tire_table() const { return tire_table_.get(); }
+
+    /// Advances one dt and returns the updated state.
+    const State& step(double steer_rate, double accel);
+
+    const State& state() const { return state_; }
+    const models::StControl& last_control() const { return last_control_; }
+    double speed() const { return Model::speed(state_); }
+
+    /// Sub-step statistics of the last DormandPrince45 step.
+    const AdaptiveReport& last_report() const { return report_; }
+
+    const models::VehicleParameters& params() const { return *params_; }
+    /// Model::hot(params()), copied at construction; step() reads only this.
+    const typename Model::Hot& hot_parameters() const { return hot_; }
+
+    /// Bundle this simulator was built from, or nullptr for borrowed parameters.
+    const models::ConfigBundle* config() const { return config_.get(); }
+
+private:
+    std::shared_ptr<const models::ConfigBundle> config_;
+    const models::VehicleParameters* params_;
+    typename Model::Hot hot_;
+    double dt_{0.01};
+    Integrator integrator_;
+    AdaptiveOptions adaptive_{};
+    double adaptive_dt_{0.0};
+    AdaptiveReport report_{};
+    std::shared_ptr<const models::TireForceTable> tire_table_;
+    State state_{};
+    models::StControl last_control_{};
+};
+
+using StdSimulator = DynamicSimulator<StdModel>;
+using MbSimulator  = DynamicSimulator<MbModel>;
+
+extern template class DynamicSimulator<StdModel>;
+extern template class DynamicSimulator<MbModel>;
+
+} // namespace velox::simulation
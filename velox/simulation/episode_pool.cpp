@@ -0,0 +1,72 @@
+#include "episode_pool.hpp"
+
+#include <algorithm>
+#include <stdexcept>
+#include <utility>
+
+namespace velox::simulation {
+
+EpisodeWorkspace::EpisodeWorkspace(const EpisodeWorkspaceOptions& options)
+    : controller_cache_(options.controller_cache)
+{
+    if (options.telemetry) {
+        recorder_.emplace(*options.telemetry);
+    }
+    controllers_.reserve(controller_cache_);
+}
+
+StSimulator& EpisodeWorkspace::begin(const RolloutJob& job)
+{
+    if (!job.params) {
+        throw std::invalid_argument("RolloutJob requires params, controller and track");
+    }
+    // StSimulator holds only fixed-size arrays and a parameter pointer: re-seating is O(1), and
+    // the constants come from the set's cache entry instead of being derived per episode.
+    simulator_.emplace(*job.params, *models::cached_vehicle_constants(job.params), job.dt);
+    simulator_->reset(job.initial_state.data(), job.initial_state.size());
+    if (recorder_) recorder_->clear();
+    ++episodes_;
+    return *simulator_;
+}
+
+RolloutController& EpisodeWorkspace::controller(const RolloutJob& job)
+{
+    if (!job.controller || !job.params || !job.track) {
+        throw std::invalid_argument("RolloutJob requires params, controller and track");
+    }
+    RolloutController* controller = nullptr;
+    auto cached = std::find_if(controllers_.begin(), controllers_.end(),
+                               [&](const CachedController& c) { return c.factory == job.controller; });
+    if (cached != controllers_.end()) {
+        cached->last_used = episodes_;
+        controller = cached->controller.get();
+    } else {
+        std::unique_ptr<RolloutController> made = job.controller->make();
+        if (!made) {
+            throw std::runtime_error("RolloutControllerFactory::make returned null");
+        }
+        ++controllers_made_;
+        if (made->reusable() && controller_cache_ > 0) {
+            if (controllers_.size() >= controller_cache_) {
+                // evict the least recently used factory
+                auto oldest = std::min_element(controllers_.begin(), controllers_.end(),
+                                               [](const CachedController& a, const CachedController& b) {
+                                                   return a.last_used < b.last_used;
+                                               });
+                *oldest = CachedController{job.controller, std::move(made), episodes_};
+                controller = oldest->controller.get();
+            } else {
+                controllers_.push_back({job.controller, std::move(made), episodes_});
+                controller = controllers_.back().controller.get();
+            }
+        } else {
+            transient_ = std::move(made);
+            controller = transient_.get();
+        }
+    }
+    controller->seed(RandomStream(job.seed, job.id));
+    controller->reset(*job.params, *job.track);
+    return *controller;
+}
+
+} // namespace velox::simulation
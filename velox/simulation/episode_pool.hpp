@@ -0,0 +1,79 @@
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <optional>
+#include <vector>
+
+#include "rollout.hpp"
+#include "st_simulator.hpp"
+#include "telemetry/telemetry_recorder.hpp"
+
+namespace velox::simulation {
+
+struct EpisodeWorkspaceOptions {
+    /// When set, every episode records into a preallocated ring buffer (TelemetryRecorder).
+    std::optional<telemetry::RecorderOptions> telemetry;
+    std::size_t controller_cache = 4; // distinct reusable controller factories kept
+};
+
+/**
+ * EpisodeWorkspace
+ *
+ * Everything one thread needs to run episodes back to back: the simulator, a telemetry ring
+ * buffer and controller instances. begin() returns the workspace to a job's initial state in
+ * O(1) (the native analogue of SimulationDaemon.reset with its InitParams/ResetParams): the
+ * simulator is re-seated in place, the recorder's cursors are rewound, and a reusable controller
+ * is reset instead of rebuilt. The simulator and recorder never allocate after construction; a
+ * controller is still made per episode unless it reports reusable(), which none of the
+ * factories in this tree do yet. RolloutPool gives every worker its own workspace.
+ *
+ * Not thread-safe; one workspace per thread.
+ */
+class EpisodeWorkspace {
+public:
+    explicit EpisodeWorkspace(const EpisodeWorkspaceOptions& options = {});
+
+    /// Seats the simulator on job.params at job.dt and resets it to job.initial_state.
+    StSimulator& begin(const RolloutJob& job);
+
+    /**
+     * Controller for the job's factory, seeded with RandomStream(job.seed, job.id) and reset.
+     * Instances whose reusable() is true are kept per factory and reset for later episodes;
+     * others are made fresh as run_rollout always did.
+     */
+    RolloutController& controller(const RolloutJob& job);
+
+    StSimulator& simulator() { return *simulator_; }
+    /// Recorder of the current episode, or nullptr when telemetry is off.
+    telemetry::TelemetryRecorder* recorder() { return recorder_ ? &*recorder_ : nullptr; }
+
+    std::size_t episodes() const noexcept { return episodes_; }
+    std::size_t controllers_made() const noexcept { return controllers_made_; }
+
+private:
+    struct CachedController {
+        std::shared_ptr<const RolloutControllerFactory> factory;
+        std::unique_ptr<RolloutController> controller;
+        std::size_t last_used{};
+    };
+
+    std::size_t controller_cache_;
+    std::optional<StSimulator> simulator_;
+    std::optional<telemetry::TelemetryRecorder> recorder_;
+    std::vector<CachedController> controllers_;
+    std::unique_ptr<RolloutController> transient_; // last non-reusable controller
+    std::size_t episodes_{0};
+    std::size_t controllers_made_{0};
+};
+
+/**
+ * run_rollout on a workspace: the simulator and controller are taken from workspace
+ * and, when the workspace records telemetry, the pose, speed, steering, acceleration and totals
+ * channels are written every step. Same result as run_rollout(job) as long as the cached
+ * controllers honour RolloutController::reusable(); with controller_cache = 0 no state survives
+ * between jobs and the result never depends on what the workspace ran before.
+ */
+RolloutResult run_rollout(const RolloutJob& job, EpisodeWorkspace& workspace);
+
+} // namespace velox::simulation
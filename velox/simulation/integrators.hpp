@@ -0,0 +1,166 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <utility>
+
+namespace velox::simulation {
+
+/**
+ * Fixed-size explicit integrators for the native model right-hand sides.
+ *
+ * A right-hand side is any callable rhs(const std::array<double, N>& x, std::array<double, N>& f);
+ * controls are held constant over the interval (zero-order hold), so callers bind them into
+ * the callable. All stage storage is on the stack.
+ */
+
+/** One classical Runge-Kutta 4 step of length dt, in place. */
+template <std::size_t N, typename Rhs>
+void rk4_step(std::array<double, N>& x, double dt, Rhs&& rhs)
+{
+    using State = std::array<double, N>;
+    State k1, k2, k3, k4, tmp;
+
+    rhs(x, k1);
+    for (std::size_t i = 0; i < N; ++i) tmp[i] = x[i] + 0.5 * dt * k1[i];
+    rhs(tmp, k2);
+    for (std::size_t i = 0; i < N; ++i) tmp[i] = x[i] + 0.5 * dt * k2[i];
+    rhs(tmp, k3);
+    for (std::size_t i = 0; i < N; ++i) tmp[i] = x[i] + dt * k3[i];
+    rhs(tmp, k4);
+
+    for (std::size_t i = 0; i < N; ++i) {
+        x[i] += dt / 6.0 * (k1[i] + 2.0 * k2[i] + 2.0 * k3[i] + k4[i]);
+    }
+}
+
+struct AdaptiveOptions {
+    double rel_tol = 1e-6;
+    double abs_tol = 1e-8;
+    double min_dt  = 1e-6;  // steps are never shortened below this (accepted regardless)
+    double max_dt  = 0.01;  // config/model_timing.yaml max_dt
+    double safety  = 0.9;
+    std::size_t max_steps = 100000;
+};
+
+struct AdaptiveReport {
+    std::size_t accepted = 0;
+    std::size_t rejected = 0;
+    double max_error = 0.0;  // largest normalised error of an accepted step
+    bool hit_min_dt = false; // a step was forced through at min_dt
+    bool hit_max_steps = false;
+};
+
+/**
+ * Dormand-Prince 5(4) with FSAL and standard error control over [0, duration].
+ *
+ * dt_hint carries the step size between calls (0 starts at max_dt); project(x) runs after
+ * every accepted step, e.g. to clamp wheel speeds to >= 0.
+ */
+template <std::size_t N, typename Rhs, typename Project>
+AdaptiveReport integrate_dopri45(std::array<double, N>& x, double duration, double& dt_hint,
+                                 Rhs&& rhs, const AdaptiveOptions& options, Project&& project)
+{
+    using State = std::array<double, N>;
+
+    constexpr double a21 = 1.0 / 5.0;
+    constexpr double a31 = 3.0 / 40.0, a32 = 9.0 / 40.0;
+    constexpr double a41 = 44.0 / 45.0, a42 = -56.0 / 15.0, a43 = 32.0 / 9.0;
+    constexpr double a51 = 19372.0 / 6561.0, a52 = -25360.0 / 2187.0, a53 = 64448.0 / 6561.0,
+                     a54 = -212.0 / 729.0;
+    constexpr double a61 = 9017.0 / 3168.0, a62 = -355.0 / 33.0, a63 = 46732.0 / 5247.0,
+                     a64 = 49.0 / 176.0, a65 = -5103.0 / 18656.0;
+    constexpr double b1 = 35.0 / 384.0, b3 = 500.0 / 1113.0, b4 = 125.0 / 192.0,
+                     b5 = -2187.0 / 6784.0, b6 = 11.0 / 84.0;
+    // b - b* (5th minus 4th order weights)
+    constexpr double e1 = 71.0 / 57600.0, e3 = -71.0 / 16695.0, e4 = 71.0 / 1920.0,
+                     e5 = -17253.0 / 339200.0, e6 = 22.0 / 525.0, e7 = -1.0 / 40.0;
+
+    AdaptiveReport report;
+    if (!(duration > 0.0)) return report;
+
+    double dt = dt_hint > 0.0 ? dt_hint : options.max_dt;
+    double t = 0.0;
+    State k1, k2, k3, k4, k5, k6, k7, tmp, next;
+    rhs(x, k1);
+
+    while (t < duration) {
+        if (report.accepted + report.rejected >= options.max_steps) {
+            report.hit_max_steps = true;
+            break;
+        }
+        dt = std::clamp(dt, options.min_dt, options.max_dt);
+        const bool last = t + dt >= duration;
+        const double h = last ? duration - t : dt;
+
+        for (std::size_t i = 0; i < N; ++i) tmp[i] = x[i] + h * a21 * k1[i];
+        rhs(tmp, k2);
+        for (std::size_t i = 0; i < N; ++i) tmp[i] = x[i] + h * (a31 * k1[i] + a32 * k2[i]);
+        rhs(tmp, k3);
+        for (std::size_t i = 0; i < N; ++i) tmp[i] = x[i] + h * (a41 * k1[i] + a42 * k2[i] + a43 * k3[i]);
+        rhs(tmp, k4);
+        for (std::size_t i = 0; i < N; ++i) {
+            tmp[i] = x[i] + h * (a51 * k1[i] + a52 * k2[i] + a53 * k3[i] + a54 * k4[i]);
+        }
+        rhs(tmp, k5);
+        for (std::size_t i = 0; i < N; ++i) {
+            tmp[i] = x[i] + h * (a61 * k1[i] + a62 * k2[i] + a63 * k3[i] + a64 * k4[i] + a65 * k5[i]);
+        }
+        rhs(tmp, k6);
+        for (std::size_t i = 0; i < N; ++i) {
+            next[i] = x[i] + h * (b1 * k1[i] + b3 * k3[i] + b4 * k4[i] + b5 * k5[i] + b6 * k6[i]);
+        }
+        rhs(next, k7);
+
+        double err2 = 0.0;
+        for (std::size_t i = 0; i < N; ++i) {
+            const double e = h * (e1 * k1[i] + e3 * k3[i] + e4 * k4[i] + e5 * k5[i] + e6 * k6[i] + e7 * k7[i]);
+            const double scale = options.abs_tol + options.rel_tol * std::max(std::abs(x[i]), std::abs(next[i]));
+            err2 += (e / scale) * (e / scale);
+        }
+        const double err = std::sqrt(err2 / static_cast<double>(N));
+        const bool finite = std::isfinite(err);
+        const bool forced = h <= options.min_dt;
+
+        if ((finite && err <= 1.0) || forced) {
+            report.hit_min_dt = report.hit_min_dt || (forced && !(finite && err <= 1.0));
+            report.max_error = std::max(report.max_error, finite ? err : 0.0);
+            ++report.accepted;
+            t = last ? duration : t + h;
+            x = next;
+            project(x);
+            // FSAL: k7 is the next k1 unless project() moved the state
+            if (x == next) {
+                k1 = k7;
+            } else {
+                rhs(x, k1);
+            }
+        } else {
+            ++report.rejected;
+        }
+
+        const double factor = !finite ? 0.2
+            : err == 0.0 ? 5.0
+            : std::clamp(options.safety * std::pow(err, -0.2), 0.2, 5.0);
+        // Keep the long-run step size: a short final step says nothing about the next interval.
+        if (!(last && finite && err <= 1.0)) {
+            dt = h * factor;
+        }
+    }
+
+    dt_hint = std::clamp(dt, options.min_dt, options.max_dt);
+    return report;
+}
+
+/** integrate_dopri45 without a projection step. */
+template <std::size_t N, typename Rhs>
+AdaptiveReport integrate_dopri45(std::array<double, N>& x, double duration, double& dt_hint,
+                                 Rhs&& rhs, const AdaptiveOptions& options = {})
+{
+    return integrate_dopri45(x, duration, dt_hint, std::forward<Rhs>(rhs), options,
+                             [](std::array<double, N>&) {});
+}
+
+} // namespace velox::simulation
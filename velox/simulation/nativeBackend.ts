@@ -0,0 +1,436 @@
+import type { YamlDocumentParser } from '../io/ConfigManager';
+import type { SingleTrackParameters } from '../models/types';
+import { SimulationTelemetryState } from '../telemetry/index';
+import type { BackendSnapshot, SimulationBackend } from './backend';
+import { LowSpeedSafety, type LowSpeedSafetyConfig } from './LowSpeedSafety';
+import { FrameColumn, kFrameHeaderDoubles, NativeFrameView } from './nativeFrame';
+import type { ModelTimingInfo } from './types';
+
+const kStStateSize = 5;
+const kDoubleBytes = 8;
+
+/**
+ * Emscripten exports of the native core (see velox/simulation/native_backend.hpp).
+ * Engine handles and pointers are plain offsets into linear memory.
+ */
+export interface VeloxNativeModule {
+  HEAPF64: Float64Array;
+  /** Needed by nativeYamlParser only; exported when HEAPU8 is in EXPORTED_RUNTIME_METHODS. */
+  HEAPU8?: Uint8Array;
+  UTF8ToString(ptr: number): string;
+  _malloc(bytes: number): number;
+  _free(ptr: number): void;
+  _velox_st_create(vehicleId: number, dt: number): number;
+  _velox_st_destroy(engine: number): void;
+  _velox_st_reset(engine: number, statePtr: number, count: number, dt: number): number;
+  _velox_st_step(engine: number, steerRate: number, accel: number, dt: number): number;
+  _velox_st_state(engine: number): number;
+  _velox_st_speed(engine: number): number;
+  /** Present in builds with the adaptive scheduler (step_scheduler.hpp). */
+  _velox_st_set_timing?(engine: number, nominalDt: number, maxDt: number): number;
+  _velox_st_advance?(engine: number, steerRate: number, accel: number, frameDt: number): number;
+  _velox_st_create_from_fields(fieldsPtr: number, count: number, dt: number): number;
+  _velox_st_create_single_track(valuesPtr: number, count: number, dt: number): number;
+  _velox_st_frame(engine: number): number;
+  _velox_st_batch_create(vehicleId: number, count: number): number;
+  _velox_st_batch_destroy(batch: number): void;
+  _velox_st_batch_reset(batch: number, index: number, statePtr: number, count: number): number;
+  _velox_st_batch_step(batch: number, dt: number): number;
+  _velox_st_batch_column(batch: number, column: number): number;
+  _velox_st_batch_create_from_fields(fieldsPtr: number, count: number, vehicles: number): number;
+  _velox_st_batch_frame(batch: number): number;
+  _velox_vehicle_parameter_count(): number;
+  _velox_yaml_flatten?(
+    textPtr: number,
+    length: number,
+    keysPtr: number,
+    keysCapacity: number,
+    valuesPtr: number,
+    valuesCapacity: number,
+  ): number;
+  _velox_last_error(): number;
+}
+
+/** Column ids of velox_st_batch_column. */
+export enum StBatchColumn {
+  X = 0,
+  Y = 1,
+  Psi = 2,
+  V = 3,
+  Delta = 4,
+  SteerRate = 5,
+  Accel = 6,
+}
+
+export interface NativeBackendOptions {
+  module: VeloxNativeModule;
+  vehicleId: number;
+  /**
+   * Parameter fields in native field order (velox_vehicle_parameters_parse output). When set,
+   * the engine is built from them instead of the vehicle ID, so no parameter files are needed.
+   */
+  fields?: ArrayLike<number>;
+  /**
+   * Single-track set as ConfigManager.loadModelParameters returns it. When set, the engine is
+   * built from it (velox_st_create_single_track) and steps exactly like JsSimulationBackend on
+   * the same parameters; takes precedence over fields and the vehicle ID.
+   */
+  singleTrack?: SingleTrackParameters;
+  /**
+   * Low-speed safety as in JsSimulationBackend. The single-track state has no yaw-rate, slip,
+   * lateral or wheel-speed entries, so the layer clamps nothing and only its latch (reported
+   * in the telemetry safety fields) depends on it and on driftEnabled.
+   */
+  lowSpeed?: LowSpeedSafetyConfig;
+  driftEnabled?: boolean;
+}
+
+/** velox_st_create_single_track order (kSingleTrackParameterCount in single_track_parameters.hpp). */
+export function singleTrackValues(p: SingleTrackParameters): number[] {
+  const mu = Number.isFinite(p.mu) && (p.mu as number) > 0 ? (p.mu as number) : Number.NaN;
+  return [
+    p.l_f,
+    p.l_r,
+    p.m,
+    p.I_z,
+    p.lat_accel_max,
+    mu,
+    p.steering.min,
+    p.steering.max,
+    p.steering.rate_min,
+    p.steering.rate_max,
+    p.accel.min,
+    p.accel.max,
+    p.accel.jerk_max ?? 0,
+  ];
+}
+
+/**
+ * ConfigManager parser backed by velox_yaml_flatten, so TS configs are read by the same
+ * YAML-subset reader as the native parameter loaders and the two cannot disagree on a bundle.
+ * Scalars come back as numbers (booleans as 0/1), nested by their dotted paths; a document the
+ * native reader rejects throws its message. Undefined when the module lacks the export or HEAPU8.
+ */
+export function nativeYamlParser(module: VeloxNativeModule): YamlDocumentParser | undefined {
+  if (!module._velox_yaml_flatten || !module.HEAPU8) {
+    return undefined;
+  }
+  return (document: string) => {
+    const text = new TextEncoder().encode(document);
+    // One scalar per line at most; dotted keys are retried larger if the first guess is short.
+    let keysCapacity = 2 * text.length + 64;
+    let valuesCapacity = Math.floor(text.length / 2) + 1;
+    for (let attempt = 0; ; attempt += 1) {
+      const textPtr = module._malloc(Math.max(text.length, 1));
+      const keysPtr = module._malloc(keysCapacity);
+      const valuesPtr = module._malloc(valuesCapacity * kDoubleBytes);
+      try {
+        module.HEAPU8!.set(text, textPtr);
+        const count = module._velox_yaml_flatten!(textPtr, text.length, keysPtr, keysCapacity, valuesPtr, valuesCapacity);
+        if (count >= 0) {
+          return nestFlattened(module, keysPtr, valuesPtr, count);
+        }
+        const message = module.UTF8ToString(module._velox_last_error());
+        if (!message.includes('too small') || attempt >= 4) {
+          throw new Error(message);
+        }
+        keysCapacity *= 2;
+        valuesCapacity *= 2;
+      } finally {
+        module._free(textPtr);
+        module._free(keysPtr);
+        module._free(valuesPtr);
+      }
+    }
+  };
+}
+
+/** Rebuilds nested records from velox_yaml_flatten's NUL-separated dotted keys and values. */
+function nestFlattened(module: VeloxNativeModule, keysPtr: number, valuesPtr: number, count: number) {
+  const result: Record<string, unknown> = {};
+  const bytes = module.HEAPU8!;
+  const decoder = new TextDecoder();
+  let cursor = keysPtr;
+  for (let i = 0; i < count; i += 1) {
+    let end = cursor;
+    while (bytes[end] !== 0) end += 1;
+    // slice(), not subarray(): TextDecoder rejects views of shared memory.
+    const path = decoder.decode(bytes.slice(cursor, end)).split('.');
+    cursor = end + 1;
+    let target = result;
+    for (const part of path.slice(0, -1)) {
+      const child = target[part];
+      target = (child && typeof child === 'object' ? child : (target[part] = {})) as Record<string, unknown>;
+    }
+    target[path[path.length - 1]] = module.HEAPF64[valuesPtr / kDoubleBytes + i];
+  }
+  return result;
+}
+
+/** Copies fields into native memory for the duration of create(pointer, count). */
+function withNativeFields(
+  module: VeloxNativeModule,
+  fields: ArrayLike<number>,
+  create: (ptr: number, count: number) => number,
+): number {
+  const ptr = module._malloc(Math.max(fields.length, 1) * kDoubleBytes);
+  try {
+    module.HEAPF64.set(fields, ptr / kDoubleBytes);
+    return create(ptr, fields.length);
+  } finally {
+    module._free(ptr);
+  }
+}
+
+/**
+ * Single-track backend stepping the C++ engine. No number[] is allocated per step; the state
+ * lives in native memory and is only copied out on snapshot().
+ */
+export class NativeSimulationBackend implements SimulationBackend {
+  private readonly module: VeloxNativeModule;
+  private engine: number;
+  private scratch: number;
+  private dt = 0.01;
+  private simTime = 0;
+  private distance = 0;
+  private energy = 0;
+  private lastAccel = 0;
+  private lastSteerRate = 0;
+  private timing?: ModelTimingInfo;
+  private readonly safety?: LowSpeedSafety;
+  ready: Promise<void> = Promise.resolve();
+
+  constructor(options: NativeBackendOptions) {
+    this.module = options.module;
+    const module = this.module;
+    const dt = this.dt;
+    if (options.singleTrack) {
+      this.engine = withNativeFields(module, singleTrackValues(options.singleTrack), (ptr, count) =>
+        module._velox_st_create_single_track(ptr, count, dt),
+      );
+    } else if (options.fields) {
+      const fields = options.fields;
+      this.engine = withNativeFields(module, fields, (ptr, count) => module._velox_st_create_from_fields(ptr, count, dt));
+    } else {
+      this.engine = module._velox_st_create(options.vehicleId, dt);
+    }
+    if (!this.engine) {
+      const source = options.singleTrack ? 'single-track parameters' : options.fields ? 'parameter fields' : `vehicle ${options.vehicleId}`;
+      throw new Error(`velox_st_create (${source}) failed: ${this.lastError()}`);
+    }
+    if (options.lowSpeed) {
+      const st = options.singleTrack;
+      const wheelbase = st ? st.l_f + st.l_r : 0;
+      this.safety = new LowSpeedSafety(options.lowSpeed, {
+        longitudinalIndex: 3,
+        steeringIndex: 4,
+        wheelbase: wheelbase > 0 ? wheelbase : undefined,
+        rearLength: st && st.l_r > 0 ? st.l_r : undefined,
+      });
+      this.safety.setDriftEnabled(options.driftEnabled ?? options.lowSpeed.drift_enabled);
+    }
+    this.scratch = this.module._malloc(kStStateSize * kDoubleBytes);
+  }
+
+  reset(state: number[], dt: number): void {
+    this.dt = dt;
+    const count = Math.min(state.length, kStStateSize);
+    const heap = this.module.HEAPF64;
+    const base = this.scratch / kDoubleBytes;
+    for (let i = 0; i < count; i += 1) {
+      heap[base + i] = Number.isFinite(state[i]) ? state[i] : 0;
+    }
+    if (!this.module._velox_st_reset(this.engine, this.scratch, count, dt)) {
+      throw new Error(`velox_st_reset failed: ${this.lastError()}`);
+    }
+    this.simTime = 0;
+    this.distance = 0;
+    this.energy = 0;
+    this.lastAccel = 0;
+    this.lastSteerRate = 0;
+    this.safety?.reset();
+    this.updateSafetyLatch();
+  }
+
+  step(control: number[], dt: number): void {
+    this.dt = dt ?? this.dt;
+    const steerRate = control[0] ?? 0;
+    const accel = control[1] ?? 0;
+    if (!this.module._velox_st_step(this.engine, steerRate, accel, this.dt)) {
+      throw new Error(`velox_st_step failed: ${this.lastError()}`);
+    }
+    const speed = this.speed();
+    this.simTime += this.dt;
+    this.distance += speed * this.dt;
+    this.energy += accel * speed * this.dt;
+    this.lastAccel = accel;
+    this.lastSteerRate = steerRate;
+    this.updateSafetyLatch();
+  }
+
+  /**
+   * One frame through velox_st_advance: error-controlled substeps between timing.max_dt and the
+   * 1 ms floor, nominal_dt near the friction limit and at low speed. Returns 0 on modules built
+   * without it. The substeps run inside the engine, so the low-speed latch is moved once, on
+   * the state at the end of the frame, where step() moves it after every substep.
+   */
+  advance(control: number[], frameDt: number, timing: ModelTimingInfo): number {
+    const module = this.module;
+    if (!module._velox_st_advance || !module._velox_st_set_timing) return 0;
+    if (this.timing?.nominal_dt !== timing.nominal_dt || this.timing?.max_dt !== timing.max_dt) {
+      if (!module._velox_st_set_timing(this.engine, timing.nominal_dt, timing.max_dt)) {
+        throw new Error(`velox_st_set_timing failed: ${this.lastError()}`);
+      }
+      this.timing = { ...timing };
+    }
+    const steerRate = control[0] ?? 0;
+    const accel = control[1] ?? 0;
+    const substeps = module._velox_st_advance(this.engine, steerRate, accel, frameDt);
+    if (!substeps) {
+      throw new Error(`velox_st_advance failed: ${this.lastError()}`);
+    }
+    // the engine integrated the totals per substep into its frame
+    const frame = module._velox_st_frame(this.engine) / kDoubleBytes;
+    const heap = module.HEAPF64;
+    this.dt = frameDt / substeps;
+    this.simTime = heap[frame + 1];
+    this.distance = heap[frame + kFrameHeaderDoubles + FrameColumn.Distance];
+    this.energy = heap[frame + kFrameHeaderDoubles + FrameColumn.Energy];
+    this.lastAccel = accel;
+    this.lastSteerRate = steerRate;
+    this.updateSafetyLatch();
+    return substeps;
+  }
+
+  snapshot(): BackendSnapshot {
+    const state = Array.from(this.stateView());
+    const telemetry = new SimulationTelemetryState();
+    telemetry.pose.x = state[0];
+    telemetry.pose.y = state[1];
+    telemetry.pose.yaw = state[2];
+    telemetry.velocity.speed = Math.abs(state[3]);
+    telemetry.velocity.longitudinal = state[3];
+    telemetry.acceleration.longitudinal = this.lastAccel;
+    telemetry.steering.desired_angle = state[4];
+    telemetry.steering.actual_angle = state[4];
+    telemetry.steering.desired_rate = this.lastSteerRate;
+    telemetry.steering.actual_rate = this.lastSteerRate;
+    telemetry.controller.acceleration = this.lastAccel;
+    telemetry.totals.distance_traveled_m = this.distance;
+    telemetry.totals.energy_consumed_joules = this.energy;
+    telemetry.totals.simulation_time_s = this.simTime;
+    if (this.safety) {
+      const status = this.safety.status(state, Math.abs(state[3]));
+      telemetry.detector_severity = status.severity;
+      telemetry.safety_stage = status.stage;
+      telemetry.detector_forced = status.detector_forced;
+      telemetry.low_speed_engaged = status.latch_active;
+    }
+    return { state, telemetry, dt: this.dt, simulation_time_s: this.simTime };
+  }
+
+  speed(): number {
+    return this.module._velox_st_speed(this.engine);
+  }
+
+  /** Frame block republished after every reset and step. */
+  frame(): NativeFrameView {
+    return new NativeFrameView(this.module.HEAPF64.buffer, this.module._velox_st_frame(this.engine));
+  }
+
+  dispose(): void {
+    if (this.engine) {
+      this.module._velox_st_destroy(this.engine);
+      this.engine = 0;
+    }
+    if (this.scratch) {
+      this.module._free(this.scratch);
+      this.scratch = 0;
+    }
+  }
+
+  // Moves the latch as VehicleSimulator does after a reset or step; the state is left as is.
+  private updateSafetyLatch(): void {
+    if (!this.safety) return;
+    const state = Array.from(this.stateView());
+    this.safety.apply(state, Math.abs(state[3]), true);
+  }
+
+  // HEAPF64 is re-read every time: it is replaced when linear memory grows.
+  private stateView(): Float64Array {
+    const base = this.module._velox_st_state(this.engine) / kDoubleBytes;
+    return this.module.HEAPF64.subarray(base, base + kStStateSize);
+  }
+
+  private lastError(): string {
+    return this.module.UTF8ToString(this.module._velox_last_error());
+  }
+}
+
+/**
+ * N independent single-track vehicles stepped by the SIMD batch engine (st_batch.hpp).
+ * Columns are Float64Array views straight into native memory: write controls into
+ * column(SteerRate)/column(Accel), call step(), read the state columns back.
+ */
+export class NativeStBatch {
+  private readonly module: VeloxNativeModule;
+  private batch: number;
+  private scratch: number;
+  readonly count: number;
+
+  constructor(module: VeloxNativeModule, vehicleId: number, count: number, fields?: ArrayLike<number>) {
+    this.module = module;
+    this.count = count;
+    this.batch = fields
+      ? withNativeFields(module, fields, (ptr, n) => module._velox_st_batch_create_from_fields(ptr, n, count))
+      : module._velox_st_batch_create(vehicleId, count);
+    if (!this.batch) {
+      throw new Error(`velox_st_batch_create(${vehicleId}, ${count}) failed: ${this.lastError()}`);
+    }
+    this.scratch = module._malloc(kStStateSize * kDoubleBytes);
+  }
+
+  /** Resets one vehicle, or all of them when index is omitted. */
+  reset(state: number[], index = -1): void {
+    const count = Math.min(state.length, kStStateSize);
+    const base = this.scratch / kDoubleBytes;
+    for (let i = 0; i < count; i += 1) {
+      this.module.HEAPF64[base + i] = Number.isFinite(state[i]) ? state[i] : 0;
+    }
+    if (!this.module._velox_st_batch_reset(this.batch, index, this.scratch, count)) {
+      throw new Error(`velox_st_batch_reset failed: ${this.lastError()}`);
+    }
+  }
+
+  step(dt: number): void {
+    if (!this.module._velox_st_batch_step(this.batch, dt)) {
+      throw new Error(`velox_st_batch_step failed: ${this.lastError()}`);
+    }
+  }
+
+  /** View of one column; re-fetch after memory growth instead of caching across frames. */
+  column(id: StBatchColumn): Float64Array {
+    const base = this.module._velox_st_batch_column(this.batch, id) / kDoubleBytes;
+    return this.module.HEAPF64.subarray(base, base + this.count);
+  }
+
+  /** Consistent copy of every vehicle after the last reset/step, readable from other threads. */
+  frame(): NativeFrameView {
+    return new NativeFrameView(this.module.HEAPF64.buffer, this.module._velox_st_batch_frame(this.batch));
+  }
+
+  dispose(): void {
+    if (this.batch) {
+      this.module._velox_st_batch_destroy(this.batch);
+      this.batch = 0;
+    }
+    if (this.scratch) {
+      this.module._free(this.scratch);
+      this.scratch = 0;
+    }
+  }
+
+  private lastError(): string {
+    return this.module.UTF8ToString(this.module._velox_last_error());
+  }
+}
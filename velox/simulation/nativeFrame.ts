@@ -0,0 +1,142 @@
+/**
+ * Reader for the seqlock-published frame blocks of the native core (SharedFrame in
+ * shared_frame.hpp, velox_frame_layout in native_backend.hpp), and the seqlock control block
+ * the main thread writes back to nativeWorker.ts.
+ *
+ * The views are built once over the module's memory buffer. With a shared (pthread) build the
+ * buffer is a SharedArrayBuffer: it is never detached by memory growth, so a view created on
+ * the main thread from a pointer posted by the worker stays valid for the engine's lifetime.
+ */
+
+export const kFrameHeaderDoubles = 3;
+export const kFrameColumns = 9;
+
+/** Frame columns; 0..6 match StBatchColumn. */
+export enum FrameColumn {
+  X = 0,
+  Y = 1,
+  Psi = 2,
+  V = 3,
+  Delta = 4,
+  SteerRate = 5,
+  Accel = 6,
+  Distance = 7,
+  Energy = 8,
+}
+
+const kMaxReadAttempts = 64;
+
+export class NativeFrameView {
+  private readonly sequence: Uint32Array;
+  private readonly doubles: Float64Array;
+  private readonly shared: boolean;
+  readonly vehicles: number;
+
+  constructor(buffer: ArrayBufferLike, pointer: number) {
+    this.sequence = new Uint32Array(buffer, pointer, 2);
+    this.vehicles = this.sequence[1];
+    this.doubles = new Float64Array(buffer, pointer, kFrameHeaderDoubles + kFrameColumns * this.vehicles);
+    this.shared = typeof SharedArrayBuffer !== 'undefined' && buffer instanceof SharedArrayBuffer;
+  }
+
+  /** Sequence word; advances by 2 per published frame. */
+  version(): number {
+    return this.shared ? Atomics.load(this.sequence, 0) : this.sequence[0];
+  }
+
+  /** Allocates the out buffer read() expects. */
+  createBuffer(): Float64Array {
+    return new Float64Array(this.doubles.length);
+  }
+
+  /**
+   * Copies a consistent frame into out (laid out like the native block) and returns its
+   * sequence, or -1 if the writer kept it busy for every attempt.
+   */
+  read(out: Float64Array): number {
+    for (let attempt = 0; attempt < kMaxReadAttempts; attempt += 1) {
+      const before = this.version();
+      if (before & 1) continue;
+      out.set(this.doubles);
+      if (this.version() === before) {
+        return before;
+      }
+    }
+    return -1;
+  }
+
+  /** Live view of one column in memory; only safe to read when the writer is idle. */
+  column(id: FrameColumn): Float64Array {
+    const start = kFrameHeaderDoubles + id * this.vehicles;
+    return this.doubles.subarray(start, start + this.vehicles);
+  }
+}
+
+/** Bytes of a control block: the sequence word, padded to 8, then [steer_rate, accel]. */
+export const kControlBlockBytes = 24;
+
+/**
+ * The [steer_rate, accel] block the main thread writes and nativeWorker.ts reads before every
+ * step. The two doubles cannot be stored atomically together, so it is guarded like the frame:
+ * the writer holds the sequence odd while it stores them and the reader retries until it sees
+ * the same even sequence on both sides, so a step never pairs the steering rate of one command
+ * with the acceleration of the next. Single writer; without shared memory both sides run on
+ * the worker thread and the sequence is not touched.
+ */
+export class NativeControlBlock {
+  readonly buffer: ArrayBufferLike;
+  private readonly sequence: Uint32Array;
+  private readonly values: Float64Array;
+  private readonly shared: boolean;
+
+  constructor(buffer: ArrayBufferLike, pointer: number) {
+    this.buffer = buffer;
+    this.sequence = new Uint32Array(buffer, pointer, 1);
+    this.values = new Float64Array(buffer, pointer + 8, 2);
+    this.shared = typeof SharedArrayBuffer !== 'undefined' && buffer instanceof SharedArrayBuffer;
+  }
+
+  write(steerRate: number, accel: number): void {
+    if (this.shared) Atomics.add(this.sequence, 0, 1);
+    this.values[0] = steerRate;
+    this.values[1] = accel;
+    if (this.shared) Atomics.add(this.sequence, 0, 1);
+  }
+
+  /**
+   * Copies a consistent pair into out; returns false and leaves out unchanged if the writer
+   * kept the block busy for every attempt.
+   */
+  read(out: number[]): boolean {
+    if (!this.shared) {
+      out[0] = this.values[0];
+      out[1] = this.values[1];
+      return true;
+    }
+    for (let attempt = 0; attempt < kMaxReadAttempts; attempt += 1) {
+      const before = Atomics.load(this.sequence, 0);
+      if (before & 1) continue;
+      const steerRate = this.values[0];
+      const accel = this.values[1];
+      if (Atomics.load(this.sequence, 0) === before) {
+        out[0] = steerRate;
+        out[1] = accel;
+        return true;
+      }
+    }
+    return false;
+  }
+}
+
+/** Accessors over a buffer filled by NativeFrameView.read(). */
+export function frameTime(frame: Float64Array): number {
+  return frame[1];
+}
+
+export function frameSteps(frame: Float64Array): number {
+  return frame[2];
+}
+
+export function frameValue(frame: Float64Array, vehicles: number, column: FrameColumn, vehicle = 0): number {
+  return frame[kFrameHeaderDoubles + column * vehicles + vehicle];
+}
@@ -0,0 +1,242 @@
+/**
+ * Web Worker host for the native single-track engine.
+ *
+ * The worker owns the WASM instance and steps it on its own clock, so simulation never
+ * competes with React rendering. With a shared-memory build (see native_backend.hpp) it posts
+ * the module's SharedArrayBuffer once; the main thread then reads the seqlock frame and writes
+ * the control block in place, and no message is exchanged per step. Without cross-origin
+ * isolation the memory is not shared and the worker posts a copied frame per tick instead.
+ *
+ * Load as a module worker: new Worker(new URL('./nativeWorker.ts', import.meta.url), { type: 'module' }).
+ */
+import { kControlBlockBytes, kFrameColumns, kFrameHeaderDoubles, NativeControlBlock } from './nativeFrame';
+import type { VeloxNativeModule } from './nativeBackend';
+
+const kDoubleBytes = 8;
+const kStStateSize = 5;
+
+export interface NativeWorkerInit {
+  type: 'init';
+  /** URL of the Emscripten MODULARIZE build (exports createVeloxModule by default). */
+  moduleUrl: string;
+  exportName?: string;
+  vehicleId: number;
+  /** Parameter fields in native order; when set the vehicle ID is only used for messages. */
+  fields?: number[];
+  dt: number;
+  /** Simulated seconds per wall-clock second. */
+  realtimeFactor?: number;
+  /** Upper bound on steps per tick so a stalled worker does not spiral. */
+  maxStepsPerTick?: number;
+  tickMs?: number;
+}
+
+export type NativeWorkerRequest =
+  | NativeWorkerInit
+  | { type: 'start' }
+  | { type: 'stop' }
+  | { type: 'reset'; state: number[] }
+  | { type: 'control'; steerRate: number; accel: number }
+  | { type: 'dispose' };
+
+export type NativeWorkerEvent =
+  | {
+      type: 'ready';
+      /** Module memory; a SharedArrayBuffer when the frame can be read in place. */
+      memory: ArrayBufferLike;
+      shared: boolean;
+      framePtr: number;
+      /** NativeControlBlock ([steer_rate, accel] under a sequence word) read before every step. */
+      controlPtr: number;
+    }
+  | { type: 'frame'; frame: Float64Array }
+  | { type: 'error'; message: string };
+
+interface WorkerScope {
+  onmessage: ((event: MessageEvent<NativeWorkerRequest>) => void) | null;
+  postMessage(message: NativeWorkerEvent, transfer?: Transferable[]): void;
+  close(): void;
+}
+
+const scope = globalThis as unknown as WorkerScope;
+
+let module: VeloxNativeModule | undefined;
+let engine = 0;
+let scratch = 0;
+let controlPtr = 0;
+let controls: NativeControlBlock | undefined;
+// last consistent [steer_rate, accel]; kept for a step if the block is mid-write every attempt
+const control = [0, 0];
+let framePtr = 0;
+let shared = false;
+let config: Required<Pick<NativeWorkerInit, 'dt' | 'realtimeFactor' | 'maxStepsPerTick' | 'tickMs'>> = {
+  dt: 0.01,
+  realtimeFactor: 1,
+  maxStepsPerTick: 200,
+  tickMs: 4,
+};
+let timer: ReturnType<typeof setTimeout> | undefined;
+let wallStart = 0;
+let simStart = 0;
+
+function post(event: NativeWorkerEvent, transfer?: Transferable[]): void {
+  scope.postMessage(event, transfer);
+}
+
+function lastError(): string {
+  return module ? module.UTF8ToString(module._velox_last_error()) : 'module not loaded';
+}
+
+function frameDoubles(): number {
+  return kFrameHeaderDoubles + kFrameColumns;
+}
+
+function simTime(): number {
+  return module ? module.HEAPF64[framePtr / kDoubleBytes + 1] : 0;
+}
+
+// Rebuilt when a non-shared memory grows and detaches the old buffer.
+function controlBlock(native: VeloxNativeModule): NativeControlBlock {
+  if (!controls || controls.buffer !== native.HEAPF64.buffer) {
+    controls = new NativeControlBlock(native.HEAPF64.buffer, controlPtr);
+  }
+  return controls;
+}
+
+function publishCopy(): void {
+  if (!module || shared) return;
+  const base = framePtr / kDoubleBytes;
+  const frame = module.HEAPF64.slice(base, base + frameDoubles());
+  post({ type: 'frame', frame }, [frame.buffer as ArrayBuffer]);
+}
+
+async function init(message: NativeWorkerInit): Promise<void> {
+  config = {
+    dt: message.dt,
+    realtimeFactor: message.realtimeFactor ?? config.realtimeFactor,
+    maxStepsPerTick: message.maxStepsPerTick ?? config.maxStepsPerTick,
+    tickMs: message.tickMs ?? config.tickMs,
+  };
+  const imported = await import(/* webpackIgnore: true */ message.moduleUrl);
+  const factory = imported[message.exportName ?? 'createVeloxModule'] ?? imported.default;
+  if (typeof factory !== 'function') {
+    throw new Error(`${message.moduleUrl} does not export a module factory`);
+  }
+  const native: VeloxNativeModule = await factory();
+  module = native;
+
+  if (message.fields) {
+    const ptr = native._malloc(Math.max(message.fields.length, 1) * kDoubleBytes);
+    native.HEAPF64.set(message.fields, ptr / kDoubleBytes);
+    engine = native._velox_st_create_from_fields(ptr, message.fields.length, config.dt);
+    native._free(ptr);
+  } else {
+    engine = native._velox_st_create(message.vehicleId, config.dt);
+  }
+  if (!engine) {
+    throw new Error(`velox_st_create(${message.vehicleId}) failed: ${lastError()}`);
+  }
+  scratch = native._malloc(kStStateSize * kDoubleBytes);
+  controlPtr = native._malloc(kControlBlockBytes);
+  native.HEAPF64.fill(0, controlPtr / kDoubleBytes, (controlPtr + kControlBlockBytes) / kDoubleBytes);
+  control.fill(0);
+  framePtr = native._velox_st_frame(engine);
+
+  const memory = native.HEAPF64.buffer;
+  shared = typeof SharedArrayBuffer !== 'undefined' && memory instanceof SharedArrayBuffer;
+  post({ type: 'ready', memory: shared ? memory : new ArrayBuffer(0), shared, framePtr, controlPtr });
+  publishCopy();
+}
+
+function reset(state: number[]): void {
+  if (!module) return;
+  const count = Math.min(state.length, kStStateSize);
+  const base = scratch / kDoubleBytes;
+  for (let i = 0; i < count; i += 1) {
+    module.HEAPF64[base + i] = Number.isFinite(state[i]) ? state[i] : 0;
+  }
+  if (!module._velox_st_reset(engine, scratch, count, config.dt)) {
+    throw new Error(`velox_st_reset failed: ${lastError()}`);
+  }
+  wallStart = performance.now();
+  simStart = 0;
+  publishCopy();
+}
+
+function tick(): void {
+  timer = undefined;
+  if (!module) return;
+  const target = simStart + ((performance.now() - wallStart) / 1000) * config.realtimeFactor;
+  const due = Math.floor((target - simTime()) / config.dt);
+  const steps = Math.min(Math.max(due, 0), config.maxStepsPerTick);
+  for (let i = 0; i < steps; i += 1) {
+    // re-read per step: the main thread may write the control block at any time
+    controlBlock(module).read(control);
+    if (!module._velox_st_step(engine, control[0], control[1], config.dt)) {
+      post({ type: 'error', message: `velox_st_step failed: ${lastError()}` });
+      return;
+    }
+  }
+  if (due > steps) {
+    // fell behind: drop the backlog instead of running ever larger catch-up ticks
+    wallStart = performance.now();
+    simStart = simTime();
+  }
+  if (steps > 0) publishCopy();
+  timer = setTimeout(tick, config.tickMs);
+}
+
+function stop(): void {
+  if (timer !== undefined) {
+    clearTimeout(timer);
+    timer = undefined;
+  }
+}
+
+function dispose(): void {
+  stop();
+  if (module) {
+    if (engine) module._velox_st_destroy(engine);
+    if (scratch) module._free(scratch);
+    if (controlPtr) module._free(controlPtr);
+  }
+  engine = scratch = controlPtr = framePtr = 0;
+  controls = undefined;
+  module = undefined;
+  scope.close();
+}
+
+async function handle(message: NativeWorkerRequest): Promise<void> {
+  switch (message.type) {
+    case 'init':
+      await init(message);
+      break;
+    case 'start':
+      if (timer === undefined && module) {
+        wallStart = performance.now();
+        simStart = simTime();
+        timer = setTimeout(tick, 0);
+      }
+      break;
+    case 'stop':
+      stop();
+      break;
+    case 'reset':
+      reset(message.state);
+      break;
+    case 'control':
+      if (module) {
+        controlBlock(module).write(message.steerRate, message.accel);
+      }
+      break;
+    case 'dispose':
+      dispose();
+      break;
+  }
+}
+
+scope.onmessage = (event) => {
+  handle(event.data).catch((error) => {
+    post({ type: 'error', message: error instanceof Error ? error.message : String(error) });
+  });
+};
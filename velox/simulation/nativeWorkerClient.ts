@@ -0,0 +1,136 @@
+import {
+  FrameColumn,
+  frameSteps,
+  frameTime,
+  frameValue,
+  kFrameColumns,
+  kFrameHeaderDoubles,
+  NativeControlBlock,
+  NativeFrameView,
+} from './nativeFrame';
+import type { NativeWorkerEvent, NativeWorkerInit, NativeWorkerRequest } from './nativeWorker';
+
+export interface NativeWorkerFrame {
+  /** Sequence of the published frame; unchanged values mean no new step since the last read. */
+  version: number;
+  simulation_time_s: number;
+  steps: number;
+  state: Float64Array;
+  steerRate: number;
+  accel: number;
+  distance_traveled_m: number;
+  energy_consumed_joules: number;
+}
+
+/**
+ * Main-thread side of nativeWorker.ts. readFrame() is meant to be called from the render loop:
+ * with shared memory it copies the latest seqlock frame out of the worker's heap (no message,
+ * no allocation beyond the reusable buffers); otherwise it returns the last frame the worker
+ * posted. setControl() writes the control block the worker reads before every step.
+ */
+export class NativeWorkerClient {
+  private readonly worker: Worker;
+  private view?: NativeFrameView;
+  private controls?: NativeControlBlock;
+  private buffer = new Float64Array(0);
+  private version = -1;
+  private fallbackVersion = 0;
+  private readonly frameOut: NativeWorkerFrame = {
+    version: -1,
+    simulation_time_s: 0,
+    steps: 0,
+    state: new Float64Array(5),
+    steerRate: 0,
+    accel: 0,
+    distance_traveled_m: 0,
+    energy_consumed_joules: 0,
+  };
+  readonly ready: Promise<void>;
+  onerror?: (message: string) => void;
+
+  constructor(worker: Worker, init: Omit<NativeWorkerInit, 'type'>) {
+    this.worker = worker;
+    this.ready = new Promise<void>((resolve, reject) => {
+      this.worker.onmessage = (event: MessageEvent<NativeWorkerEvent>) => {
+        const message = event.data;
+        switch (message.type) {
+          case 'ready':
+            if (message.shared) {
+              this.view = new NativeFrameView(message.memory, message.framePtr);
+              this.controls = new NativeControlBlock(message.memory, message.controlPtr);
+              this.buffer = this.view.createBuffer();
+            }
+            resolve();
+            break;
+          case 'frame':
+            this.buffer = message.frame;
+            this.fallbackVersion += 2;
+            break;
+          case 'error':
+            reject(new Error(message.message));
+            this.onerror?.(message.message);
+            break;
+        }
+      };
+    });
+    this.send({ type: 'init', ...init });
+  }
+
+  /** True when frames are read in place from shared memory. */
+  get shared(): boolean {
+    return this.view !== undefined;
+  }
+
+  start(): void {
+    this.send({ type: 'start' });
+  }
+
+  stop(): void {
+    this.send({ type: 'stop' });
+  }
+
+  reset(state: number[]): void {
+    this.send({ type: 'reset', state });
+  }
+
+  setControl(steerRate: number, accel: number): void {
+    if (this.controls) {
+      this.controls.write(steerRate, accel);
+    } else {
+      this.send({ type: 'control', steerRate, accel });
+    }
+  }
+
+  /** Latest frame; the returned object and its state array are reused by the next call. */
+  readFrame(): NativeWorkerFrame {
+    if (this.view) {
+      const version = this.view.read(this.buffer);
+      if (version >= 0) this.version = version;
+    } else {
+      this.version = this.fallbackVersion;
+    }
+    const frame = this.frameOut;
+    if (this.buffer.length < kFrameHeaderDoubles + kFrameColumns) return frame;
+    frame.version = this.version;
+    frame.simulation_time_s = frameTime(this.buffer);
+    frame.steps = frameSteps(this.buffer);
+    for (let i = 0; i < frame.state.length; i += 1) {
+      frame.state[i] = frameValue(this.buffer, 1, i as FrameColumn);
+    }
+    frame.steerRate = frameValue(this.buffer, 1, FrameColumn.SteerRate);
+    frame.accel = frameValue(this.buffer, 1, FrameColumn.Accel);
+    frame.distance_traveled_m = frameValue(this.buffer, 1, FrameColumn.Distance);
+    frame.energy_consumed_joules = frameValue(this.buffer, 1, FrameColumn.Energy);
+    return frame;
+  }
+
+  dispose(): void {
+    this.send({ type: 'dispose' });
+    this.view = undefined;
+    this.controls = undefined;
+  }
+
+  private send(message: NativeWorkerRequest): void {
+    this.worker.postMessage(message);
+  }
+}
@@ -0,0 +1,400 @@
+#include "native_backend.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <exception>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+
+#include "shared_frame.hpp"
+#include "st_batch.hpp"
+#include "st_simulator.hpp"
+#include "step_scheduler.hpp"
+#include "vehicle_parameter_cache.hpp"
+#include "vehicle_parameter_fields.hpp"
+#include "yaml_subset.hpp"
+
+using velox::simulation::SharedFrame;
+
+struct velox_st_engine {
+    std::shared_ptr<const velox::models::VehicleParameters> params;
+    velox::simulation::StSimulator simulator;
+    // kDefaultTimings of SimulationDaemon.ts until velox_st_set_timing
+    velox::simulation::AdaptiveStepScheduler scheduler{velox::models::ModelTiming{0.01, 0.016}};
+    SharedFrame frame{1};
+    double steps{0.0};
+};
+
+struct velox_st_batch {
+    std::shared_ptr<const velox::models::VehicleParameters> params;
+    velox::simulation::StBatch batch;
+    SharedFrame frame;
+    double steps{0.0};
+};
+
+namespace {
+
+thread_local std::string g_last_error;
+
+std::shared_ptr<const velox::models::VehicleParameters> parameters_from_fields(const double* fields, int count)
+{
+    const auto& descriptors = velox::models::kVehicleParameterFields;
+    if (!fields || count != static_cast<int>(descriptors.size())) {
+        throw std::invalid_argument("expected " + std::to_string(descriptors.size()) +
+                                    " vehicle parameter fields, got " + std::to_string(count));
+    }
+    auto params = std::make_shared<velox::models::VehicleParameters>();
+    for (std::size_t i = 0; i < descriptors.size(); ++i) {
+        velox::models::field_value(*params, descriptors[i]) = fields[i];
+    }
+    return params;
+}
+
+velox_st_engine* make_engine(std::shared_ptr<const velox::models::VehicleParameters> params, double dt)
+{
+    const auto constants = velox::models::cached_vehicle_constants(params);
+    auto* engine = new velox_st_engine{params, velox::simulation::StSimulator(*params, *constants, dt)};
+    engine->simulator.reset(nullptr, 0);
+    return engine;
+}
+
+velox_st_engine* make_engine(const velox::models::SingleTrackParameters& st, double dt)
+{
+    const auto constants = velox::models::derive_vehicle_constants(st);
+    auto params = std::make_shared<const velox::models::VehicleParameters>(
+        velox::models::vehicle_parameters_from_single_track(st));
+    auto* engine = new velox_st_engine{params, velox::simulation::StSimulator(*params, constants, dt)};
+    engine->simulator.reset(nullptr, 0);
+    return engine;
+}
+
+velox_st_batch* make_batch(std::shared_ptr<const velox::models::VehicleParameters> params, int count)
+{
+    if (count <= 0) {
+        throw std::invalid_argument("velox_st_batch_create requires a positive count");
+    }
+    const auto n = static_cast<std::size_t>(count);
+    return new velox_st_batch{params, velox::simulation::StBatch(*params, n), SharedFrame(n)};
+}
+
+// Single vehicle: state, the applied controls and the JS backend's running totals.
+void publish_engine(velox_st_engine& engine, double time, double steer_rate, double accel,
+                    double distance, double energy)
+{
+    const auto& state = engine.simulator.state();
+    engine.frame.publish([&](SharedFrame& f) {
+        f.set_time(time);
+        f.set_steps(engine.steps);
+        for (std::size_t c = 0; c < state.size(); ++c) f.column(static_cast<SharedFrame::Column>(c))[0] = state[c];
+        f.column(SharedFrame::SteerRate)[0] = steer_rate;
+        f.column(SharedFrame::Accel)[0] = accel;
+        f.column(SharedFrame::Distance)[0] = distance;
+        f.column(SharedFrame::Energy)[0] = energy;
+    });
+}
+
+// Copies the live columns; dt > 0 advances the per-vehicle totals and [reset_begin, reset_end)
+// restarts them.
+void publish_batch(velox_st_batch& batch, double time, double dt, std::size_t reset_begin = 0,
+                   std::size_t reset_end = 0)
+{
+    velox::simulation::StBatch& b = batch.batch;
+    const std::size_t n = b.size();
+    batch.frame.publish([&](SharedFrame& f) {
+        f.set_time(time);
+        f.set_steps(batch.steps);
+        std::copy_n(b.x(), n, f.column(SharedFrame::X));
+        std::copy_n(b.y(), n, f.column(SharedFrame::Y));
+        std::copy_n(b.psi(), n, f.column(SharedFrame::Psi));
+        std::copy_n(b.v(), n, f.column(SharedFrame::V));
+        std::copy_n(b.delta(), n, f.column(SharedFrame::Delta));
+        std::copy_n(b.control_steer_rate(), n, f.column(SharedFrame::SteerRate));
+        std::copy_n(b.control_accel(), n, f.column(SharedFrame::Accel));
+        if (dt > 0.0) {
+            double* distance = f.column(SharedFrame::Distance);
+            double* energy = f.column(SharedFrame::Energy);
+            for (std::size_t i = 0; i < n; ++i) {
+                const double speed = std::abs(b.v()[i]);
+                distance[i] += speed * dt;
+                energy[i] += b.control_accel()[i] * speed * dt;
+            }
+        }
+        for (std::size_t i = reset_begin; i < reset_end; ++i) {
+            f.column(SharedFrame::Distance)[i] = 0.0;
+            f.column(SharedFrame::Energy)[i] = 0.0;
+        }
+    });
+}
+
+template <typename Fn>
+int guarded(Fn&& fn)
+{
+    try {
+        fn();
+        g_last_error.clear();
+        return 1;
+    } catch (const std::exception& e) {
+        g_last_error = e.what();
+    } catch (...) {
+        g_last_error = "unknown native engine error";
+    }
+    return 0;
+}
+
+} // anonymous namespace
+
+extern "C" {
+
+velox_st_engine* velox_st_create(int vehicle_id, double dt)
+{
+    velox_st_engine* engine = nullptr;
+    guarded([&] { engine = make_engine(velox::models::cached_vehicle_parameters(vehicle_id), dt); });
+    return engine;
+}
+
+velox_st_engine* velox_st_create_from_fields(const double* fields, int count, double dt)
+{
+    velox_st_engine* engine = nullptr;
+    guarded([&] { engine = make_engine(parameters_from_fields(fields, count), dt); });
+    return engine;
+}
+
+velox_st_engine* velox_st_create_single_track(const double* values, int count, double dt)
+{
+    velox_st_engine* engine = nullptr;
+    guarded([&] {
+        const auto n = count > 0 ? static_cast<std::size_t>(count) : 0;
+        engine = make_engine(velox::models::single_track_parameters_from_values(values, n), dt);
+    });
+    return engine;
+}
+
+void velox_st_destroy(velox_st_engine* engine)
+{
+    delete engine;
+}
+
+int velox_st_reset(velox_st_engine* engine, const double* state, int count, double dt)
+{
+    if (!engine) return 0;
+    return guarded([&] {
+        engine->simulator.set_dt(dt);
+        engine->simulator.reset(state, count > 0 ? static_cast<std::size_t>(count) : 0);
+        engine->steps = 0.0;
+        engine->scheduler.reset();
+        publish_engine(*engine, 0.0, 0.0, 0.0, 0.0, 0.0);
+    });
+}
+
+int velox_st_step(velox_st_engine* engine, double steer_rate, double accel, double dt)
+{
+    if (!engine) return 0;
+    return guarded([&] {
+        engine->simulator.set_dt(dt);
+        engine->simulator.step(steer_rate, accel);
+        const SharedFrame& f = engine->frame;
+        const double speed = engine->simulator.speed();
+        engine->steps += 1.0;
+        publish_engine(*engine, f.time() + dt, steer_rate, accel, f.column(SharedFrame::Distance)[0] + speed * dt,
+                       f.column(SharedFrame::Energy)[0] + accel * speed * dt);
+    });
+}
+
+int velox_st_set_timing(velox_st_engine* engine, double nominal_dt, double max_dt)
+{
+    if (!engine) return 0;
+    return guarded([&] {
+        engine->scheduler = velox::simulation::AdaptiveStepScheduler(velox::models::ModelTiming{nominal_dt, max_dt});
+    });
+}
+
+int velox_st_advance(velox_st_engine* engine, double steer_rate, double accel, double frame_dt)
+{
+    if (!engine) return 0;
+    int substeps = 0;
+    guarded([&] {
+        const SharedFrame& f = engine->frame;
+        double time = f.time();
+        double distance = f.column(SharedFrame::Distance)[0];
+        double energy = f.column(SharedFrame::Energy)[0];
+        const auto schedule = engine->scheduler.advance(
+            engine->simulator, steer_rate, accel, frame_dt, [&](const velox::simulation::StSimulator& sim, double dt) {
+                const double speed = sim.speed();
+                time += dt;
+                distance += speed * dt;
+                energy += accel * speed * dt;
+            });
+        engine->steps += static_cast<double>(schedule.steps.accepted);
+        publish_engine(*engine, time, steer_rate, accel, distance, energy);
+        substeps = static_cast<int>(schedule.steps.accepted);
+    });
+    return substeps;
+}
+
+const double* velox_st_state(const velox_st_engine* engine)
+{
+    return engine ? engine->simulator.state().data() : nullptr;
+}
+
+double velox_st_speed(const velox_st_engine* engine)
+{
+    return engine ? engine->simulator.speed() : 0.0;
+}
+
+const double* velox_st_frame(const velox_st_engine* engine)
+{
+    return engine ? engine->frame.data() : nullptr;
+}
+
+velox_st_batch* velox_st_batch_create(int vehicle_id, int count)
+{
+    velox_st_batch* batch = nullptr;
+    guarded([&] { batch = make_batch(velox::models::cached_vehicle_parameters(vehicle_id), count); });
+    return batch;
+}
+
+velox_st_batch* velox_st_batch_create_from_fields(const double* fields, int count, int vehicles)
+{
+    velox_st_batch* batch = nullptr;
+    guarded([&] { batch = make_batch(parameters_from_fields(fields, count), vehicles); });
+    return batch;
+}
+
+void velox_st_batch_destroy(velox_st_batch* batch)
+{
+    delete batch;
+}
+
+int velox_st_batch_reset(velox_st_batch* batch, int index, const double* state, int count)
+{
+    if (!batch) return 0;
+    return guarded([&] {
+        const std::size_t n = count > 0 ? static_cast<std::size_t>(count) : 0;
+        if (index < 0) {
+            batch->batch.reset_all(state, n);
+            batch->steps = 0.0;
+            publish_batch(*batch, 0.0, 0.0, 0, batch->batch.size());
+        } else {
+            const auto i = static_cast<std::size_t>(index);
+            batch->batch.reset(i, state, n);
+            publish_batch(*batch, batch->frame.time(), 0.0, i, i + 1);
+        }
+    });
+}
+
+int velox_st_batch_step(velox_st_batch* batch, double dt)
+{
+    if (!batch) return 0;
+    return guarded([&] {
+        batch->batch.step(dt);
+        batch->steps += 1.0;
+        publish_batch(*batch, batch->frame.time() + dt, dt);
+    });
+}
+
+double* velox_st_batch_column(velox_st_batch* batch, int column)
+{
+    if (!batch) return nullptr;
+    velox::simulation::StBatch& b = batch->batch;
+    switch (column) {
+    case VELOX_ST_BATCH_X:          return b.x();
+    case VELOX_ST_BATCH_Y:          return b.y();
+    case VELOX_ST_BATCH_PSI:        return b.psi();
+    case VELOX_ST_BATCH_V:          return b.v();
+    case VELOX_ST_BATCH_DELTA:      return b.delta();
+    case VELOX_ST_BATCH_STEER_RATE: return b.control_steer_rate();
+    case VELOX_ST_BATCH_ACCEL:      return b.control_accel();
+    default:                        return nullptr;
+    }
+}
+
+const double* velox_st_batch_frame(const velox_st_batch* batch)
+{
+    return batch ? batch->frame.data() : nullptr;
+}
+
+int velox_yaml_flatten(const char* text, int length, char* keys, int keys_capacity,
+                       double* values, int values_capacity)
+{
+    if (!text || length < 0 || keys_capacity < 0 || values_capacity < 0) return -1;
+    int count = 0;
+    const int ok = guarded([&] {
+        using namespace velox::models;
+        YamlSubsetReader reader(std::string_view(text, static_cast<std::size_t>(length)));
+        YamlEvent event;
+        int used = 0;
+        while (reader.next(event)) {
+            if (event.type != YamlEventType::Scalar) continue;
+
+            double value = 0.0;
+            bool flag = false;
+            if (parse_yaml_bool(event.value, flag)) {
+                value = flag ? 1.0 : 0.0;
+            } else if (!parse_yaml_number(event.value, value)) {
+                throw std::runtime_error("YAML line " + std::to_string(event.line) + ": '" +
+                                         std::string(event.key) + "' is not numeric");
+            }
+            if (count >= values_capacity) throw std::runtime_error("values buffer too small");
+
+            // dotted path: open maps, then the key, then the terminator
+            std::size_t needed = event.key.size() + 1;
+            for (std::size_t d = 0; d < reader.open_maps(); ++d) needed += reader.map_key(d).size() + 1;
+            if (!keys || used + static_cast<int>(needed) > keys_capacity) {
+                throw std::runtime_error("keys buffer too small");
+            }
+            char* out = keys + used;
+            for (std::size_t d = 0; d < reader.open_maps(); ++d) {
+                const std::string_view part = reader.map_key(d);
+                out = std::copy(part.begin(), part.end(), out);
+                *out++ = '.';
+            }
+            out = std::copy(event.key.begin(), event.key.end(), out);
+            *out = '\0';
+            used += static_cast<int>(needed);
+            values[count++] = value;
+        }
+    });
+    return ok ? count : -1;
+}
+
+int velox_vehicle_parameter_count()
+{
+    return static_cast<int>(velox::models::kVehicleParameterFields.size());
+}
+
+const char* velox_vehicle_parameter_name(int index)
+{
+    static thread_local std::string name;
+    const auto& fields = velox::models::kVehicleParameterFields;
+    if (index < 0 || index >= static_cast<int>(fields.size())) return nullptr;
+    name = velox::models::field_path(fields[static_cast<std::size_t>(index)]);
+    return name.c_str();
+}
+
+int velox_vehicle_parameters_parse(const char* vehicle, int vehicle_length, const char* tire, int tire_length,
+                                   double* out, int capacity)
+{
+    const auto& fields = velox::models::kVehicleParameterFields;
+    if (!vehicle || !tire || !out || vehicle_length < 0 || tire_length < 0 ||
+        capacity < static_cast<int>(fields.size())) {
+        g_last_error = "velox_vehicle_parameters_parse: invalid arguments";
+        return 0;
+    }
+    return guarded([&] {
+        velox::models::VehicleParameters p;
+        velox::models::apply_vehicle_document(std::string_view(vehicle, static_cast<std::size_t>(vehicle_length)), p);
+        velox::models::apply_tire_document(std::string_view(tire, static_cast<std::size_t>(tire_length)), p);
+        for (std::size_t i = 0; i < fields.size(); ++i) {
+            out[i] = velox::models::field_value(p, fields[i]);
+        }
+    });
+}
+
+const char* velox_last_error()
+{
+    return g_last_error.c_str();
+}
+
+} // extern "C"
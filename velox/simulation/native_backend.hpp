@@ -0,0 +1,164 @@
+#pragma once
+
+/**
+ * C ABI over the native single-track engine.
+ *
+ * This is the surface consumed by NativeSimulationBackend (nativeBackend.ts) when the core is
+ * compiled to WASM, and by any other foreign-function host. Functions never throw: failures
+ * return 0/nullptr and leave a message for velox_last_error().
+ *
+ * Emscripten target (no filesystem; parameters come from the embedded sets or from
+ * velox_*_create_from_fields):
+ *
+ *   em++ -std=c++20 -O3 -msimd128 -pthread -sSHARED_MEMORY=1 -sALLOW_MEMORY_GROWTH=1
+ *        -sMODULARIZE=1 -sEXPORT_NAME=createVeloxModule -sENVIRONMENT=web,worker
+ *        -sEXPORTED_RUNTIME_METHODS=HEAPF64,HEAPU32,HEAPU8,UTF8ToString,wasmMemory
+ *        -DVELOX_EMBEDDED_PARAMETERS -DVELOX_PARAMETERS_NO_YAML -Iparameters -Ivelox
+ *        <sources> -o public/wasm/velox.js
+ *
+ * where <sources> are the .cpp files of parameters/, velox/models/, velox/simulation/ and
+ * velox/telemetry/ (minus the filesystem watcher).
+ *
+ * With shared memory the frame blocks below (velox_st_frame, velox_st_batch_frame) can be
+ * viewed from any thread the module's memory was posted to; see nativeWorker.ts.
+ */
+
+#if defined(__EMSCRIPTEN__)
+#include <emscripten/emscripten.h>
+#define VELOX_EXPORT EMSCRIPTEN_KEEPALIVE
+#elif defined(_WIN32)
+#define VELOX_EXPORT __declspec(dllexport)
+#else
+#define VELOX_EXPORT __attribute__((visibility("default")))
+#endif
+
+extern "C" {
+
+typedef struct velox_st_engine velox_st_engine;
+
+/// Creates an engine for a CommonRoad vehicle ID using the shared parameter cache.
+VELOX_EXPORT velox_st_engine* velox_st_create(int vehicle_id, double dt);
+
+VELOX_EXPORT void velox_st_destroy(velox_st_engine* engine);
+
+/// Resets to state[0..count); returns 1 on success, 0 on failure.
+VELOX_EXPORT int velox_st_reset(velox_st_engine* engine, const double* state, int count, double dt);
+
+/// Advances one step with [steer_rate, accel]; returns 1 on success, 0 on failure.
+VELOX_EXPORT int velox_st_step(velox_st_engine* engine, double steer_rate, double accel, double dt);
+
+/**
+ * Timing for velox_st_advance (config/model_timing.yaml); the default is nominal 0.01 s and max
+ * 0.016 s. Returns 1 on success, 0 for a non-positive value.
+ */
+VELOX_EXPORT int velox_st_set_timing(velox_st_engine* engine, double nominal_dt, double max_dt);
+
+/**
+ * Advances frame_dt with [steer_rate, accel] held, split into error-controlled substeps
+ * (AdaptiveStepScheduler in step_scheduler.hpp), and publishes the frame once. Returns the
+ * number of substeps taken, 0 on failure.
+ */
+VELOX_EXPORT int velox_st_advance(velox_st_engine* engine, double steer_rate, double accel, double frame_dt);
+
+/// Pointer to the engine-owned 5-element state [x, y, psi, v, delta]; stable for its lifetime.
+VELOX_EXPORT const double* velox_st_state(const velox_st_engine* engine);
+
+VELOX_EXPORT double velox_st_speed(const velox_st_engine* engine);
+
+/**
+ * Creates an engine from fields[0..velox_vehicle_parameter_count()) in field order (the output of
+ * velox_vehicle_parameters_parse), without touching the filesystem or the parameter cache.
+ */
+VELOX_EXPORT velox_st_engine* velox_st_create_from_fields(const double* fields, int count, double dt);
+
+/**
+ * Creates an engine from a single-track parameter set (SingleTrackParameters in
+ * velox/models/types.ts, as ConfigManager.loadModelParameters returns it) flattened as
+ * values[0..13): l_f, l_r, m, I_z, lat_accel_max, mu (NaN when unset), steering.min,
+ * steering.max, steering.rate_min, steering.rate_max, accel.min, accel.max, accel.jerk_max.
+ * Its steps match the JS VehicleSimulator on the same set: the mu -> lat_accel_max / g -> 0.8
+ * friction chain and the [accel.min, accel.max] range.
+ */
+VELOX_EXPORT velox_st_engine* velox_st_create_single_track(const double* values, int count, double dt);
+
+/**
+ * Frame layout shared by velox_st_frame and velox_st_batch_frame (SharedFrame in
+ * shared_frame.hpp). Viewed as doubles: [0] holds the u32 sequence and u32 vehicle count,
+ * [1] simulation time, [2] steps, then VELOX_FRAME_COLUMNS columns of `vehicles` doubles.
+ * The sequence is odd while the engine is writing; readers retry until it is even and
+ * unchanged across their copy.
+ */
+enum velox_frame_layout {
+    VELOX_FRAME_HEADER_DOUBLES = 3,
+    VELOX_FRAME_COLUMN_DISTANCE = 7,
+    VELOX_FRAME_COLUMN_ENERGY = 8,
+    VELOX_FRAME_COLUMNS = 9,
+};
+
+/// Engine-owned frame republished by every reset and step; stable for the engine lifetime.
+VELOX_EXPORT const double* velox_st_frame(const velox_st_engine* engine);
+
+typedef struct velox_st_batch velox_st_batch;
+
+/// Column ids for velox_st_batch_column: state [x, y, psi, v, delta], then controls.
+enum velox_st_batch_column_id {
+    VELOX_ST_BATCH_X = 0,
+    VELOX_ST_BATCH_Y = 1,
+    VELOX_ST_BATCH_PSI = 2,
+    VELOX_ST_BATCH_V = 3,
+    VELOX_ST_BATCH_DELTA = 4,
+    VELOX_ST_BATCH_STEER_RATE = 5,
+    VELOX_ST_BATCH_ACCEL = 6,
+};
+
+/// Creates an SoA batch of count vehicles sharing one parameter set.
+VELOX_EXPORT velox_st_batch* velox_st_batch_create(int vehicle_id, int count);
+
+/// As velox_st_batch_create, with parameters from fields as in velox_st_create_from_fields.
+VELOX_EXPORT velox_st_batch* velox_st_batch_create_from_fields(const double* fields, int count, int vehicles);
+
+VELOX_EXPORT void velox_st_batch_destroy(velox_st_batch* batch);
+
+/// Resets vehicle index (or every vehicle when index < 0) to state[0..count).
+VELOX_EXPORT int velox_st_batch_reset(velox_st_batch* batch, int index, const double* state, int count);
+
+/// Advances every vehicle by dt using the control columns; returns 1 on success.
+VELOX_EXPORT int velox_st_batch_step(velox_st_batch* batch, double dt);
+
+/// Engine-owned column (velox_st_batch_column_id); stable for the batch lifetime.
+VELOX_EXPORT double* velox_st_batch_column(velox_st_batch* batch, int column);
+
+/**
+ * Batch frame (velox_frame_layout), republished by every reset and step. Unlike the live
+ * columns it is never half-stepped, so another thread can read it while the batch runs.
+ */
+VELOX_EXPORT const double* velox_st_batch_frame(const velox_st_batch* batch);
+
+/**
+ * Flattens a YAML-subset document (config/, parameters/) with the native streaming reader.
+ * Scalar paths are written to keys as NUL-terminated dotted strings ("normal.engage_speed"),
+ * back to back, and their values to values (booleans as 0/1). Returns the scalar count, or -1
+ * on a parse error, a non-numeric scalar or a buffer that is too small. nativeYamlParser
+ * (nativeBackend.ts) hands this to ConfigManager, so TS configs use the same reader.
+ */
+VELOX_EXPORT int velox_yaml_flatten(const char* text, int length, char* keys, int keys_capacity,
+                                    double* values, int values_capacity);
+
+/// Number of VehicleParameters fields, the size velox_vehicle_parameters_parse expects.
+VELOX_EXPORT int velox_vehicle_parameter_count();
+
+/// Dotted name of field index ("steering.v_max"), or nullptr when out of range.
+VELOX_EXPORT const char* velox_vehicle_parameter_name(int index);
+
+/**
+ * Parses a vehicle and a tire document into out[0..velox_vehicle_parameter_count()) in field
+ * order, exactly as setup_vehicle_parameters would from files. Returns 1 on success.
+ */
+VELOX_EXPORT int velox_vehicle_parameters_parse(const char* vehicle, int vehicle_length,
+                                                const char* tire, int tire_length,
+                                                double* out, int capacity);
+
+/// Message of the last failure on the calling thread ("" if none).
+VELOX_EXPORT const char* velox_last_error();
+
+} // extern "C"
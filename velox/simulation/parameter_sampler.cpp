@@ -0,0 +1,113 @@
+#include "parameter_sampler.hpp"
+
+#include <algorithm>
+#include <stdexcept>
+#include <utility>
+
+#include "random_stream.hpp"
+
+namespace velox::simulation {
+
+using models::FieldDescriptor;
+using models::VehicleParameters;
+
+namespace {
+
+struct ResolvedPerturbation {
+    const FieldDescriptor* field;
+    const FieldPerturbation* spec;
+    std::size_t draw; // index into the per-variant draw table
+};
+
+struct ResolvedSpec {
+    std::vector<ResolvedPerturbation> fields;
+    std::vector<const FieldPerturbation*> draws; // distribution of each draw, in draw order
+};
+
+ResolvedSpec resolve(const PerturbationSpec& spec)
+{
+    ResolvedSpec resolved;
+    std::vector<std::pair<std::uint32_t, std::size_t>> groups;
+    for (const FieldPerturbation& p : spec.fields) {
+        const FieldDescriptor* field = models::find_field_path(p.field);
+        if (!field) {
+            throw std::invalid_argument("PerturbationSpec: unknown vehicle parameter '" + p.field + "'");
+        }
+        if (p.distribution == PerturbationDistribution::Normal && !(p.p1 >= 0.0)) {
+            throw std::invalid_argument("PerturbationSpec: negative standard deviation for '" + p.field + "'");
+        }
+        if (!(p.lower <= p.upper)) {
+            throw std::invalid_argument("PerturbationSpec: lower > upper for '" + p.field + "'");
+        }
+        std::size_t draw = resolved.draws.size();
+        auto group = std::find_if(groups.begin(), groups.end(), [&](const auto& g) { return g.first == p.group; });
+        if (p.group != 0 && group != groups.end()) {
+            draw = group->second; // shares the draw of the group's first field
+        } else {
+            resolved.draws.push_back(&p);
+            if (p.group != 0) groups.emplace_back(p.group, draw);
+        }
+        resolved.fields.push_back({field, &p, draw});
+    }
+    return resolved;
+}
+
+double sample(const FieldPerturbation& p, RandomStream& rng)
+{
+    switch (p.distribution) {
+    case PerturbationDistribution::Uniform: return rng.uniform(p.p0, p.p1);
+    case PerturbationDistribution::Normal:  return rng.normal(p.p0, p.p1);
+    }
+    return 0.0;
+}
+
+void fill(const VehicleParameters& base, const PerturbationSpec& spec, const ResolvedSpec& resolved,
+          VehicleParameters* out, std::size_t first, std::size_t count)
+{
+    std::vector<double> draws(resolved.draws.size());
+    for (std::size_t k = 0; k < count; ++k) {
+        const std::size_t variant = first + k;
+        RandomStream rng(spec.seed, variant);
+        for (std::size_t d = 0; d < draws.size(); ++d) {
+            draws[d] = sample(*resolved.draws[d], rng);
+        }
+
+        VehicleParameters& p = out[k];
+        p = base;
+        for (const ResolvedPerturbation& r : resolved.fields) {
+            const double base_value = models::field_value(base, *r.field);
+            const double x = draws[r.draw];
+            const double value = r.spec->mode == PerturbationMode::Relative ? base_value * (1.0 + x) : base_value + x;
+            models::field_value(p, *r.field) = std::clamp(value, r.spec->lower, r.spec->upper);
+        }
+    }
+}
+
+} // anonymous namespace
+
+void ParameterArena::gather(const FieldDescriptor& d, double* out) const
+{
+    for (std::size_t i = 0; i < variants_.size(); ++i) {
+        out[i] = models::field_value(variants_[i], d);
+    }
+}
+
+ParameterArena sample_parameters(const VehicleParameters& base, const PerturbationSpec& spec, std::size_t count)
+{
+    const ResolvedSpec resolved = resolve(spec);
+    ParameterArena arena(count);
+    fill(base, spec, resolved, arena.data(), 0, count);
+    return arena;
+}
+
+void sample_parameters_into(const VehicleParameters& base, const PerturbationSpec& spec, ParameterArena& arena,
+                            std::size_t first, std::size_t count)
+{
+    if (first > arena.size() || count > arena.size() - first) {
+        throw std::out_of_range("sample_parameters_into range exceeds the arena");
+    }
+    const ResolvedSpec resolved = resolve(spec);
+    fill(base, spec, resolved, arena.data() + first, first, count);
+}
+
+} // namespace velox::simulation
@@ -0,0 +1,91 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <string>
+#include <vector>
+
+#include "vehicle_parameter_fields.hpp"
+#include "vehicle_parameters.hpp"
+
+namespace velox::simulation {
+
+enum class PerturbationDistribution : std::uint8_t {
+    Uniform, // draw in [p0, p1)
+    Normal,  // mean p0, standard deviation p1
+};
+
+enum class PerturbationMode : std::uint8_t {
+    Absolute, // value = base + draw
+    Relative, // value = base * (1 + draw)
+};
+
+/**
+ * Distribution over one named VehicleParameters field. field is the dotted path of
+ * models::field_path ("m", "I_z", "tire.p_dy1", "steering.max"). Fields with the same non-zero
+ * group share one draw per variant, e.g. steering.min and steering.max scaled together, or m
+ * and I_z for a consistent mass distribution. The result is clamped to [lower, upper].
+ */
+struct FieldPerturbation {
+    std::string field;
+    PerturbationDistribution distribution{PerturbationDistribution::Uniform};
+    PerturbationMode mode{PerturbationMode::Relative};
+    double p0{};
+    double p1{};
+    double lower{-std::numeric_limits<double>::infinity()};
+    double upper{std::numeric_limits<double>::infinity()};
+    std::uint32_t group{};
+};
+
+struct PerturbationSpec {
+    std::vector<FieldPerturbation> fields;
+    std::uint64_t seed{};
+};
+
+/**
+ * ParameterArena
+ *
+ * Contiguous array of VehicleParameters variants. Every field of variant i sits at a fixed
+ * byte offset (FieldDescriptor::offset) from data() + i, so a batch integrator can stride
+ * over one field of all variants (StBatch(const VehicleParameters*, count) does) without any
+ * per-variant indirection.
+ */
+class ParameterArena {
+public:
+    ParameterArena() = default;
+    explicit ParameterArena(std::size_t count, const models::VehicleParameters& fill = {}) : variants_(count, fill) {}
+
+    std::size_t size() const { return variants_.size(); }
+    static constexpr std::size_t stride() { return sizeof(models::VehicleParameters); }
+
+    models::VehicleParameters* data() { return variants_.data(); }
+    const models::VehicleParameters* data() const { return variants_.data(); }
+    models::VehicleParameters& operator[](std::size_t i) { return variants_[i]; }
+    const models::VehicleParameters& operator[](std::size_t i) const { return variants_[i]; }
+
+    /// Copies field d of every variant into out[0..size()).
+    void gather(const models::FieldDescriptor& d, double* out) const;
+
+private:
+    std::vector<models::VehicleParameters> variants_;
+};
+
+/**
+ * sample_parameters
+ *
+ * Derives count variants of base by applying spec, without reparsing any YAML. Variant i draws
+ * from its own RandomStream(spec.seed, i), so it is the same for any count, order or thread
+ * split (sample_parameters_into can fill disjoint ranges of one arena concurrently).
+ *
+ * Throws std::invalid_argument for an unknown field path, a negative standard deviation or
+ * lower > upper.
+ */
+ParameterArena sample_parameters(const models::VehicleParameters& base, const PerturbationSpec& spec,
+                                 std::size_t count);
+
+/// Fills arena[first, first + count) with variants first..first + count of sample_parameters.
+void sample_parameters_into(const models::VehicleParameters& base, const PerturbationSpec& spec,
+                            ParameterArena& arena, std::size_t first, std::size_t count);
+
+} // namespace velox::simulation
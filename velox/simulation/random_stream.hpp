@@ -0,0 +1,83 @@
+#pragma once
+
+#include <cmath>
+#include <cstdint>
+#include <limits>
+
+namespace velox::simulation {
+
+/** SplitMix64 step: advances state and returns the next output (seeding and stream mixing). */
+constexpr std::uint64_t splitmix64(std::uint64_t& state)
+{
+    std::uint64_t z = (state += 0x9e3779b97f4a7c15ull);
+    z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ull;
+    z = (z ^ (z >> 27)) * 0x94d049bb133111ebull;
+    return z ^ (z >> 31);
+}
+
+/**
+ * RandomStream
+ *
+ * xoshiro256** generator seeded from (seed, stream) through SplitMix64, so every job of a run
+ * can own an independent stream that depends only on its inputs and never on which thread or
+ * in which order it runs. The distributions are implemented here rather than taken from
+ * <random>, whose std::*_distribution output differs between standard libraries: next() and
+ * uniform() are identical on every platform, normal() additionally depends only on libm.
+ */
+class RandomStream {
+public:
+    explicit RandomStream(std::uint64_t seed = 0, std::uint64_t stream = 0)
+    {
+        std::uint64_t mix = seed;
+        const std::uint64_t base = splitmix64(mix);
+        mix = base ^ (stream * 0xd1b54a32d192ed03ull);
+        for (std::uint64_t& word : s_) {
+            word = splitmix64(mix);
+        }
+    }
+
+    std::uint64_t next()
+    {
+        const std::uint64_t result = rotl(s_[1] * 5, 7) * 9;
+        const std::uint64_t t = s_[1] << 17;
+        s_[2] ^= s_[0];
+        s_[3] ^= s_[1];
+        s_[1] ^= s_[2];
+        s_[0] ^= s_[3];
+        s_[2] ^= t;
+        s_[3] = rotl(s_[3], 45);
+        return result;
+    }
+
+    /// Uniform in [0, 1) with 53 random bits.
+    double uniform() { return static_cast<double>(next() >> 11) * 0x1.0p-53; }
+
+    double uniform(double lo, double hi) { return lo + (hi - lo) * uniform(); }
+
+    /// Standard normal by Box-Muller; the second variate of each pair is kept for the next call.
+    double normal()
+    {
+        if (has_spare_) {
+            has_spare_ = false;
+            return spare_;
+        }
+        double u1 = uniform();
+        while (u1 <= std::numeric_limits<double>::min()) u1 = uniform();
+        const double r = std::sqrt(-2.0 * std::log(u1));
+        const double theta = 6.283185307179586 * uniform();
+        spare_ = r * std::sin(theta);
+        has_spare_ = true;
+        return r * std::cos(theta);
+    }
+
+    double normal(double mean, double stddev) { return mean + stddev * normal(); }
+
+private:
+    static constexpr std::uint64_t rotl(std::uint64_t x, int k) { return (x << k) | (x >> (64 - k)); }
+
+    std::uint64_t s_[4];
+    double spare_{0.0};
+    bool has_spare_{false};
+};
+
+} // namespace velox::simulation
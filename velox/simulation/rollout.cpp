@@ -0,0 +1,159 @@
+#include "rollout.hpp"
+
+#include <cmath>
+#include <exception>
+#include <optional>
+#include <stdexcept>
+
+#include "episode_pool.hpp"
+#include "st_simulator.hpp"
+#include "telemetry/instrumentation.hpp"
+
+namespace velox::simulation {
+
+namespace {
+
+void record_step(telemetry::TelemetryRecorder& recorder, const StSimulator& sim, double time,
+                 const RolloutResult& totals)
+{
+    using telemetry::Channel;
+    const auto row = recorder.sample(time);
+    if (!row) return;
+    const models::StState& x = sim.state();
+    const models::StControl& u = sim.last_control();
+    row.set(Channel::PoseX, x[0]);
+    row.set(Channel::PoseY, x[1]);
+    row.set(Channel::PoseYaw, x[2]);
+    row.set(Channel::VelocitySpeed, std::abs(x[3]));
+    row.set(Channel::VelocityLongitudinal, x[3]);
+    row.set(Channel::SteeringActualAngle, x[4]);
+    row.set(Channel::SteeringActualRate, u[0]);
+    row.set(Channel::AccelerationLongitudinal, u[1]);
+    row.set(Channel::ControllerAcceleration, u[1]);
+    row.set(Channel::TotalsDistanceTraveled, totals.distance_m);
+    row.set(Channel::TotalsEnergyConsumed, totals.energy_j);
+    row.set(Channel::TotalsSimulationTime, time);
+}
+
+} // anonymous namespace
+
+RolloutResult run_rollout(const RolloutJob& job)
+{
+    // No controller cache: no state survives the call.
+    EpisodeWorkspaceOptions options;
+    options.controller_cache = 0;
+    EpisodeWorkspace workspace(options);
+    return run_rollout(job, workspace);
+}
+
+RolloutResult run_rollout(const RolloutJob& job, EpisodeWorkspace& workspace)
+{
+    VELOX_TIME_SCOPE(telemetry::Stage::Rollout);
+    VELOX_COUNT(telemetry::Counter::Rollouts, 1);
+    RolloutResult result;
+    result.id = job.id;
+    try {
+        if (!job.params || !job.controller || !job.track) {
+            throw std::invalid_argument("RolloutJob requires params, controller and track");
+        }
+        const RolloutTrack& track = *job.track;
+        const double length = track.length();
+        if (!(length > 0.0)) {
+            throw std::invalid_argument("RolloutTrack length must be positive");
+        }
+        if (!std::isfinite(job.dt) || !(job.dt > 0.0)) {
+            throw std::invalid_argument("RolloutJob dt must be finite and positive");
+        }
+        if (!std::isfinite(job.max_time_s) || job.max_time_s < 0.0) {
+            throw std::invalid_argument("RolloutJob max_time_s must be finite and non-negative");
+        }
+        // 2^64: anything at or above it does not fit the step counter
+        const double step_budget = std::ceil(job.max_time_s / job.dt);
+        if (!(step_budget < 18446744073709551616.0)) {
+            throw std::invalid_argument("RolloutJob max_time_s / dt exceeds the step counter");
+        }
+        const auto max_steps = static_cast<std::uint64_t>(step_budget);
+
+        StSimulator& sim = workspace.begin(job);
+        RolloutController& controller = workspace.controller(job);
+        telemetry::TelemetryRecorder* recorder = workspace.recorder();
+
+        std::optional<StyleAccumulator> style;
+        if (job.style) {
+            const double limit = job.style->metrics.lat_accel_limit > 0.0 ? job.style->metrics.lat_accel_limit
+                                                                          : sim.constants().accel_budget;
+            style.emplace(job.style->metrics, job.style->weights, limit);
+        }
+
+        double progress = track.project(sim.state(), -1.0);
+        double covered = 0.0;
+        double time = 0.0;
+        models::StControl control{};
+
+        result.outcome = RolloutOutcome::Timeout;
+        for (std::uint64_t step = 0; step < max_steps; ++step) {
+            {
+                VELOX_TIME_SCOPE(telemetry::Stage::Controller);
+                controller.command(sim.state(), time, control);
+            }
+            sim.step(control[0], control[1]);
+
+            const double speed = sim.speed();
+            time += job.dt;
+            result.distance_m += speed * job.dt;
+            result.energy_j += sim.last_control()[1] * speed * job.dt;
+            result.steps = step + 1;
+            if (recorder) {
+                VELOX_TIME_SCOPE(telemetry::Stage::Telemetry);
+                record_step(*recorder, sim, time, result);
+            }
+
+            double next;
+            bool off_track;
+            {
+                VELOX_TIME_SCOPE(telemetry::Stage::TrackQuery);
+                next = track.project(sim.state(), progress);
+                off_track = track.off_track(sim.state());
+            }
+            double advance = next - progress;
+            if (track.closed()) {
+                // unwrap across the start/finish line
+                if (advance < -0.5 * length) advance += length;
+                else if (advance > 0.5 * length) advance -= length;
+            }
+            covered += advance;
+            progress = next;
+            if (style) {
+                style->add(sim.state(), sim.last_control(), track.curvature(next), track.target_speed(next), job.dt);
+            }
+
+            if (covered >= length || (!track.closed() && next >= length)) {
+                result.outcome = RolloutOutcome::LapComplete;
+                break;
+            }
+            if (off_track) {
+                result.outcome = RolloutOutcome::OffTrack;
+                break;
+            }
+            if (style && style->cost() > job.style->stop_cost) {
+                result.outcome = RolloutOutcome::Dominated;
+                break;
+            }
+        }
+        result.lap_time_s = time;
+        result.final_state = sim.state();
+        if (style) {
+            result.style = style->metrics();
+            // a dominated run reports the bound it was stopped on, not a completion penalty
+            result.style_cost = result.outcome == RolloutOutcome::Dominated
+                                    ? style->cost()
+                                    : style->final_cost(result.outcome == RolloutOutcome::LapComplete);
+        }
+    } catch (const std::exception& e) {
+        result.outcome = RolloutOutcome::Error;
+        result.error = e.what();
+    }
+    return result;
+}
+
+} // namespace velox::simulation
@@ -0,0 +1,144 @@
+#pragma once
+
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <optional>
+#include <string>
+
+#include "models/vehicle_dynamics_st.hpp"
+#include "random_stream.hpp"
+#include "style_metrics.hpp"
+
+namespace velox::simulation {
+
+/**
+ * Track as seen by a rollout: arc-length progress of a state along the reference line.
+ * Implementations must be immutable after construction; one instance is shared by every
+ * worker thread.
+ */
+class RolloutTrack {
+public:
+    virtual ~RolloutTrack() = default;
+
+    /// Reference length [m]; one lap on a closed track, start-to-finish on an open one.
+    virtual double length() const = 0;
+    virtual bool closed() const = 0;
+
+    /// Arc length of the closest reference point. hint is the previous result (or < 0 when
+    /// unknown) and may be used to warm-start the search.
+    virtual double project(const models::StState& state, double hint) const = 0;
+
+    /// True when the state has left the drivable area; the default never terminates early.
+    virtual bool off_track(const models::StState& state) const { (void)state; return false; }
+
+    /// Reference curvature [1/m] at arc length s, for style metrics; the default is straight.
+    virtual double curvature(double s) const { (void)s; return 0.0; }
+
+    /// Target speed [m/s] at arc length s for the speed-tracking metric; NaN (the default)
+    /// leaves speed tracking out.
+    virtual double target_speed(double s) const { (void)s; return std::numeric_limits<double>::quiet_NaN(); }
+};
+
+/**
+ * Stateful controller instance. Each rollout gets its own instance from a
+ * RolloutControllerFactory, so implementations need no internal synchronisation.
+ */
+class RolloutController {
+public:
+    virtual ~RolloutController() = default;
+
+    virtual void reset(const models::VehicleParameters& params, const RolloutTrack& track) = 0;
+
+    /**
+     * Called before reset() with the job's own stream (RandomStream(job.seed, job.id)).
+     * Controllers that draw noise must take it from here, never from a shared generator, for
+     * results to be independent of thread count and scheduling.
+     */
+    virtual void seed(const RandomStream& stream) { (void)stream; }
+
+    /**
+     * True when seed() + reset() fully restore the state make() produced, so an
+     * EpisodeWorkspace (episode_pool.hpp) may keep this instance for the next episode of the
+     * same factory instead of making a new one.
+     */
+    virtual bool reusable() const { return false; }
+
+    /// Writes [steering rate, acceleration] for the current state and simulation time.
+    virtual void command(const models::StState& state, double time_s, models::StControl& out) = 0;
+};
+
+/// Immutable controller configuration; make() is called concurrently from worker threads.
+class RolloutControllerFactory {
+public:
+    virtual ~RolloutControllerFactory() = default;
+    virtual std::unique_ptr<RolloutController> make() const = 0;
+};
+
+/** Style scoring of a rollout; see StyleAccumulator. */
+struct RolloutStyle {
+    StyleMetricsOptions metrics;
+    StyleScoreWeights weights;
+    /// The rollout stops as RolloutOutcome::Dominated once its running cost exceeds this, e.g.
+    /// the best complete score of a sweep so far.
+    double stop_cost = std::numeric_limits<double>::infinity();
+};
+
+struct RolloutJob {
+    std::uint64_t id{};
+    std::shared_ptr<const models::VehicleParameters> params;
+    std::shared_ptr<const RolloutControllerFactory> controller;
+    std::shared_ptr<const RolloutTrack> track;
+    models::StState initial_state{};
+    double dt{0.01};
+    double max_time_s{300.0};
+    std::uint64_t seed{0}; // base seed of the job's RandomStream; the stream id is the job id
+    std::shared_ptr<const RolloutStyle> style; // null: no style metrics
+};
+
+enum class RolloutOutcome {
+    LapComplete,
+    Timeout,
+    OffTrack,
+    Dominated, // running style cost exceeded RolloutStyle::stop_cost
+    Error,
+};
+
+struct RolloutResult {
+    std::uint64_t id{};
+    RolloutOutcome outcome{RolloutOutcome::Error};
+    double lap_time_s{};
+    double distance_m{};
+    double energy_j{};
+    std::uint64_t steps{};
+    models::StState final_state{};
+    std::optional<StyleMetrics> style; // set when the job has a RolloutStyle
+    double style_cost{};               // final_cost(); for Dominated, cost() when stopped (a lower bound)
+    std::string error;
+};
+
+/**
+ * run_rollout
+ *
+ * Runs one job to completion on the calling thread with a StSimulator: the controller is stepped
+ * at the job dt until the accumulated progress covers track->length(), the track reports an
+ * off-track state, or max_time_s elapses. Distance and energy accumulate as in
+ * SimulationDaemon (|v| dt and a v dt with the applied acceleration), in step order. With a
+ * job.style, a StyleAccumulator is fed every step with the track's curvature and target speed
+ * at the new progress, and the run ends as Dominated once its cost exceeds style->stop_cost
+ * (after the lap and off-track checks of that step).
+ *
+ * This overload is a pure function of the job: the simulator, controller and stream are local
+ * to the call and the shared inputs are immutable, so the same job gives a bitwise identical
+ * result on any thread. The EpisodeWorkspace overload (episode_pool.hpp) re-seats the
+ * simulator and the stream per job but may keep a controller from an earlier job of the same
+ * factory; it gives the same result only while every controller that reports reusable()
+ * really is restored by seed() + reset(). run_rollouts_deterministic does not reuse
+ * controllers, so it does not depend on that.
+ *
+ * Never throws; failures, including a non-finite or non-positive dt and a negative or
+ * non-finite max_time_s, are reported as RolloutOutcome::Error with a message.
+ */
+RolloutResult run_rollout(const RolloutJob& job);
+
+} // namespace velox::simulation
@@ -0,0 +1,230 @@
+#include "rollout_pool.hpp"
+
+#include <algorithm>
+#include <exception>
+#include <stdexcept>
+#include <string>
+#include <unordered_map>
+#include <utility>
+
+namespace velox::simulation {
+
+namespace {
+
+constexpr std::size_t kPairwiseBlock = 8;
+
+// Pairwise summation of field(results[i]) over [begin, end); the split points depend only on
+// the range, so the rounding is the same for every run over the same results.
+template <typename Field>
+double pairwise_sum(const std::vector<RolloutResult>& results, std::size_t begin, std::size_t end, Field field)
+{
+    if (end - begin <= kPairwiseBlock) {
+        double sum = 0.0;
+        for (std::size_t i = begin; i < end; ++i) sum += field(results[i]);
+        return sum;
+    }
+    const std::size_t mid = begin + (end - begin) / 2;
+    return pairwise_sum(results, begin, mid, field) + pairwise_sum(results, mid, end, field);
+}
+
+} // anonymous namespace
+
+RolloutPool::RolloutPool(ResultCallback on_result, std::size_t threads, const EpisodeWorkspaceOptions& workspace)
+    : on_result_(std::move(on_result))
+    , workspace_options_(workspace)
+{
+    if (threads == 0) {
+        threads = std::max<std::size_t>(1, std::thread::hardware_concurrency());
+    }
+    queues_.reserve(threads);
+    for (std::size_t i = 0; i < threads; ++i) {
+        queues_.push_back(std::make_unique<WorkerQueue>());
+    }
+    threads_.reserve(threads);
+    for (std::size_t i = 0; i < threads; ++i) {
+        threads_.emplace_back([this, i] { worker_loop(i); });
+    }
+}
+
+RolloutPool::~RolloutPool()
+{
+    drain(); // a pending callback error is dropped: destructors must not throw
+    {
+        std::lock_guard lock(state_mutex_);
+        stopping_ = true;
+    }
+    work_cv_.notify_all();
+    for (std::thread& t : threads_) {
+        t.join();
+    }
+}
+
+void RolloutPool::enqueue(RolloutJob&& job)
+{
+    const std::size_t target = next_queue_.fetch_add(1, std::memory_order_relaxed) % queues_.size();
+    WorkerQueue& q = *queues_[target];
+    std::lock_guard lock(q.mutex);
+    q.jobs.push_back(std::move(job));
+}
+
+void RolloutPool::submit(RolloutJob job)
+{
+    enqueue(std::move(job));
+    {
+        std::lock_guard lock(state_mutex_);
+        ++queued_;
+        ++unfinished_;
+    }
+    work_cv_.notify_one();
+}
+
+void RolloutPool::submit(std::vector<RolloutJob> jobs)
+{
+    const std::size_t count = jobs.size();
+    for (RolloutJob& job : jobs) {
+        enqueue(std::move(job));
+    }
+    {
+        std::lock_guard lock(state_mutex_);
+        queued_ += count;
+        unfinished_ += count;
+    }
+    work_cv_.notify_all();
+}
+
+void RolloutPool::drain()
+{
+    std::unique_lock lock(state_mutex_);
+    idle_cv_.wait(lock, [this] { return unfinished_ == 0; });
+}
+
+void RolloutPool::wait()
+{
+    std::exception_ptr error;
+    {
+        std::unique_lock lock(state_mutex_);
+        idle_cv_.wait(lock, [this] { return unfinished_ == 0; });
+        error = std::exchange(callback_error_, nullptr);
+    }
+    if (error) {
+        std::rethrow_exception(error);
+    }
+}
+
+// Own deque from the back (most recently dealt, still warm), others from the front.
+bool RolloutPool::take(std::size_t self, RolloutJob& out)
+{
+    {
+        WorkerQueue& own = *queues_[self];
+        std::lock_guard lock(own.mutex);
+        if (!own.jobs.empty()) {
+            out = std::move(own.jobs.back());
+            own.jobs.pop_back();
+            return true;
+        }
+    }
+    const std::size_t n = queues_.size();
+    for (std::size_t k = 1; k < n; ++k) {
+        WorkerQueue& victim = *queues_[(self + k) % n];
+        std::lock_guard lock(victim.mutex);
+        if (!victim.jobs.empty()) {
+            out = std::move(victim.jobs.front());
+            victim.jobs.pop_front();
+            return true;
+        }
+    }
+    return false;
+}
+
+void RolloutPool::worker_loop(std::size_t self)
+{
+    EpisodeWorkspace workspace(workspace_options_);
+    RolloutJob job;
+    for (;;) {
+        {
+            std::unique_lock lock(state_mutex_);
+            work_cv_.wait(lock, [this] { return stopping_ || queued_ > 0; });
+            if (queued_ == 0) return; // stopping with nothing left
+        }
+        if (!take(self, job)) {
+            continue; // another worker won the race for the last job
+        }
+        {
+            std::lock_guard lock(state_mutex_);
+            --queued_;
+        }
+
+        RolloutResult result = run_rollout(job, workspace);
+        job = RolloutJob{}; // release shared inputs before reporting
+        std::exception_ptr error;
+        if (on_result_) {
+            try {
+                on_result_(std::move(result));
+            } catch (...) {
+                error = std::current_exception();
+            }
+        }
+
+        bool idle = false;
+        {
+            std::lock_guard lock(state_mutex_);
+            if (error && !callback_error_) callback_error_ = std::move(error);
+            idle = (--unfinished_ == 0);
+        }
+        if (idle) {
+            idle_cv_.notify_all();
+        }
+    }
+}
+
+std::vector<RolloutResult> run_rollouts_deterministic(std::vector<RolloutJob> jobs, std::size_t threads)
+{
+    std::unordered_map<std::uint64_t, std::size_t> slot;
+    slot.reserve(jobs.size());
+    for (std::size_t i = 0; i < jobs.size(); ++i) {
+        if (!slot.emplace(jobs[i].id, i).second) {
+            throw std::invalid_argument("run_rollouts_deterministic: duplicate job id " + std::to_string(jobs[i].id));
+        }
+    }
+
+    // A cached controller is the only state a worker could carry from one job to the next.
+    EpisodeWorkspaceOptions workspace;
+    workspace.controller_cache = 0;
+
+    // Workers only read `slot` and each writes the one element its job owns.
+    std::vector<RolloutResult> results(jobs.size());
+    {
+        RolloutPool pool([&](RolloutResult&& result) { results[slot.at(result.id)] = std::move(result); },
+                         std::min(threads == 0 ? std::size_t{std::thread::hardware_concurrency()} : threads,
+                                  std::max<std::size_t>(jobs.size(), 1)),
+                         workspace);
+        pool.submit(std::move(jobs));
+        pool.wait();
+    }
+    return results;
+}
+
+RolloutTotals reduce_rollouts(const std::vector<RolloutResult>& results)
+{
+    RolloutTotals totals;
+    totals.rollouts = results.size();
+    for (const RolloutResult& r : results) {
+        totals.steps += r.steps;
+        switch (r.outcome) {
+            case RolloutOutcome::LapComplete: ++totals.laps_completed; break;
+            case RolloutOutcome::Timeout: ++totals.timeouts; break;
+            case RolloutOutcome::OffTrack: ++totals.off_track; break;
+            case RolloutOutcome::Dominated: ++totals.dominated; break;
+            case RolloutOutcome::Error: ++totals.errors; break;
+        }
+    }
+    const std::size_t n = results.size();
+    totals.distance_m = pairwise_sum(results, 0, n, [](const RolloutResult& r) { return r.distance_m; });
+    totals.energy_j = pairwise_sum(results, 0, n, [](const RolloutResult& r) { return r.energy_j; });
+    totals.lap_time_s = pairwise_sum(results, 0, n, [](const RolloutResult& r) {
+        return r.outcome == RolloutOutcome::LapComplete ? r.lap_time_s : 0.0;
+    });
+    return totals;
+}
+
+} // namespace velox::simulation
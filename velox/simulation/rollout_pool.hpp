@@ -0,0 +1,118 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "episode_pool.hpp"
+#include "rollout.hpp"
+
+namespace velox::simulation {
+
+/**
+ * Work-stealing pool that runs RolloutJobs across all cores.
+ *
+ * Each worker owns a deque: submit() deals jobs round-robin, a worker pops from the back of its
+ * own deque and steals from the front of the others when it runs dry, so long and short laps
+ * balance out without a central queue. Every job runs through run_rollout() on the worker's
+ * own EpisodeWorkspace (simulator, telemetry recorder, reusable controllers), built on that
+ * thread and reused for every job it runs, so the simulator and recorder are never rebuilt per
+ * episode; the only state shared between threads is the immutable job inputs.
+ *
+ * Results are streamed to the callback from the worker thread as each job finishes (completion
+ * order, not submission order; run_rollouts_deterministic restores submission order). The
+ * callback must be thread-safe. An exception it throws does not take the worker down: the
+ * first one is kept and rethrown by the next wait(), after every job has been reported.
+ */
+class RolloutPool {
+public:
+    using ResultCallback = std::function<void(RolloutResult&&)>;
+
+    /// threads == 0 uses std::thread::hardware_concurrency(); workspace configures each worker's.
+    explicit RolloutPool(ResultCallback on_result, std::size_t threads = 0,
+                         const EpisodeWorkspaceOptions& workspace = {});
+    ~RolloutPool();
+
+    RolloutPool(const RolloutPool&) = delete;
+    RolloutPool& operator=(const RolloutPool&) = delete;
+
+    void submit(RolloutJob job);
+    void submit(std::vector<RolloutJob> jobs);
+
+    /// Blocks until every job submitted so far has been reported, then rethrows the first
+    /// exception the callback threw since the last wait(), if any.
+    void wait();
+
+    std::size_t thread_count() const { return threads_.size(); }
+
+private:
+    struct WorkerQueue {
+        std::mutex mutex;
+        std::deque<RolloutJob> jobs;
+    };
+
+    void enqueue(RolloutJob&& job);
+    bool take(std::size_t self, RolloutJob& out);
+    void worker_loop(std::size_t self);
+    void drain();
+
+    ResultCallback on_result_;
+    EpisodeWorkspaceOptions workspace_options_;
+    std::vector<std::unique_ptr<WorkerQueue>> queues_;
+    std::vector<std::thread> threads_;
+
+    std::mutex state_mutex_;
+    std::condition_variable work_cv_;
+    std::condition_variable idle_cv_;
+    std::size_t queued_{0};     // guarded by state_mutex_
+    std::size_t unfinished_{0}; // guarded by state_mutex_
+    bool stopping_{false};      // guarded by state_mutex_
+    std::exception_ptr callback_error_; // guarded by state_mutex_
+    std::atomic<std::size_t> next_queue_{0};
+};
+
+/** Aggregate of a result set; see reduce_rollouts(). */
+struct RolloutTotals {
+    std::size_t rollouts{};
+    std::size_t laps_completed{};
+    std::size_t timeouts{};
+    std::size_t off_track{};
+    std::size_t dominated{};
+    std::size_t errors{};
+    std::uint64_t steps{};
+    double distance_m{};
+    double energy_j{};
+    double lap_time_s{}; // summed over completed laps only
+};
+
+/**
+ * run_rollouts_deterministic
+ *
+ * Deterministic execution mode: runs jobs on a RolloutPool of `threads` workers and returns
+ * the results in submission order. The workers keep no controllers between jobs
+ * (controller_cache = 0), so each result is a pure function of its job, as with
+ * run_rollout(job), whatever ran before it on the same worker. Each lands in its own
+ * preallocated slot, so the returned vector is bitwise identical for any thread count or
+ * scheduling order. Job ids must be unique (they key the slots); throws
+ * std::invalid_argument otherwise.
+ */
+std::vector<RolloutResult> run_rollouts_deterministic(std::vector<RolloutJob> jobs, std::size_t threads = 0);
+
+/**
+ * reduce_rollouts
+ *
+ * Sums distance, energy and lap time with pairwise summation over a tree fixed by the result
+ * index, so the totals depend only on the order of results, never on how they were produced.
+ * Pass the output of run_rollouts_deterministic (or any submission-ordered set).
+ */
+RolloutTotals reduce_rollouts(const std::vector<RolloutResult>& results);
+
+} // namespace velox::simulation
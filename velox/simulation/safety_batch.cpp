@@ -0,0 +1,354 @@
+#include "safety_batch.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+#include <string>
+
+#include "st_batch.hpp"
+#include "telemetry/instrumentation.hpp"
+
+namespace velox::simulation {
+
+using namespace velox::simd;
+
+namespace {
+
+constexpr double kStageTransition = static_cast<double>(SafetyStageCode::Transition);
+constexpr double kStageEmergency = static_cast<double>(SafetyStageCode::Emergency);
+
+// clamp() of LowSpeedSafety.ts: max(lo, min(hi, x))
+VecD clamp_ts(VecD x, VecD lo, VecD hi)
+{
+    return max(lo, min(hi, x));
+}
+
+[[maybe_unused]] double lane_sum(VecD v)
+{
+    double lanes[kWidth];
+    store(lanes, v);
+    double sum = 0.0;
+    for (double lane : lanes) sum += lane;
+    return sum;
+}
+
+void validate_profile(const models::LowSpeedSafetyProfile& profile, const char* name)
+{
+    if (profile.engage_speed < 0.0 || profile.release_speed <= 0.0 || profile.release_speed < profile.engage_speed) {
+        throw std::invalid_argument(std::string("LowSpeedSafety profile ") + name +
+                                    " has invalid engage/release speeds");
+    }
+    if (!(profile.yaw_rate_limit > 0.0) || !(profile.slip_angle_limit > 0.0)) {
+        throw std::invalid_argument(std::string("LowSpeedSafety profile ") + name + " requires positive limits");
+    }
+}
+
+void fill_valid(AlignedBuffer& valid, std::size_t count)
+{
+    for (std::size_t i = 0; i < count; ++i) valid[i] = 1.0;
+}
+
+} // anonymous namespace
+
+LowSpeedSafetyBatch::LowSpeedSafetyBatch(const models::LowSpeedSafetyConfig& config, std::size_t count,
+                                         double wheelbase, double rear_length)
+    : config_(config)
+    , count_(count)
+    , wheelbase_(wheelbase)
+    , rear_length_(rear_length)
+    , drift_enabled_(config.drift_enabled)
+    , valid_(count), engaged_(count), severity_(count), blend_(count), stage_(count), speed_(count)
+{
+    validate_profile(config_.normal, "normal");
+    validate_profile(config_.drift, "drift");
+    if (config_.stop_speed_epsilon < 0.0) {
+        throw std::invalid_argument("stop_speed_epsilon must be non-negative");
+    }
+    fill_valid(valid_, count_);
+}
+
+void LowSpeedSafetyBatch::reset(std::size_t i)
+{
+    if (i >= count_) {
+        throw std::out_of_range("LowSpeedSafetyBatch::reset index out of range");
+    }
+    engaged_[i] = 0.0;
+    severity_[i] = 0.0;
+    blend_[i] = 0.0;
+    stage_[i] = 0.0;
+}
+
+void LowSpeedSafetyBatch::reset_all()
+{
+    for (std::size_t i = 0; i < count_; ++i) reset(i);
+}
+
+void LowSpeedSafetyBatch::apply(StBatch& batch, bool update_latch)
+{
+    if (batch.size() != count_) {
+        throw std::invalid_argument("LowSpeedSafetyBatch and StBatch sizes differ");
+    }
+    const double* v = batch.v();
+    for (std::size_t i = 0; i < speed_.size(); i += kWidth) {
+        store(speed_.data() + i, abs(load(v + i)));
+    }
+    SafetyColumns columns;
+    columns.longitudinal = batch.v();
+    columns.steering = batch.delta();
+    apply(columns, speed_.data(), update_latch);
+}
+
+void LowSpeedSafetyBatch::apply(const SafetyColumns& c, const double* speed, bool update_latch)
+{
+    VELOX_TIME_SCOPE(telemetry::Stage::LowSpeedSafety);
+    const models::LowSpeedSafetyProfile& profile = drift_enabled_ ? config_.drift : config_.normal;
+
+    // Which optional quantities exist is uniform over the batch; only their values are per lane.
+    const bool has_kinematic = c.steering && wheelbase_ > 0.0 && rear_length_ > 0.0;
+    const bool heading_from_velocity = c.longitudinal && c.lateral;
+    const bool has_heading = heading_from_velocity || c.slip;
+    const double band_s = std::max(profile.release_speed - profile.engage_speed, 0.0);
+    const bool has_band = band_s > 0.0;
+
+    const VecD zero = broadcast(0.0);
+    const VecD one = broadcast(1.0);
+    const VecD tiny = broadcast(1e-9);
+    const VecD engage = broadcast(profile.engage_speed);
+    const VecD release = broadcast(profile.release_speed);
+    const VecD upper = broadcast(profile.release_speed + band_s);
+    const VecD inv_band = broadcast(has_band ? 1.0 / band_s : 0.0);
+    const VecD eps = broadcast(config_.stop_speed_epsilon);
+    const VecD yaw_limit = broadcast(profile.yaw_rate_limit);
+    const VecD slip_limit = broadcast(profile.slip_angle_limit);
+    const VecD inv_yaw_limit = broadcast(1.0 / std::max(profile.yaw_rate_limit, 1e-6));
+    const VecD inv_slip_limit = broadcast(1.0 / std::max(profile.slip_angle_limit, 1e-6));
+    const VecD inv_release = broadcast(1.0 / std::max(profile.release_speed, 1e-6));
+    const VecD min_limit = broadcast(std::max(config_.stop_speed_epsilon, 1e-6));
+    const VecD rear_ratio = broadcast(has_kinematic ? rear_length_ / wheelbase_ : 0.0);
+    const VecD inv_wheelbase = broadcast(has_kinematic ? 1.0 / wheelbase_ : 0.0);
+    const VecD emergency_code = broadcast(kStageEmergency);
+    const VecD transition_code = broadcast(kStageTransition);
+    const MaskD drift = mask_all(drift_enabled_);
+    const MaskD blend_kinematic = mask_all(has_kinematic);
+
+    // scaledLimit(): the limit shrinks linearly below the release speed, never under min_limit
+    auto scaled_limit = [&](VecD limit, VecD s) {
+        const VecD ratio = clamp_ts(s * inv_release, zero, one);
+        return select(s >= release, limit, clamp_ts(limit * ratio, min_limit, limit));
+    };
+    auto blend = [](VecD value, VecD target, VecD b) { return (broadcast(1.0) - b) * value + b * target; };
+
+    VecD engagements = zero;
+    const std::size_t padded = engaged_.size();
+    for (std::size_t i = 0; i < padded; i += kWidth) {
+        const VecD s = load(speed + i);
+
+        // monitor()
+        const VecD b = has_band ? clamp_ts((upper - s) * inv_band, zero, one) : zero;
+        const MaskD near_stop = abs(s) <= eps;
+        const VecD yaw_state = c.yaw_rate ? load(c.yaw_rate + i) : zero;
+        const VecD slip_state = c.slip ? load(c.slip + i) : zero;
+
+        // kinematic yaw rate v cos(beta) tan(delta) / L; the kinematic slip target is only read
+        // in emergency, where the velocity heading replaces it
+        VecD yaw_target = zero;
+        if (has_kinematic) {
+            const VecD tan_delta = tan(load(c.steering + i));
+            const VecD tan_beta = tan_delta * rear_ratio;
+            const VecD cos_beta = one / sqrt(one + tan_beta * tan_beta);
+            yaw_target = select(abs(s) <= tiny, zero, s * cos_beta * tan_delta * inv_wheelbase);
+        }
+
+        VecD heading = zero;
+        if (heading_from_velocity) {
+            const VecD lon = load(c.longitudinal + i);
+            const VecD lat = load(c.lateral + i);
+            heading = select((abs(lon) <= tiny) & (abs(lat) <= tiny), zero, atan2(lat, lon));
+        } else if (c.slip) {
+            heading = slip_state;
+        }
+
+        const VecD severity = max(abs(yaw_state) * inv_yaw_limit, abs(slip_state) * inv_slip_limit);
+
+        // decide()
+        const MaskD trip = severity > one;
+        const VecD previous_stage = load(stage_.data() + i);
+        MaskD engaged = load(engaged_.data() + i) > zero;
+        if (update_latch) {
+            const MaskD release_now = engaged & (s > release) & !trip;
+            const MaskD engage_now = (!engaged) & ((s < engage) | trip);
+            engaged = (engaged & !release_now) | engage_now;
+            store(engaged_.data() + i, select(engaged, one, zero));
+        }
+        const MaskD emergency = engaged | trip;
+        const MaskD transition = (!emergency) & (b > zero);
+        const VecD stage = select(emergency, emergency_code, select(transition, transition_code, zero));
+        if (update_latch) {
+            const MaskD entering = (previous_stage == zero) & (stage > zero);
+            engagements = engagements + select(entering, load(valid_.data() + i), zero);
+        }
+        store(severity_.data() + i, severity);
+        store(blend_.data() + i, b);
+        store(stage_.data() + i, stage);
+
+        // clampState()
+        const MaskD normal = (!emergency) & (!transition);
+        const MaskD unclamped = drift & normal;
+        const MaskD blending = b > zero;
+        const MaskD wheel_latch = emergency | (s < engage) | blending;
+
+        // emergency targets: zero yaw, slip along the velocity heading unless nearly stopped
+        const MaskD follow_heading = mask_all(has_heading) & !near_stop;
+        const VecD slip_command = select(follow_heading, heading, zero);
+
+        if (c.yaw_rate) {
+            const VecD limit = scaled_limit(yaw_limit, s);
+            VecD value = clamp_ts(yaw_state, -limit, limit);
+            value = select(blending & blend_kinematic, blend(value, clamp_ts(yaw_target, -limit, limit), b), value);
+            store(c.yaw_rate + i, select(emergency, zero, select(unclamped, yaw_state, value)));
+        }
+        if (c.lateral) {
+            const VecD value = load(c.lateral + i);
+            VecD sin_command, cos_command;
+            sincos(slip_command, sin_command, cos_command);
+            const VecD em = select(follow_heading, s * sin_command, zero);
+            store(c.lateral + i, select(emergency, em, select(abs(value) <= eps, zero, value)));
+        }
+        if (c.slip) {
+            const VecD limit = scaled_limit(slip_limit, s);
+            VecD value = clamp_ts(slip_state, -limit, limit);
+            const VecD target = select(follow_heading, clamp_ts(heading, -limit, limit), zero);
+            value = select(blending, blend(value, target, b), value);
+            const VecD em = clamp_ts(slip_command, -slip_limit, slip_limit);
+            store(c.slip + i, select(emergency, em, select(unclamped, slip_state, value)));
+        }
+        for (double* wheel : c.wheel_speeds) {
+            if (!wheel) continue;
+            const VecD value = load(wheel + i);
+            store(wheel + i, select((value <= zero) | (wheel_latch & (value <= eps)), zero, value));
+        }
+    }
+    VELOX_COUNT(telemetry::Counter::SafetyEngagements, static_cast<std::uint64_t>(lane_sum(engagements)));
+}
+
+LossOfControlBatch::LossOfControlBatch(const models::LossOfControlConfig& config, std::size_t count,
+                                       std::size_t wheels)
+    : config_(config)
+    , count_(count)
+    , wheels_(wheels)
+    , valid_(count), primed_(count)
+    , prev_yaw_rate_(count), prev_slip_angle_(count), prev_lateral_accel_(count)
+    , severity_(count)
+    , scratch_yaw_(count), scratch_slip_(count), scratch_lat_(count)
+{
+    if (wheels_ > kMaxWheels) {
+        throw std::invalid_argument("LossOfControlBatch supports at most " + std::to_string(kMaxWheels) +
+                                    " wheels");
+    }
+    for (std::size_t w = 0; w < wheels_; ++w) prev_slip_ratio_[w].resize(count);
+    fill_valid(valid_, count_);
+}
+
+void LossOfControlBatch::reset(std::size_t i)
+{
+    if (i >= count_) {
+        throw std::out_of_range("LossOfControlBatch::reset index out of range");
+    }
+    primed_[i] = 0.0;
+    prev_yaw_rate_[i] = 0.0;
+    prev_slip_angle_[i] = 0.0;
+    prev_lateral_accel_[i] = 0.0;
+    for (std::size_t w = 0; w < wheels_; ++w) prev_slip_ratio_[w][i] = 0.0;
+    severity_[i] = 0.0;
+}
+
+void LossOfControlBatch::reset_all()
+{
+    for (std::size_t i = 0; i < count_; ++i) reset(i);
+}
+
+void LossOfControlBatch::update(double dt, const double* yaw_rate, const double* slip_angle,
+                                const double* lateral_accel, const double* const* slip_ratios)
+{
+    if (!(dt > 0.0)) {
+        throw std::invalid_argument("LossOfControlDetector requires positive dt");
+    }
+    VELOX_TIME_SCOPE(telemetry::Stage::LossOfControl);
+
+    const VecD zero = broadcast(0.0);
+    const VecD half = broadcast(0.5);
+    const VecD inv_dt = broadcast(1.0 / std::max(dt, 1e-9));
+
+    struct Limits {
+        VecD threshold, rate, inv_threshold, inv_rate;
+    };
+    auto limits = [](const models::MetricThreshold& m) {
+        return Limits{broadcast(m.threshold), broadcast(m.rate), broadcast(1.0 / m.threshold),
+                      broadcast(1.0 / m.rate)};
+    };
+    const Limits yaw_limits = limits(config_.yaw_rate);
+    const Limits slip_limits = limits(config_.slip_angle);
+    const Limits lat_limits = limits(config_.lateral_accel);
+    const Limits ratio_limits = limits(config_.slip_ratio);
+
+    // evaluateMetric(): scores only when both the magnitude and its rate reach their thresholds
+    auto score = [&](VecD value, double* previous, const Limits& l, MaskD primed) {
+        const VecD rate = abs(value - load(previous)) * inv_dt;
+        const VecD mag = abs(value);
+        const MaskD active = primed & (mag >= l.threshold) & (rate >= l.rate);
+        const VecD s = max(zero, half * ((mag - l.threshold) * l.inv_threshold) +
+                                     half * ((rate - l.rate) * l.inv_rate));
+        store(previous, value);
+        return select(active, s, zero);
+    };
+
+    VecD events = zero;
+    const std::size_t padded = severity_.size();
+    for (std::size_t i = 0; i < padded; i += kWidth) {
+        const MaskD primed = load(primed_.data() + i) > zero;
+        VecD severity = zero;
+        if (yaw_rate) severity = max(severity, score(load(yaw_rate + i), prev_yaw_rate_.data() + i, yaw_limits, primed));
+        if (slip_angle) {
+            severity = max(severity, score(load(slip_angle + i), prev_slip_angle_.data() + i, slip_limits, primed));
+        }
+        if (lateral_accel) {
+            severity = max(severity,
+                           score(load(lateral_accel + i), prev_lateral_accel_.data() + i, lat_limits, primed));
+        }
+        if (slip_ratios) {
+            for (std::size_t w = 0; w < wheels_; ++w) {
+                if (!slip_ratios[w]) continue;
+                severity = max(severity, score(load(slip_ratios[w] + i), prev_slip_ratio_[w].data() + i,
+                                               ratio_limits, primed));
+            }
+        }
+        const MaskD rising = (load(severity_.data() + i) <= zero) & (severity > zero);
+        events = events + select(rising, load(valid_.data() + i), zero);
+        store(severity_.data() + i, severity);
+        store(primed_.data() + i, broadcast(1.0));
+    }
+    VELOX_COUNT(telemetry::Counter::LossOfControlEvents, static_cast<std::uint64_t>(lane_sum(events)));
+}
+
+void LossOfControlBatch::update(const StBatch& batch, const models::VehicleParameters& params, double dt)
+{
+    if (batch.size() != count_) {
+        throw std::invalid_argument("LossOfControlBatch and StBatch sizes differ");
+    }
+    const double L_s = std::max(params.a + params.b, 1e-6);
+    const VecD one = broadcast(1.0);
+    const VecD inv_L = broadcast(1.0 / L_s);
+    const VecD rear_ratio = broadcast(params.b / L_s);
+    for (std::size_t i = 0; i < scratch_yaw_.size(); i += kWidth) {
+        const VecD v = abs(load(batch.v() + i));
+        const VecD tan_beta = rear_ratio * tan(load(batch.delta() + i));
+        const VecD sin_beta = tan_beta / sqrt(one + tan_beta * tan_beta);
+        const VecD yaw_rate = v * sin_beta * inv_L;
+        store(scratch_yaw_.data() + i, yaw_rate);
+        store(scratch_slip_.data() + i, atan(tan_beta));
+        store(scratch_lat_.data() + i, v * yaw_rate);
+    }
+    update(dt, scratch_yaw_.data(), scratch_slip_.data(), scratch_lat_.data());
+}
+
+} // namespace velox::simulation
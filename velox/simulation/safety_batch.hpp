@@ -0,0 +1,137 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+#include "config_bundle.hpp"
+#include "simd.hpp"
+
+namespace velox::simulation {
+
+class StBatch;
+
+/**
+ * State columns the low-speed safety layer reads and clamps, index = vehicle. A null column
+ * is a state the model does not have (the undefined indices of LowSpeedIndices). Every column
+ * must be padded to a multiple of simd::kWidth like the StBatch / AlignedBuffer columns.
+ */
+struct SafetyColumns {
+    double* longitudinal = nullptr; // body longitudinal velocity [m/s]
+    double* lateral = nullptr;      // body lateral velocity [m/s]
+    double* yaw_rate = nullptr;     // [rad/s]
+    double* slip = nullptr;         // body slip angle [rad]
+    const double* steering = nullptr;
+    std::array<double*, 2> wheel_speeds{};
+};
+
+/// SafetyStage as recorded by the telemetry channel: normal, transition, emergency.
+enum class SafetyStageCode : std::uint8_t { Normal = 0, Transition = 1, Emergency = 2 };
+
+/**
+ * LowSpeedSafetyBatch
+ *
+ * LowSpeedSafety (LowSpeedSafety.ts) for N vehicles in structure-of-arrays form. apply() runs
+ * monitor, decide and clampState for kWidth vehicles at a time; every branch of the JS version
+ * becomes a lane mask and both sides are computed and blended with select(), so the cost is
+ * independent of how many vehicles are latched.
+ *
+ * The engage/release latch is kept per vehicle. After each apply() the columns severity(),
+ * transition_blend() and stage() hold what status() would report for that state.
+ */
+class LowSpeedSafetyBatch {
+public:
+    /**
+     * wheelbase / rear_length enable the kinematic yaw-rate and slip targets (LowSpeedIndices
+     * wheelbase and rearLength); pass 0 to leave them undefined. Throws std::invalid_argument
+     * for the profile errors LowSpeedSafety rejects.
+     */
+    LowSpeedSafetyBatch(const models::LowSpeedSafetyConfig& config, std::size_t count, double wheelbase = 0.0,
+                        double rear_length = 0.0);
+
+    std::size_t size() const { return count_; }
+
+    void reset(std::size_t i);
+    void reset_all();
+    void set_drift_enabled(bool enabled) { drift_enabled_ = enabled; }
+    bool drift_enabled() const { return drift_enabled_; }
+
+    /**
+     * LowSpeedSafety::apply for every vehicle; speed[i] is the model speed of vehicle i and is
+     * padded like the columns. update_latch = false evaluates without moving the latch, as in the RK4 stages.
+     */
+    void apply(const SafetyColumns& columns, const double* speed, bool update_latch = true);
+
+    /// Single-track batch: longitudinal = v, steering = delta, speed = |v|.
+    void apply(StBatch& batch, bool update_latch = true);
+
+    // Per-vehicle outputs of the last apply().
+    const double* engaged() const { return engaged_.data(); } // latch, 0 or 1
+    const double* severity() const { return severity_.data(); }
+    const double* transition_blend() const { return blend_.data(); }
+    const double* stage() const { return stage_.data(); } // SafetyStageCode as double
+
+    SafetyStageCode stage(std::size_t i) const { return static_cast<SafetyStageCode>(static_cast<int>(stage_[i])); }
+
+private:
+    models::LowSpeedSafetyConfig config_;
+    std::size_t count_;
+    double wheelbase_;
+    double rear_length_;
+    bool drift_enabled_;
+    simd::AlignedBuffer valid_;       // 1 for real lanes, 0 for padding
+    simd::AlignedBuffer engaged_;
+    simd::AlignedBuffer severity_, blend_, stage_;
+    simd::AlignedBuffer speed_;       // scratch for apply(StBatch&)
+};
+
+/**
+ * LossOfControlBatch
+ *
+ * LossOfControlDetector (LossOfControlDetector.ts) for N vehicles. Each vehicle monitors yaw
+ * rate, slip angle, lateral acceleration and `wheels` slip ratios; a metric scores once both
+ * its magnitude and its rate of change exceed their thresholds, and the vehicle severity is the
+ * largest score. The first update after a reset only primes the previous values.
+ */
+class LossOfControlBatch {
+public:
+    static constexpr std::size_t kMaxWheels = 4;
+
+    /// Throws std::invalid_argument for more than kMaxWheels wheels.
+    LossOfControlBatch(const models::LossOfControlConfig& config, std::size_t count, std::size_t wheels = 0);
+
+    std::size_t size() const { return count_; }
+    std::size_t wheels() const { return wheels_; }
+
+    void reset(std::size_t i);
+    void reset_all();
+
+    /**
+     * One detector update per vehicle. A null metric column is not monitored; slip_ratios
+     * holds wheels() columns. Throws std::invalid_argument for a non-positive dt.
+     */
+    void update(double dt, const double* yaw_rate, const double* slip_angle, const double* lateral_accel,
+                const double* const* slip_ratios = nullptr);
+
+    /**
+     * Single-track batch: the kinematic yaw rate v sin(beta) / L, slip beta and lateral
+     * acceleration v^2 sin(beta) / L that JsSimulationBackend reports. It has no wheel slips to
+     * monitor.
+     */
+    void update(const StBatch& batch, const models::VehicleParameters& params, double dt);
+
+    const double* severity() const { return severity_.data(); }
+
+private:
+    models::LossOfControlConfig config_;
+    std::size_t count_;
+    std::size_t wheels_;
+    simd::AlignedBuffer valid_;
+    simd::AlignedBuffer primed_;      // 1 once the previous values exist
+    simd::AlignedBuffer prev_yaw_rate_, prev_slip_angle_, prev_lateral_accel_;
+    std::array<simd::AlignedBuffer, kMaxWheels> prev_slip_ratio_{};
+    simd::AlignedBuffer severity_;
+    simd::AlignedBuffer scratch_yaw_, scratch_slip_, scratch_lat_;
+};
+
+} // namespace velox::simulation
@@ -0,0 +1,99 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <new>
+
+namespace velox::simulation {
+
+/**
+ * SharedFrame
+ *
+ * Fixed block of the latest simulation state for one or more vehicles, published with a
+ * sequence lock so a reader on another thread (a JS main thread holding typed-array views over
+ * the WASM SharedArrayBuffer) can copy a consistent frame without a call into the engine.
+ *
+ * Layout, all host byte order, 8-byte aligned:
+ *
+ *   u32     sequence   odd while a write is in progress, incremented by 2 per publish
+ *   u32     vehicles
+ *   f64     simulation time [s]
+ *   f64     steps since the last full reset
+ *   f64     columns[kColumns][vehicles], column-major (Column ids below)
+ *
+ * Reader protocol: load the sequence (Atomics.load), retry while it is odd, copy what is
+ * needed, reload the sequence and retry if it changed. One writer only.
+ */
+class SharedFrame {
+public:
+    /// Column ids; 0..6 match velox_st_batch_column_id.
+    enum Column : std::size_t {
+        X, Y, Psi, V, Delta, SteerRate, Accel,
+        Distance, // accumulated |v| dt [m]
+        Energy,   // accumulated accel |v| dt, as in the JS backend [J/kg]
+    };
+    static constexpr std::size_t kColumns = Energy + 1;
+    static constexpr std::size_t kHeaderDoubles = 3;
+
+    explicit SharedFrame(std::size_t vehicles)
+        : vehicles_(vehicles)
+        , storage_(new (std::align_val_t{64}) double[kHeaderDoubles + kColumns * vehicles]())
+    {
+        ::new (static_cast<void*>(storage_.get())) Header{{0}, static_cast<std::uint32_t>(vehicles)};
+    }
+
+    SharedFrame(const SharedFrame&) = delete;
+    SharedFrame& operator=(const SharedFrame&) = delete;
+    SharedFrame(SharedFrame&&) noexcept = default;
+    SharedFrame& operator=(SharedFrame&&) noexcept = default;
+
+    std::size_t vehicles() const noexcept { return vehicles_; }
+    std::size_t bytes() const noexcept { return (kHeaderDoubles + kColumns * vehicles_) * sizeof(double); }
+
+    /// Start of the block; stable for the frame's lifetime.
+    const double* data() const noexcept { return storage_.get(); }
+
+    double time() const noexcept { return storage_[1]; }
+    double steps() const noexcept { return storage_[2]; }
+    const double* column(Column c) const noexcept { return storage_.get() + kHeaderDoubles + c * vehicles_; }
+
+    /**
+     * Runs write(frame) inside the sequence lock. Inside write, set_time/set_steps/column()
+     * update the block; readers observe either the previous frame or the complete new one.
+     */
+    template <typename Fn>
+    void publish(Fn&& write)
+    {
+        std::atomic<std::uint32_t>& sequence = header()->sequence;
+        const std::uint32_t s = sequence.load(std::memory_order_relaxed);
+        sequence.store(s + 1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+        write(*this);
+        sequence.store(s + 2, std::memory_order_release);
+    }
+
+    void set_time(double t) noexcept { storage_[1] = t; }
+    void set_steps(double n) noexcept { storage_[2] = n; }
+    double* column(Column c) noexcept { return storage_.get() + kHeaderDoubles + c * vehicles_; }
+
+private:
+    struct Header {
+        std::atomic<std::uint32_t> sequence;
+        std::uint32_t vehicles;
+    };
+    static_assert(sizeof(Header) == sizeof(double) && std::atomic<std::uint32_t>::is_always_lock_free,
+                  "the sequence word is read in place by Atomics.load");
+
+    struct AlignedDelete {
+        void operator()(double* p) const noexcept { ::operator delete[](p, std::align_val_t{64}); }
+    };
+
+    Header* header() noexcept { return reinterpret_cast<Header*>(storage_.get()); }
+
+    std::size_t vehicles_;
+    std::unique_ptr<double[], AlignedDelete> storage_;
+};
+
+} // namespace velox::simulation
@@ -0,0 +1,328 @@
+#pragma once
+
+#include <cmath>
+#include <cstddef>
+#include <new>
+#include <utility>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#define VELOX_SIMD_AVX2 1
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+#include <arm_neon.h>
+#define VELOX_SIMD_NEON 1
+#elif defined(__wasm_simd128__)
+#include <wasm_simd128.h>
+#define VELOX_SIMD_WASM 1
+#else
+#define VELOX_SIMD_SCALAR 1
+#endif
+
+namespace velox::simd {
+
+/**
+ * Minimal double-precision SIMD layer for the batch kernels.
+ *
+ * Exactly one backend is compiled in, selected by the target flags (-mavx2 -mfma, aarch64
+ * NEON, -msimd128) with a one-lane scalar fallback. Kernels are written once against VecD /
+ * MaskD and the transcendental helpers below, so all backends share the same arithmetic.
+ */
+
+#if VELOX_SIMD_AVX2
+
+struct VecD  { __m256d v; };
+struct MaskD { __m256d m; };
+inline constexpr std::size_t kWidth = 4;
+
+inline VecD load(const double* p)         { return {_mm256_loadu_pd(p)}; }
+inline void store(double* p, VecD a)      { _mm256_storeu_pd(p, a.v); }
+inline VecD broadcast(double x)           { return {_mm256_set1_pd(x)}; }
+inline VecD operator+(VecD a, VecD b)     { return {_mm256_add_pd(a.v, b.v)}; }
+inline VecD operator-(VecD a, VecD b)     { return {_mm256_sub_pd(a.v, b.v)}; }
+inline VecD operator*(VecD a, VecD b)     { return {_mm256_mul_pd(a.v, b.v)}; }
+inline VecD operator/(VecD a, VecD b)     { return {_mm256_div_pd(a.v, b.v)}; }
+inline VecD operator-(VecD a)             { return {_mm256_xor_pd(a.v, _mm256_set1_pd(-0.0))}; }
+inline VecD min(VecD a, VecD b)           { return {_mm256_min_pd(a.v, b.v)}; }
+inline VecD max(VecD a, VecD b)           { return {_mm256_max_pd(a.v, b.v)}; }
+inline VecD abs(VecD a)                   { return {_mm256_andnot_pd(_mm256_set1_pd(-0.0), a.v)}; }
+inline VecD sqrt(VecD a)                  { return {_mm256_sqrt_pd(a.v)}; }
+inline VecD floor(VecD a)                 { return {_mm256_floor_pd(a.v)}; }
+inline VecD round(VecD a)                 { return {_mm256_round_pd(a.v, _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC)}; }
+#if defined(__FMA__)
+inline VecD fma(VecD a, VecD b, VecD c)   { return {_mm256_fmadd_pd(a.v, b.v, c.v)}; }
+#else
+inline VecD fma(VecD a, VecD b, VecD c)   { return a * b + c; }
+#endif
+inline MaskD operator<(VecD a, VecD b)    { return {_mm256_cmp_pd(a.v, b.v, _CMP_LT_OQ)}; }
+inline MaskD operator<=(VecD a, VecD b)   { return {_mm256_cmp_pd(a.v, b.v, _CMP_LE_OQ)}; }
+inline MaskD operator>(VecD a, VecD b)    { return {_mm256_cmp_pd(a.v, b.v, _CMP_GT_OQ)}; }
+inline MaskD operator>=(VecD a, VecD b)   { return {_mm256_cmp_pd(a.v, b.v, _CMP_GE_OQ)}; }
+inline MaskD operator==(VecD a, VecD b)   { return {_mm256_cmp_pd(a.v, b.v, _CMP_EQ_OQ)}; }
+inline MaskD operator&(MaskD a, MaskD b)  { return {_mm256_and_pd(a.m, b.m)}; }
+inline MaskD operator|(MaskD a, MaskD b)  { return {_mm256_or_pd(a.m, b.m)}; }
+inline MaskD operator!(MaskD a)           { return {_mm256_xor_pd(a.m, _mm256_castsi256_pd(_mm256_set1_epi64x(-1)))}; }
+inline MaskD mask_all(bool on)            { return {_mm256_castsi256_pd(_mm256_set1_epi64x(on ? -1 : 0))}; }
+/// Lane-wise m ? a : b
+inline VecD select(MaskD m, VecD a, VecD b) { return {_mm256_blendv_pd(b.v, a.v, m.m)}; }
+inline bool any(MaskD m)                  { return _mm256_movemask_pd(m.m) != 0; }
+
+#elif VELOX_SIMD_NEON
+
+struct VecD  { float64x2_t v; };
+struct MaskD { uint64x2_t m; };
+inline constexpr std::size_t kWidth = 2;
+
+inline VecD load(const double* p)         { return {vld1q_f64(p)}; }
+inline void store(double* p, VecD a)      { vst1q_f64(p, a.v); }
+inline VecD broadcast(double x)           { return {vdupq_n_f64(x)}; }
+inline VecD operator+(VecD a, VecD b)     { return {vaddq_f64(a.v, b.v)}; }
+inline VecD operator-(VecD a, VecD b)     { return {vsubq_f64(a.v, b.v)}; }
+inline VecD operator*(VecD a, VecD b)     { return {vmulq_f64(a.v, b.v)}; }
+inline VecD operator/(VecD a, VecD b)     { return {vdivq_f64(a.v, b.v)}; }
+inline VecD operator-(VecD a)             { return {vnegq_f64(a.v)}; }
+inline VecD min(VecD a, VecD b)           { return {vminnmq_f64(a.v, b.v)}; }
+inline VecD max(VecD a, VecD b)           { return {vmaxnmq_f64(a.v, b.v)}; }
+inline VecD abs(VecD a)                   { return {vabsq_f64(a.v)}; }
+inline VecD sqrt(VecD a)                  { return {vsqrtq_f64(a.v)}; }
+inline VecD floor(VecD a)                 { return {vrndmq_f64(a.v)}; }
+inline VecD round(VecD a)                 { return {vrndnq_f64(a.v)}; }
+inline VecD fma(VecD a, VecD b, VecD c)   { return {vfmaq_f64(c.v, a.v, b.v)}; }
+inline MaskD operator<(VecD a, VecD b)    { return {vcltq_f64(a.v, b.v)}; }
+inline MaskD operator<=(VecD a, VecD b)   { return {vcleq_f64(a.v, b.v)}; }
+inline MaskD operator>(VecD a, VecD b)    { return {vcgtq_f64(a.v, b.v)}; }
+inline MaskD operator>=(VecD a, VecD b)   { return {vcgeq_f64(a.v, b.v)}; }
+inline MaskD operator==(VecD a, VecD b)   { return {vceqq_f64(a.v, b.v)}; }
+inline MaskD operator&(MaskD a, MaskD b)  { return {vandq_u64(a.m, b.m)}; }
+inline MaskD operator|(MaskD a, MaskD b)  { return {vorrq_u64(a.m, b.m)}; }
+inline MaskD operator!(MaskD a)           { return {veorq_u64(a.m, vdupq_n_u64(~0ULL))}; }
+inline MaskD mask_all(bool on)            { return {vdupq_n_u64(on ? ~0ULL : 0ULL)}; }
+inline VecD select(MaskD m, VecD a, VecD b) { return {vbslq_f64(m.m, a.v, b.v)}; }
+inline bool any(MaskD m)                  { return vmaxvq_u32(vreinterpretq_u32_u64(m.m)) != 0; }
+
+#elif VELOX_SIMD_WASM
+
+struct VecD  { v128_t v; };
+struct MaskD { v128_t m; };
+inline constexpr std::size_t kWidth = 2;
+
+inline VecD load(const double* p)         { return {wasm_v128_load(p)}; }
+inline void store(double* p, VecD a)      { wasm_v128_store(p, a.v); }
+inline VecD broadcast(double x)           { return {wasm_f64x2_splat(x)}; }
+inline VecD operator+(VecD a, VecD b)     { return {wasm_f64x2_add(a.v, b.v)}; }
+inline VecD operator-(VecD a, VecD b)     { return {wasm_f64x2_sub(a.v, b.v)}; }
+inline VecD operator*(VecD a, VecD b)     { return {wasm_f64x2_mul(a.v, b.v)}; }
+inline VecD operator/(VecD a, VecD b)     { return {wasm_f64x2_div(a.v, b.v)}; }
+inline VecD operator-(VecD a)             { return {wasm_f64x2_neg(a.v)}; }
+inline VecD min(VecD a, VecD b)           { return {wasm_f64x2_pmin(a.v, b.v)}; }
+inline VecD max(VecD a, VecD b)           { return {wasm_f64x2_pmax(a.v, b.v)}; }
+inline VecD abs(VecD a)                   { return {wasm_f64x2_abs(a.v)}; }
+inline VecD sqrt(VecD a)                  { return {wasm_f64x2_sqrt(a.v)}; }
+inline VecD floor(VecD a)                 { return {wasm_f64x2_floor(a.v)}; }
+inline VecD round(VecD a)                 { return {wasm_f64x2_nearest(a.v)}; }
+inline VecD fma(VecD a, VecD b, VecD c)   { return a * b + c; }
+inline MaskD operator<(VecD a, VecD b)    { return {wasm_f64x2_lt(a.v, b.v)}; }
+inline MaskD operator<=(VecD a, VecD b)   { return {wasm_f64x2_le(a.v, b.v)}; }
+inline MaskD operator>(VecD a, VecD b)    { return {wasm_f64x2_gt(a.v, b.v)}; }
+inline MaskD operator>=(VecD a, VecD b)   { return {wasm_f64x2_ge(a.v, b.v)}; }
+inline MaskD operator==(VecD a, VecD b)   { return {wasm_f64x2_eq(a.v, b.v)}; }
+inline MaskD operator&(MaskD a, MaskD b)  { return {wasm_v128_and(a.m, b.m)}; }
+inline MaskD operator|(MaskD a, MaskD b)  { return {wasm_v128_or(a.m, b.m)}; }
+inline MaskD operator!(MaskD a)           { return {wasm_v128_not(a.m)}; }
+inline MaskD mask_all(bool on)            { return {wasm_i64x2_splat(on ? -1 : 0)}; }
+inline VecD select(MaskD m, VecD a, VecD b) { return {wasm_v128_bitselect(a.v, b.v, m.m)}; }
+inline bool any(MaskD m)                  { return wasm_v128_any_true(m.m); }
+
+#else
+
+struct VecD  { double v; };
+struct MaskD { bool m; };
+inline constexpr std::size_t kWidth = 1;
+
+inline VecD load(const double* p)         { return {*p}; }
+inline void store(double* p, VecD a)      { *p = a.v; }
+inline VecD broadcast(double x)           { return {x}; }
+inline VecD operator+(VecD a, VecD b)     { return {a.v + b.v}; }
+inline VecD operator-(VecD a, VecD b)     { return {a.v - b.v}; }
+inline VecD operator*(VecD a, VecD b)     { return {a.v * b.v}; }
+inline VecD operator/(VecD a, VecD b)     { return {a.v / b.v}; }
+inline VecD operator-(VecD a)             { return {-a.v}; }
+inline VecD min(VecD a, VecD b)           { return {a.v < b.v ? a.v : b.v}; }
+inline VecD max(VecD a, VecD b)           { return {a.v > b.v ? a.v : b.v}; }
+inline VecD abs(VecD a)                   { return {std::fabs(a.v)}; }
+inline VecD sqrt(VecD a)                  { return {std::sqrt(a.v)}; }
+inline VecD floor(VecD a)                 { return {std::floor(a.v)}; }
+inline VecD round(VecD a)                 { return {std::nearbyint(a.v)}; }
+inline VecD fma(VecD a, VecD b, VecD c)   { return a * b + c; }
+inline MaskD operator<(VecD a, VecD b)    { return {a.v < b.v}; }
+inline MaskD operator<=(VecD a, VecD b)   { return {a.v <= b.v}; }
+inline MaskD operator>(VecD a, VecD b)    { return {a.v > b.v}; }
+inline MaskD operator>=(VecD a, VecD b)   { return {a.v >= b.v}; }
+inline MaskD operator==(VecD a, VecD b)   { return {a.v == b.v}; }
+inline MaskD operator&(MaskD a, MaskD b)  { return {a.m && b.m}; }
+inline MaskD operator|(MaskD a, MaskD b)  { return {a.m || b.m}; }
+inline MaskD operator!(MaskD a)           { return {!a.m}; }
+inline MaskD mask_all(bool on)            { return {on}; }
+inline VecD select(MaskD m, VecD a, VecD b) { return m.m ? a : b; }
+inline bool any(MaskD m)                  { return m.m; }
+
+#endif
+
+// ---------------------------------------------------------------------------------------------
+// Shared helpers (backend independent)
+
+/// Finite lanes: x - x is 0 for finite x and NaN otherwise.
+inline MaskD is_finite(VecD x)
+{
+    return (x - x) == broadcast(0.0);
+}
+
+/// clamp() from the JS models: non-finite lanes collapse to 0, the rest clamp to [lo, hi].
+inline VecD clamp_finite(VecD x, VecD lo, VecD hi)
+{
+    return select(is_finite(x), min(max(x, lo), hi), broadcast(0.0));
+}
+
+inline VecD copysign(VecD magnitude, VecD sign)
+{
+    return select(sign < broadcast(0.0), -abs(magnitude), abs(magnitude));
+}
+
+/**
+ * sin and cos with Cody-Waite reduction by pi/2 and the Cephes minimax polynomials on
+ * [-pi/4, pi/4]. Accurate to a few ulp for |x| up to ~1e6 rad.
+ */
+inline void sincos(VecD x, VecD& s, VecD& c)
+{
+    const VecD q = round(x * broadcast(0.63661977236758134308)); // 2/pi
+    VecD r = fma(q, broadcast(-1.5707962512969970703125), x);
+    r = fma(q, broadcast(-7.549789415861596e-08), r);
+    r = fma(q, broadcast(-5.390302858158119e-15), r);
+    const VecD z = r * r;
+
+    VecD ps = broadcast(1.58962301576546568060e-10);
+    ps = fma(ps, z, broadcast(-2.50507477628578072866e-8));
+    ps = fma(ps, z, broadcast(2.75573136213857245213e-6));
+    ps = fma(ps, z, broadcast(-1.98412698295895385996e-4));
+    ps = fma(ps, z, broadcast(8.33333333332211858878e-3));
+    ps = fma(ps, z, broadcast(-1.66666666666666307295e-1));
+    const VecD sr = fma(r * z, ps, r);
+
+    VecD pc = broadcast(-1.13585365213876817300e-11);
+    pc = fma(pc, z, broadcast(2.08757008419747316778e-9));
+    pc = fma(pc, z, broadcast(-2.75573141792967388112e-7));
+    pc = fma(pc, z, broadcast(2.48015872888517045348e-5));
+    pc = fma(pc, z, broadcast(-1.38888888888730564116e-3));
+    pc = fma(pc, z, broadcast(4.16666666666665929218e-2));
+    const VecD cr = fma(z * z, pc, broadcast(1.0) - broadcast(0.5) * z);
+
+    // quadrant = q mod 4, computed in floating point to stay in the double lanes
+    const VecD quadrant = q - broadcast(4.0) * floor(q * broadcast(0.25));
+    const MaskD q1 = quadrant == broadcast(1.0);
+    const MaskD q2 = quadrant == broadcast(2.0);
+    const MaskD q3 = quadrant == broadcast(3.0);
+    const MaskD swap = q1 | q3;
+    const VecD s_base = select(swap, cr, sr);
+    const VecD c_base = select(swap, sr, cr);
+    s = select(q2 | q3, -s_base, s_base);
+    c = select(q1 | q2, -c_base, c_base);
+}
+
+/// Cephes atan: three-way range reduction and a rational approximation.
+inline VecD atan(VecD x)
+{
+    const VecD ax = abs(x);
+    const MaskD big = ax > broadcast(2.41421356237309504880);   // tan(3pi/8)
+    const MaskD mid = (ax > broadcast(0.66)) & !big;
+
+    const VecD one = broadcast(1.0);
+    VecD t = select(big, -(one / ax), select(mid, (ax - one) / (ax + one), ax));
+    const VecD y0 = select(big, broadcast(1.57079632679489661923),
+                           select(mid, broadcast(0.78539816339744830962), broadcast(0.0)));
+    const VecD more = select(big, broadcast(6.123233995736765886130e-17),
+                             select(mid, broadcast(3.061616997868382943065e-17), broadcast(0.0)));
+
+    const VecD z = t * t;
+    VecD p = broadcast(-8.750608600031904122785e-1);
+    p = fma(p, z, broadcast(-1.615753718733365076637e1));
+    p = fma(p, z, broadcast(-7.500855792314704667340e1));
+    p = fma(p, z, broadcast(-1.228866684490136173410e2));
+    p = fma(p, z, broadcast(-6.485021904942025371773e1));
+    VecD q = z + broadcast(2.485846490142306297962e1);
+    q = fma(q, z, broadcast(1.650270098316988542046e2));
+    q = fma(q, z, broadcast(4.328810604912902668951e2));
+    q = fma(q, z, broadcast(4.853903996359136964868e2));
+    q = fma(q, z, broadcast(1.945506571482613964425e2));
+
+    const VecD r = fma(t, z * (p / q), t) + more + y0;
+    return copysign(r, x);
+}
+
+/// atan2 on top of atan(); (+-0, +-0) maps to 0.
+inline VecD atan2(VecD y, VecD x)
+{
+    const VecD zero = broadcast(0.0);
+    const MaskD x_zero = x == zero;
+    const VecD base = atan(y / select(x_zero, broadcast(1.0), x));
+    const VecD r = select(x < zero, base + copysign(broadcast(3.14159265358979323846), y), base);
+    const VecD axis = select(y == zero, zero, copysign(broadcast(1.57079632679489661923), y));
+    return select(x_zero, axis, r);
+}
+
+inline VecD tan(VecD x)
+{
+    VecD s, c;
+    sincos(x, s, c);
+    return s / c;
+}
+
+/**
+ * Cache-line aligned, zero-initialised array sized to a multiple of kWidth so kernels can run
+ * whole vectors over the tail without a scalar epilogue.
+ */
+class AlignedBuffer {
+public:
+    static constexpr std::size_t kAlignment = 64;
+
+    AlignedBuffer() = default;
+    explicit AlignedBuffer(std::size_t count) { resize(count); }
+    AlignedBuffer(const AlignedBuffer&) = delete;
+    AlignedBuffer& operator=(const AlignedBuffer&) = delete;
+    AlignedBuffer(AlignedBuffer&& other) noexcept { swap(other); }
+    AlignedBuffer& operator=(AlignedBuffer&& other) noexcept { swap(other); return *this; }
+    ~AlignedBuffer() { release(); }
+
+    static std::size_t padded(std::size_t count) { return (count + kWidth - 1) / kWidth * kWidth; }
+
+    void resize(std::size_t count)
+    {
+        release();
+        size_ = padded(count);
+        if (size_ == 0) return;
+        data_ = static_cast<double*>(::operator new[](size_ * sizeof(double), std::align_val_t{kAlignment}));
+        for (std::size_t i = 0; i < size_; ++i) data_[i] = 0.0;
+    }
+
+    double* data() { return data_; }
+    const double* data() const { return data_; }
+    std::size_t size() const { return size_; }
+    double& operator[](std::size_t i) { return data_[i]; }
+    double operator[](std::size_t i) const { return data_[i]; }
+
+private:
+    void release()
+    {
+        if (data_) ::operator delete[](data_, std::align_val_t{kAlignment});
+        data_ = nullptr;
+        size_ = 0;
+    }
+    void swap(AlignedBuffer& other) noexcept
+    {
+        std::swap(data_, other.data_);
+        std::swap(size_, other.size_);
+    }
+
+    double* data_{nullptr};
+    std::size_t size_{0};
+};
+
+} // namespace velox::simd
@@ -0,0 +1,184 @@
+#include "st_batch.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+#include "telemetry/instrumentation.hpp"
+
+namespace velox::simulation {
+
+using namespace velox::simd;
+
+StBatch::StBatch(const models::VehicleParameters& params, std::size_t count)
+    : params_(&params)
+    , params_stride_(0)
+    , count_(count)
+    , x_(count), y_(count), psi_(count), v_(count), delta_(count)
+    , steer_rate_(count), accel_(count), last_accel_(count)
+    , wheelbase_(count), rear_ratio_(count), budget_(count)
+    , steer_min_(count), steer_max_(count), rate_min_(count), rate_max_(count), a_max_(count), j_max_(count)
+{
+    gather_parameters();
+}
+
+StBatch::StBatch(const models::VehicleParameters* params, std::size_t count)
+    : params_(params)
+    , params_stride_(1)
+    , count_(count)
+    , x_(count), y_(count), psi_(count), v_(count), delta_(count)
+    , steer_rate_(count), accel_(count), last_accel_(count)
+    , wheelbase_(count), rear_ratio_(count), budget_(count)
+    , steer_min_(count), steer_max_(count), rate_min_(count), rate_max_(count), a_max_(count), j_max_(count)
+{
+    if (!params && count > 0) {
+        throw std::invalid_argument("StBatch requires a parameter array");
+    }
+    gather_parameters();
+}
+
+void StBatch::gather_parameters()
+{
+    const std::size_t padded = x_.size();
+    // a shared set is derived once and broadcast; an array derives each variant once, here
+    models::DerivedVehicleConstants c;
+    for (std::size_t i = 0; i < padded; ++i) {
+        if (i == 0 || (params_stride_ != 0 && i < count_)) {
+            c = models::derive_vehicle_constants(params(std::min(i, count_ - 1)));
+        }
+        wheelbase_[i] = c.wheelbase;
+        rear_ratio_[i] = c.rear_ratio;
+        budget_[i] = c.accel_budget;
+        steer_min_[i] = c.steer_min;
+        steer_max_[i] = c.steer_max;
+        rate_min_[i] = c.steer_rate_min;
+        rate_max_[i] = c.steer_rate_max;
+        a_max_[i] = c.a_max;
+        j_max_[i] = c.j_max;
+    }
+}
+
+void StBatch::reset(std::size_t i, const double* state, std::size_t n)
+{
+    if (i >= count_) {
+        throw std::out_of_range("StBatch::reset index out of range");
+    }
+    double s[models::kStStateSize] = {};
+    std::copy_n(state, std::min(n, models::kStStateSize), s);
+
+    // Same initial clamps as StSimulator::reset (steering bounds, then friction envelope), on the
+    // constants gathered at construction.
+    s[4] = std::isfinite(s[4]) ? std::min(std::max(s[4], steer_min_[i]), steer_max_[i]) : 0.0;
+    const double speed = std::abs(s[3]);
+    if (budget_[i] > 0.0 && speed > 1e-6) {
+        const double lim = std::atan((budget_[i] * wheelbase_[i]) / (speed * speed));
+        s[4] = std::min(std::max(s[4], -lim), lim);
+    }
+
+    x_[i] = s[0]; y_[i] = s[1]; psi_[i] = s[2]; v_[i] = s[3]; delta_[i] = s[4];
+    steer_rate_[i] = 0.0;
+    accel_[i] = 0.0;
+    last_accel_[i] = 0.0;
+}
+
+void StBatch::reset_all(const double* state, std::size_t n)
+{
+    for (std::size_t i = 0; i < count_; ++i) {
+        reset(i, state, n);
+    }
+}
+
+models::StState StBatch::state(std::size_t i) const
+{
+    return {x_[i], y_[i], psi_[i], v_[i], delta_[i]};
+}
+
+void StBatch::step(double dt)
+{
+    if (!(dt > 0.0)) {
+        throw std::invalid_argument("StBatch timestep must be positive");
+    }
+    VELOX_TIME_SCOPE(telemetry::Stage::Dynamics);
+    VELOX_COUNT(telemetry::Counter::Steps, count_);
+    const VecD zero = broadcast(0.0);
+    const VecD one = broadcast(1.0);
+    const VecD eps_speed = broadcast(1e-6);
+    const VecD h = broadcast(dt);
+
+    // Friction-limited steering envelope: |delta| <= atan(mu g L / v^2) while moving.
+    auto limit_delta = [&](VecD delta, VecD speed, MaskD has_budget, VecD budget_L) {
+        const MaskD active = has_budget & (speed > eps_speed);
+        const VecD lim = atan(budget_L / select(active, speed * speed, one));
+        return select(active, min(max(delta, -lim), lim), delta);
+    };
+
+    const std::size_t padded = x_.size();
+    for (std::size_t i = 0; i < padded; i += kWidth) {
+        const VecD L = load(wheelbase_.data() + i);
+        const VecD inv_L = one / L;
+        const VecD rear_ratio = load(rear_ratio_.data() + i);
+        const VecD budget = load(budget_.data() + i);
+        const VecD budget_sq = budget * budget;
+        const VecD budget_L = budget * L;
+        const MaskD has_budget = budget > zero;
+        const VecD steer_min = load(steer_min_.data() + i);
+        const VecD steer_max = load(steer_max_.data() + i);
+        const VecD a_max = load(a_max_.data() + i);
+        const VecD j_max = load(j_max_.data() + i);
+
+        VecD x = load(x_.data() + i);
+        VecD y = load(y_.data() + i);
+        VecD psi = load(psi_.data() + i);
+        VecD v = load(v_.data() + i);
+        VecD delta = load(delta_.data() + i);
+        const VecD prev_v = v;
+
+        // StSimulator::apply_limits
+        delta = clamp_finite(delta, steer_min, steer_max);
+        delta = limit_delta(delta, abs(v), has_budget, budget_L);
+
+        // StSimulator::clamp_control
+        const VecD rate = clamp_finite(load(steer_rate_.data() + i), load(rate_min_.data() + i),
+                                       load(rate_max_.data() + i));
+        VecD accel = clamp_finite(load(accel_.data() + i), -a_max, a_max);
+        const MaskD jerk_limited = j_max > zero;
+        if (any(jerk_limited)) {
+            const VecD prev_accel = load(last_accel_.data() + i);
+            const VecD jerk_step = j_max * h;
+            accel = select(jerk_limited, clamp_finite(accel, prev_accel - jerk_step, prev_accel + jerk_step), accel);
+        }
+
+        // beta = atan(l_r / L * tan(delta)); sin/cos(beta) follow from tan(beta) directly.
+        const VecD tan_beta = rear_ratio * tan(delta);
+        const VecD cos_beta = one / sqrt(one + tan_beta * tan_beta);
+        const VecD sin_beta = tan_beta * cos_beta;
+        const VecD curvature = sin_beta * inv_L;
+        const VecD lateral = v * v * curvature;
+        const VecD accel_limit = sqrt(max(zero, budget_sq - lateral * lateral));
+        accel = clamp_finite(accel, -accel_limit, accel_limit);
+
+        // vehicle_dynamics_st with the already-limited control, then explicit Euler
+        VecD sin_psi, cos_psi;
+        sincos(psi, sin_psi, cos_psi);
+        const VecD heading_x = cos_psi * cos_beta - sin_psi * sin_beta;
+        const VecD heading_y = sin_psi * cos_beta + cos_psi * sin_beta;
+        x = fma(h, v * heading_x, x);
+        y = fma(h, v * heading_y, y);
+        psi = fma(h, v * curvature, psi);
+        v = fma(h, accel, v);
+        delta = fma(h, rate, delta);
+
+        delta = clamp_finite(delta, steer_min, steer_max);
+        delta = limit_delta(delta, abs(v), has_budget, budget_L);
+        v = select((prev_v >= zero) & (v < zero), zero, v);
+
+        store(x_.data() + i, x);
+        store(y_.data() + i, y);
+        store(psi_.data() + i, psi);
+        store(v_.data() + i, v);
+        store(delta_.data() + i, delta);
+        store(last_accel_.data() + i, accel);
+    }
+}
+
+} // namespace velox::simulation
@@ -0,0 +1,79 @@
+#pragma once
+
+#include <cstddef>
+
+#include "models/vehicle_dynamics_st.hpp"
+#include "simd.hpp"
+
+namespace velox::simulation {
+
+/**
+ * Structure-of-arrays batch of independent single-track vehicles, sharing one
+ * VehicleParameters or each with its own (a ParameterArena from parameter_sampler.hpp).
+ *
+ * step() advances every vehicle with the same constraint sequence as StSimulator::step, written
+ * once against velox::simd so it runs kWidth lanes at a time on AVX2, NEON or WASM SIMD128. The
+ * transcendental calls are the Cephes kernels in simd.hpp, so lanes agree with StSimulator to
+ * within a few ulp per step rather than bit-for-bit.
+ *
+ * Controls are written into control_steer_rate()/control_accel() before each step; all arrays
+ * are padded to a multiple of the vector width and padding lanes are ignored.
+ */
+class StBatch {
+public:
+    /// Parameters are borrowed; they must outlive the batch.
+    StBatch(const models::VehicleParameters& params, std::size_t count);
+
+    /**
+     * Vehicle i uses params[i] (e.g. ParameterArena::data()). The fields step() and reset()
+     * read are gathered into lane columns here, so later changes to the array are not seen.
+     */
+    StBatch(const models::VehicleParameters* params, std::size_t count);
+
+    std::size_t size() const { return count_; }
+
+    /// Resets vehicle i to state[0..n) (missing entries are zero).
+    void reset(std::size_t i, const double* state, std::size_t n);
+    /// Resets every vehicle to the same initial state.
+    void reset_all(const double* state, std::size_t n);
+
+    /// Advances all vehicles by dt using the current control arrays.
+    void step(double dt);
+
+    // State columns, index = vehicle.
+    double* x()     { return x_.data(); }
+    double* y()     { return y_.data(); }
+    double* psi()   { return psi_.data(); }
+    double* v()     { return v_.data(); }
+    double* delta() { return delta_.data(); }
+    const double* x() const     { return x_.data(); }
+    const double* y() const     { return y_.data(); }
+    const double* psi() const   { return psi_.data(); }
+    const double* v() const     { return v_.data(); }
+    const double* delta() const { return delta_.data(); }
+
+    // Control columns consumed by step(); last_accel() holds the applied (limited) acceleration.
+    double* control_steer_rate() { return steer_rate_.data(); }
+    double* control_accel()      { return accel_.data(); }
+    const double* last_accel() const { return last_accel_.data(); }
+
+    /// Copies vehicle i into AoS form.
+    models::StState state(std::size_t i) const;
+
+    /// Parameters of vehicle i.
+    const models::VehicleParameters& params(std::size_t i) const { return params_[i * params_stride_]; }
+
+private:
+    void gather_parameters();
+
+    const models::VehicleParameters* params_;
+    std::size_t params_stride_; // 0 when all vehicles share params_[0]
+    std::size_t count_;
+    simd::AlignedBuffer x_, y_, psi_, v_, delta_;
+    simd::AlignedBuffer steer_rate_, accel_, last_accel_;
+    // Per-lane copies of the parameters step() uses; padding lanes repeat the last vehicle.
+    simd::AlignedBuffer wheelbase_, rear_ratio_, budget_;
+    simd::AlignedBuffer steer_min_, steer_max_, rate_min_, rate_max_, a_max_, j_max_;
+};
+
+} // namespace velox::simulation
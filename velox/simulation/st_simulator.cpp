@@ -0,0 +1,133 @@
+#include "st_simulator.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+#include "telemetry/instrumentation.hpp"
+
+namespace velox::simulation {
+
+using models::StControl;
+using models::StState;
+using models::kStStateSize;
+
+namespace {
+
+double clamp_finite(double value, double lo, double hi)
+{
+    if (!std::isfinite(value)) return 0.0;
+    return std::min(std::max(value, lo), hi);
+}
+
+} // anonymous namespace
+
+StSimulator::StSimulator(const models::VehicleParameters& params, double dt)
+    : constants_(models::derive_vehicle_constants(params))
+    , params_(&params)
+{
+    set_dt(dt);
+}
+
+StSimulator::StSimulator(const models::VehicleParameters& params, const models::DerivedVehicleConstants& constants,
+                         double dt)
+    : constants_(constants)
+    , params_(&params)
+{
+    set_dt(dt);
+}
+
+void StSimulator::reset(const double* initial, std::size_t count)
+{
+    state_.fill(0.0);
+    const std::size_t n = std::min(count, kStStateSize);
+    for (std::size_t i = 0; i < n; ++i) {
+        state_[i] = initial[i];
+    }
+    state_[4] = std::min(std::max(state_[4], constants_.steer_min), constants_.steer_max);
+    apply_limits(state_);
+    last_control_ = {0.0, 0.0};
+}
+
+void StSimulator::set_dt(double dt)
+{
+    if (!(dt > 0.0)) {
+        throw std::invalid_argument("StSimulator timestep must be positive");
+    }
+    dt_ = dt;
+}
+
+double StSimulator::speed() const
+{
+    return std::abs(state_[3]);
+}
+
+const StState& StSimulator::step(double steer_rate, double accel)
+{
+    VELOX_TIME_SCOPE(telemetry::Stage::Dynamics);
+    VELOX_COUNT(telemetry::Counter::Steps, 1);
+    const double prev_long = state_[3];
+
+    apply_limits(state_);
+    const StControl control = clamp_control(state_, steer_rate, accel);
+    models::vehicle_dynamics_st(state_, control, constants_, rhs_);
+    for (std::size_t i = 0; i < kStStateSize; ++i) {
+        state_[i] += dt_ * rhs_[i];
+    }
+    apply_limits(state_);
+    last_control_ = control;
+
+    // Longitudinal speed may not cross zero from forward motion within a step.
+    if (prev_long >= 0.0 && state_[3] < 0.0) {
+        state_[3] = 0.0;
+    }
+    apply_limits(state_);
+    return state_;
+}
+
+// Steering-angle bounds plus the friction-limited steering envelope (VehicleSimulator.applySafety).
+void StSimulator::apply_limits(StState& state) const
+{
+    const models::DerivedVehicleConstants& c = constants_;
+    const double speed = std::abs(state[3]);
+    state[4] = clamp_finite(state[4], c.steer_min, c.steer_max);
+
+    if (c.accel_budget > 0.0 && speed > 1e-6) {
+        const double max_delta_for_lat = std::atan(c.budget_wheelbase / (speed * speed));
+        state[4] = std::min(std::max(state[4], -max_delta_for_lat), max_delta_for_lat);
+    }
+}
+
+// Mirrors VehicleSimulator.clampKinematicControl; may tighten state[4] in place.
+StControl StSimulator::clamp_control(StState& state, double steer_rate, double accel) const
+{
+    const models::DerivedVehicleConstants& c = constants_;
+    const double rate  = clamp_finite(steer_rate, c.steer_rate_min, c.steer_rate_max);
+    double limited     = clamp_finite(accel, c.a_min, c.a_max);
+    const double delta = clamp_finite(state[4], c.steer_min, c.steer_max);
+    state[4] = delta;
+
+    if (c.j_max > 0.0) {
+        const double max_delta = c.j_max * dt_;
+        const double prev_accel = last_control_[1];
+        limited = clamp_finite(limited, prev_accel - max_delta, prev_accel + max_delta);
+    }
+
+    const double L = c.wheelbase;
+    const double beta = std::atan(c.rear_ratio * std::tan(delta));
+    const double curvature = std::sin(beta) / L;
+    const double v = state[3];
+    const double lateral_accel = v * v * curvature;
+    const double accel_limit = std::sqrt(std::max(0.0, c.accel_budget_sq -
+                                                       lateral_accel * lateral_accel));
+    limited = clamp_finite(limited, -accel_limit, accel_limit);
+
+    if (c.accel_budget > 0.0 && std::abs(v) > 1e-6) {
+        const double max_delta_for_lat = std::atan(c.budget_wheelbase / (v * v));
+        state[4] = clamp_finite(delta, -max_delta_for_lat, max_delta_for_lat);
+    }
+
+    return {rate, limited};
+}
+
+} // namespace velox::simulation
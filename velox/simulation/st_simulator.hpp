@@ -0,0 +1,64 @@
+#pragma once
+
+#include <cstddef>
+
+#include "models/vehicle_dynamics_st.hpp"
+
+namespace velox::simulation {
+
+/**
+ * Native counterpart of VehicleSimulator (velox/simulation/VehicleSimulator.ts) for the
+ * single-track model.
+ *
+ * Applies the same steering-angle, jerk and friction-circle constraints as the JS
+ * stepKinematic path and advances the state with explicit Euler. State, derivative and
+ * control scratch live inside the object, so step() performs no heap allocation.
+ */
+class StSimulator {
+public:
+    /**
+     * Parameters are borrowed; they must outlive the simulator. Throws std::invalid_argument
+     * for a non-positive dt or parameters derive_vehicle_constants rejects.
+     */
+    StSimulator(const models::VehicleParameters& params, double dt);
+
+    /**
+     * Steps on constants instead of deriving them from params (which stays what params()
+     * returns): derive_vehicle_constants(const SingleTrackParameters&) with
+     * vehicle_parameters_from_single_track reproduces the JS VehicleSimulator on that set, and
+     * cached_vehicle_constants reuses the block of a shared set across simulators.
+     * Throws std::invalid_argument for a non-positive dt.
+     */
+    StSimulator(const models::VehicleParameters& params, const models::DerivedVehicleConstants& constants, double dt);
+
+    /// Copies up to kStStateSize values from initial (missing entries are zero).
+    void reset(const double* initial, std::size_t count);
+
+    /// Throws std::invalid_argument for a non-positive dt.
+    void set_dt(double dt);
+    double dt() const { return dt_; }
+
+    /// Advances one step and returns the updated state.
+    const models::StState& step(double steer_rate, double accel);
+
+    const models::StState& state() const { return state_; }
+    const models::StControl& last_control() const { return last_control_; }
+    double speed() const;
+
+    const models::VehicleParameters& params() const { return *params_; }
+    /// Derived once in the constructor; the per-substep code reads these instead of params().
+    const models::DerivedVehicleConstants& constants() const { return constants_; }
+
+private:
+    void apply_limits(models::StState& state) const;
+    models::StControl clamp_control(models::StState& state, double steer_rate, double accel) const;
+
+    models::DerivedVehicleConstants constants_;
+    const models::VehicleParameters* params_;
+    double dt_{0.01};
+    models::StState state_{};
+    models::StState rhs_{};
+    models::StControl last_control_{};
+};
+
+} // namespace velox::simulation
@@ -0,0 +1,85 @@
+#include "step_scheduler.hpp"
+
+#include <stdexcept>
+#include <string>
+
+namespace velox::simulation {
+
+using models::StState;
+using models::kStStateSize;
+
+AdaptiveStepScheduler::AdaptiveStepScheduler(const models::ModelTiming& timing,
+                                             const AdaptiveScheduleOptions& options)
+    : options_(options)
+    , nominal_dt_(timing.nominal_dt)
+    , max_dt_(options.max_dt > 0.0 ? options.max_dt : timing.max_dt)
+    , dt_hint_(timing.nominal_dt)
+{
+    if (!(nominal_dt_ > 0.0) || !(max_dt_ > 0.0)) {
+        throw std::invalid_argument("AdaptiveStepScheduler requires positive nominal_dt and max_dt");
+    }
+    if (!(options_.min_dt > 0.0) || options_.min_dt > max_dt_) {
+        throw std::invalid_argument("AdaptiveStepScheduler min_dt must be in (0, max_dt]");
+    }
+    if (!(options_.position_tol > 0.0) || !(options_.heading_tol > 0.0) || !(options_.speed_tol > 0.0) ||
+        !(options_.steering_tol > 0.0)) {
+        throw std::invalid_argument("AdaptiveStepScheduler tolerances must be positive");
+    }
+    nominal_dt_ = std::clamp(nominal_dt_, options_.min_dt, max_dt_);
+    dt_hint_ = nominal_dt_;
+}
+
+AdaptiveSchedule AdaptiveStepScheduler::begin(double frame_dt) const
+{
+    if (!std::isfinite(frame_dt)) {
+        throw std::invalid_argument("Requested dt must be finite");
+    }
+    if (frame_dt <= 0.0) {
+        throw std::invalid_argument("Requested dt must be positive; got " + std::to_string(frame_dt));
+    }
+    AdaptiveSchedule schedule;
+    schedule.requested_dt = frame_dt;
+    schedule.clamped_dt = std::max(frame_dt, options_.min_dt);
+    schedule.clamped_to_min = schedule.clamped_dt > frame_dt;
+    return schedule;
+}
+
+// Euler took x1 = x0 + dt f0; Heun would take x0 + dt/2 (f0 + f1), so the local error estimate
+// is dt/2 |f1 - f0|. Both slopes are measured through StSimulator::step, so the steering,
+// jerk and friction limits it applies enter f1 exactly as they entered f0 and a state resting
+// on a limit does not read as error.
+double AdaptiveStepScheduler::step_error(const StState& before, const StSimulator& after, double steer_rate,
+                                         double accel, double dt) const
+{
+    const StState& x1 = after.state();
+    StSimulator probe = after;
+    const StState& x2 = probe.step(steer_rate, accel);
+
+    const double tolerance[kStStateSize] = {options_.position_tol, options_.position_tol, options_.heading_tol,
+                                            options_.speed_tol, options_.steering_tol};
+    double error = 0.0;
+    for (std::size_t i = 0; i < kStStateSize; ++i) {
+        const double f0 = (x1[i] - before[i]) / dt;
+        const double f1 = (x2[i] - x1[i]) / dt;
+        error = std::max(error, 0.5 * dt * std::abs(f1 - f0) / tolerance[i]);
+    }
+    return std::isfinite(error) ? error : 1e6;
+}
+
+double AdaptiveStepScheduler::step_cap(const StSimulator& simulator, double accel) const
+{
+    const StState& x = simulator.state();
+    const double v = x[3];
+    if (std::abs(v) < options_.low_speed_threshold) return nominal_dt_;
+
+    const models::DerivedVehicleConstants& c = simulator.constants();
+    if (c.accel_budget > 0.0) {
+        const double beta = std::atan(c.rear_ratio * std::tan(x[4]));
+        const double lateral = v * v * std::sin(beta) / c.wheelbase;
+        const double longitudinal = std::isfinite(accel) ? std::min(std::max(accel, c.a_min), c.a_max) : 0.0;
+        if (std::hypot(lateral, longitudinal) > options_.friction_utilization * c.accel_budget) return nominal_dt_;
+    }
+    return max_dt_;
+}
+
+} // namespace velox::simulation
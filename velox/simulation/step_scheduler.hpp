@@ -0,0 +1,156 @@
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+
+#include "config_bundle.hpp"
+#include "integrators.hpp"
+#include "st_simulator.hpp"
+#include "telemetry/instrumentation.hpp"
+
+namespace velox::simulation {
+
+/**
+ * Error tolerances and regime guards of the adaptive scheduler. The error of a step is the
+ * largest component of |Heun - Euler| divided by its tolerance, so each tolerance is the local
+ * error accepted per substep in that state's units.
+ */
+struct AdaptiveScheduleOptions {
+    double position_tol = 1e-3;  // [m] x, y
+    double heading_tol  = 1e-3;  // [rad] psi
+    double speed_tol    = 1e-2;  // [m/s] v
+    double steering_tol = 1e-3;  // [rad] delta
+    double min_dt = 0.001;       // kMinStableDt of SimulationDaemon.ts
+    double max_dt = 0.0;         // 0 takes ModelTiming::max_dt
+    double safety = 0.9;
+    /// Below this speed the steps are capped at nominal_dt (low-speed safety regime) [m/s].
+    double low_speed_threshold = 1.0;
+    /// Above this share of the friction budget the steps are capped at nominal_dt.
+    double friction_utilization = 0.9;
+    std::size_t max_steps = 10000;
+};
+
+/** What one advance() did; steps holds the accept/reject counts of the error controller. */
+struct AdaptiveSchedule {
+    double requested_dt = 0.0;
+    double clamped_dt = 0.0;
+    bool clamped_to_min = false;
+    double min_step = 0.0;
+    double max_step = 0.0;
+    AdaptiveReport steps{};
+};
+
+/**
+ * AdaptiveStepScheduler
+ *
+ * Error-controlled alternative to the fixed split of ModelTiming.planSteps (SimulationDaemon.ts)
+ * for the native single-track engine, used when InitParams.adaptive_substeps asks for it. It is
+ * an accuracy mode, not a fast path: steps are capped at the max_dt planSteps splits at, so it
+ * never takes fewer substeps than the plan, and every attempt costs two StSimulator steps (the
+ * trial and the probe). Each substep is taken by StSimulator itself, so the state is bit-for-bit
+ * the one a fixed schedule with the same step sizes produces; the Heun corrector of the
+ * embedded Euler/Heun pair only measures the local error and picks the next step size. The
+ * probe step it takes from the trial state is counted under Counter::Steps like any other.
+ *
+ * Steps grow up to max_dt on straights and shrink where the error does. Near the friction limit
+ * and in the low-speed regime, where apply_limits and the safety latch act non-smoothly, steps
+ * never exceed nominal_dt. The step size is carried between frames.
+ */
+class AdaptiveStepScheduler {
+public:
+    /// Throws std::invalid_argument for a non-positive nominal_dt or max_dt.
+    explicit AdaptiveStepScheduler(const models::ModelTiming& timing, const AdaptiveScheduleOptions& options = {});
+
+    const AdaptiveScheduleOptions& options() const { return options_; }
+    double max_dt() const { return max_dt_; }
+    double nominal_dt() const { return nominal_dt_; }
+
+    /// Step size the next advance() starts with.
+    double dt_hint() const { return dt_hint_; }
+    void reset() { dt_hint_ = nominal_dt_; }
+
+    /**
+     * Advances simulator over frame_dt (clamped to min_dt like planSteps) with the control held.
+     * on_step(simulator, dt) runs after every accepted substep. Throws std::invalid_argument
+     * for a non-finite or non-positive frame_dt.
+     */
+    template <typename OnStep>
+    AdaptiveSchedule advance(StSimulator& simulator, double steer_rate, double accel, double frame_dt,
+                             OnStep&& on_step);
+
+    AdaptiveSchedule advance(StSimulator& simulator, double steer_rate, double accel, double frame_dt)
+    {
+        return advance(simulator, steer_rate, accel, frame_dt, [](const StSimulator&, double) {});
+    }
+
+private:
+    AdaptiveSchedule begin(double frame_dt) const;
+    /// Normalised local error of the step from before to after (costs one probe step).
+    double step_error(const models::StState& before, const StSimulator& after, double steer_rate, double accel,
+                      double dt) const;
+    /// max_dt, or nominal_dt while the vehicle is slow or near the friction limit.
+    double step_cap(const StSimulator& simulator, double accel) const;
+
+    AdaptiveScheduleOptions options_;
+    double nominal_dt_;
+    double max_dt_;
+    double dt_hint_;
+};
+
+template <typename OnStep>
+AdaptiveSchedule AdaptiveStepScheduler::advance(StSimulator& simulator, double steer_rate, double accel,
+                                                double frame_dt, OnStep&& on_step)
+{
+    AdaptiveSchedule schedule = begin(frame_dt);
+    AdaptiveReport& report = schedule.steps;
+    const double min_dt = options_.min_dt;
+
+    double remaining = schedule.clamped_dt;
+    while (remaining > 0.0) {
+        const bool forced = report.accepted + report.rejected >= options_.max_steps;
+        double proposal = std::min(dt_hint_, step_cap(simulator, accel));
+        double dt = proposal;
+        if (forced) {
+            report.hit_max_steps = true;
+            dt = remaining;
+        } else if (remaining <= dt * (1.0 + 1e-9)) {
+            dt = remaining;
+        } else if (remaining < 2.0 * dt && remaining >= 2.0 * min_dt) {
+            dt = 0.5 * remaining; // two even steps instead of one long one and a sliver
+        }
+        const bool truncated = dt < proposal;
+
+        StSimulator trial = simulator;
+        trial.set_dt(dt);
+        trial.step(steer_rate, accel);
+        const double error = step_error(simulator.state(), trial, steer_rate, accel, dt);
+
+        double factor = error > 0.0 ? options_.safety / std::sqrt(error) : 5.0;
+        factor = std::clamp(factor, 0.2, 5.0);
+        const bool at_min = dt <= min_dt * (1.0 + 1e-9);
+        if (error <= 1.0 || at_min || forced) {
+            if (error > 1.0 && at_min) report.hit_min_dt = true;
+            simulator = trial;
+            remaining -= dt;
+            if (remaining < 1e-12) remaining = 0.0;
+            ++report.accepted;
+            report.max_error = std::max(report.max_error, error);
+            schedule.min_step = report.accepted == 1 ? dt : std::min(schedule.min_step, dt);
+            schedule.max_step = std::max(schedule.max_step, dt);
+            on_step(static_cast<const StSimulator&>(simulator), dt);
+            // a shortened tail step says nothing about growing past the proposal
+            proposal = truncated ? std::min(proposal, dt * std::max(factor, 1.0)) : dt * factor;
+        } else {
+            ++report.rejected;
+            proposal = dt * std::min(factor, 1.0);
+        }
+        dt_hint_ = std::clamp(proposal, min_dt, max_dt_);
+    }
+
+    VELOX_RECORD_SUBSTEPS(report.accepted);
+    VELOX_COUNT(telemetry::Counter::RejectedSubsteps, report.rejected);
+    return schedule;
+}
+
+} // namespace velox::simulation
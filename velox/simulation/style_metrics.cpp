@@ -0,0 +1,127 @@
+#include "style_metrics.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <numbers>
+#include <stdexcept>
+#include <string>
+
+namespace velox::simulation {
+
+namespace {
+
+void require_weight(double w, const char* name)
+{
+    if (!std::isfinite(w) || w < 0.0) {
+        throw std::invalid_argument(std::string("StyleScoreWeights.") + name + " must be finite and non-negative");
+    }
+}
+
+template <std::size_t N>
+void require_increasing(const std::array<double, N>& edges, const char* name)
+{
+    for (std::size_t i = 0; i < N; ++i) {
+        if (!std::isfinite(edges[i]) || edges[i] < 0.0 || (i > 0 && !(edges[i] > edges[i - 1]))) {
+            throw std::invalid_argument(std::string("StyleMetricsOptions.") + name +
+                                        " must be finite, non-negative and increasing");
+        }
+    }
+}
+
+template <std::size_t N>
+std::size_t bin_of(const std::array<double, N>& edges, double x) noexcept
+{
+    std::size_t bin = 0;
+    while (bin < N && x >= edges[bin]) ++bin;
+    return bin;
+}
+
+double wrap_angle(double a) noexcept
+{
+    return std::remainder(a, 2.0 * std::numbers::pi);
+}
+
+} // anonymous namespace
+
+double RunningMoments::stddev() const noexcept
+{
+    return std::sqrt(variance());
+}
+
+StyleAccumulator::StyleAccumulator(const StyleMetricsOptions& options, const StyleScoreWeights& weights,
+                                   double lat_accel_limit)
+    : options_(options)
+    , weights_(weights)
+    , inv_lat_accel_limit_(0.0)
+{
+    require_weight(weights.time, "time");
+    require_weight(weights.jerk, "jerk");
+    require_weight(weights.steer_rate, "steer_rate");
+    require_weight(weights.speed_error, "speed_error");
+    require_weight(weights.risk, "risk");
+    require_weight(weights.incomplete, "incomplete");
+    require_increasing(options.curvature_edges, "curvature_edges");
+    require_increasing(options.risk_edges, "risk_edges");
+    if (!std::isfinite(lat_accel_limit) || !(lat_accel_limit > 0.0)) {
+        throw std::invalid_argument("StyleAccumulator lateral acceleration limit must be positive");
+    }
+    inv_lat_accel_limit_ = 1.0 / lat_accel_limit;
+}
+
+void StyleAccumulator::reset() noexcept
+{
+    metrics_ = StyleMetrics{};
+    has_previous_ = false;
+    previous_accel_ = 0.0;
+    previous_yaw_ = 0.0;
+}
+
+void StyleAccumulator::add(const models::StState& state, const models::StControl& applied, double curvature,
+                           double target_speed, double dt) noexcept
+{
+    const double speed = std::abs(state[3]);
+    const double accel = applied[1];
+    const double steer_rate = applied[0];
+
+    metrics_.time_s += dt;
+    ++metrics_.samples;
+    metrics_.speed.add(speed);
+    metrics_.accel.add(accel);
+    metrics_.steer_rate.add(steer_rate);
+    metrics_.steer_rate_sq_integral += steer_rate * steer_rate * dt;
+    metrics_.speed_by_curvature[bin_of(options_.curvature_edges, std::abs(curvature))].add(speed);
+
+    if (std::isfinite(target_speed)) {
+        const double error = state[3] - target_speed;
+        metrics_.speed_error.add(error);
+        metrics_.speed_error_sq_integral += error * error * dt;
+    }
+
+    if (has_previous_ && dt > 0.0) {
+        const double jerk = (accel - previous_accel_) / dt;
+        metrics_.jerk_sq_integral += jerk * jerk * dt;
+        metrics_.peak_jerk = std::max(metrics_.peak_jerk, std::abs(jerk));
+
+        const double lat = std::abs(state[3] * wrap_angle(state[2] - previous_yaw_) / dt);
+        metrics_.lat_accel.add(lat);
+        metrics_.risk_band_time_s[bin_of(options_.risk_edges, lat * inv_lat_accel_limit_)] += dt;
+    }
+    has_previous_ = true;
+    previous_accel_ = accel;
+    previous_yaw_ = state[2];
+}
+
+double StyleAccumulator::cost() const noexcept
+{
+    const StyleMetrics& m = metrics_;
+    return weights_.time * m.time_s + weights_.jerk * m.jerk_sq_integral +
+           weights_.steer_rate * m.steer_rate_sq_integral + weights_.speed_error * m.speed_error_sq_integral +
+           weights_.risk * m.risk_band_time_s[kRiskBands - 1];
+}
+
+double StyleAccumulator::final_cost(bool lap_complete) const noexcept
+{
+    return cost() + (lap_complete ? 0.0 : weights_.incomplete);
+}
+
+} // namespace velox::simulation
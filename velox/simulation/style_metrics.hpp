@@ -0,0 +1,134 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+
+#include "models/vehicle_dynamics_st.hpp"
+
+namespace velox::simulation {
+
+/** Welford running mean/variance with extrema; O(1) per sample, no history. */
+struct RunningMoments {
+    std::uint64_t count{};
+    double mean{};
+    double m2{}; // sum of squared deviations from the running mean
+    double min{std::numeric_limits<double>::infinity()};
+    double max{-std::numeric_limits<double>::infinity()};
+
+    void add(double x) noexcept
+    {
+        ++count;
+        const double delta = x - mean;
+        mean += delta / static_cast<double>(count);
+        m2 += delta * (x - mean);
+        if (x < min) min = x;
+        if (x > max) max = x;
+    }
+
+    /// Population variance; 0 for fewer than two samples.
+    double variance() const noexcept { return count > 1 ? m2 / static_cast<double>(count) : 0.0; }
+    double stddev() const noexcept;
+};
+
+inline constexpr std::size_t kCurvatureBins = 4;
+inline constexpr std::size_t kRiskBands = 4;
+
+struct StyleMetricsOptions {
+    /// Upper |kappa| edges [1/m] of all but the last curvature bin: straights, sweepers,
+    /// corners, hairpins with the defaults.
+    std::array<double, kCurvatureBins - 1> curvature_edges{0.01, 0.03, 0.06};
+    /// Upper edges of all but the last risk band, as a fraction of lat_accel_limit.
+    std::array<double, kRiskBands - 1> risk_edges{0.5, 0.8, 0.95};
+    /// Lateral acceleration the risk bands are relative to [m/s^2]; 0 uses the vehicle's mu g.
+    double lat_accel_limit = 0.0;
+};
+
+/**
+ * Cost weights; every term is a non-negative integral over the run, so the running cost never
+ * decreases and bounds the final cost from below. Zero disables a term.
+ */
+struct StyleScoreWeights {
+    double time = 1.0;        // per simulated second
+    double jerk = 0.0;        // per (m/s^3)^2 s of longitudinal jerk
+    double steer_rate = 0.0;  // per (rad/s)^2 s of commanded steering rate
+    double speed_error = 0.0; // per (m/s)^2 s against the track's target speed
+    double risk = 0.0;        // per second spent in the top risk band
+    double incomplete = 0.0;  // added once when the lap was not completed
+};
+
+/** Lap metrics of one run, as accumulated by StyleAccumulator. */
+struct StyleMetrics {
+    double time_s{};
+    std::uint64_t samples{};
+
+    RunningMoments speed;        // |v| [m/s]
+    RunningMoments accel;        // applied longitudinal acceleration [m/s^2]
+    RunningMoments steer_rate;   // applied steering rate [rad/s]
+    RunningMoments lat_accel;    // |v * yaw rate| [m/s^2]
+    RunningMoments speed_error;  // v - target, only where the track reports a target
+
+    // smoothness
+    double jerk_sq_integral{};       // int (da/dt)^2 dt [m^2/s^5]
+    double steer_rate_sq_integral{}; // int steer_rate^2 dt [rad^2/s]
+    double peak_jerk{};              // max |da/dt| [m/s^3]
+
+    // speed tracking
+    double speed_error_sq_integral{}; // int (v - target)^2 dt [m^2/s]
+
+    /// Seconds spent in each band of |lat_accel| / lat_accel_limit (StyleMetricsOptions::risk_edges).
+    std::array<double, kRiskBands> risk_band_time_s{};
+    /// |v| per bin of the track curvature at the car's progress (StyleMetricsOptions::curvature_edges).
+    std::array<RunningMoments, kCurvatureBins> speed_by_curvature{};
+};
+
+/**
+ * StyleAccumulator
+ *
+ * Streaming form of the lap metrics the style tooling used to derive from a stored telemetry
+ * trace: running moments, jerk and steering-rate integrals, time in lateral-acceleration risk
+ * bands and curvature-binned speed statistics, updated in O(1) per step with no history beyond
+ * the previous sample. Integrals use the step dt (rectangle rule, like the distance and energy
+ * totals of run_rollout); jerk and yaw rate are differences of consecutive samples, so the
+ * first sample contributes to neither.
+ *
+ * cost() is the weighted score so far (StyleScoreWeights). It is non-decreasing, so once it
+ * exceeds the best complete score found, the candidate is dominated and can be stopped
+ * (RolloutStyle::stop_cost).
+ *
+ * Plain value type: no allocation, copyable, one per run.
+ */
+class StyleAccumulator {
+public:
+    /// Throws std::invalid_argument for negative or non-finite weights, edges that are not
+    /// increasing, or a non-positive lat_accel_limit.
+    StyleAccumulator(const StyleMetricsOptions& options, const StyleScoreWeights& weights, double lat_accel_limit);
+
+    void reset() noexcept;
+
+    /**
+     * Adds one step: state after the step, the control the simulator applied, the track
+     * curvature and target speed at the car's progress (target NaN: no speed-tracking sample)
+     * and the step length.
+     */
+    void add(const models::StState& state, const models::StControl& applied, double curvature,
+             double target_speed, double dt) noexcept;
+
+    const StyleMetrics& metrics() const noexcept { return metrics_; }
+
+    /// Weighted score so far; a lower bound on final_cost().
+    double cost() const noexcept;
+    double final_cost(bool lap_complete) const noexcept;
+
+private:
+    StyleMetricsOptions options_;
+    StyleScoreWeights weights_;
+    double inv_lat_accel_limit_;
+    StyleMetrics metrics_;
+    bool has_previous_{false};
+    double previous_accel_{};
+    double previous_yaw_{};
+};
+
+} // namespace velox::simulation
@@ -0,0 +1,360 @@
+#include "instrumentation.hpp"
+
+#include <algorithm>
+#include <bit>
+#include <cmath>
+#include <fstream>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+namespace velox::telemetry {
+
+namespace detail {
+std::atomic<bool> g_enabled{false};
+} // namespace detail
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+constexpr std::uint64_t kNoMin = std::numeric_limits<std::uint64_t>::max();
+constexpr int kStageShift = 56; // trace events pack the stage above a 56-bit duration
+
+constexpr std::array<std::string_view, kStageCount> kStageNames = {
+    "dynamics", "low_speed_safety", "loss_of_control", "controller", "track_query", "telemetry", "rollout",
+};
+constexpr std::array<std::string_view, kCounterCount> kCounterNames = {
+    "steps", "substeps", "rejected_substeps", "schedule_calls", "safety_engagements", "loss_of_control_events",
+    "rollouts",
+};
+
+std::atomic<bool> g_trace{false};
+
+struct AtomicStage {
+    std::atomic<std::uint64_t> count{0};
+    std::atomic<std::uint64_t> total{0};
+    std::atomic<std::uint64_t> min{kNoMin};
+    std::atomic<std::uint64_t> max{0};
+    std::array<std::atomic<std::uint64_t>, kTimingBuckets> buckets{};
+};
+
+struct TraceSlot {
+    std::atomic<std::uint64_t> start{0};
+    std::atomic<std::uint64_t> packed{0}; // stage << kStageShift | duration
+};
+
+// Written by its owning thread only (so relaxed fetch_add never contends), read by snapshots.
+struct ThreadBlock {
+    std::uint32_t tid{};
+    std::array<AtomicStage, kStageCount> stages{};
+    std::array<std::atomic<std::uint64_t>, kCounterCount> counters{};
+    std::array<std::atomic<std::uint64_t>, kSubstepBuckets> substeps{};
+    std::atomic<TraceSlot*> trace{nullptr};
+    std::atomic<std::uint64_t> trace_count{0};
+    std::unique_ptr<TraceSlot[]> trace_storage;
+};
+
+// Blocks outlive their threads so totals survive pool shutdown; one block per thread ever seen.
+struct Registry {
+    std::mutex mutex;
+    std::vector<std::unique_ptr<ThreadBlock>> blocks;
+};
+
+Registry& registry()
+{
+    static Registry r;
+    return r;
+}
+
+ThreadBlock& thread_block()
+{
+    thread_local ThreadBlock* block = nullptr;
+    if (!block) {
+        Registry& r = registry();
+        const std::lock_guard<std::mutex> lock(r.mutex);
+        r.blocks.push_back(std::make_unique<ThreadBlock>());
+        block = r.blocks.back().get();
+        block->tid = static_cast<std::uint32_t>(r.blocks.size());
+    }
+    return *block;
+}
+
+// Tick origin of the trace timestamps and the reference for the tick rate.
+struct Epoch {
+    std::uint64_t ticks;
+    Clock::time_point time;
+};
+
+const Epoch& epoch()
+{
+    static const Epoch e{read_ticks(), Clock::now()};
+    return e;
+}
+
+[[maybe_unused]] const bool kEpochAtStartup = (epoch(), true);
+
+double ns_per_tick()
+{
+#if defined(__x86_64__) || defined(__i386__) || defined(_M_X64) || defined(_M_IX86) || defined(__aarch64__)
+    // measured against steady_clock over at least 20 ms since the epoch
+    static const double rate = [] {
+        const Epoch& e = epoch();
+        while (Clock::now() - e.time < std::chrono::milliseconds(20)) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(5));
+        }
+        const std::uint64_t ticks = read_ticks();
+        const double ns = std::chrono::duration<double, std::nano>(Clock::now() - e.time).count();
+        return ticks > e.ticks ? ns / static_cast<double>(ticks - e.ticks) : 1.0;
+    }();
+    return rate;
+#else
+    return 1.0;
+#endif
+}
+
+std::size_t timing_bucket(std::uint64_t ticks)
+{
+    const std::size_t b = ticks == 0 ? 0 : static_cast<std::size_t>(std::bit_width(ticks)) - 1;
+    return std::min(b, kTimingBuckets - 1);
+}
+
+void raise_to(std::atomic<std::uint64_t>& a, std::uint64_t v)
+{
+    if (v > a.load(std::memory_order_relaxed)) a.store(v, std::memory_order_relaxed);
+}
+
+void lower_to(std::atomic<std::uint64_t>& a, std::uint64_t v)
+{
+    if (v < a.load(std::memory_order_relaxed)) a.store(v, std::memory_order_relaxed);
+}
+
+TraceSlot* trace_ring(ThreadBlock& block)
+{
+    TraceSlot* ring = block.trace.load(std::memory_order_relaxed);
+    if (!ring) {
+        block.trace_storage = std::make_unique<TraceSlot[]>(kTraceCapacity);
+        ring = block.trace_storage.get();
+        block.trace.store(ring, std::memory_order_release);
+    }
+    return ring;
+}
+
+void write_json_string(std::ofstream& out, std::string_view s)
+{
+    out << '"';
+    for (char c : s) {
+        if (c == '"' || c == '\\') out << '\\';
+        out << c;
+    }
+    out << '"';
+}
+
+} // anonymous namespace
+
+std::string_view stage_name(Stage stage)
+{
+    return kStageNames[static_cast<std::size_t>(stage)];
+}
+
+std::string_view counter_name(Counter counter)
+{
+    return kCounterNames[static_cast<std::size_t>(counter)];
+}
+
+double InstrumentationSnapshot::mean_ns(Stage s) const
+{
+    const StageStats& st = stage(s);
+    return st.count == 0 ? 0.0 : static_cast<double>(st.total_ticks) * ns_per_tick / static_cast<double>(st.count);
+}
+
+double InstrumentationSnapshot::quantile_ns(Stage s, double q) const
+{
+    const StageStats& st = stage(s);
+    if (st.count == 0) return 0.0;
+    const double target = std::clamp(q, 0.0, 1.0) * static_cast<double>(st.count);
+    std::uint64_t seen = 0;
+    for (std::size_t b = 0; b < kTimingBuckets; ++b) {
+        seen += st.buckets[b];
+        if (static_cast<double>(seen) >= target && seen > 0) {
+            return std::ldexp(1.0, static_cast<int>(b + 1)) * ns_per_tick;
+        }
+    }
+    return static_cast<double>(st.max_ticks) * ns_per_tick;
+}
+
+void set_instrumentation_enabled(bool enabled)
+{
+    if (!enabled) g_trace.store(false, std::memory_order_relaxed);
+    detail::g_enabled.store(enabled, std::memory_order_relaxed);
+}
+
+bool instrumentation_enabled() noexcept
+{
+    return detail::g_enabled.load(std::memory_order_relaxed);
+}
+
+void set_trace_enabled(bool enabled)
+{
+    g_trace.store(enabled, std::memory_order_relaxed);
+    if (enabled) detail::g_enabled.store(true, std::memory_order_relaxed);
+}
+
+namespace detail {
+
+void record_stage(Stage stage, std::uint64_t start, std::uint64_t end) noexcept
+{
+    ThreadBlock& block = thread_block();
+    const std::uint64_t ticks = end > start ? end - start : 0;
+    AtomicStage& st = block.stages[static_cast<std::size_t>(stage)];
+    st.count.fetch_add(1, std::memory_order_relaxed);
+    st.total.fetch_add(ticks, std::memory_order_relaxed);
+    lower_to(st.min, ticks);
+    raise_to(st.max, ticks);
+    st.buckets[timing_bucket(ticks)].fetch_add(1, std::memory_order_relaxed);
+
+    if (g_trace.load(std::memory_order_relaxed)) {
+        TraceSlot* ring = trace_ring(block);
+        const std::uint64_t n = block.trace_count.load(std::memory_order_relaxed);
+        TraceSlot& slot = ring[n % kTraceCapacity];
+        const std::uint64_t duration = std::min(ticks, (std::uint64_t{1} << kStageShift) - 1);
+        slot.start.store(start, std::memory_order_relaxed);
+        slot.packed.store(static_cast<std::uint64_t>(stage) << kStageShift | duration, std::memory_order_relaxed);
+        block.trace_count.store(n + 1, std::memory_order_release);
+    }
+}
+
+void add_counter(Counter counter, std::uint64_t n) noexcept
+{
+    thread_block().counters[static_cast<std::size_t>(counter)].fetch_add(n, std::memory_order_relaxed);
+}
+
+void record_substeps(std::uint64_t n) noexcept
+{
+    ThreadBlock& block = thread_block();
+    block.substeps[std::min<std::uint64_t>(n, kSubstepBuckets - 1)].fetch_add(1, std::memory_order_relaxed);
+    block.counters[static_cast<std::size_t>(Counter::Substeps)].fetch_add(n, std::memory_order_relaxed);
+    block.counters[static_cast<std::size_t>(Counter::ScheduleCalls)].fetch_add(1, std::memory_order_relaxed);
+}
+
+} // namespace detail
+
+InstrumentationSnapshot instrumentation_snapshot()
+{
+    InstrumentationSnapshot snap;
+    snap.ns_per_tick = ns_per_tick();
+    for (StageStats& st : snap.stages) st.min_ticks = kNoMin;
+
+    Registry& r = registry();
+    const std::lock_guard<std::mutex> lock(r.mutex);
+    snap.threads = r.blocks.size();
+    for (const auto& block : r.blocks) {
+        for (std::size_t s = 0; s < kStageCount; ++s) {
+            const AtomicStage& in = block->stages[s];
+            StageStats& out = snap.stages[s];
+            out.count += in.count.load(std::memory_order_relaxed);
+            out.total_ticks += in.total.load(std::memory_order_relaxed);
+            out.min_ticks = std::min(out.min_ticks, in.min.load(std::memory_order_relaxed));
+            out.max_ticks = std::max(out.max_ticks, in.max.load(std::memory_order_relaxed));
+            for (std::size_t b = 0; b < kTimingBuckets; ++b) {
+                out.buckets[b] += in.buckets[b].load(std::memory_order_relaxed);
+            }
+        }
+        for (std::size_t c = 0; c < kCounterCount; ++c) {
+            snap.counters[c] += block->counters[c].load(std::memory_order_relaxed);
+        }
+        for (std::size_t b = 0; b < kSubstepBuckets; ++b) {
+            snap.substeps_per_schedule[b] += block->substeps[b].load(std::memory_order_relaxed);
+        }
+    }
+    for (StageStats& st : snap.stages) {
+        if (st.count == 0) st.min_ticks = 0;
+    }
+    return snap;
+}
+
+void reset_instrumentation()
+{
+    Registry& r = registry();
+    const std::lock_guard<std::mutex> lock(r.mutex);
+    for (const auto& block : r.blocks) {
+        for (AtomicStage& st : block->stages) {
+            st.count.store(0, std::memory_order_relaxed);
+            st.total.store(0, std::memory_order_relaxed);
+            st.min.store(kNoMin, std::memory_order_relaxed);
+            st.max.store(0, std::memory_order_relaxed);
+            for (auto& b : st.buckets) b.store(0, std::memory_order_relaxed);
+        }
+        for (auto& c : block->counters) c.store(0, std::memory_order_relaxed);
+        for (auto& b : block->substeps) b.store(0, std::memory_order_relaxed);
+        block->trace_count.store(0, std::memory_order_relaxed);
+    }
+}
+
+void write_chrome_trace(const std::string& path)
+{
+    const double us_per_tick = ns_per_tick() * 1e-3;
+    const std::uint64_t origin = epoch().ticks;
+    const InstrumentationSnapshot snap = instrumentation_snapshot();
+
+    std::ofstream out(path, std::ios::trunc);
+    if (!out) {
+        throw std::runtime_error("Cannot write trace file: " + path);
+    }
+    out.precision(3);
+    out << std::fixed << "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[\n";
+    out << R"({"name":"process_name","ph":"M","pid":1,"tid":0,"args":{"name":"velox"}})";
+
+    double last_us = 0.0;
+    Registry& r = registry();
+    {
+        const std::lock_guard<std::mutex> lock(r.mutex);
+        for (const auto& block : r.blocks) {
+            out << ",\n" << R"({"name":"thread_name","ph":"M","pid":1,"tid":)" << block->tid
+                << R"(,"args":{"name":"worker )" << block->tid << "\"}}";
+
+            const TraceSlot* ring = block->trace.load(std::memory_order_acquire);
+            if (!ring) continue;
+            const std::uint64_t end = block->trace_count.load(std::memory_order_acquire);
+            const std::uint64_t begin = end > kTraceCapacity ? end - kTraceCapacity : 0;
+            std::vector<std::pair<std::uint64_t, std::uint64_t>> events;
+            events.reserve(static_cast<std::size_t>(end - begin));
+            for (std::uint64_t k = begin; k < end; ++k) {
+                const TraceSlot& slot = ring[k % kTraceCapacity];
+                events.emplace_back(slot.start.load(std::memory_order_relaxed),
+                                    slot.packed.load(std::memory_order_relaxed));
+            }
+            // the owner may have lapped the ring while we copied; drop the slots it reused
+            const std::uint64_t now = block->trace_count.load(std::memory_order_acquire);
+            const std::uint64_t valid_from = now > kTraceCapacity ? now - kTraceCapacity : 0;
+            for (std::uint64_t k = std::max(begin, valid_from); k < end; ++k) {
+                const auto [start, packed] = events[static_cast<std::size_t>(k - begin)];
+                const auto stage = static_cast<std::size_t>(packed >> kStageShift);
+                if (stage >= kStageCount || start < origin) continue;
+                const std::uint64_t duration = packed & ((std::uint64_t{1} << kStageShift) - 1);
+                const double ts = static_cast<double>(start - origin) * us_per_tick;
+                last_us = std::max(last_us, ts + static_cast<double>(duration) * us_per_tick);
+                out << ",\n{\"name\":";
+                write_json_string(out, kStageNames[stage]);
+                out << ",\"cat\":\"velox\",\"ph\":\"X\",\"pid\":1,\"tid\":" << block->tid << ",\"ts\":" << ts
+                    << ",\"dur\":" << static_cast<double>(duration) * us_per_tick << '}';
+            }
+        }
+    }
+
+    for (std::size_t c = 0; c < kCounterCount; ++c) {
+        out << ",\n{\"name\":";
+        write_json_string(out, kCounterNames[c]);
+        out << ",\"ph\":\"C\",\"pid\":1,\"tid\":0,\"ts\":" << last_us << ",\"args\":{\"value\":" << snap.counters[c]
+            << "}}";
+    }
+    out << "\n]}\n";
+    if (!out) {
+        throw std::runtime_error("Failed writing trace file: " + path);
+    }
+}
+
+} // namespace velox::telemetry
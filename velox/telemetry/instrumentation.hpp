@@ -0,0 +1,183 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#elif defined(_M_X64) || defined(_M_IX86)
+#include <intrin.h>
+#endif
+
+/**
+ * VELOX_INSTRUMENTATION=0 compiles every VELOX_TIME_SCOPE / VELOX_COUNT / VELOX_RECORD_SUBSTEPS
+ * site to nothing. When compiled in, recording still starts disabled and costs one relaxed load
+ * per site until set_instrumentation_enabled(true).
+ */
+#ifndef VELOX_INSTRUMENTATION
+#define VELOX_INSTRUMENTATION 1
+#endif
+
+namespace velox::telemetry {
+
+/** Hot-path stages with their own timing histogram. */
+enum class Stage : std::uint8_t {
+    Dynamics,        // one simulator / batch step
+    LowSpeedSafety,
+    LossOfControl,
+    Controller,
+    TrackQuery,      // projection and off-track tests
+    Telemetry,
+    Rollout,         // a whole run_rollout()
+};
+
+inline constexpr std::size_t kStageCount = static_cast<std::size_t>(Stage::Rollout) + 1;
+
+enum class Counter : std::uint8_t {
+    Steps,
+    Substeps,             // accepted integrator sub-steps
+    RejectedSubsteps,
+    ScheduleCalls,        // step schedules planned (ModelTiming::planSteps in the daemon)
+    SafetyEngagements,    // low-speed safety entering a non-normal stage
+    LossOfControlEvents,  // detector severity crossing its threshold
+    Rollouts,
+};
+
+inline constexpr std::size_t kCounterCount = static_cast<std::size_t>(Counter::Rollouts) + 1;
+
+std::string_view stage_name(Stage stage);
+std::string_view counter_name(Counter counter);
+
+/// Stage histograms bucket durations by floor(log2(ticks)).
+inline constexpr std::size_t kTimingBuckets = 48;
+/// Sub-steps per schedule: buckets 0..30 exact, the last one 31 and above.
+inline constexpr std::size_t kSubstepBuckets = 32;
+
+/** TSC on x86, the virtual counter on aarch64, steady_clock nanoseconds elsewhere. */
+inline std::uint64_t read_ticks() noexcept
+{
+#if defined(__x86_64__) || defined(__i386__) || defined(_M_X64) || defined(_M_IX86)
+    return __rdtsc();
+#elif defined(__aarch64__)
+    std::uint64_t ticks;
+    asm volatile("mrs %0, cntvct_el0" : "=r"(ticks));
+    return ticks;
+#else
+    return static_cast<std::uint64_t>(
+        std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch())
+            .count());
+#endif
+}
+
+struct StageStats {
+    std::uint64_t count{};
+    std::uint64_t total_ticks{};
+    std::uint64_t min_ticks{};
+    std::uint64_t max_ticks{};
+    std::array<std::uint64_t, kTimingBuckets> buckets{};
+};
+
+/** Totals over every thread at the time of the call. */
+struct InstrumentationSnapshot {
+    double ns_per_tick{1.0};
+    std::size_t threads{};
+    std::array<StageStats, kStageCount> stages{};
+    std::array<std::uint64_t, kCounterCount> counters{};
+    std::array<std::uint64_t, kSubstepBuckets> substeps_per_schedule{};
+
+    const StageStats& stage(Stage s) const { return stages[static_cast<std::size_t>(s)]; }
+    std::uint64_t counter(Counter c) const { return counters[static_cast<std::size_t>(c)]; }
+
+    double mean_ns(Stage s) const;
+    /// Upper edge of the histogram bucket holding quantile q in [0, 1].
+    double quantile_ns(Stage s, double q) const;
+};
+
+void set_instrumentation_enabled(bool enabled);
+bool instrumentation_enabled() noexcept;
+
+/**
+ * Also keeps the most recent timed scopes per thread (a fixed ring of kTraceCapacity events)
+ * for write_chrome_trace(). Implies set_instrumentation_enabled(true).
+ */
+void set_trace_enabled(bool enabled);
+inline constexpr std::size_t kTraceCapacity = 1u << 14;
+
+/**
+ * Sums the per-thread blocks without pausing the writers. Each value is read atomically, so
+ * a snapshot taken mid-step may be a few events apart between stages but never torn.
+ */
+InstrumentationSnapshot instrumentation_snapshot();
+
+/// Zeroes every histogram, counter and trace ring. Writers may keep running.
+void reset_instrumentation();
+
+/**
+ * Writes the trace rings as Chrome trace JSON ("X" events per timed scope, one track per
+ * thread, final counter values as "C" events); loads in chrome://tracing and Perfetto.
+ */
+void write_chrome_trace(const std::string& path);
+
+namespace detail {
+
+extern std::atomic<bool> g_enabled;
+
+void record_stage(Stage stage, std::uint64_t start, std::uint64_t end) noexcept;
+void add_counter(Counter counter, std::uint64_t n) noexcept;
+void record_substeps(std::uint64_t n) noexcept;
+
+} // namespace detail
+
+inline void count(Counter counter, std::uint64_t n = 1) noexcept
+{
+    if (detail::g_enabled.load(std::memory_order_relaxed)) detail::add_counter(counter, n);
+}
+
+/// Histogram entry for one schedule of n sub-steps; also adds n to Counter::Substeps.
+inline void record_substeps(std::uint64_t n) noexcept
+{
+    if (detail::g_enabled.load(std::memory_order_relaxed)) detail::record_substeps(n);
+}
+
+/** Times its scope into the stage histogram (and the trace ring when tracing). */
+class ScopedTimer {
+public:
+    explicit ScopedTimer(Stage stage) noexcept
+        : stage_(stage)
+        , active_(detail::g_enabled.load(std::memory_order_relaxed))
+        , start_(active_ ? read_ticks() : 0)
+    {
+    }
+    ~ScopedTimer()
+    {
+        if (active_) detail::record_stage(stage_, start_, read_ticks());
+    }
+    ScopedTimer(const ScopedTimer&) = delete;
+    ScopedTimer& operator=(const ScopedTimer&) = delete;
+
+private:
+    Stage stage_;
+    bool active_;
+    std::uint64_t start_;
+};
+
+} // namespace velox::telemetry
+
+#define VELOX_INSTRUMENTATION_CONCAT_(a, b) a##b
+#define VELOX_INSTRUMENTATION_CONCAT(a, b) VELOX_INSTRUMENTATION_CONCAT_(a, b)
+
+#if VELOX_INSTRUMENTATION
+#define VELOX_TIME_SCOPE(stage) \
+    const ::velox::telemetry::ScopedTimer VELOX_INSTRUMENTATION_CONCAT(velox_scope_timer_, __LINE__)(stage)
+#define VELOX_COUNT(counter, n) ::velox::telemetry::count((counter), (n))
+#define VELOX_RECORD_SUBSTEPS(n) ::velox::telemetry::record_substeps(n)
+#else
+#define VELOX_TIME_SCOPE(stage) static_cast<void>(0)
+#define VELOX_COUNT(counter, n) static_cast<void>(0)
+#define VELOX_RECORD_SUBSTEPS(n) static_cast<void>(0)
+#endif
@@ -0,0 +1,267 @@
+#include "telemetry_recorder.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <limits>
+#include <stdexcept>
+#include <type_traits>
+
+#include "instrumentation.hpp"
+
+namespace velox::telemetry {
+
+namespace {
+
+constexpr std::uint32_t kFileVersion = 1;
+constexpr char kFileMagic[8] = {'V', 'X', 'T', 'E', 'L', 'E', 'M', '\0'};
+
+struct FileHeader {
+    char magic[8];
+    std::uint32_t version;
+    std::uint32_t channels;
+    std::uint64_t samples;
+    std::uint64_t steps;
+    std::uint64_t dropped;
+    std::uint32_t decimation;
+    std::uint32_t reserved;
+};
+
+static_assert(std::is_trivially_copyable_v<FileHeader> && sizeof(FileHeader) == 48,
+              "telemetry header is written verbatim");
+
+std::size_t pad8(std::size_t n)
+{
+    return (n + 7) / 8 * 8;
+}
+
+// Columns start one cache line apart modulo the page size: with power-of-two capacities the
+// same slot of every column would otherwise map to one cache set.
+std::size_t pad_column(std::size_t capacity)
+{
+    constexpr std::size_t kLine = 64 / sizeof(float);
+    return (capacity + kLine - 1) / kLine * kLine + kLine;
+}
+
+template <typename T>
+void write_raw(std::ofstream& out, const T* data, std::size_t count)
+{
+    if (count > 0) out.write(reinterpret_cast<const char*>(data), static_cast<std::streamsize>(count * sizeof(T)));
+}
+
+} // anonymous namespace
+
+std::optional<Channel> find_channel(std::string_view name)
+{
+    for (std::size_t i = 0; i < kChannelCount; ++i) {
+        if (kChannelNames[i] == name) return static_cast<Channel>(i);
+    }
+    return std::nullopt;
+}
+
+std::vector<Channel> channels_under(std::string_view prefix)
+{
+    std::vector<Channel> out;
+    for (std::size_t i = 0; i < kChannelCount; ++i) {
+        const std::string_view name = kChannelNames[i];
+        if (name == prefix ||
+            (name.size() > prefix.size() && name.substr(0, prefix.size()) == prefix && name[prefix.size()] == '.')) {
+            out.push_back(static_cast<Channel>(i));
+        }
+    }
+    return out;
+}
+
+TelemetryRecorder::TelemetryRecorder(const RecorderOptions& options)
+    : capacity_(options.capacity)
+    , stride_(pad_column(options.capacity))
+    , decimation_(options.decimation)
+    , channels_(options.channels)
+{
+    if (capacity_ == 0) {
+        throw std::invalid_argument("TelemetryRecorder capacity must be positive");
+    }
+    if (decimation_ == 0) {
+        throw std::invalid_argument("TelemetryRecorder decimation must be positive");
+    }
+    if (channels_.empty()) {
+        for (std::size_t i = 0; i < kChannelCount; ++i) channels_.push_back(static_cast<Channel>(i));
+    }
+
+    column_of_.fill(-1);
+    for (std::size_t c = 0; c < channels_.size(); ++c) {
+        std::int32_t& column = column_of_[static_cast<std::size_t>(channels_[c])];
+        if (column >= 0) {
+            throw std::invalid_argument("TelemetryRecorder channel listed twice: " +
+                                        std::string(channel_name(channels_[c])));
+        }
+        column = static_cast<std::int32_t>(c);
+    }
+
+    data_.assign(channels_.size() * stride_, std::numeric_limits<float>::quiet_NaN());
+    time_.assign(capacity_, 0.0);
+}
+
+TelemetryRecorder::Row TelemetryRecorder::sample(double time_s)
+{
+    if (steps_++ % decimation_ != 0) return {};
+
+    const std::size_t slot = head_;
+    if (size_ == capacity_) {
+        ++dropped_;
+    } else {
+        ++size_;
+    }
+    head_ = head_ + 1 == capacity_ ? 0 : head_ + 1;
+
+    time_[slot] = time_s;
+    for (std::size_t c = 0; c < channels_.size(); ++c) {
+        data_[c * stride_ + slot] = std::numeric_limits<float>::quiet_NaN();
+    }
+    return Row(this, slot);
+}
+
+std::vector<double> TelemetryRecorder::times() const
+{
+    std::vector<double> out(size_);
+    const std::size_t first = oldest();
+    for (std::size_t k = 0; k < size_; ++k) out[k] = time_[(first + k) % capacity_];
+    return out;
+}
+
+std::vector<float> TelemetryRecorder::column(Channel channel) const
+{
+    const std::int32_t column = column_of_[static_cast<std::size_t>(channel)];
+    if (column < 0) {
+        throw std::invalid_argument("Channel not recorded: " + std::string(channel_name(channel)));
+    }
+    const float* base = data_.data() + static_cast<std::size_t>(column) * stride_;
+    std::vector<float> out(size_);
+    const std::size_t first = oldest();
+    // the ring is at most two contiguous runs
+    const std::size_t tail = std::min(size_, capacity_ - first);
+    std::copy_n(base + first, tail, out.begin());
+    std::copy_n(base, size_ - tail, out.begin() + static_cast<std::ptrdiff_t>(tail));
+    return out;
+}
+
+void TelemetryRecorder::clear() noexcept
+{
+    head_ = 0;
+    size_ = 0;
+    steps_ = 0;
+    dropped_ = 0;
+}
+
+void TelemetryRecorder::write(const std::string& path) const
+{
+    VELOX_TIME_SCOPE(Stage::Telemetry);
+    FileHeader h{};
+    std::memcpy(h.magic, kFileMagic, sizeof(kFileMagic));
+    h.version    = kFileVersion;
+    h.channels   = static_cast<std::uint32_t>(channels_.size());
+    h.samples    = size_;
+    h.steps      = steps_;
+    h.dropped    = dropped_;
+    h.decimation = decimation_;
+
+    std::string table;
+    for (Channel c : channels_) {
+        const std::string_view name = channel_name(c);
+        const auto length = static_cast<std::uint16_t>(name.size());
+        table.append(reinterpret_cast<const char*>(&length), sizeof(length));
+        table.append(name);
+    }
+    table.resize(pad8(table.size()), '\0');
+
+    std::ofstream out(path, std::ios::binary | std::ios::trunc);
+    if (!out) {
+        throw std::runtime_error("Cannot write telemetry file: " + path);
+    }
+    out.write(reinterpret_cast<const char*>(&h), sizeof(h));
+    out.write(table.data(), static_cast<std::streamsize>(table.size()));
+
+    // ring order -> chronological order, two contiguous runs per column
+    const std::size_t first = oldest();
+    const std::size_t tail = std::min(size_, capacity_ - first);
+    write_raw(out, time_.data() + first, tail);
+    write_raw(out, time_.data(), size_ - tail);
+    for (std::size_t c = 0; c < channels_.size(); ++c) {
+        const float* base = data_.data() + c * stride_;
+        write_raw(out, base + first, tail);
+        write_raw(out, base, size_ - tail);
+    }
+    if (!out) {
+        throw std::runtime_error("Failed writing telemetry file: " + path);
+    }
+}
+
+std::size_t TelemetryRecorder::memory_bytes() const noexcept
+{
+    return data_.size() * sizeof(float) + time_.size() * sizeof(double);
+}
+
+const std::vector<float>* TelemetryFile::column(std::string_view name) const
+{
+    for (std::size_t c = 0; c < channels.size(); ++c) {
+        if (channels[c] == name) return &columns[c];
+    }
+    return nullptr;
+}
+
+TelemetryFile read_telemetry(const std::string& path)
+{
+    std::ifstream in(path, std::ios::binary);
+    if (!in) {
+        throw std::runtime_error("Cannot open telemetry file: " + path);
+    }
+    const std::string blob((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+
+    FileHeader h{};
+    if (blob.size() < sizeof(h)) {
+        throw std::runtime_error("Truncated telemetry file: " + path);
+    }
+    std::memcpy(&h, blob.data(), sizeof(h));
+    if (std::memcmp(h.magic, kFileMagic, sizeof(kFileMagic)) != 0 || h.version != kFileVersion) {
+        throw std::runtime_error("Not a version " + std::to_string(kFileVersion) + " telemetry file: " + path);
+    }
+
+    TelemetryFile file;
+    file.steps = h.steps;
+    file.dropped = h.dropped;
+    file.decimation = h.decimation;
+
+    std::size_t pos = sizeof(h);
+    for (std::uint32_t c = 0; c < h.channels; ++c) {
+        std::uint16_t length = 0;
+        if (blob.size() - pos < sizeof(length)) {
+            throw std::runtime_error("Corrupt telemetry file: " + path);
+        }
+        std::memcpy(&length, blob.data() + pos, sizeof(length));
+        pos += sizeof(length);
+        if (blob.size() - pos < length) {
+            throw std::runtime_error("Corrupt telemetry file: " + path);
+        }
+        file.channels.emplace_back(blob.data() + pos, length);
+        pos += length;
+    }
+    pos = sizeof(h) + pad8(pos - sizeof(h));
+
+    const std::uint64_t expected = pos + h.samples * (sizeof(double) + std::uint64_t{h.channels} * sizeof(float));
+    if (pos > blob.size() || blob.size() != expected) {
+        throw std::runtime_error("Corrupt telemetry file: " + path);
+    }
+    const auto read_column = [&](auto& column) {
+        column.resize(h.samples);
+        const std::size_t bytes = h.samples * sizeof(column[0]);
+        if (bytes > 0) std::memcpy(column.data(), blob.data() + pos, bytes);
+        pos += bytes;
+    };
+    read_column(file.time);
+    file.columns.resize(h.channels);
+    for (auto& column : file.columns) read_column(column);
+    return file;
+}
+
+} // namespace velox::telemetry
@@ -0,0 +1,189 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace velox::telemetry {
+
+/**
+ * Leaf fields of SimulationTelemetry (velox/telemetry/index.ts), in toJson() order. Booleans
+ * record as 0/1 and safety_stage as 0 normal, 1 transition, 2 emergency.
+ */
+enum class Channel : std::uint16_t {
+    PoseX, PoseY, PoseYaw,
+    VelocitySpeed, VelocityLongitudinal, VelocityLateral, VelocityYawRate, VelocityGlobalX, VelocityGlobalY,
+    AccelerationLongitudinal, AccelerationLateral,
+    TractionSlipAngle, TractionFrontSlipAngle, TractionRearSlipAngle, TractionLateralForceSaturation,
+    TractionDriftMode,
+    SteeringDesiredAngle, SteeringDesiredRate, SteeringActualAngle, SteeringActualRate,
+    ControllerAcceleration, ControllerThrottle, ControllerBrake, ControllerDriveForce, ControllerBrakeForce,
+    ControllerRegenForce, ControllerHydraulicForce, ControllerDragForce, ControllerRollingForce,
+    PowertrainTotalTorque, PowertrainDriveTorque, PowertrainRegenTorque, PowertrainMechanicalPower,
+    PowertrainBatteryPower, PowertrainSoc,
+    FrontAxleDriveTorque, FrontAxleBrakeTorque, FrontAxleRegenTorque, FrontAxleNormalForce,
+    FrontAxleLeftSpeed, FrontAxleLeftSlipRatio, FrontAxleLeftFrictionUtilization,
+    FrontAxleRightSpeed, FrontAxleRightSlipRatio, FrontAxleRightFrictionUtilization,
+    RearAxleDriveTorque, RearAxleBrakeTorque, RearAxleRegenTorque, RearAxleNormalForce,
+    RearAxleLeftSpeed, RearAxleLeftSlipRatio, RearAxleLeftFrictionUtilization,
+    RearAxleRightSpeed, RearAxleRightSlipRatio, RearAxleRightFrictionUtilization,
+    TotalsDistanceTraveled, TotalsEnergyConsumed, TotalsSimulationTime,
+    LowSpeedEngaged, DetectorSeverity, SafetyStage, DetectorForced,
+};
+
+inline constexpr std::size_t kChannelCount = static_cast<std::size_t>(Channel::DetectorForced) + 1;
+
+/// Dotted toJson() path of each channel, index = Channel.
+inline constexpr std::array<std::string_view, kChannelCount> kChannelNames = {
+    "pose.x", "pose.y", "pose.yaw",
+    "velocity.speed", "velocity.longitudinal", "velocity.lateral", "velocity.yaw_rate", "velocity.global_x",
+    "velocity.global_y",
+    "acceleration.longitudinal", "acceleration.lateral",
+    "traction.slip_angle", "traction.front_slip_angle", "traction.rear_slip_angle",
+    "traction.lateral_force_saturation", "traction.drift_mode",
+    "steering.desired_angle", "steering.desired_rate", "steering.actual_angle", "steering.actual_rate",
+    "controller.acceleration", "controller.throttle", "controller.brake", "controller.drive_force",
+    "controller.brake_force", "controller.regen_force", "controller.hydraulic_force", "controller.drag_force",
+    "controller.rolling_force",
+    "powertrain.total_torque", "powertrain.drive_torque", "powertrain.regen_torque",
+    "powertrain.mechanical_power", "powertrain.battery_power", "powertrain.soc",
+    "front_axle.drive_torque", "front_axle.brake_torque", "front_axle.regen_torque", "front_axle.normal_force",
+    "front_axle.left.speed", "front_axle.left.slip_ratio", "front_axle.left.friction_utilization",
+    "front_axle.right.speed", "front_axle.right.slip_ratio", "front_axle.right.friction_utilization",
+    "rear_axle.drive_torque", "rear_axle.brake_torque", "rear_axle.regen_torque", "rear_axle.normal_force",
+    "rear_axle.left.speed", "rear_axle.left.slip_ratio", "rear_axle.left.friction_utilization",
+    "rear_axle.right.speed", "rear_axle.right.slip_ratio", "rear_axle.right.friction_utilization",
+    "totals.distance_traveled_m", "totals.energy_consumed_joules", "totals.simulation_time_s",
+    "low_speed_engaged", "detector_severity", "safety_stage", "detector_forced",
+};
+
+inline constexpr std::string_view channel_name(Channel channel)
+{
+    return kChannelNames[static_cast<std::size_t>(channel)];
+}
+
+std::optional<Channel> find_channel(std::string_view name);
+
+/// Channels equal to name or nested under it ("front_axle" selects all ten axle channels).
+std::vector<Channel> channels_under(std::string_view prefix);
+
+struct RecorderOptions {
+    std::size_t capacity = 1u << 16;  // samples kept; older ones are overwritten
+    std::uint32_t decimation = 1;     // keep every n-th step
+    std::vector<Channel> channels;    // empty records every channel
+};
+
+/**
+ * TelemetryRecorder
+ *
+ * Columnar ring buffer for per-step telemetry. Every selected channel owns one preallocated
+ * float32 column of capacity() samples next to a float64 time column; recording writes scalars
+ * into the current slot and never allocates. Producers fill only the fields they know:
+ *
+ *   if (auto row = recorder.sample(t)) {
+ *       row.set(Channel::PoseX, x);
+ *       row.set(Channel::VelocitySpeed, v);
+ *   }
+ *
+ * sample() counts steps and returns an inactive row for decimated ones; set() on a channel
+ * that is not selected is a no-op. Channels not set for a kept sample read as NaN.
+ *
+ * write() exports the samples in chronological order as a raw columnar block (format below);
+ * read_telemetry() loads it back. Not thread-safe; use one recorder per simulated vehicle.
+ */
+class TelemetryRecorder {
+public:
+    /// Throws std::invalid_argument for a zero capacity or decimation or a repeated channel.
+    explicit TelemetryRecorder(const RecorderOptions& options = {});
+
+    class Row {
+    public:
+        explicit operator bool() const noexcept { return recorder_ != nullptr; }
+        void set(Channel channel, double value) const noexcept
+        {
+            if (!recorder_) return;
+            const std::int32_t column = recorder_->column_of_[static_cast<std::size_t>(channel)];
+            if (column >= 0) recorder_->data_[static_cast<std::size_t>(column) * recorder_->stride_ + slot_] =
+                static_cast<float>(value);
+        }
+
+    private:
+        friend class TelemetryRecorder;
+        Row() = default;
+        Row(TelemetryRecorder* recorder, std::size_t slot) : recorder_(recorder), slot_(slot) {}
+
+        TelemetryRecorder* recorder_{nullptr};
+        std::size_t slot_{0};
+    };
+
+    /// Advances the step counter; the row is active when this step is kept.
+    Row sample(double time_s);
+
+    std::size_t capacity() const noexcept { return capacity_; }
+    std::size_t size() const noexcept { return size_; }
+    std::uint64_t steps() const noexcept { return steps_; }
+    std::uint64_t dropped() const noexcept { return dropped_; }
+    std::uint32_t decimation() const noexcept { return decimation_; }
+    const std::vector<Channel>& channels() const noexcept { return channels_; }
+    bool records(Channel channel) const noexcept { return column_of_[static_cast<std::size_t>(channel)] >= 0; }
+
+    /// Chronological copies of the kept samples; column() throws for an unselected channel.
+    std::vector<double> times() const;
+    std::vector<float> column(Channel channel) const;
+
+    /// Forgets all samples and the step counter; the buffers stay allocated.
+    void clear() noexcept;
+
+    /**
+     * Writes the recording. Layout, host byte order:
+     *
+     *   header            "VXTELEM\0", u32 version, u32 channels, u64 samples, u64 steps,
+     *                     u64 dropped, u32 decimation, u32 reserved
+     *   channel table     per channel: u16 name length, name bytes; zero-padded to 8 bytes
+     *   time column       f64[samples]
+     *   channel columns   f32[samples] each, in channel-table order
+     *
+     * so a reader can map the file and view every column in place (numpy.frombuffer with the
+     * offsets above, or an Arrow fixed-width buffer per column).
+     */
+    void write(const std::string& path) const;
+
+    std::size_t memory_bytes() const noexcept;
+
+private:
+    std::size_t oldest() const noexcept { return size_ < capacity_ ? 0 : head_; }
+
+    std::size_t capacity_;
+    std::size_t stride_;        // column pitch; padded so columns do not alias in the cache
+    std::uint32_t decimation_;
+    std::vector<Channel> channels_;
+    std::array<std::int32_t, kChannelCount> column_of_{};
+    std::vector<float> data_;   // channels_.size() columns of stride_ floats
+    std::vector<double> time_;
+    std::size_t head_{0};       // next slot to write
+    std::size_t size_{0};
+    std::uint64_t steps_{0};
+    std::uint64_t dropped_{0};
+};
+
+/** Recording read back from a write() file; columns are by channel name. */
+struct TelemetryFile {
+    std::vector<std::string> channels;
+    std::vector<double> time;
+    std::vector<std::vector<float>> columns;
+    std::uint64_t steps{};
+    std::uint64_t dropped{};
+    std::uint32_t decimation{1};
+
+    /// Column of the named channel, or nullptr.
+    const std::vector<float>* column(std::string_view name) const;
+};
+
+/** Throws std::runtime_error for a missing, truncated or foreign file. */
+TelemetryFile read_telemetry(const std::string& path);
+
+} // namespace velox::telemetry
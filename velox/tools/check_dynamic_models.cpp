@@ -0,0 +1,155 @@
+// Regression check for the native STD and MB models at the ends of the speed range.
+//
+// Drives both models with both integrators from rest under constant acceleration and brakes
+// them from 15 m/s to rest, then holds them there. Fails when a model stalls on the way up
+// (the wheel-spin limit cycle of the blend region), does not come to rest, creeps off once
+// stopped, or when Dormand-Prince collapses its step at the locked-wheel clamp.
+//
+//   check_dynamic_models [--params parameters] [--vehicle 2]
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+
+#include "dynamic_simulator.hpp"
+#include "vehicle_parameter_cache.hpp"
+
+using namespace velox;
+
+namespace {
+
+constexpr double kDt = 0.01;
+constexpr double kLaunchAccel = 2.0;  // [m/s^2]
+constexpr double kLaunchTime = 3.0;   // [s]
+constexpr double kBrakeSpeed = 15.0;  // [m/s]
+constexpr double kBrakeAccel = -6.0;  // [m/s^2]
+constexpr double kBrakeLimit = 5.0;   // [s] to come to rest
+constexpr double kHoldTime = 1.0;     // [s] at rest afterwards
+constexpr double kRestSpeed = 0.1;    // [m/s]
+constexpr double kMaxMeanSubsteps = 50.0;
+
+struct Options {
+    std::string params;
+    int vehicle = 2;
+};
+
+Options parse_options(int argc, char** argv)
+{
+    Options o;
+    for (int i = 1; i < argc; ++i) {
+        const std::string arg = argv[i];
+        auto value = [&]() -> std::string {
+            if (i + 1 >= argc) throw std::invalid_argument("Missing value for " + arg);
+            return argv[++i];
+        };
+        if (arg == "--params") {
+            o.params = value();
+        } else if (arg == "--vehicle") {
+            o.vehicle = std::atoi(value().c_str());
+        } else {
+            throw std::invalid_argument("Unknown argument: " + arg);
+        }
+    }
+    return o;
+}
+
+struct Run {
+    std::size_t steps = 0;
+    std::size_t substeps = 0; // accepted + rejected Dormand-Prince attempts
+    bool hit_min_dt = false;
+
+    template <typename Sim>
+    void step(Sim& sim, double accel)
+    {
+        sim.step(0.0, accel);
+        ++steps;
+        substeps += sim.last_report().accepted + sim.last_report().rejected;
+        hit_min_dt = hit_min_dt || sim.last_report().hit_min_dt;
+    }
+
+    double mean_substeps() const { return steps ? static_cast<double>(substeps) / steps : 0.0; }
+};
+
+template <typename Sim>
+bool check_launch(Sim& sim, const char* name)
+{
+    const double rest[7] = {};
+    sim.reset(rest, 7);
+    Run run;
+    const auto n = static_cast<std::size_t>(std::lround(kLaunchTime / kDt));
+    for (std::size_t k = 0; k < n; ++k) run.step(sim, kLaunchAccel);
+
+    const double v = sim.state()[3];
+    const double ideal = kLaunchAccel * kLaunchTime;
+    bool ok = v >= 0.8 * ideal && v <= ideal + kRestSpeed;
+    if (sim.integrator() == simulation::Integrator::DormandPrince45) ok = ok && run.mean_substeps() <= kMaxMeanSubsteps;
+    std::printf("%-10s launch  v %6.3f m/s after %.1f s (ideal %.1f)  %5.1f substeps/step  %s\n", name, v,
+                kLaunchTime, ideal, run.mean_substeps(), ok ? "ok" : "FAIL");
+    return ok;
+}
+
+template <typename Sim>
+bool check_brake(Sim& sim, const char* name)
+{
+    const double moving[7] = {0.0, 0.0, 0.0, kBrakeSpeed, 0.0, 0.0, 0.0};
+    sim.reset(moving, 7);
+    Run run;
+    const auto limit = static_cast<std::size_t>(std::lround(kBrakeLimit / kDt));
+    while (run.steps < limit && sim.state()[3] > 0.5 * kRestSpeed) run.step(sim, kBrakeAccel);
+    const bool stopped = sim.state()[3] <= 0.5 * kRestSpeed;
+    const double stop_time = run.steps * kDt;
+
+    double creep = 0.0;
+    const auto hold = static_cast<std::size_t>(std::lround(kHoldTime / kDt));
+    for (std::size_t k = 0; k < hold; ++k) {
+        run.step(sim, 0.0);
+        creep = std::max(creep, std::abs(sim.state()[3]));
+    }
+
+    bool ok = stopped && creep <= kRestSpeed;
+    if (sim.integrator() == simulation::Integrator::DormandPrince45) {
+        ok = ok && !run.hit_min_dt && run.mean_substeps() <= kMaxMeanSubsteps;
+    }
+    std::printf("%-10s brake   rest after %.2f s, |v| <= %.3f m/s held  %5.1f substeps/step%s  %s\n", name,
+                stop_time, creep, run.mean_substeps(), run.hit_min_dt ? " (hit min_dt)" : "", ok ? "ok" : "FAIL");
+    return ok;
+}
+
+template <typename Sim>
+bool check_model(const models::VehicleParameters& params, const char* model)
+{
+    bool ok = true;
+    for (const auto integrator : {simulation::Integrator::Rk4, simulation::Integrator::DormandPrince45}) {
+        const std::string name =
+            std::string(model) + (integrator == simulation::Integrator::Rk4 ? " rk4" : " dp45");
+        Sim sim(params, kDt, integrator);
+        ok = check_launch(sim, name.c_str()) && ok;
+        ok = check_brake(sim, name.c_str()) && ok;
+    }
+    return ok;
+}
+
+} // anonymous namespace
+
+int main(int argc, char** argv)
+{
+    try {
+        const Options opt = parse_options(argc, argv);
+        const auto params = models::cached_vehicle_parameters(opt.vehicle, opt.params);
+
+        bool ok = check_model<simulation::StdSimulator>(*params, "std");
+        ok = check_model<simulation::MbSimulator>(*params, "mb") && ok;
+        if (!ok) {
+            std::cerr << "check_dynamic_models: vehicle " << opt.vehicle << " failed\n";
+            return 1;
+        }
+        return 0;
+    } catch (const std::exception& e) {
+        std::cerr << "check_dynamic_models: " << e.what() << '\n';
+        return 1;
+    }
+}
@@ -0,0 +1,82 @@
+// Compiles tracks/*.csv into the binary TrackIndex format (.vxtrk).
+//
+// Each CSV is paired into gates, indexed on a uniform grid and written next to the others in
+// the output directory, so rollouts can load a track with one read instead of re-deriving the
+// geometry. The playground scale (3.7) is applied unless --scale says otherwise.
+//
+//   compile_tracks [--tracks tracks] [--out tracks/compiled] [--scale 3.7] [--cell 0]
+
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+
+#include "track/track_index.hpp"
+
+namespace fs = std::filesystem;
+using namespace velox::track;
+
+namespace {
+
+struct Options {
+    std::string tracks = "tracks";
+    std::string out = "tracks/compiled";
+    TrackBuildOptions build{kPlaygroundTrackScale, 0.0, {}};
+};
+
+Options parse_options(int argc, char** argv)
+{
+    Options o;
+    for (int i = 1; i < argc; ++i) {
+        const std::string arg = argv[i];
+        auto value = [&]() -> std::string {
+            if (i + 1 >= argc) throw std::invalid_argument("Missing value for " + arg);
+            return argv[++i];
+        };
+        if (arg == "--tracks") {
+            o.tracks = value();
+        } else if (arg == "--out") {
+            o.out = value();
+        } else if (arg == "--scale") {
+            o.build.scale = std::atof(value().c_str());
+        } else if (arg == "--cell") {
+            o.build.cell_size = std::atof(value().c_str());
+        } else {
+            throw std::invalid_argument("Unknown argument: " + arg);
+        }
+    }
+    return o;
+}
+
+} // anonymous namespace
+
+int main(int argc, char** argv)
+{
+    try {
+        const Options opt = parse_options(argc, argv);
+        fs::create_directories(opt.out);
+
+        std::size_t compiled = 0;
+        for (const auto& entry : fs::directory_iterator(opt.tracks)) {
+            if (!entry.is_regular_file() || entry.path().extension() != ".csv") continue;
+
+            const TrackIndex track = TrackIndex::from_csv(entry.path().string(), opt.build);
+            const fs::path target = fs::path(opt.out) / entry.path().stem().concat(".vxtrk");
+            track.save_binary(target.string());
+
+            std::printf("%-40s %4zu cones %4zu gates %s %7zu bytes\n", entry.path().filename().string().c_str(),
+                        track.cones().size(), track.gates().size(), track.is_loop() ? "loop" : "open",
+                        track.memory_bytes());
+            ++compiled;
+        }
+        if (compiled == 0) {
+            throw std::runtime_error("No .csv tracks in " + opt.tracks);
+        }
+        return 0;
+    } catch (const std::exception& e) {
+        std::cerr << "compile_tracks: " << e.what() << '\n';
+        return 1;
+    }
+}
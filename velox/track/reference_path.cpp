@@ -0,0 +1,553 @@
+#include "reference_path.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstring>
+#include <limits>
+#include <map>
+#include <mutex>
+#include <shared_mutex>
+#include <stdexcept>
+#include <string>
+
+#include "models/vehicle_dynamics_st.hpp"
+
+namespace velox::track {
+
+namespace {
+
+constexpr double kMinSpacing = 0.2;  // kMinSpacing in path.ts
+constexpr double kMuCap = 1.6;       // resolveMu() cap in the baseline controller
+constexpr double kDefaultMu = 0.9;   // resolveMu() fallback
+constexpr double kEpsilon = 1e-6;
+constexpr double kPi = 3.14159265358979323846;
+
+double wrap_angle(double a)
+{
+    while (a > kPi) a -= 2.0 * kPi;
+    while (a <= -kPi) a += 2.0 * kPi;
+    return a;
+}
+
+// Menger curvature of three points (curvatureFromPoints in math.ts), unsigned.
+double menger_curvature(double x0, double y0, double x1, double y1, double x2, double y2)
+{
+    const double a = std::hypot(x1 - x0, y1 - y0);
+    const double b = std::hypot(x2 - x1, y2 - y1);
+    const double c = std::hypot(x2 - x0, y2 - y0);
+    const double area = std::abs(0.5 * (x0 * (y1 - y2) + x1 * (y2 - y0) + x2 * (y0 - y1)));
+    return 4.0 * area / std::max(a * b * c, kEpsilon);
+}
+
+// Longitudinal budget left inside the friction ellipse at speed v on curvature kappa.
+double available_accel(double v, double kappa, double cap, double lat_accel)
+{
+    const double ratio = v * v * std::abs(kappa) / lat_accel;
+    return cap * std::sqrt(std::max(0.0, 1.0 - ratio * ratio));
+}
+
+} // anonymous namespace
+
+SpeedLimits resolve_speed_limits(const models::VehicleParameters& vehicle, const SpeedProfileOptions& options)
+{
+    // resolveMu(): override, then the vehicle's own mu (p_dy1), then lat_accel_max / g, else 0.9
+    const double vehicle_mu = vehicle.tire.p_dy1;
+    double mu = kDefaultMu;
+    if (options.mu > 0.0) {
+        mu = std::min(options.mu, kMuCap);
+    } else if (std::isfinite(vehicle_mu) && vehicle_mu > 0.0) {
+        mu = std::min(vehicle_mu, kMuCap);
+    } else if (options.lat_accel_max > 0.0) {
+        mu = std::min(options.lat_accel_max / models::kGravity, kMuCap);
+    }
+
+    SpeedLimits limits;
+    limits.lat_accel         = std::max(mu * options.risk_scale, 1e-3) * models::kGravity;
+    limits.accel             = options.accel_max > 0.0 ? options.accel_max : vehicle.longitudinal.a_max;
+    limits.brake             = options.brake_max > 0.0 ? options.brake_max : vehicle.longitudinal.a_max;
+    limits.min_speed         = options.min_speed;
+    limits.max_speed         = options.max_speed;
+    limits.curvature_epsilon = options.curvature_epsilon;
+    limits.start_speed       = options.start_speed;
+    return limits;
+}
+
+ReferencePath::ReferencePath(const TrackIndex& track, const SpeedLimits& limits, const ReferencePathOptions& options)
+    : limits_(limits)
+    , loop_(track.is_loop())
+{
+    if (!(limits.lat_accel > 0.0) || !(limits.accel > 0.0) || !(limits.brake > 0.0) ||
+        !(limits.max_speed > 0.0) || limits.min_speed < 0.0 || limits.min_speed > limits.max_speed ||
+        !(limits.curvature_epsilon > 0.0) || limits.start_speed < 0.0) {
+        throw std::invalid_argument("ReferencePath requires positive speed limits");
+    }
+
+    // orderedCheckpoints(): gate mid-points, else the cones, else a short straight
+    std::vector<double> xs;
+    std::vector<double> ys;
+    for (const Gate& g : track.gates()) {
+        xs.push_back(0.5 * (double(g.ax) + g.bx));
+        ys.push_back(0.5 * (double(g.ay) + g.by));
+    }
+    if (xs.empty()) {
+        for (const Cone& c : track.cones()) {
+            xs.push_back(c.x);
+            ys.push_back(c.y);
+        }
+    }
+    if (xs.size() < 2) {
+        loop_ = false;
+        xs = {0.0, 5.0};
+        ys = {0.0, 0.0};
+    }
+
+    resample(xs, ys, std::max(options.spacing, kMinSpacing));
+    if (s_.size() < std::max<std::size_t>(options.min_points, 2)) {
+        // too coarse to resample: keep the raw points (and close the loop explicitly)
+        x_ = xs;
+        y_ = ys;
+        if (loop_) {
+            x_.push_back(xs.front());
+            y_.push_back(ys.front());
+        }
+        s_.assign(x_.size(), 0.0);
+        for (std::size_t i = 1; i < x_.size(); ++i) {
+            s_[i] = s_[i - 1] + std::hypot(x_[i] - x_[i - 1], y_[i] - y_[i - 1]);
+        }
+    }
+    length_ = s_.back();
+    for (std::size_t i = 1; i < s_.size(); ++i) max_segment_ = std::max(max_segment_, s_[i] - s_[i - 1]);
+
+    const std::size_t n = s_.size();
+    heading_.resize(n);
+    for (std::size_t i = 0; i < n; ++i) {
+        const std::size_t a = i + 1 < n ? i : i - 1;
+        heading_[i] = std::atan2(y_[a + 1] - y_[a], x_[a + 1] - x_[a]);
+    }
+    compute_curvature(options.curvature_smoothing);
+    compute_speed_profile();
+    build_tree();
+}
+
+void ReferencePath::resample(const std::vector<double>& xs, const std::vector<double>& ys, double spacing)
+{
+    // resample() in path.ts: equal spacing along the polyline, the corners themselves dropped
+    std::vector<double> bx = xs;
+    std::vector<double> by = ys;
+    if (loop_) {
+        bx.push_back(xs.front());
+        by.push_back(ys.front());
+    }
+
+    x_.assign(1, bx[0]);
+    y_.assign(1, by[0]);
+    double lx = bx[0];
+    double ly = by[0];
+    double carry = 0.0;
+    for (std::size_t i = 1; i < bx.size(); ++i) {
+        double seg = std::hypot(bx[i] - lx, by[i] - ly);
+        if (seg < kEpsilon) continue;
+        double remaining = seg;
+        while (remaining + carry >= spacing) {
+            const double step = spacing - carry;
+            const double dx = (bx[i] - lx) / seg;
+            const double dy = (by[i] - ly) / seg;
+            lx += dx * step;
+            ly += dy * step;
+            x_.push_back(lx);
+            y_.push_back(ly);
+            remaining -= step;
+            carry = 0.0;
+            seg = std::hypot(bx[i] - lx, by[i] - ly);
+            if (seg < kEpsilon) break;
+        }
+        carry += remaining;
+        lx = bx[i];
+        ly = by[i];
+    }
+
+    const double tail_x = loop_ ? xs.front() : xs.back();
+    const double tail_y = loop_ ? ys.front() : ys.back();
+    const double gap = std::hypot(x_.back() - tail_x, y_.back() - tail_y);
+    if (loop_) {
+        // closed paths end exactly on the first sample so that s wraps at length()
+        if (gap <= spacing * 0.2 && x_.size() > 1) {
+            x_.back() = tail_x;
+            y_.back() = tail_y;
+        } else {
+            x_.push_back(tail_x);
+            y_.push_back(tail_y);
+        }
+    } else if (gap > spacing * 0.1) {
+        x_.push_back(tail_x);
+        y_.push_back(tail_y);
+    }
+
+    s_.assign(x_.size(), 0.0);
+    for (std::size_t i = 1; i < x_.size(); ++i) {
+        s_[i] = s_[i - 1] + std::hypot(x_[i] - x_[i - 1], y_[i] - y_[i - 1]);
+    }
+}
+
+void ReferencePath::compute_curvature(std::size_t smoothing)
+{
+    const std::size_t n = s_.size();
+    // unique samples: a closed path's last sample repeats the first
+    const std::size_t m = loop_ ? n - 1 : n;
+    std::vector<double> raw(n, 0.0);
+    for (std::size_t i = 0; i < m && m >= 3; ++i) {
+        const std::size_t p = i == 0 ? (loop_ ? m - 1 : 0) : i - 1;
+        const std::size_t q = i == m - 1 ? (loop_ ? 0 : m - 1) : i + 1;
+        const double k = menger_curvature(x_[p], y_[p], x_[i], y_[i], x_[q], y_[q]);
+        const double cross = (x_[i] - x_[p]) * (y_[q] - y_[i]) - (y_[i] - y_[p]) * (x_[q] - x_[i]);
+        raw[i] = cross < 0.0 ? -k : k;
+    }
+
+    curvature_ = raw;
+    if (smoothing > 1 && m > 0) {
+        const long half = std::max<long>(1, static_cast<long>(smoothing / 2));
+        const long count = static_cast<long>(m);
+        for (long i = 0; i < count; ++i) {
+            double sum = 0.0;
+            int used = 0;
+            for (long k = -half; k <= half; ++k) {
+                long j = i + k;
+                if (loop_) j = ((j % count) + count) % count;
+                if (j < 0 || j >= count) continue;
+                sum += raw[static_cast<std::size_t>(j)];
+                ++used;
+            }
+            curvature_[static_cast<std::size_t>(i)] = sum / used;
+        }
+    }
+    if (loop_) curvature_[n - 1] = curvature_[0];
+}
+
+void ReferencePath::compute_speed_profile()
+{
+    const std::size_t n = s_.size();
+    const SpeedLimits& l = limits_;
+    curvature_limit_.resize(n);
+    for (std::size_t i = 0; i < n; ++i) {
+        const double v = std::sqrt(l.lat_accel / (std::abs(curvature_[i]) + l.curvature_epsilon));
+        curvature_limit_[i] = std::clamp(v, l.min_speed, l.max_speed);
+    }
+    speed_ = curvature_limit_;
+    if (n < 2) return;
+
+    const std::size_t segments = n - 1;
+    const auto ds = [this](std::size_t i) { return s_[i + 1] - s_[i]; };
+
+    if (!loop_) {
+        speed_[0] = std::min(speed_[0], l.start_speed);
+        for (std::size_t i = 0; i < segments; ++i) {
+            const double a = available_accel(speed_[i], curvature_[i], l.accel, l.lat_accel);
+            speed_[i + 1] = std::min(speed_[i + 1], std::sqrt(speed_[i] * speed_[i] + 2.0 * a * ds(i)));
+        }
+        for (std::size_t i = segments; i-- > 0;) {
+            const double b = available_accel(speed_[i + 1], curvature_[i + 1], l.brake, l.lat_accel);
+            speed_[i] = std::min(speed_[i], std::sqrt(speed_[i + 1] * speed_[i + 1] + 2.0 * b * ds(i)));
+        }
+        return;
+    }
+
+    // Closed path: sample n-1 is sample 0. Two laps per pass let the limits wrap through s = 0.
+    std::vector<double>& v = speed_;
+    for (std::size_t k = 0; k < 2 * segments; ++k) {
+        const std::size_t i = k % segments;
+        const double a = available_accel(v[i], curvature_[i], l.accel, l.lat_accel);
+        const double next = std::sqrt(v[i] * v[i] + 2.0 * a * ds(i));
+        const std::size_t j = (i + 1) % segments;
+        v[j] = std::min(v[j], next);
+    }
+    for (std::size_t k = 0; k < 2 * segments; ++k) {
+        const std::size_t i = segments - 1 - (k % segments); // segment i runs from i to i + 1
+        const std::size_t j = (i + 1) % segments;
+        const double b = available_accel(v[j], curvature_[j], l.brake, l.lat_accel);
+        v[i] = std::min(v[i], std::sqrt(v[j] * v[j] + 2.0 * b * ds(i)));
+    }
+    v[n - 1] = v[0];
+}
+
+void ReferencePath::build_tree()
+{
+    const std::size_t m = loop_ ? s_.size() - 1 : s_.size();
+    tree_.resize(m);
+    for (std::size_t i = 0; i < m; ++i) tree_[i] = static_cast<std::uint32_t>(i);
+
+    // median split on x at even depths and y at odd ones; node of [lo, hi) sits at its middle
+    const auto build = [this](auto&& self, std::size_t lo, std::size_t hi, int depth) -> void {
+        if (hi - lo < 2) return;
+        const std::size_t mid = lo + (hi - lo) / 2;
+        const std::vector<double>& key = depth % 2 == 0 ? x_ : y_;
+        std::nth_element(tree_.begin() + static_cast<std::ptrdiff_t>(lo),
+                         tree_.begin() + static_cast<std::ptrdiff_t>(mid),
+                         tree_.begin() + static_cast<std::ptrdiff_t>(hi),
+                         [&key](std::uint32_t a, std::uint32_t b) { return key[a] < key[b]; });
+        self(self, lo, mid, depth + 1);
+        self(self, mid + 1, hi, depth + 1);
+    };
+    build(build, 0, m, 0);
+}
+
+std::size_t ReferencePath::nearest_sample(double x, double y) const
+{
+    std::size_t best = 0;
+    double best_d2 = std::numeric_limits<double>::infinity();
+    const auto search = [&](auto&& self, std::size_t lo, std::size_t hi, int depth) -> void {
+        if (lo >= hi) return;
+        const std::size_t mid = lo + (hi - lo) / 2;
+        const std::uint32_t i = tree_[mid];
+        const double dx = x - x_[i];
+        const double dy = y - y_[i];
+        const double d2 = dx * dx + dy * dy;
+        if (d2 < best_d2) {
+            best_d2 = d2;
+            best = i;
+        }
+        const double split = depth % 2 == 0 ? dx : dy;
+        if (split < 0.0) {
+            self(self, lo, mid, depth + 1);
+            if (split * split < best_d2) self(self, mid + 1, hi, depth + 1);
+        } else {
+            self(self, mid + 1, hi, depth + 1);
+            if (split * split < best_d2) self(self, lo, mid, depth + 1);
+        }
+    };
+    search(search, 0, tree_.size(), 0);
+    return best;
+}
+
+template <typename Visit>
+void ReferencePath::samples_within(double x, double y, double radius, Visit&& visit) const
+{
+    const double r2 = radius * radius;
+    const auto search = [&](auto&& self, std::size_t lo, std::size_t hi, int depth) -> void {
+        if (lo >= hi) return;
+        const std::size_t mid = lo + (hi - lo) / 2;
+        const std::uint32_t i = tree_[mid];
+        const double dx = x - x_[i];
+        const double dy = y - y_[i];
+        if (dx * dx + dy * dy <= r2) visit(i);
+        const double split = depth % 2 == 0 ? dx : dy;
+        if (split <= radius) self(self, lo, mid, depth + 1);
+        if (split >= -radius) self(self, mid + 1, hi, depth + 1);
+    };
+    search(search, 0, tree_.size(), 0);
+}
+
+PathProjection ReferencePath::project_segment(std::size_t segment, double x, double y) const
+{
+    const std::size_t a = segment;
+    const std::size_t b = segment + 1;
+    const double dx = x_[b] - x_[a];
+    const double dy = y_[b] - y_[a];
+    const double len2 = std::max(dx * dx + dy * dy, 1e-9);
+    const double t = std::clamp(((x - x_[a]) * dx + (y - y_[a]) * dy) / len2, 0.0, 1.0);
+
+    PathProjection p;
+    p.segment   = segment;
+    p.x         = x_[a] + dx * t;
+    p.y         = y_[a] + dy * t;
+    p.s         = s_[a] + (s_[b] - s_[a]) * t;
+    p.heading   = std::atan2(dy, dx);
+    p.curvature = curvature_[a] + (curvature_[b] - curvature_[a]) * t;
+    p.distance  = std::hypot(x - p.x, y - p.y);
+    p.lateral   = (dx * (y - y_[a]) - dy * (x - x_[a])) < 0.0 ? -p.distance : p.distance;
+    if (loop_ && p.s >= length_) p.s -= length_;
+    return p;
+}
+
+PathProjection ReferencePath::refine(std::size_t segment, double x, double y) const
+{
+    // Walk to the locally closest segment; on a closed path the walk wraps through s = 0.
+    const std::size_t segments = segment_count();
+    PathProjection best = project_segment(segment, x, y);
+    for (std::size_t steps = 0; steps < segments; ++steps) {
+        const std::size_t prev = segment > 0 ? segment - 1 : (loop_ ? segments - 1 : segment);
+        const std::size_t next = segment + 1 < segments ? segment + 1 : (loop_ ? 0 : segment);
+        const PathProjection p = project_segment(prev, x, y);
+        const PathProjection q = project_segment(next, x, y);
+        if (p.distance < best.distance && p.distance <= q.distance) {
+            best = p;
+            segment = prev;
+        } else if (q.distance < best.distance) {
+            best = q;
+            segment = next;
+        } else {
+            break;
+        }
+    }
+    return best;
+}
+
+std::size_t ReferencePath::locate(double s) const
+{
+    const auto it = std::upper_bound(s_.begin(), s_.end(), s);
+    const std::size_t i = it == s_.begin() ? 0 : static_cast<std::size_t>(it - s_.begin()) - 1;
+    return std::min(i, segment_count() - 1);
+}
+
+PathProjection ReferencePath::project(double x, double y, double hint) const
+{
+    if (hint >= 0.0) {
+        Cursor cursor{locate(loop_ ? std::fmod(hint, length_) : hint), true};
+        return project(x, y, cursor);
+    }
+    // The closest point of any segment is within half a segment of one of its end samples, so
+    // every candidate segment touches a sample within d + max_segment / 2 of the query, where d
+    // is the nearest-sample distance.
+    const std::size_t segments = segment_count();
+    const std::size_t last = loop_ ? segments : segments + 1;
+    const std::size_t nearest = nearest_sample(x, y);
+    const double d = std::hypot(x - x_[nearest], y - y_[nearest]);
+    PathProjection best;
+    best.distance = std::numeric_limits<double>::infinity();
+    samples_within(x, y, d + 0.5 * max_segment_, [&](std::size_t i) {
+        if (i < segments) {
+            const PathProjection p = project_segment(i, x, y);
+            if (p.distance < best.distance) best = p;
+        }
+        const std::size_t prev = i > 0 ? i - 1 : (loop_ ? segments - 1 : last);
+        if (prev < segments) {
+            const PathProjection p = project_segment(prev, x, y);
+            if (p.distance < best.distance) best = p;
+        }
+    });
+    return best;
+}
+
+PathProjection ReferencePath::project(double x, double y, Cursor& cursor) const
+{
+    PathProjection p;
+    if (cursor.valid && cursor.segment < segment_count()) {
+        p = refine(cursor.segment, x, y);
+        // a jump or a wrong local minimum: confirm with the global search
+        if (p.distance > std::max(2.0, 4.0 * (length_ / static_cast<double>(segment_count())))) {
+            const PathProjection global = project(x, y);
+            if (global.distance < p.distance) p = global;
+        }
+    } else {
+        p = project(x, y);
+    }
+    cursor.segment = p.segment;
+    cursor.valid = true;
+    return p;
+}
+
+PathSample ReferencePath::sample(double s) const
+{
+    if (loop_) {
+        s = std::fmod(s, length_);
+        if (s < 0.0) s += length_;
+    } else {
+        s = std::clamp(s, 0.0, length_);
+    }
+    const std::size_t a = locate(s);
+    const std::size_t b = a + 1;
+    const double t = std::clamp((s - s_[a]) / std::max(s_[b] - s_[a], 1e-9), 0.0, 1.0);
+
+    PathSample out;
+    out.s         = s;
+    out.x         = x_[a] + (x_[b] - x_[a]) * t;
+    out.y         = y_[a] + (y_[b] - y_[a]) * t;
+    out.heading   = wrap_angle(heading_[a] + wrap_angle(heading_[b] - heading_[a]) * t);
+    out.curvature = curvature_[a] + (curvature_[b] - curvature_[a]) * t;
+    out.speed     = speed_[a] + (speed_[b] - speed_[a]) * t;
+    return out;
+}
+
+std::size_t ReferencePath::memory_bytes() const noexcept
+{
+    return (s_.size() + x_.size() + y_.size() + heading_.size() + curvature_.size() +
+            curvature_limit_.size() + speed_.size()) * sizeof(double) +
+           tree_.size() * sizeof(std::uint32_t);
+}
+
+namespace {
+
+struct PathCache {
+    std::shared_mutex mutex;
+    std::map<std::string, std::shared_ptr<const ReferencePath>> entries;
+    std::atomic<std::uint64_t> hits{0};
+    std::atomic<std::uint64_t> misses{0};
+};
+
+PathCache& path_cache()
+{
+    static PathCache instance;
+    return instance;
+}
+
+// The path depends on the gate geometry, the loop flag, the resolved limits and the options;
+// tracks without gates also depend on their cones.
+std::string path_key(const TrackIndex& track, const SpeedLimits& l, const ReferencePathOptions& o)
+{
+    const double scalars[] = {track.is_loop() ? 1.0 : 0.0, l.lat_accel, l.accel, l.brake, l.min_speed,
+                              l.max_speed, l.curvature_epsilon, l.start_speed, o.spacing,
+                              static_cast<double>(o.min_points), static_cast<double>(o.curvature_smoothing)};
+    const std::size_t gate_bytes = track.gates().size() * sizeof(Gate);
+    std::string key(sizeof(scalars) + gate_bytes, '\0');
+    std::memcpy(key.data(), scalars, sizeof(scalars));
+    if (gate_bytes) std::memcpy(key.data() + sizeof(scalars), track.gates().data(), gate_bytes);
+    if (track.gates().empty()) {
+        for (const Cone& c : track.cones()) {
+            const float xy[2] = {c.x, c.y};
+            key.append(reinterpret_cast<const char*>(xy), sizeof(xy));
+        }
+    }
+    return key;
+}
+
+} // anonymous namespace
+
+std::shared_ptr<const ReferencePath> cached_reference_path(const TrackIndex& track,
+                                                           const models::VehicleParameters& vehicle,
+                                                           const SpeedProfileOptions& style,
+                                                           const ReferencePathOptions& options)
+{
+    const SpeedLimits limits = resolve_speed_limits(vehicle, style);
+    PathCache& c = path_cache();
+    std::string key = path_key(track, limits, options);
+    {
+        std::shared_lock lock(c.mutex);
+        auto it = c.entries.find(key);
+        if (it != c.entries.end()) {
+            c.hits.fetch_add(1, std::memory_order_relaxed);
+            return it->second;
+        }
+    }
+
+    // Build outside the lock; the first path published for a key wins.
+    c.misses.fetch_add(1, std::memory_order_relaxed);
+    auto path = std::make_shared<const ReferencePath>(track, limits, options);
+
+    std::unique_lock lock(c.mutex);
+    auto [it, inserted] = c.entries.emplace(std::move(key), std::move(path));
+    return it->second;
+}
+
+ReferencePathCacheStats reference_path_cache_stats()
+{
+    PathCache& c = path_cache();
+    ReferencePathCacheStats stats;
+    stats.hits   = c.hits.load(std::memory_order_relaxed);
+    stats.misses = c.misses.load(std::memory_order_relaxed);
+    {
+        std::shared_lock lock(c.mutex);
+        stats.entries = c.entries.size();
+    }
+    return stats;
+}
+
+void clear_reference_path_cache()
+{
+    PathCache& c = path_cache();
+    std::unique_lock lock(c.mutex);
+    c.entries.clear();
+    c.hits.store(0, std::memory_order_relaxed);
+    c.misses.store(0, std::memory_order_relaxed);
+}
+
+} // namespace velox::track
@@ -0,0 +1,181 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "track_index.hpp"
+#include "vehicle_parameters.hpp"
+
+namespace velox::track {
+
+/** Centre-line sampling, as PathOptions in controllers/baseline/path.ts. */
+struct ReferencePathOptions {
+    double spacing = 0.8;                 // resample distance [m], at least 0.2
+    std::size_t min_points = 6;           // fewer resampled points keep the raw gate midpoints
+    std::size_t curvature_smoothing = 5;  // moving-average window over the curvature samples
+
+    bool operator==(const ReferencePathOptions&) const = default;
+};
+
+/**
+ * Speed-profile inputs of one vehicle and style preset. Zero means "take it from the vehicle".
+ * mu resolves like resolveMu() in the baseline controller: this override, then the vehicle's
+ * tire.p_dy1, then lat_accel_max / g, then 0.9, each capped at 1.6. The acceleration limits
+ * fall back to longitudinal.a_max.
+ */
+struct SpeedProfileOptions {
+    double mu = 0.0;
+    double lat_accel_max = 0.0;      // the vehicle's lat_accel_max; used when neither mu is set
+    double risk_scale = 1.0;         // style risk, lerp(0.85, 1.15, risk) in the style-param controller
+    double min_speed = 0.5;          // [m/s]
+    double max_speed = 32.0;         // [m/s]
+    double curvature_epsilon = 1e-3; // [1/m]
+    double accel_max = 0.0;          // [m/s^2]
+    double brake_max = 0.0;          // [m/s^2], positive
+    double start_speed = 0.0;        // [m/s] at s = 0 of an open path
+
+    bool operator==(const SpeedProfileOptions&) const = default;
+};
+
+/** Fully resolved speed-profile limits; what the profile (and the cache key) depend on. */
+struct SpeedLimits {
+    double lat_accel = 0.0; // effective mu * g [m/s^2]
+    double accel = 0.0;
+    double brake = 0.0;
+    double min_speed = 0.0;
+    double max_speed = 0.0;
+    double curvature_epsilon = 0.0;
+    double start_speed = 0.0;
+
+    bool operator==(const SpeedLimits&) const = default;
+};
+
+SpeedLimits resolve_speed_limits(const models::VehicleParameters& vehicle, const SpeedProfileOptions& options = {});
+
+struct PathProjection {
+    double s = 0.0;          // arc length of the closest point [m]
+    double x = 0.0;
+    double y = 0.0;
+    double heading = 0.0;    // of the closest segment [rad]
+    double curvature = 0.0;  // interpolated [1/m], positive to the left
+    double lateral = 0.0;    // signed offset of the query point, positive to the left [m]
+    double distance = 0.0;   // |lateral| up to the segment end caps [m]
+    std::size_t segment = 0; // index of the segment start sample
+};
+
+struct PathSample {
+    double s = 0.0;
+    double x = 0.0;
+    double y = 0.0;
+    double heading = 0.0;
+    double curvature = 0.0;
+    double speed = 0.0;      // speed profile [m/s]
+};
+
+/**
+ * ReferencePath
+ *
+ * Arc-length parameterised centre line of a TrackIndex (gate mid-points in order), resampled
+ * and with signed, smoothed curvature as buildPath() in controllers/baseline/path.ts, except at
+ * the closure of a loop: this one always ends on the first sample, so length() is the whole lap
+ * and s wraps there. Where path.ts appends the start only when the last resampled point is more
+ * than 0.2 spacing away from it (its closing segment is implicit), the last point is moved onto
+ * the start instead, and a loop too coarse to resample is closed the same way. Open paths match.
+ * On top of the curvature limit sqrt(lat_accel / (|kappa| + eps)) it stores the speed profile
+ * after a forward (acceleration) and a backward (braking) pass, both inside the friction
+ * ellipse; closed paths run each pass over two laps so the profile is periodic.
+ *
+ * Samples live in contiguous per-field arrays. project() without a hint is an exact k-d tree
+ * search, O(log n) for points near the path; with the previous s as hint, or through a Cursor,
+ * it walks from the last segment to the locally closest one and costs O(1) per step.
+ *
+ * Immutable after construction; safe to share between threads.
+ */
+class ReferencePath {
+public:
+    /// Throws std::invalid_argument for non-positive limits.
+    ReferencePath(const TrackIndex& track, const SpeedLimits& limits, const ReferencePathOptions& options = {});
+
+    std::size_t size() const noexcept { return s_.size(); }
+    double length() const noexcept { return length_; }
+    bool closed() const noexcept { return loop_; }
+    const SpeedLimits& limits() const noexcept { return limits_; }
+
+    // sample columns, index = sample; closed paths repeat the first point at s = length()
+    const std::vector<double>& s() const noexcept { return s_; }
+    const std::vector<double>& x() const noexcept { return x_; }
+    const std::vector<double>& y() const noexcept { return y_; }
+    const std::vector<double>& heading() const noexcept { return heading_; }
+    const std::vector<double>& curvature() const noexcept { return curvature_; }
+    const std::vector<double>& curvature_limit() const noexcept { return curvature_limit_; }
+    const std::vector<double>& speed() const noexcept { return speed_; }
+
+    /// Interpolated sample at arc length s (wrapped on closed paths, clamped on open ones).
+    PathSample sample(double s) const;
+
+    /// Closest point; hint < 0 searches globally, otherwise warm-starts from the segment at hint.
+    PathProjection project(double x, double y, double hint = -1.0) const;
+
+    /// Warm-start handle for per-step projection; segment is kept between calls.
+    struct Cursor {
+        std::size_t segment = 0;
+        bool valid = false;
+    };
+    PathProjection project(double x, double y, Cursor& cursor) const;
+
+    std::size_t memory_bytes() const noexcept;
+
+private:
+    void resample(const std::vector<double>& xs, const std::vector<double>& ys, double spacing);
+    void compute_curvature(std::size_t smoothing);
+    void compute_speed_profile();
+    void build_tree();
+
+    std::size_t segment_count() const noexcept { return s_.size() < 2 ? 0 : s_.size() - 1; }
+    std::size_t locate(double s) const;
+    std::size_t nearest_sample(double x, double y) const;
+    template <typename Visit>
+    void samples_within(double x, double y, double radius, Visit&& visit) const;
+    PathProjection project_segment(std::size_t segment, double x, double y) const;
+    PathProjection refine(std::size_t segment, double x, double y) const;
+
+    SpeedLimits limits_;
+    bool loop_{false};
+    double length_{0.0};
+    double max_segment_{0.0};
+    std::vector<double> s_;
+    std::vector<double> x_;
+    std::vector<double> y_;
+    std::vector<double> heading_;
+    std::vector<double> curvature_;
+    std::vector<double> curvature_limit_;
+    std::vector<double> speed_;
+    std::vector<std::uint32_t> tree_; // implicit k-d tree over sample indices
+};
+
+/**
+ * cached_reference_path
+ *
+ * Process-wide cache of reference paths keyed by track geometry, resolved speed limits and
+ * path options, so every rollout of one (track, vehicle, style preset) shares a single build.
+ * Vehicles with the same friction and acceleration limits share entries. Entries live until
+ * clear_reference_path_cache().
+ */
+std::shared_ptr<const ReferencePath> cached_reference_path(const TrackIndex& track,
+                                                           const models::VehicleParameters& vehicle,
+                                                           const SpeedProfileOptions& style = {},
+                                                           const ReferencePathOptions& options = {});
+
+struct ReferencePathCacheStats {
+    std::uint64_t hits{};
+    std::uint64_t misses{};
+    std::size_t   entries{};
+};
+
+ReferencePathCacheStats reference_path_cache_stats();
+
+void clear_reference_path_cache();
+
+} // namespace velox::track
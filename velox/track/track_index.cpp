@@ -0,0 +1,778 @@
+#include "track_index.hpp"
+
+#include <algorithm>
+#include <charconv>
+#include <cmath>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <limits>
+#include <map>
+#include <stdexcept>
+#include <system_error>
+#include <type_traits>
+
+namespace velox::track {
+
+namespace {
+
+constexpr double kEmptyTrackSpan = 60.0;   // EMPTY_TRACK_SPAN in loadTracks.ts
+constexpr std::size_t kGridMargin = 4;     // cells around the cone bounds
+constexpr std::size_t kMaxCells = 1u << 20;
+constexpr std::uint32_t kFileVersion = 1;
+constexpr char kFileMagic[8] = {'V', 'X', 'T', 'R', 'A', 'C', 'K', '\0'};
+
+struct FileHeader {
+    char magic[8];
+    std::uint32_t version;
+    std::uint32_t loop;
+    std::uint64_t cones;
+    std::uint64_t gates;
+    std::uint64_t segments;
+    std::uint64_t nx;
+    std::uint64_t ny;
+    std::uint64_t gate_items;
+    std::uint64_t quad_items;
+    std::uint64_t boundary_items;
+    double origin_x;
+    double origin_y;
+    double cell_size;
+    TrackBounds bounds;
+    StartPose start;
+};
+
+static_assert(std::is_trivially_copyable_v<Cone> && std::is_trivially_copyable_v<Gate> &&
+              std::is_trivially_copyable_v<BoundarySegment> && std::is_trivially_copyable_v<FileHeader>,
+              "track arrays are written verbatim");
+
+struct Point {
+    double x;
+    double y;
+};
+
+std::string_view trim(std::string_view s)
+{
+    while (!s.empty() && (s.front() == ' ' || s.front() == '\t' || s.front() == '\r')) s.remove_prefix(1);
+    while (!s.empty() && (s.back() == ' ' || s.back() == '\t' || s.back() == '\r')) s.remove_suffix(1);
+    return s;
+}
+
+std::string lower(std::string_view s)
+{
+    std::string out(s);
+    for (char& c : out) {
+        if (c >= 'A' && c <= 'Z') c = static_cast<char>(c - 'A' + 'a');
+    }
+    return out;
+}
+
+ConeTag parse_tag(std::string_view text)
+{
+    const std::string tag = lower(text);
+    if (tag == "blue") return ConeTag::Blue;
+    if (tag == "yellow") return ConeTag::Yellow;
+    if (tag == "orange") return ConeTag::Orange;
+    if (tag == "big_orange") return ConeTag::BigOrange;
+    if (tag == "car_start") return ConeTag::CarStart;
+    return ConeTag::Unknown;
+}
+
+float parse_column(std::string_view text, std::size_t line, const char* column)
+{
+    text = trim(text);
+    if (!text.empty() && text.front() == '+') text.remove_prefix(1);
+    double value = 0.0;
+    const auto [ptr, ec] = std::from_chars(text.data(), text.data() + text.size(), value);
+    if (text.empty() || ec != std::errc{} || ptr != text.data() + text.size() || !std::isfinite(value)) {
+        throw std::runtime_error("Track CSV line " + std::to_string(line) + ": " + column +
+                                 " is not a finite number ('" + std::string(text) + "')");
+    }
+    return static_cast<float>(value);
+}
+
+double cross(double ax, double ay, double bx, double by)
+{
+    return ax * by - ay * bx;
+}
+
+double point_segment_distance(double px, double py, double ax, double ay, double bx, double by)
+{
+    const double dx = bx - ax;
+    const double dy = by - ay;
+    const double len2 = dx * dx + dy * dy;
+    double t = len2 > 0.0 ? ((px - ax) * dx + (py - ay) * dy) / len2 : 0.0;
+    t = std::clamp(t, 0.0, 1.0);
+    return std::hypot(px - (ax + t * dx), py - (ay + t * dy));
+}
+
+double segment_distance(double px, double py, const BoundarySegment& s)
+{
+    return point_segment_distance(px, py, s.ax, s.ay, s.bx, s.by);
+}
+
+bool segments_intersect(Point p0, Point p1, Point q0, Point q1)
+{
+    const double d1 = cross(q1.x - q0.x, q1.y - q0.y, p0.x - q0.x, p0.y - q0.y);
+    const double d2 = cross(q1.x - q0.x, q1.y - q0.y, p1.x - q0.x, p1.y - q0.y);
+    const double d3 = cross(p1.x - p0.x, p1.y - p0.y, q0.x - p0.x, q0.y - p0.y);
+    const double d4 = cross(p1.x - p0.x, p1.y - p0.y, q1.x - p0.x, q1.y - p0.y);
+    return ((d1 <= 0.0 && d2 >= 0.0) || (d1 >= 0.0 && d2 <= 0.0)) &&
+           ((d3 <= 0.0 && d4 >= 0.0) || (d3 >= 0.0 && d4 <= 0.0));
+}
+
+// Smallest distance between an axis-aligned rectangle and a segment.
+double rect_segment_distance(double x0, double y0, double x1, double y1, const BoundarySegment& s)
+{
+    const auto inside = [&](double x, double y) { return x >= x0 && x <= x1 && y >= y0 && y <= y1; };
+    if (inside(s.ax, s.ay) || inside(s.bx, s.by)) return 0.0;
+
+    const Point corners[4] = {{x0, y0}, {x1, y0}, {x1, y1}, {x0, y1}};
+    const Point a{s.ax, s.ay};
+    const Point b{s.bx, s.by};
+    double best = std::numeric_limits<double>::infinity();
+    for (int i = 0; i < 4; ++i) {
+        const Point& c = corners[i];
+        const Point& d = corners[(i + 1) % 4];
+        if (segments_intersect(a, b, c, d)) return 0.0;
+        best = std::min(best, point_segment_distance(c.x, c.y, a.x, a.y, b.x, b.y));
+        best = std::min(best, point_segment_distance(a.x, a.y, c.x, c.y, d.x, d.y));
+        best = std::min(best, point_segment_distance(b.x, b.y, c.x, c.y, d.x, d.y));
+    }
+    return best;
+}
+
+// Largest distance from any point of the rectangle to the segment; distance to a segment is
+// convex, so the maximum sits on a corner.
+double rect_segment_max_distance(double x0, double y0, double x1, double y1, const BoundarySegment& s)
+{
+    return std::max({segment_distance(x0, y0, s), segment_distance(x1, y0, s),
+                     segment_distance(x1, y1, s), segment_distance(x0, y1, s)});
+}
+
+double median_spacing(const std::vector<Cone>& cones, const std::vector<std::size_t>& chain)
+{
+    std::vector<double> gaps;
+    for (std::size_t i = 1; i < chain.size(); ++i) {
+        gaps.push_back(std::hypot(double(cones[chain[i]].x) - cones[chain[i - 1]].x,
+                                  double(cones[chain[i]].y) - cones[chain[i - 1]].y));
+    }
+    if (gaps.empty()) return 0.0;
+    std::nth_element(gaps.begin(), gaps.begin() + static_cast<std::ptrdiff_t>(gaps.size() / 2), gaps.end());
+    return gaps[gaps.size() / 2];
+}
+
+double end_gap(const std::vector<Cone>& cones, const std::vector<std::size_t>& chain)
+{
+    const Cone& a = cones[chain.front()];
+    const Cone& b = cones[chain.back()];
+    return std::hypot(double(a.x) - b.x, double(a.y) - b.y);
+}
+
+// A cone chain is closed when its ends are no further apart than twice its median spacing. Some
+// layouts repeat the first cone at the end; that copy is dropped so it cannot be paired.
+bool close_chain(const std::vector<Cone>& cones, std::vector<std::size_t>& chain)
+{
+    if (chain.size() < 3) return false;
+    const double spacing = median_spacing(cones, chain);
+    if (end_gap(cones, chain) > 2.0 * spacing) return false;
+    if (end_gap(cones, chain) < 0.25 * spacing) chain.pop_back();
+    return true;
+}
+
+template <typename T>
+void write_array(std::ofstream& out, const std::vector<T>& v)
+{
+    out.write(reinterpret_cast<const char*>(v.data()), static_cast<std::streamsize>(v.size() * sizeof(T)));
+}
+
+template <typename T>
+void read_array(const std::string& blob, std::size_t& pos, std::vector<T>& v, std::size_t count)
+{
+    v.resize(count);
+    std::memcpy(v.data(), blob.data() + pos, count * sizeof(T));
+    pos += count * sizeof(T);
+}
+
+} // anonymous namespace
+
+const char* cone_tag_name(ConeTag tag)
+{
+    switch (tag) {
+    case ConeTag::Blue:      return "blue";
+    case ConeTag::Yellow:    return "yellow";
+    case ConeTag::Orange:    return "orange";
+    case ConeTag::BigOrange: return "big_orange";
+    case ConeTag::CarStart:  return "car_start";
+    case ConeTag::Unknown:   break;
+    }
+    return "unknown";
+}
+
+TrackIndex TrackIndex::from_csv_text(std::string_view text, const TrackBuildOptions& options)
+{
+    TrackIndex track;
+    std::size_t line_no = 0;
+    std::size_t pos = 0;
+    while (pos < text.size()) {
+        const std::size_t end = std::min(text.find('\n', pos), text.size());
+        const std::string_view line = trim(text.substr(pos, end - pos));
+        pos = end + 1;
+        ++line_no;
+        if (line.empty() || lower(line.substr(0, 4)) == "tag,") continue;
+
+        std::string_view columns[7];
+        std::size_t count = 0;
+        std::size_t start = 0;
+        while (count < 7) {
+            const std::size_t comma = line.find(',', start);
+            columns[count++] = line.substr(start, comma == std::string_view::npos ? line.size() - start : comma - start);
+            if (comma == std::string_view::npos) break;
+            start = comma + 1;
+        }
+        if (count < 3) {
+            throw std::runtime_error("Track CSV line " + std::to_string(line_no) + ": expected tag,x,y,...");
+        }
+
+        Cone cone;
+        cone.tag = parse_tag(trim(columns[0]));
+        cone.x   = parse_column(columns[1], line_no, "x");
+        cone.y   = parse_column(columns[2], line_no, "y");
+        if (count > 3) cone.direction     = parse_column(columns[3], line_no, "direction");
+        if (count > 4) cone.x_variance    = parse_column(columns[4], line_no, "x_variance");
+        if (count > 5) cone.y_variance    = parse_column(columns[5], line_no, "y_variance");
+        if (count > 6) cone.xy_covariance = parse_column(columns[6], line_no, "xy_covariance");
+        track.cones_.push_back(cone);
+    }
+
+    track.build(options);
+    return track;
+}
+
+TrackIndex TrackIndex::from_csv(const std::string& path, const TrackBuildOptions& options)
+{
+    std::ifstream in(path, std::ios::binary);
+    if (!in) {
+        throw std::runtime_error("Cannot open track file: " + path);
+    }
+    const std::string text((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+    try {
+        return from_csv_text(text, options);
+    } catch (const std::runtime_error& e) {
+        throw std::runtime_error(path + ": " + e.what());
+    }
+}
+
+void TrackIndex::build(const TrackBuildOptions& options)
+{
+    if (!(options.scale > 0.0) || !(options.cell_size >= 0.0)) {
+        throw std::invalid_argument("TrackBuildOptions require scale > 0 and cell_size >= 0");
+    }
+
+    if (cones_.empty()) {
+        bounds_ = {-kEmptyTrackSpan / 2, -kEmptyTrackSpan / 2, kEmptyTrackSpan / 2, kEmptyTrackSpan / 2};
+    } else {
+        bounds_ = {cones_[0].x, cones_[0].y, cones_[0].x, cones_[0].y};
+        for (const Cone& c : cones_) {
+            bounds_.min_x = std::min<double>(bounds_.min_x, c.x);
+            bounds_.min_y = std::min<double>(bounds_.min_y, c.y);
+            bounds_.max_x = std::max<double>(bounds_.max_x, c.x);
+            bounds_.max_y = std::max<double>(bounds_.max_y, c.y);
+        }
+        if (options.scale != 1.0) {
+            const double cx = 0.5 * (bounds_.min_x + bounds_.max_x);
+            const double cy = 0.5 * (bounds_.min_y + bounds_.max_y);
+            for (Cone& c : cones_) {
+                c.x = static_cast<float>(cx + (c.x - cx) * options.scale);
+                c.y = static_cast<float>(cy + (c.y - cy) * options.scale);
+            }
+            bounds_ = {cx + (bounds_.min_x - cx) * options.scale, cy + (bounds_.min_y - cy) * options.scale,
+                       cx + (bounds_.max_x - cx) * options.scale, cy + (bounds_.max_y - cy) * options.scale};
+        }
+    }
+
+    pair_gates();
+
+    const double span = std::max(bounds_.max_x - bounds_.min_x, bounds_.max_y - bounds_.min_y);
+    if (options.loop) {
+        loop_ = *options.loop;
+    } else if (gates_.size() > 2) {
+        // startFinishFromPairs: the last gate ends near the first one
+        const Gate& first = gates_.front();
+        const Gate& last = gates_.back();
+        const double gap = std::hypot(0.5 * (first.ax + first.bx - last.ax - last.bx),
+                                      0.5 * (first.ay + first.by - last.ay - last.by));
+        loop_ = gap <= std::max(2.5, span / 8.0);
+    }
+
+    if (!gates_.empty()) {
+        const Gate& g = gates_.front();
+        start_.x = 0.5 * (g.ax + g.bx);
+        start_.y = 0.5 * (g.ay + g.by);
+        double nx = -(g.by - g.ay);
+        double ny = g.bx - g.ax;
+        if (gates_.size() > 1) {
+            const Gate& next = gates_[1];
+            const double tx = 0.5 * (next.ax + next.bx) - start_.x;
+            const double ty = 0.5 * (next.ay + next.by) - start_.y;
+            if (nx * tx + ny * ty < 0.0) {
+                nx = -nx;
+                ny = -ny;
+            }
+        }
+        start_.yaw = std::atan2(ny, nx);
+    }
+
+    build_boundaries();
+
+    double cell = options.cell_size;
+    if (cell <= 0.0) {
+        std::vector<double> spacing;
+        for (std::size_t i = 1; i < gates_.size(); ++i) {
+            spacing.push_back(std::hypot(0.5 * (gates_[i].ax + gates_[i].bx - gates_[i - 1].ax - gates_[i - 1].bx),
+                                         0.5 * (gates_[i].ay + gates_[i].by - gates_[i - 1].ay - gates_[i - 1].by)));
+        }
+        if (spacing.empty()) {
+            cell = std::max(1.0, span / 32.0);
+        } else {
+            std::nth_element(spacing.begin(), spacing.begin() + static_cast<std::ptrdiff_t>(spacing.size() / 2), spacing.end());
+            cell = std::max(0.5, spacing[spacing.size() / 2]);
+        }
+    }
+    build_grid(cell);
+}
+
+void TrackIndex::pair_gates()
+{
+    std::vector<std::size_t> yellows;
+    std::vector<std::size_t> blues;
+    for (std::size_t i = 0; i < cones_.size(); ++i) {
+        if (cones_[i].tag == ConeTag::Yellow) yellows.push_back(i);
+        if (cones_[i].tag == ConeTag::Blue) blues.push_back(i);
+    }
+    const bool closed_blue = close_chain(cones_, blues);
+    const bool closed = close_chain(cones_, yellows) && closed_blue;
+
+    // nearestPairs(): all combinations by distance, each cone used once
+    struct Combo {
+        double distance;
+        std::uint32_t yellow; // position along the yellow chain
+        std::uint32_t blue;   // position along the blue chain
+    };
+    std::vector<Combo> combos;
+    combos.reserve(yellows.size() * blues.size());
+    for (std::size_t y = 0; y < yellows.size(); ++y) {
+        for (std::size_t b = 0; b < blues.size(); ++b) {
+            const Cone& cy = cones_[yellows[y]];
+            const Cone& cb = cones_[blues[b]];
+            combos.push_back({std::hypot(double(cy.x) - cb.x, double(cy.y) - cb.y),
+                              static_cast<std::uint32_t>(y), static_cast<std::uint32_t>(b)});
+        }
+    }
+    std::stable_sort(combos.begin(), combos.end(),
+                     [](const Combo& l, const Combo& r) { return l.distance < r.distance; });
+    if (combos.empty()) {
+        gates_.clear();
+        return;
+    }
+
+    // Accept a pair only if it keeps both chains in order, so that gates never cross and their
+    // order follows the boundaries. Closed chains are rotated to start at the nearest pair.
+    const std::uint32_t nb = static_cast<std::uint32_t>(blues.size());
+    const std::uint32_t ny = static_cast<std::uint32_t>(yellows.size());
+    const std::uint32_t b0 = closed ? combos.front().blue : 0;
+    const std::uint32_t y0 = closed ? combos.front().yellow : 0;
+
+    const std::size_t target = std::min(yellows.size(), blues.size());
+    std::vector<bool> used_yellow(yellows.size(), false);
+    std::vector<bool> used_blue(blues.size(), false);
+    std::map<std::uint32_t, std::uint32_t> accepted; // rotated blue -> rotated yellow
+    for (const Combo& c : combos) {
+        if (accepted.size() >= target) break;
+        if (used_yellow[c.yellow] || used_blue[c.blue]) continue;
+        const std::uint32_t rb = (c.blue + nb - b0) % nb;
+        const std::uint32_t ry = (c.yellow + ny - y0) % ny;
+        const auto next = accepted.lower_bound(rb);
+        if (next != accepted.end() && next->second <= ry) continue;
+        if (next != accepted.begin() && std::prev(next)->second >= ry) continue;
+        accepted.emplace(rb, ry);
+        used_yellow[c.yellow] = true;
+        used_blue[c.blue] = true;
+    }
+
+    gates_.clear();
+    gates_.reserve(accepted.size());
+    std::size_t first = 0;
+    double first_key = std::numeric_limits<double>::infinity();
+    const Cone* car = nullptr;
+    for (const Cone& c : cones_) {
+        if (c.tag == ConeTag::CarStart) {
+            car = &c;
+            break;
+        }
+    }
+    for (const auto& [rb, ry] : accepted) {
+        const std::uint32_t b = (rb + b0) % nb;
+        const Cone& cy = cones_[yellows[(ry + y0) % ny]];
+        const Cone& cb = cones_[blues[b]];
+        // a closed track starts at the gate nearest the car_start cone, else the first blue cone
+        const double key = car ? std::hypot(0.5 * (double(cy.x) + cb.x) - car->x, 0.5 * (double(cy.y) + cb.y) - car->y)
+                               : static_cast<double>(b);
+        if (key < first_key) {
+            first_key = key;
+            first = gates_.size();
+        }
+        gates_.push_back({cy.x, cy.y, cb.x, cb.y});
+    }
+    if (closed) {
+        std::rotate(gates_.begin(), gates_.begin() + static_cast<std::ptrdiff_t>(first), gates_.end());
+    }
+}
+
+void TrackIndex::build_boundaries()
+{
+    segments_.clear();
+    for (const ConeTag side : {ConeTag::Blue, ConeTag::Yellow}) {
+        std::vector<const Cone*> chain;
+        for (const Cone& c : cones_) {
+            if (c.tag == side) chain.push_back(&c);
+        }
+        for (std::size_t i = 1; i < chain.size(); ++i) {
+            segments_.push_back({chain[i - 1]->x, chain[i - 1]->y, chain[i]->x, chain[i]->y, side});
+        }
+        if (loop_ && chain.size() > 2) {
+            segments_.push_back({chain.back()->x, chain.back()->y, chain.front()->x, chain.front()->y, side});
+        }
+    }
+}
+
+std::size_t TrackIndex::quad_count() const noexcept
+{
+    if (gates_.size() < 2) return 0;
+    return loop_ ? gates_.size() : gates_.size() - 1;
+}
+
+void TrackIndex::build_grid(double cell_size)
+{
+    const double width = bounds_.max_x - bounds_.min_x;
+    const double height = bounds_.max_y - bounds_.min_y;
+    cell_size_ = cell_size;
+    for (;;) {
+        nx_ = static_cast<std::size_t>(std::ceil(width / cell_size_)) + 1 + 2 * kGridMargin;
+        ny_ = static_cast<std::size_t>(std::ceil(height / cell_size_)) + 1 + 2 * kGridMargin;
+        if (nx_ * ny_ <= kMaxCells) break;
+        cell_size_ *= 2.0;
+    }
+    origin_x_ = bounds_.min_x - static_cast<double>(kGridMargin) * cell_size_;
+    origin_y_ = bounds_.min_y - static_cast<double>(kGridMargin) * cell_size_;
+
+    const std::size_t cells = nx_ * ny_;
+    const auto clamp_cell = [](double v, std::size_t n) {
+        return static_cast<std::size_t>(std::clamp(v, 0.0, static_cast<double>(n - 1)));
+    };
+
+    // Registers every item in the cells overlapped by its bounding box.
+    const auto fill_by_box = [&](CellLists& lists, std::size_t count, auto&& box) {
+        std::vector<std::vector<std::uint32_t>> per_cell(cells);
+        for (std::size_t i = 0; i < count; ++i) {
+            double x0, y0, x1, y1;
+            box(i, x0, y0, x1, y1);
+            const std::size_t cx0 = clamp_cell(std::floor((x0 - origin_x_) / cell_size_), nx_);
+            const std::size_t cx1 = clamp_cell(std::floor((x1 - origin_x_) / cell_size_), nx_);
+            const std::size_t cy0 = clamp_cell(std::floor((y0 - origin_y_) / cell_size_), ny_);
+            const std::size_t cy1 = clamp_cell(std::floor((y1 - origin_y_) / cell_size_), ny_);
+            for (std::size_t cy = cy0; cy <= cy1; ++cy) {
+                for (std::size_t cx = cx0; cx <= cx1; ++cx) {
+                    per_cell[cy * nx_ + cx].push_back(static_cast<std::uint32_t>(i));
+                }
+            }
+        }
+        lists.offsets.assign(cells + 1, 0);
+        lists.items.clear();
+        for (std::size_t c = 0; c < cells; ++c) {
+            lists.items.insert(lists.items.end(), per_cell[c].begin(), per_cell[c].end());
+            lists.offsets[c + 1] = static_cast<std::uint32_t>(lists.items.size());
+        }
+    };
+
+    fill_by_box(gate_cells_, gates_.size(), [&](std::size_t i, double& x0, double& y0, double& x1, double& y1) {
+        const Gate& g = gates_[i];
+        x0 = std::min(g.ax, g.bx);
+        x1 = std::max(g.ax, g.bx);
+        y0 = std::min(g.ay, g.by);
+        y1 = std::max(g.ay, g.by);
+    });
+    fill_by_box(quad_cells_, quad_count(), [&](std::size_t i, double& x0, double& y0, double& x1, double& y1) {
+        const Gate& g = gates_[i];
+        const Gate& h = gates_[(i + 1) % gates_.size()];
+        x0 = std::min({g.ax, g.bx, h.ax, h.bx});
+        x1 = std::max({g.ax, g.bx, h.ax, h.bx});
+        y0 = std::min({g.ay, g.by, h.ay, h.by});
+        y1 = std::max({g.ay, g.by, h.ay, h.by});
+    });
+
+    // Nearest-segment candidates: a segment whose closest approach to the cell is beyond the
+    // best worst-case distance of another segment can never be the nearest one inside it. The
+    // centre distance d bounds both sides (d - h <= near, max <= d + h for half-diagonal h), so
+    // only segments within d_min + 2h of the centre need the exact rectangle tests.
+    boundary_cells_.offsets.assign(cells + 1, 0);
+    boundary_cells_.items.clear();
+    const double half_diagonal = cell_size_ * std::sqrt(0.5);
+    std::vector<double> centre(segments_.size());
+    std::vector<std::uint32_t> shortlist;
+    for (std::size_t cy = 0; cy < ny_; ++cy) {
+        for (std::size_t cx = 0; cx < nx_; ++cx) {
+            const double x0 = origin_x_ + static_cast<double>(cx) * cell_size_;
+            const double y0 = origin_y_ + static_cast<double>(cy) * cell_size_;
+            const double x1 = x0 + cell_size_;
+            const double y1 = y0 + cell_size_;
+            double nearest = std::numeric_limits<double>::infinity();
+            for (std::size_t s = 0; s < segments_.size(); ++s) {
+                centre[s] = segment_distance(0.5 * (x0 + x1), 0.5 * (y0 + y1), segments_[s]);
+                nearest = std::min(nearest, centre[s]);
+            }
+            shortlist.clear();
+            double bound = std::numeric_limits<double>::infinity();
+            for (std::size_t s = 0; s < segments_.size(); ++s) {
+                if (centre[s] > nearest + 2.0 * half_diagonal) continue;
+                shortlist.push_back(static_cast<std::uint32_t>(s));
+                bound = std::min(bound, rect_segment_max_distance(x0, y0, x1, y1, segments_[s]));
+            }
+            for (const std::uint32_t s : shortlist) {
+                if (rect_segment_distance(x0, y0, x1, y1, segments_[s]) <= bound) {
+                    boundary_cells_.items.push_back(s);
+                }
+            }
+            boundary_cells_.offsets[cy * nx_ + cx + 1] = static_cast<std::uint32_t>(boundary_cells_.items.size());
+        }
+    }
+}
+
+bool TrackIndex::cell_of(double x, double y, std::size_t& cx, std::size_t& cy) const
+{
+    const double fx = std::floor((x - origin_x_) / cell_size_);
+    const double fy = std::floor((y - origin_y_) / cell_size_);
+    if (!(fx >= 0.0 && fy >= 0.0 && fx < static_cast<double>(nx_) && fy < static_cast<double>(ny_))) {
+        return false;
+    }
+    cx = static_cast<std::size_t>(fx);
+    cy = static_cast<std::size_t>(fy);
+    return true;
+}
+
+bool TrackIndex::crosses_gate(std::size_t gate, double x0, double y0, double x1, double y1) const
+{
+    const Gate& g = gates_[gate];
+    const double gx = g.bx - g.ax;
+    const double gy = g.by - g.ay;
+    // half-open in the motion so that a step ending exactly on the line counts once
+    const double s0 = cross(gx, gy, x0 - g.ax, y0 - g.ay);
+    const double s1 = cross(gx, gy, x1 - g.ax, y1 - g.ay);
+    if (!((s0 < 0.0 && s1 >= 0.0) || (s0 >= 0.0 && s1 < 0.0))) return false;
+    const double mx = x1 - x0;
+    const double my = y1 - y0;
+    const double e0 = cross(mx, my, g.ax - x0, g.ay - y0);
+    const double e1 = cross(mx, my, g.bx - x0, g.by - y0);
+    return (e0 <= 0.0 && e1 >= 0.0) || (e0 >= 0.0 && e1 <= 0.0);
+}
+
+long TrackIndex::first_gate_crossed(double x0, double y0, double x1, double y1) const
+{
+    long best = -1;
+    double best_t = std::numeric_limits<double>::infinity();
+    const auto consider = [&](std::size_t gate) {
+        if (!crosses_gate(gate, x0, y0, x1, y1)) return;
+        const Gate& g = gates_[gate];
+        const double gx = g.bx - g.ax;
+        const double gy = g.by - g.ay;
+        const double s0 = cross(gx, gy, x0 - g.ax, y0 - g.ay);
+        const double s1 = cross(gx, gy, x1 - g.ax, y1 - g.ay);
+        const double t = s0 / (s0 - s1);
+        if (t < best_t || (t == best_t && static_cast<long>(gate) < best)) {
+            best_t = t;
+            best = static_cast<long>(gate);
+        }
+    };
+
+    std::size_t cx0, cy0, cx1, cy1;
+    if (!cell_of(std::min(x0, x1), std::min(y0, y1), cx0, cy0) ||
+        !cell_of(std::max(x0, x1), std::max(y0, y1), cx1, cy1)) {
+        for (std::size_t i = 0; i < gates_.size(); ++i) consider(i);
+        return best;
+    }
+    for (std::size_t cy = cy0; cy <= cy1; ++cy) {
+        for (std::size_t cx = cx0; cx <= cx1; ++cx) {
+            const std::size_t cell = cy * nx_ + cx;
+            for (std::uint32_t k = gate_cells_.offsets[cell]; k < gate_cells_.offsets[cell + 1]; ++k) {
+                consider(gate_cells_.items[k]);
+            }
+        }
+    }
+    return best;
+}
+
+BoundaryHit TrackIndex::nearest_boundary(double x, double y) const
+{
+    BoundaryHit hit{std::numeric_limits<double>::infinity(), 0};
+    const auto consider = [&](std::size_t s) {
+        const double d = segment_distance(x, y, segments_[s]);
+        if (d < hit.distance) hit = {d, s};
+    };
+
+    std::size_t cx, cy;
+    if (!cell_of(x, y, cx, cy)) {
+        for (std::size_t s = 0; s < segments_.size(); ++s) consider(s);
+        return hit;
+    }
+    const std::size_t cell = cy * nx_ + cx;
+    for (std::uint32_t k = boundary_cells_.offsets[cell]; k < boundary_cells_.offsets[cell + 1]; ++k) {
+        consider(boundary_cells_.items[k]);
+    }
+    return hit;
+}
+
+bool TrackIndex::in_quad(std::size_t quad, double x, double y) const
+{
+    const Gate& g = gates_[quad];
+    const Gate& h = gates_[(quad + 1) % gates_.size()];
+    const Point poly[4] = {{g.ax, g.ay}, {g.bx, g.by}, {h.bx, h.by}, {h.ax, h.ay}};
+    bool inside = false;
+    for (int i = 0, j = 3; i < 4; j = i++) {
+        if ((poly[i].y > y) != (poly[j].y > y) &&
+            x < (poly[j].x - poly[i].x) * (y - poly[i].y) / (poly[j].y - poly[i].y) + poly[i].x) {
+            inside = !inside;
+        }
+    }
+    return inside;
+}
+
+bool TrackIndex::on_track(double x, double y) const
+{
+    std::size_t cx, cy;
+    if (!cell_of(x, y, cx, cy)) return false;
+    const std::size_t cell = cy * nx_ + cx;
+    for (std::uint32_t k = quad_cells_.offsets[cell]; k < quad_cells_.offsets[cell + 1]; ++k) {
+        if (in_quad(quad_cells_.items[k], x, y)) return true;
+    }
+    return false;
+}
+
+std::size_t TrackIndex::memory_bytes() const noexcept
+{
+    const auto lists = [](const CellLists& l) {
+        return (l.offsets.size() + l.items.size()) * sizeof(std::uint32_t);
+    };
+    return cones_.size() * sizeof(Cone) + gates_.size() * sizeof(Gate) +
+           segments_.size() * sizeof(BoundarySegment) + lists(gate_cells_) + lists(quad_cells_) +
+           lists(boundary_cells_);
+}
+
+void TrackIndex::save_binary(const std::string& path) const
+{
+    FileHeader h{};
+    std::memcpy(h.magic, kFileMagic, sizeof(kFileMagic));
+    h.version        = kFileVersion;
+    h.loop           = loop_ ? 1u : 0u;
+    h.cones          = cones_.size();
+    h.gates          = gates_.size();
+    h.segments       = segments_.size();
+    h.nx             = nx_;
+    h.ny             = ny_;
+    h.gate_items     = gate_cells_.items.size();
+    h.quad_items     = quad_cells_.items.size();
+    h.boundary_items = boundary_cells_.items.size();
+    h.origin_x       = origin_x_;
+    h.origin_y       = origin_y_;
+    h.cell_size      = cell_size_;
+    h.bounds         = bounds_;
+    h.start          = start_;
+
+    std::ofstream out(path, std::ios::binary | std::ios::trunc);
+    if (!out) {
+        throw std::runtime_error("Cannot write track file: " + path);
+    }
+    out.write(reinterpret_cast<const char*>(&h), sizeof(h));
+    write_array(out, cones_);
+    write_array(out, gates_);
+    write_array(out, segments_);
+    for (const CellLists* l : {&gate_cells_, &quad_cells_, &boundary_cells_}) {
+        write_array(out, l->offsets);
+        write_array(out, l->items);
+    }
+    if (!out) {
+        throw std::runtime_error("Failed writing track file: " + path);
+    }
+}
+
+TrackIndex TrackIndex::load_binary(const std::string& path)
+{
+    std::ifstream in(path, std::ios::binary);
+    if (!in) {
+        throw std::runtime_error("Cannot open track file: " + path);
+    }
+    const std::string blob((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+
+    FileHeader h{};
+    if (blob.size() < sizeof(h)) {
+        throw std::runtime_error("Truncated track file: " + path);
+    }
+    std::memcpy(&h, blob.data(), sizeof(h));
+    if (std::memcmp(h.magic, kFileMagic, sizeof(kFileMagic)) != 0 || h.version != kFileVersion) {
+        throw std::runtime_error("Not a version " + std::to_string(kFileVersion) + " track file: " + path);
+    }
+
+    if (h.nx == 0 || h.ny == 0 || h.nx > kMaxCells / h.ny || !(h.cell_size > 0.0)) {
+        throw std::runtime_error("Corrupt track file: " + path);
+    }
+    const std::uint64_t cells = h.nx * h.ny;
+
+    // the counts come from the file, so size each array against the bytes left instead of
+    // summing them: an oversized count cannot wrap the total
+    std::uint64_t remaining = blob.size() - sizeof(h);
+    const auto take = [&remaining](std::uint64_t count, std::size_t size) {
+        if (count > remaining / size) return false;
+        remaining -= count * size;
+        return true;
+    };
+    if (!take(h.cones, sizeof(Cone)) || !take(h.gates, sizeof(Gate)) ||
+        !take(h.segments, sizeof(BoundarySegment)) || !take(cells + 1, sizeof(std::uint32_t)) ||
+        !take(h.gate_items, sizeof(std::uint32_t)) || !take(cells + 1, sizeof(std::uint32_t)) ||
+        !take(h.quad_items, sizeof(std::uint32_t)) || !take(cells + 1, sizeof(std::uint32_t)) ||
+        !take(h.boundary_items, sizeof(std::uint32_t)) || remaining != 0) {
+        throw std::runtime_error("Corrupt track file: " + path);
+    }
+
+    TrackIndex track;
+    std::size_t pos = sizeof(h);
+    read_array(blob, pos, track.cones_, h.cones);
+    read_array(blob, pos, track.gates_, h.gates);
+    read_array(blob, pos, track.segments_, h.segments);
+    read_array(blob, pos, track.gate_cells_.offsets, cells + 1);
+    read_array(blob, pos, track.gate_cells_.items, h.gate_items);
+    read_array(blob, pos, track.quad_cells_.offsets, cells + 1);
+    read_array(blob, pos, track.quad_cells_.items, h.quad_items);
+    read_array(blob, pos, track.boundary_cells_.offsets, cells + 1);
+    read_array(blob, pos, track.boundary_cells_.items, h.boundary_items);
+
+    track.loop_      = h.loop != 0;
+    track.nx_        = h.nx;
+    track.ny_        = h.ny;
+    track.origin_x_  = h.origin_x;
+    track.origin_y_  = h.origin_y;
+    track.cell_size_ = h.cell_size;
+    track.bounds_    = h.bounds;
+    track.start_     = h.start;
+
+    // the queries index without checks, so reject lists that point outside the arrays
+    const auto valid = [](const CellLists& l, std::size_t limit) {
+        if (l.offsets.front() != 0 || l.offsets.back() != l.items.size()) return false;
+        if (!std::is_sorted(l.offsets.begin(), l.offsets.end())) return false;
+        return std::all_of(l.items.begin(), l.items.end(), [limit](std::uint32_t i) { return i < limit; });
+    };
+    if (!valid(track.gate_cells_, track.gates_.size()) || !valid(track.quad_cells_, track.quad_count()) ||
+        !valid(track.boundary_cells_, track.segments_.size())) {
+        throw std::runtime_error("Corrupt track file: " + path);
+    }
+    return track;
+}
+
+} // namespace velox::track
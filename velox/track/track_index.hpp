@@ -0,0 +1,166 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace velox::track {
+
+enum class ConeTag : std::uint8_t {
+    Unknown,
+    Blue,
+    Yellow,
+    Orange,
+    BigOrange,
+    CarStart,
+};
+
+/** One row of a track CSV (tag,x,y,direction,x_variance,y_variance,xy_covariance). */
+struct Cone {
+    float x{};
+    float y{};
+    float direction{};
+    float x_variance{};
+    float y_variance{};
+    float xy_covariance{};
+    ConeTag tag{ConeTag::Unknown};
+};
+
+/** Checkpoint gate between a paired yellow (a) and blue (b) cone, as in loadTracks.ts. */
+struct Gate {
+    float ax{};
+    float ay{};
+    float bx{};
+    float by{};
+};
+
+/** Boundary piece between consecutive cones of one colour. */
+struct BoundarySegment {
+    float ax{};
+    float ay{};
+    float bx{};
+    float by{};
+    ConeTag side{ConeTag::Unknown};
+};
+
+struct TrackBounds {
+    double min_x{};
+    double min_y{};
+    double max_x{};
+    double max_y{};
+};
+
+struct StartPose {
+    double x{};
+    double y{};
+    double yaw{};
+};
+
+struct BoundaryHit {
+    double distance{};          // to the boundary centre line [m]; cones have cone_radius
+    std::size_t segment{};      // index into boundaries()
+};
+
+/** Playground scale applied to the CSV layouts (TRACK_SCALE_FACTOR in loadTracks.ts). */
+inline constexpr double kPlaygroundTrackScale = 3.7;
+
+struct TrackBuildOptions {
+    double scale = 1.0;            // about the cone bounds centre, like scaleTrack()
+    double cell_size = 0.0;        // grid cell edge [m]; 0 picks the median gate spacing
+    std::optional<bool> loop;      // unset detects a closed track from the gate layout
+};
+
+/**
+ * TrackIndex
+ *
+ * Compiled cone track with a uniform grid over its gates, boundary segments and the corridor
+ * between consecutive gates. Cones are paired into gates greedily by distance like
+ * loadTracks.ts, except that a pair must keep both colour chains in order (the CSVs list each
+ * colour in driving order); that stops gates from crossing in tight esses and orders them along
+ * the track. Each grid cell stores:
+ *
+ *   - the gates and corridor quads whose bounding box overlaps it, and
+ *   - every boundary segment that can be the nearest one for some point of the cell,
+ *
+ * so gate crossing, nearest-boundary distance and off-track tests touch one or a few cells
+ * rather than every cone. Queries outside the grid fall back to a linear scan.
+ *
+ * The binary form (save_binary / load_binary) is the in-memory layout written verbatim behind a
+ * small header, in host byte order. Immutable after construction; safe to share between threads.
+ */
+class TrackIndex {
+public:
+    /** Parses CSV text. Throws std::runtime_error naming the line of a malformed row. */
+    static TrackIndex from_csv_text(std::string_view text, const TrackBuildOptions& options = {});
+    static TrackIndex from_csv(const std::string& path, const TrackBuildOptions& options = {});
+
+    /** Throws std::runtime_error for a missing, truncated or foreign file. */
+    static TrackIndex load_binary(const std::string& path);
+    void save_binary(const std::string& path) const;
+
+    const std::vector<Cone>& cones() const noexcept { return cones_; }
+    const std::vector<Gate>& gates() const noexcept { return gates_; }
+    const std::vector<BoundarySegment>& boundaries() const noexcept { return segments_; }
+    const TrackBounds& bounds() const noexcept { return bounds_; }
+    bool is_loop() const noexcept { return loop_; }
+
+    /// Mid-point of the first gate, facing the second one (startPose in loadTracks.ts).
+    const StartPose& start_pose() const noexcept { return start_; }
+
+    /// True when the motion p0 -> p1 crosses gate (in either direction).
+    bool crosses_gate(std::size_t gate, double x0, double y0, double x1, double y1) const;
+
+    /// Index of the first gate crossed by the motion p0 -> p1, or -1. Intended for short moves.
+    long first_gate_crossed(double x0, double y0, double x1, double y1) const;
+
+    /// Nearest boundary segment; distance is +inf for a track without boundaries.
+    BoundaryHit nearest_boundary(double x, double y) const;
+
+    /// True when (x, y) lies inside the corridor spanned by consecutive gates.
+    bool on_track(double x, double y) const;
+
+    std::size_t memory_bytes() const noexcept;
+
+private:
+    // CSR list of item indices per grid cell
+    struct CellLists {
+        std::vector<std::uint32_t> offsets; // cell_count + 1
+        std::vector<std::uint32_t> items;
+    };
+
+    TrackIndex() = default;
+
+    void build(const TrackBuildOptions& options);
+    void pair_gates();
+    void build_boundaries();
+    void build_grid(double cell_size);
+
+    bool cell_of(double x, double y, std::size_t& cx, std::size_t& cy) const;
+    std::size_t quad_count() const noexcept;
+    bool in_quad(std::size_t quad, double x, double y) const;
+
+    std::vector<Cone> cones_;
+    std::vector<Gate> gates_;
+    std::vector<BoundarySegment> segments_;
+    TrackBounds bounds_{};
+    StartPose start_{};
+    bool loop_{false};
+
+    // grid
+    double origin_x_{};
+    double origin_y_{};
+    double cell_size_{1.0};
+    std::size_t nx_{0};
+    std::size_t ny_{0};
+    CellLists gate_cells_;
+    CellLists quad_cells_;
+    CellLists boundary_cells_;
+};
+
+/** Lower-case tag name as written in the CSVs ("blue", "big_orange", ...). */
+const char* cone_tag_name(ConeTag tag);
+
+} // namespace velox::track